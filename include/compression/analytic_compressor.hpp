@@ -0,0 +1,136 @@
+/**
+ *  AutoComp Analytic Compression Strategy
+ *  analytic_compressor.hpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_ANALYTIC_COMPRESSOR_HPP
+#define AC_ANALYTIC_COMPRESSOR_HPP
+
+#include <map>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "utils/buffer.hpp"
+#include "utils/exceptions.hpp"
+#include "utils/data_structures.hpp"
+#include "utils/bandwidth_estimator.hpp"
+#include "utils/codec_calibration.hpp"
+#include "messaging/compressor.pb.h"
+#include "compression/automatic_compression_strategy.hpp"
+#include "compression/compression_strategy.hpp"
+
+namespace autocomp {
+
+/**
+ * Analytic Compressor class.
+ *
+ * Chooses, for each chunk, the codec with the highest predicted effective
+ * transmission rate, as the training compressor measures it: the least of
+ * the bandwidth and the rate the codec outputs compressed data at, times
+ * its ratio. The rate and ratio come from the calibration of the codecs on
+ * this host, the rate scaled by the share of a core the CPU load leaves,
+ * and every chunk compressed refines it. Unlike the decision tree, nothing
+ * learned on another CPU is taken for granted.
+ *
+ * One compressor serves a single session, and must not be used by several
+ * threads at once.
+ */
+class AnalyticCompressor : public AutomaticCompressionStrategy
+{
+  // CompressorType => Pair<Compressor, Level>
+  using CompressorType = CodecCalibration::Codec;
+
+  using CompressorPointer = std::shared_ptr<CompressionStrategy>;
+
+  std::map<CompressorType, CompressorPointer> compressors;
+
+  CodecCalibration * calibration;
+
+  const ResourceState * resourceState;
+
+  /**
+   * Bandwidth of the session's connection. Without it, the server wide
+   * bandwidth of the resource state is used
+   */
+  const std::shared_ptr<const BandwidthEstimator> bandwidthEstimator;
+
+public:
+
+  /**
+   * AnalyticCompressor constructor
+   *
+   * @param calibration Calibration of the codecs, refined by this compressor
+   *
+   * @ŧhrows std::bad_alloc On a memory allocation failure.
+   */
+  AnalyticCompressor(CodecCalibration * calibration,
+                     const ResourceState * resourceState,
+                     const std::shared_ptr<io::PerformanceDataWriter> &
+                        performanceDataWriter = nullptr,
+                     const std::shared_ptr<const BandwidthEstimator> &
+                        bandwidthEstimator = nullptr);
+
+  /**
+   * @copydoc autocomp::CompressionStrategy::compress()
+   */
+  Compressor compress(const Buffer & inData, Buffer & outData) const;
+
+  /**
+   * Ranks the codecs for a chunk, from the highest predicted effective
+   * transmission rate to the lowest. Copying is always ranked
+   */
+  std::vector<CompressorType> rankCompressors(const Buffer & inData) const;
+
+  /**
+   * Calibrates the codecs the analytic compressors choose from by
+   * compressing samples of text, records, doubles and random bytes with
+   * each of them
+   *
+   * @param sampleSize Size of the text sample, which the compression rates
+   *                   are measured on, and of the doubles FPC is timed on
+   */
+  static void calibrate(CodecCalibration & calibration,
+                        const std::size_t & sampleSize =
+                          constants::CALIBRATION_SAMPLE_SIZE);
+
+private:
+
+  /**
+   * Creates the codecs to choose from, all but copying
+   */
+  static std::map<CompressorType, CompressorPointer> createCompressors();
+
+  std::vector<CompressorType> rankCompressors(const double & entropy,
+                                              const int & fpcLevel) const;
+
+  /**
+   * Gets the entropy of the chunk from a few samples of it
+   */
+  static double getEntropy(const Buffer & inData);
+
+  /**
+   * Gets the level FPC would compress the chunk with, if it is made of
+   * doubles
+   *
+   * @returns 0 if it is not
+   */
+  static int getFPCLevel(const Buffer & inData);
+
+  /**
+   * Gets the CPU load the prediction is made with: the load the CPU budget
+   * leaves to this session if there is one, otherwise the system's
+   */
+  float getCPULoad() const;
+
+  float getBandwidth() const;
+
+}; // class AnalyticCompressor
+
+} // namespace autocomp
+
+#endif // AC_ANALYTIC_COMPRESSOR_HPP
@@ -12,14 +12,22 @@
 
 #include <string>
 #include <map>
+#include <array>
+#include <vector>
 #include <memory>
 #include <cmath>
+#include <chrono>
+#include <algorithm>
 
 #include "utils/buffer.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/constants.hpp"
 #include "utils/data_structures.hpp"
 #include "utils/functions.hpp"
-#include "utils/decision_tree.hpp"
+#include "utils/floating_point_detector.hpp"
+#include "utils/change_point_detector.hpp"
+#include "utils/classification_model.hpp"
+#include "utils/bandwidth_estimator.hpp"
 #include "network/socket/tcp_socket.hpp"
 #include "messaging/compressor.pb.h"
 #include "compression/automatic_compression_strategy.hpp"
@@ -28,35 +36,94 @@
 #include "compression/lzo_compressor.hpp"
 #include "compression/bzip2_compressor.hpp"
 #include "compression/lzma_compressor.hpp"
+#include "compression/fpc_compressor.hpp"
 
 namespace autocomp {
 
 /** 
  * AutoComp Compressor class.
+ *
+ * The server creates one compressor per session, so the adaptive state below
+ * follows the data of a single client: an incompressible stream only makes
+ * its own session send uncompressed. A compressor must not be shared by
+ * sessions, nor used by several threads at once.
  */
 template<class SocketType>
 class AutoCompCompressor : public AutomaticCompressionStrategy
 {
+  /**
+   * Adaptive state of the session, updated as its chunks are compressed
+   */
+  struct SessionState
+  {
+    int currentBytecounting;
+    Compressibility currentCompressibility;
+    int currentFPCLevel;                  // 0 unless the data is doubles
+    bool sendingUncompressed;
+    float currentSendBufferLoad;
+    long bytesSinceEvaluation;            // -1 until the first chunk
+    bool dataChanged;
+    ChangePointDetector entropyDetector;
+    ChangePointDetector compressionDetector;
+    Compressor lastUsedCompressor;
+
+    SessionState()
+      : currentBytecounting(0),
+        currentCompressibility{1, 0},
+        currentFPCLevel(0),
+        sendingUncompressed(false),
+        currentSendBufferLoad(0),
+        bytesSinceEvaluation(-1),
+        dataChanged(false),
+        entropyDetector(constants::CUSUM_ENTROPY_DRIFT,
+                        constants::CUSUM_ENTROPY_THRESHOLD),
+        compressionDetector(constants::CUSUM_COMPRESSION_DRIFT,
+                            constants::CUSUM_COMPRESSION_THRESHOLD),
+        lastUsedCompressor(COPY)
+    {}
+  };
+
+  mutable SessionState sessionState;
+
   const ResourceState * resourceState;
 
+  /**
+   * Bandwidth of the session's connection. Without it, the server wide
+   * bandwidth of the resource state is used
+   */
+  const std::shared_ptr<const BandwidthEstimator> bandwidthEstimator;
+
   const std::shared_ptr<SocketType> clientSocket;
 
   const float clientSocketSendBufferCapacity;
 
-  const int bytesToSendUncompressed = 512 * 1024; // 512 KB
-
-  const int bytesToSendBeforeCalculatingAgaing = 512 * 1024;
+protected:
 
   // <--- Compressors ---> //
 
   // CompressorType => Pair<Compressor, Level>
   using CompressorType = std::pair<Compressor, int>;
 
+  // Context => CPU load, bandwidth and bytecounting levels
+  using Context = std::array<int, 3>;
+
+private:
+
   using CompressorPointer = std::shared_ptr<CompressionStrategy>;
 
   std::map<CompressorType, CompressorPointer> compressors;
 
-  const DecisionTree * decisionTree;
+  /**
+   * Used instead of the chosen compressor, in this order, while its working
+   * memory does not fit in the memory budget
+   */
+  const std::vector<CompressorType> lowMemoryCompressors{{ZLIB, 1},
+                                                         {SNAPPY, -1}};
+
+  /**
+   * Decision tree or ensemble the compressors are chosen with
+   */
+  const ClassificationModel * model;
 
 public:
 
@@ -65,28 +132,124 @@ public:
    *
    * @ŧhrows std::bad_alloc On a memory allocation failure.
    */
-  AutoCompCompressor(const DecisionTree * decisionTree,
+  AutoCompCompressor(const ClassificationModel * model,
                      const ResourceState * resourceState,
                      const std::shared_ptr<SocketType> & clientSocket,
                      const std::shared_ptr<io::PerformanceDataWriter> &
-                        performanceDataWriter = nullptr);
+                        performanceDataWriter = nullptr,
+                     const std::shared_ptr<const BandwidthEstimator> &
+                        bandwidthEstimator = nullptr);
 
   /**
    * @copydoc autocomp::CompressionStrategy::compress()
    */
   Compressor compress(const Buffer & inData, Buffer & outData) const;
 
+  /**
+   * Forgets what was learned from the data compressed so far, so the
+   * compressor can serve a new session
+   */
+  void reset();
+
+protected:
+
+  /**
+   * Chooses the compressor for a chunk, with the model by default. Models
+   * trained with a fourth feature take the compressibility level
+   */
+  virtual CompressorType chooseCompressor(const Context & context) const
+  {
+    if (this->model->getFeatureCount() > context.size()) {
+      return this->model->classify(std::array<int, 4>{{
+          context[0], context[1], context[2],
+          this->getCompressibilityLevel(
+              this->sessionState.currentCompressibility.compressionRatio
+            )
+        }});
+    }
+
+    return this->model->classify(context);
+  }
+
+  /**
+   * Gets the compressor a chunk is compressed with, given the chosen one.
+   * By default FPC takes the place of the fast LZ codecs on doubles, which
+   * the model was never trained to choose
+   *
+   * @param compressorType Compressor chosen
+   * @param inData Chunk to compress
+   */
+  virtual CompressorType adaptToData(const CompressorType & compressorType,
+                                     const Buffer & inData) const;
+
+  /**
+   * Tells how a chunk was compressed. Nothing is done with it by default
+   *
+   * @param context Context the compressor was chosen in
+   * @param compressorType Compressor chosen
+   * @param usedCompressor Compressor used, another one if the chosen one did
+   *                       not fit in the memory budget
+   * @param inSize Size of the chunk
+   * @param outSize Size of the compressed chunk
+   * @param compressionTime Time it took to compress it
+   */
+  virtual void observe(const Context & /* context */,
+                       const CompressorType & /* compressorType */,
+                       const Compressor & /* usedCompressor */,
+                       const std::size_t & /* inSize */,
+                       const std::size_t & /* outSize */,
+                       const std::chrono::nanoseconds & /* compressionTime */)
+    const
+  {}
+
+  float getBandwidth() const;
+
 private:
 
+  /**
+   * Compresses with the given compressor or, if the memory governor can not
+   * fit its working memory, with the first lighter one that fits
+   *
+   * @returns The compressor used, COPY if the data was not compressed
+   */
+  Compressor compressWithinBudget(const CompressorType & compressorType,
+                                  const Buffer & inData,
+                                  Buffer & outData) const;
+
+  /**
+   * Chooses a compressor for the chunk and compresses it
+   */
+  Compressor selectAndCompress(const Buffer & inData, Buffer & outData) const;
+
+  /**
+   * Takes the measure of the data again if the chunk is far enough from the
+   * last time and the data changed, or too far from it anyway
+   */
+  void evaluateData(const Buffer & inData) const;
+
+  /**
+   * Follows the share of the chunks each compressor leaves, to tell when
+   * the data changes while it is compressed
+   */
+  void watchCompression(const Compressor & usedCompressor,
+                        const std::size_t & inSize,
+                        const std::size_t & outSize) const;
+
+  /**
+   * Gets the CPU load to choose the compressor with: the load the CPU budget
+   * leaves to this session if there is one, otherwise the system's
+   */
+  float getCPULoad() const;
+
   int getCPULoadLevel(const float & cpuLoad) const;
 
   int getBandwidthLevel(const float & bandwidth) const;
 
   int getBytecoutingLevel(const float & bytecounting) const;
 
-  float getClientSocketSendBufferLoad() const;
+  int getCompressibilityLevel(const float & compressionRatio) const;
 
-  int getBytecounting(const Buffer & inData) const;
+  float getClientSocketSendBufferLoad() const;
 
 }; // class AutoCompCompressor
 
@@ -94,18 +257,20 @@ private:
 
 template<class SocketType>
 AutoCompCompressor<SocketType>::AutoCompCompressor(
-    const DecisionTree * decisionTree, const ResourceState * resourceState,
+    const ClassificationModel * model, const ResourceState * resourceState,
     const std::shared_ptr<SocketType> & clientSocket,
-    const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter
+    const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter,
+    const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator
   )
   : AutomaticCompressionStrategy(performanceDataWriter),
-    decisionTree(decisionTree),
     resourceState(resourceState),
+    bandwidthEstimator(bandwidthEstimator),
     clientSocket(clientSocket),
-    clientSocketSendBufferCapacity(clientSocket->getSendBufferCapacity())
+    clientSocketSendBufferCapacity(clientSocket->getSendBufferCapacity()),
+    model(model)
 {
-  if (not decisionTree) {
-    throw std::domain_error("decisionTree must not be null");
+  if (not model) {
+    throw std::domain_error("model must not be null");
   }
 
   if (not resourceState) {
@@ -150,6 +315,15 @@ AutoCompCompressor<SocketType>::AutoCompCompressor(
         std::make_shared<LZMACompressor>(compressionLevel))
       );
   }
+
+  // Insert the fpc levels doubles are compressed with
+  for (int compressionLevel : {constants::FPC_FAST_LEVEL,
+                               constants::FPC_STRONG_LEVEL}) {
+    this->compressors.insert(
+        std::make_pair(std::make_pair(FPC, compressionLevel),
+        std::make_shared<FPCCompressor>(compressionLevel))
+      );
+  }
 }
 
 template<class SocketType>
@@ -157,49 +331,43 @@ Compressor
 AutoCompCompressor<SocketType>::compress(const Buffer & inData,
                                          Buffer & outData) const
 {
-  static int currentBytecounting(0);
-  static float currentSendBufferLoad(0.0);
-  static int remainingBytesToCalculateAgain(0);
-  static int remainingBytesToSendUncompressed(0);
-  //static int remainingBytesToSendSnappy(0);
+  std::chrono::nanoseconds cpuTime = getThreadCPUTime();
 
-  if (remainingBytesToSendUncompressed > 0) {
-    remainingBytesToSendUncompressed -= inData.getSize();
+  Compressor compressor = this->selectAndCompress(inData, outData);
 
-    return COPY;
-  }
+  this->cpuCommitment.record(getThreadCPUTime() - cpuTime);
 
-  //CompressorType compressorType;
-  //CompressorPointer compressor;
+  return compressor;
+}
 
-  if (remainingBytesToCalculateAgain <= 0) {
-    //if ((currentSendBufferLoad = this->getClientSocketSendBufferLoad()) < 0.1 or
-    //    (currentBytecounting = this->getBytecounting(inData)) > 100) {
+template<class SocketType>
+Compressor
+AutoCompCompressor<SocketType>::selectAndCompress(const Buffer & inData,
+                                                  Buffer & outData) const
+{
+  int & currentBytecounting = this->sessionState.currentBytecounting;
+  float & currentSendBufferLoad = this->sessionState.currentSendBufferLoad;
+  //static int remainingBytesToSendSnappy(0);
 
-    if ((currentBytecounting = this->getBytecounting(inData)) > 100) {
-      remainingBytesToSendUncompressed = this->bytesToSendUncompressed;
+  //CompressorType compressorType;
+  //CompressorPointer compressor;
 
-      return COPY;
-    }
+  this->evaluateData(inData);
 
-    remainingBytesToCalculateAgain = this->bytesToSendBeforeCalculatingAgaing;
-  }
-  else {
-    remainingBytesToCalculateAgain -= inData.getSize();
+  if (this->sessionState.sendingUncompressed) {
+    return COPY;
   }
 
   if ((currentSendBufferLoad = this->getClientSocketSendBufferLoad()) < 0.05) {
-    try {
-      auto compressor = this->compressors.at(std::make_pair(ZLIB, 3));
-      compressor->compress(inData, outData);
-    }
-    catch (const std::out_of_range & error) {
-      return COPY;
-    }
-
     //remainingBytesToSendSnappy = 512 * 1024;
 
-    return ZLIB;
+    Compressor usedCompressor =
+      this->compressWithinBudget(std::make_pair(ZLIB, 3), inData, outData);
+
+    this->watchCompression(usedCompressor, inData.getSize(),
+                           outData.getSize());
+
+    return usedCompressor;
   }
 
   /*
@@ -236,30 +404,206 @@ AutoCompCompressor<SocketType>::compress(const Buffer & inData,
   }
   */
 
-  auto compressorType = 
-    this->decisionTree->classify(
-        {
-          this->getCPULoadLevel(this->resourceState->cpuLoad),
-          this->getBandwidthLevel(this->resourceState->bandwidth),
-          this->getBytecoutingLevel(currentBytecounting)
-        }
-      );
+  Context context{{
+    this->getCPULoadLevel(this->getCPULoad()),
+    this->getBandwidthLevel(this->getBandwidth()),
+    this->getBytecoutingLevel(currentBytecounting)
+  }};
+
+  auto compressorType = this->chooseCompressor(context);
 
-  this->performanceDataWriter->write(Compressor_Name(compressorType.first));  
+  if (this->performanceDataWriter) {
+    this->performanceDataWriter->write(Compressor_Name(compressorType.first));
+  }
 
   if (compressorType.first == COPY) {
+    this->observe(context, compressorType, COPY, inData.getSize(),
+                  inData.getSize(), std::chrono::nanoseconds(0));
+
     return COPY;
   }
 
+  CompressorType usedCompressorType = this->adaptToData(compressorType,
+                                                        inData);
+
+  auto tic = std::chrono::steady_clock::now();
+  Compressor usedCompressor =
+    this->compressWithinBudget(usedCompressorType, inData, outData);
+  auto toc = std::chrono::steady_clock::now();
+
+  this->observe(context, compressorType, usedCompressor, inData.getSize(),
+                usedCompressor == COPY ? inData.getSize() : outData.getSize(),
+                toc - tic);
+  this->watchCompression(usedCompressor, inData.getSize(), outData.getSize());
+
+  return usedCompressor;
+}
+
+// The fast LZ codecs find no repeated bytes in doubles, which FPC predicts
+// as fast. It only takes whole 8 byte words
+template<class SocketType>
+typename AutoCompCompressor<SocketType>::CompressorType
+AutoCompCompressor<SocketType>::adaptToData(
+    const CompressorType & compressorType, const Buffer & inData
+  ) const
+{
+  int currentFPCLevel = this->sessionState.currentFPCLevel;
+
+  if (currentFPCLevel > 0 and inData.getSize() % 8 == 0 and
+      (compressorType.first == SNAPPY or compressorType.first == LZO)) {
+    return std::make_pair(FPC, currentFPCLevel);
+  }
+
+  return compressorType;
+}
+
+// The entropy of every chunk is followed, even while it is sent
+// uncompressed. Its sampled byte features cost far less than the probe
+template<class SocketType>
+void AutoCompCompressor<SocketType>::evaluateData(const Buffer & inData) const
+{
+  SessionState & state = this->sessionState;
+  ByteFeatures byteFeatures = this->getByteFeatures(inData);
+
+  if (state.entropyDetector.update(byteFeatures.entropy)) {
+    state.dataChanged = true;
+  }
+
+  bool isDue =
+    state.bytesSinceEvaluation < 0 or
+    state.bytesSinceEvaluation >= constants::REEVALUATION_MAX_BYTES or
+    (state.dataChanged and
+     state.bytesSinceEvaluation >= constants::REEVALUATION_MIN_BYTES);
+
+  if (not isDue) {
+    state.bytesSinceEvaluation += inData.getSize();
+
+    return;
+  }
+
+  state.bytesSinceEvaluation = inData.getSize();
+  state.dataChanged = false;
+
+  // The chunk starts the references the next change is measured from
+  state.entropyDetector.reset();
+  state.entropyDetector.update(byteFeatures.entropy);
+  state.compressionDetector.reset();
+
+  state.currentCompressibility = this->compressibilityProbe.probe(inData);
+  state.currentBytecounting = byteFeatures.bytecount;
+
+  // Many distinct bytes may still be redundant, like base64, so it takes
+  // the probe to agree
+  state.sendingUncompressed =
+    state.currentBytecounting > 100 and
+    state.currentCompressibility.compressionRatio < constants::PROBE_MIN_RATIO;
+
+  if (state.sendingUncompressed) {
+    return;
+  }
+
+  FloatingPointFeatures floatingPointFeatures =
+    getFloatingPointFeatures(inData.getData(), inData.getSize());
+
+  state.currentFPCLevel = isFloatingPointData(floatingPointFeatures)
+                            ? getFPCLevel(floatingPointFeatures)
+                            : 0;
+}
+
+// Each compressor leaves its own share of the same data, so the reference
+// starts over when the compressor does
+template<class SocketType>
+void AutoCompCompressor<SocketType>::watchCompression(
+    const Compressor & usedCompressor, const std::size_t & inSize,
+    const std::size_t & outSize
+  ) const
+{
+  SessionState & state = this->sessionState;
+
+  if (usedCompressor == COPY or inSize == 0) {
+    return;
+  }
+
+  if (usedCompressor != state.lastUsedCompressor) {
+    state.compressionDetector.reset();
+    state.lastUsedCompressor = usedCompressor;
+  }
+
+  double compressedShare = outSize / static_cast<double>(inSize);
+
+  if (state.compressionDetector.update(compressedShare)) {
+    state.dataChanged = true;
+  }
+}
+
+template<class SocketType>
+void AutoCompCompressor<SocketType>::reset()
+{
+  this->sessionState = SessionState();
+  this->compressibilityProbe.reset();
+}
+
+template<class SocketType>
+Compressor AutoCompCompressor<SocketType>::compressWithinBudget(
+    const CompressorType & compressorType, const Buffer & inData,
+    Buffer & outData
+  ) const
+{
+  CompressorType usedCompressorType = compressorType;
+  CompressorPointer compressor;
+
   try {
-    auto compressor = this->compressors.at(compressorType);
-    compressor->compress(inData, outData);
+    compressor = this->compressors.at(compressorType);
   }
   catch (const std::out_of_range & error) {
     return COPY;
   }
 
-  return compressorType.first;
+  MemoryGovernor::Reservation workingMemory;
+
+  if (this->memoryGovernor) {
+    std::size_t chosenWorkingMemory = compressor->getCompressionMemory();
+    workingMemory = this->memoryGovernor->tryAcquire(chosenWorkingMemory);
+
+    for (const CompressorType & lowMemoryCompressorType :
+           this->lowMemoryCompressors) {
+      if (workingMemory) {
+        break;
+      }
+
+      auto lowMemoryCompressor =
+        this->compressors.at(lowMemoryCompressorType);
+      std::size_t lowWorkingMemory =
+        lowMemoryCompressor->getCompressionMemory();
+
+      if (lowWorkingMemory >= chosenWorkingMemory) {
+        continue;
+      }
+
+      workingMemory = this->memoryGovernor->tryAcquire(lowWorkingMemory);
+      compressor = lowMemoryCompressor;
+      usedCompressorType = lowMemoryCompressorType;
+    }
+
+    if (not workingMemory) {
+      return COPY;
+    }
+  }
+
+  compressor->compress(inData, outData);
+
+  return usedCompressorType.first;
+}
+
+template<class SocketType>
+inline
+float AutoCompCompressor<SocketType>::getCPULoad() const
+{
+  float cpuLoad = this->resourceState->cpuLoad;
+
+  return this->cpuBudget ? this->cpuBudget->getLoad(this->cpuCommitment,
+                                                    cpuLoad)
+                         : cpuLoad;
 }
 
 template<class SocketType>
@@ -294,6 +638,16 @@ AutoCompCompressor<SocketType>::getBytecoutingLevel(const float & bytecounting)
   return bytecounting / 10;
 }
 
+// Tenths of the ratio the probe got, up to 10
+template<class SocketType>
+inline int
+AutoCompCompressor<SocketType>::getCompressibilityLevel(
+    const float & compressionRatio
+  ) const
+{
+  return std::min(compressionRatio, 10.0f) * 10;
+}
+
 template<class SocketType>
 inline
 float AutoCompCompressor<SocketType>::getClientSocketSendBufferLoad() const
@@ -304,24 +658,10 @@ float AutoCompCompressor<SocketType>::getClientSocketSendBufferLoad() const
 
 template<class SocketType>
 inline
-int AutoCompCompressor<SocketType>::getBytecounting(const Buffer & inData) const
+float AutoCompCompressor<SocketType>::getBandwidth() const
 {
-  static const float subChunkProportion = 0.1;
-  static const std::vector<float> relativeSubChunkPositions({0.10, 0.45, 0.80});
-
-  int subChunkSize = subChunkProportion * inData.getSize();
-  int offset;
-
-  float averageBytecounting = 0;
-
-  for (const float & relativePosition : relativeSubChunkPositions) {
-    offset = relativePosition * inData.getSize();
-    averageBytecounting += bytecounting(inData.getData() + offset,
-                                        subChunkSize);
-  }
-
-  return std::round(averageBytecounting /
-                      (float) relativeSubChunkPositions.size());
+  return this->bandwidthEstimator ? this->bandwidthEstimator->getBandwidth()
+                                  : this->resourceState->bandwidth.load();
 }
 
 } // namespace autocomp
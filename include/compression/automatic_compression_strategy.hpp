@@ -16,8 +16,13 @@
 
 #include "utils/buffer.hpp"
 #include "utils/data_structures.hpp"
+#include "utils/bounded_queue.hpp"
+#include "utils/memory_governor.hpp"
+#include "utils/cpu_budget.hpp"
+#include "utils/byte_histogram.hpp"
 #include "io/performance_data_writer.hpp"
 #include "messaging/compressor.pb.h"
+#include "compression/compressibility_probe.hpp"
 
 
 namespace autocomp {
@@ -34,15 +39,112 @@ protected:
    */
   mutable std::shared_ptr<io::PerformanceDataWriter> performanceDataWriter;
 
+  /**
+   * Queue the compressed chunks wait in before being sent, if known
+   */
+  const QueueOccupancy * transmissionQueue;
+
+  /**
+   * Governor the working memory of the codecs is charged to, if any
+   */
+  MemoryGovernor * memoryGovernor;
+
+  /**
+   * Demand of the codecs on the CPU budget of the server, if any
+   */
+  mutable CPUBudget::Commitment cpuCommitment;
+  const CPUBudget * cpuBudget;
+
+  /**
+   * Compressibility of the data of the session, probed once per window
+   */
+  mutable CompressibilityProbe compressibilityProbe;
+
 public:
 
   AutomaticCompressionStrategy(
       const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter =
         nullptr
     )
-    : performanceDataWriter(performanceDataWriter)
+    : performanceDataWriter(performanceDataWriter),
+      transmissionQueue(nullptr),
+      memoryGovernor(nullptr),
+      cpuBudget(nullptr)
   {}
 
+  /**
+   * Sets the queue the compressed chunks wait in before being sent. Its
+   * occupancy tells how far the network is lagging behind the compressor
+   *
+   * @param transmissionQueue The transmission queue, or nullptr
+   */
+  void setTransmissionQueue(const QueueOccupancy * transmissionQueue)
+  {
+    this->transmissionQueue = transmissionQueue;
+  }
+
+  /**
+   * Sets the governor the working memory of the codecs is charged to while
+   * they compress
+   *
+   * @param memoryGovernor The memory governor, or nullptr
+   */
+  void setMemoryGovernor(MemoryGovernor * memoryGovernor)
+  {
+    this->memoryGovernor = memoryGovernor;
+  }
+
+  /**
+   * Sets the budget the CPU time of the codecs is committed to, which the
+   * other sessions take into account when choosing their codecs
+   *
+   * @param cpuBudget The CPU budget, or nullptr
+   */
+  void setCPUBudget(CPUBudget * cpuBudget)
+  {
+    this->cpuCommitment = cpuBudget ? cpuBudget->commit()
+                                    : CPUBudget::Commitment();
+    this->cpuBudget = cpuBudget;
+  }
+
+  /**
+   * Gets the load of the transmission queue. A full queue means that the
+   * network is the bottleneck, so slower and stronger compression is
+   * affordable.
+   *
+   * @returns The load of the transmission queue in [0, 1], or 0 if unknown
+   */
+  float getTransmissionQueueLoad() const
+  {
+    return this->transmissionQueue ? this->transmissionQueue->getLoad() : 0;
+  }
+
+  /**
+   * Gets how well the data of the session compresses, as a sample of the
+   * chunk, or of one before it within the probe window, compressed
+   *
+   * @param inData Chunk about to be compressed
+   */
+  Compressibility getCompressibility(const Buffer & inData) const
+  {
+    return this->compressibilityProbe.get(inData);
+  }
+
+  /**
+   * Gets the features of the byte distribution of a chunk, from the three
+   * subchunks the compressors sample
+   */
+  ByteFeatures getByteFeatures(const Buffer & inData) const
+  {
+    return ByteHistogram::getSampledFeatures(inData.getData(),
+                                             inData.getSize());
+  }
+
+  int getBytecounting(const Buffer & inData) const
+  {
+    return this->getByteFeatures(inData).bytecount;
+  }
+
   /**
    * Compression method
    *
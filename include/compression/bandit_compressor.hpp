@@ -0,0 +1,175 @@
+/**
+ *  AutoComp Online Learning Compression Strategy
+ *  bandit_compressor.hpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_BANDIT_COMPRESSOR_HPP
+#define AC_BANDIT_COMPRESSOR_HPP
+
+#include <memory>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include "utils/constants.hpp"
+#include "utils/functions.hpp"
+#include "utils/contextual_bandit.hpp"
+#include "compression/autocomp_compressor.hpp"
+
+namespace autocomp {
+
+/**
+ * Bandit Compressor class.
+ *
+ * AutoComp, choosing its compressors with a contextual bandit shared by the
+ * sessions of the server instead of a model trained offline, and teaching it
+ * the effective transmission rate of every chunk. At most
+ * constants::BANDIT_MAX_EXPLORATION of the chunks of a session are
+ * compressed with a compressor other than the best known one.
+ *
+ * FPC is one of the arms of the bandit, so the compressor chosen is the one
+ * used, and the bandit learns where FPC pays instead of having it replace
+ * the fast LZ codecs on doubles.
+ */
+template<class SocketType>
+class BanditCompressor : public AutoCompCompressor<SocketType>
+{
+  using typename AutoCompCompressor<SocketType>::CompressorType;
+  using typename AutoCompCompressor<SocketType>::Context;
+
+  ContextualBandit * contextualBandit;
+
+  mutable std::mt19937 generator;
+
+  mutable std::size_t nChoices;
+  mutable std::size_t nExplorations;
+
+public:
+
+  /**
+   * BanditCompressor constructor
+   *
+   * @param contextualBandit Bandit the compressors are chosen with
+   * @param model Model the bandit may be warm started with
+   *
+   * @ŧhrows std::bad_alloc On a memory allocation failure.
+   */
+  BanditCompressor(ContextualBandit * contextualBandit,
+                   const ClassificationModel * model,
+                   const ResourceState * resourceState,
+                   const std::shared_ptr<SocketType> & clientSocket,
+                   const std::shared_ptr<io::PerformanceDataWriter> &
+                      performanceDataWriter = nullptr,
+                   const std::shared_ptr<const BandwidthEstimator> &
+                      bandwidthEstimator = nullptr);
+
+protected:
+
+  CompressorType chooseCompressor(const Context & context) const override;
+
+  CompressorType adaptToData(const CompressorType & compressorType,
+                             const Buffer & inData) const override;
+
+  void observe(const Context & context, const CompressorType & compressorType,
+               const Compressor & usedCompressor, const std::size_t & inSize,
+               const std::size_t & outSize,
+               const std::chrono::nanoseconds & compressionTime)
+    const override;
+
+}; // class BanditCompressor
+
+// <--- BanditCompressor's methods definition ---> //
+
+template<class SocketType>
+BanditCompressor<SocketType>::BanditCompressor(
+    ContextualBandit * contextualBandit, const ClassificationModel * model,
+    const ResourceState * resourceState,
+    const std::shared_ptr<SocketType> & clientSocket,
+    const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter,
+    const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator
+  )
+  : AutoCompCompressor<SocketType>(model, resourceState, clientSocket,
+                                   performanceDataWriter, bandwidthEstimator),
+    contextualBandit(contextualBandit),
+    generator(std::random_device()()),
+    nChoices(0),
+    nExplorations(0)
+{
+  if (not contextualBandit) {
+    throw std::domain_error("contextualBandit must not be null");
+  }
+}
+
+template<class SocketType>
+typename BanditCompressor<SocketType>::CompressorType
+BanditCompressor<SocketType>::chooseCompressor(const Context & context) const
+{
+  bool explore = this->nExplorations <
+                 constants::BANDIT_MAX_EXPLORATION * (this->nChoices + 1);
+
+  ContextualBandit::Choice choice =
+    this->contextualBandit->choose(context, this->generator, explore);
+
+  this->nChoices++;
+  this->nExplorations += choice.exploratory;
+
+  return choice.arm;
+}
+
+// FPC drops the bytes after the last whole 8 byte word, so those chunks are
+// sent uncompressed, which teaches the bandit nothing
+template<class SocketType>
+typename BanditCompressor<SocketType>::CompressorType
+BanditCompressor<SocketType>::adaptToData(
+    const CompressorType & compressorType, const Buffer & inData
+  ) const
+{
+  if (compressorType.first == FPC and inData.getSize() % 8 != 0) {
+    return std::make_pair(COPY, -1);
+  }
+
+  return compressorType;
+}
+
+// The reward is the effective transmission rate, as the training compressor
+// computes it, over the bandwidth. Chunks compressed with a lighter
+// compressor than the chosen one, for lack of memory, teach nothing
+template<class SocketType>
+void BanditCompressor<SocketType>::observe(
+    const Context & context, const CompressorType & compressorType,
+    const Compressor & usedCompressor, const std::size_t & inSize,
+    const std::size_t & outSize,
+    const std::chrono::nanoseconds & compressionTime
+  ) const
+{
+  float bandwidth = this->getBandwidth();
+
+  if (usedCompressor != compressorType.first or bandwidth <= 0 or
+      outSize == 0) {
+    return;
+  }
+
+  double reward = 1;
+
+  if (usedCompressor != COPY) {
+    double microseconds =
+      std::chrono::duration<double, std::micro>(compressionTime).count();
+    // Compression rate in Mbits/s (8e-6 Mbits in 1 byte and 1e-6 sec in 1 us)
+    double compressionRate = microseconds > 0 ? 8 * outSize / microseconds
+                                              : bandwidth;
+    double compressionRatio = inSize / static_cast<double>(outSize);
+
+    reward = effectiveTransmissionRate(bandwidth, compressionRate,
+                                       compressionRatio) / bandwidth;
+  }
+
+  this->contextualBandit->record(context, compressorType, reward);
+}
+
+} // namespace autocomp
+
+#endif // AC_BANDIT_COMPRESSOR_HPP
@@ -13,6 +13,7 @@
 #define AC_BZIP2_COMPRESSOR_HPP
 
 #include <string>
+#include <cstddef>
 
 extern "C" {
   #include "bzlib.h"
@@ -49,6 +50,11 @@ public:
    */
   void compress(const Buffer & inData, Buffer & outData) const;
 
+  /**
+   * @copydoc autocomp::CompressionStrategy::getCompressionMemory()
+   */
+  std::size_t getCompressionMemory() const;
+
   /**
    * @copydoc autocomp::CompressionStrategy::decompress()
    */
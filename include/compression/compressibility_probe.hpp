@@ -0,0 +1,89 @@
+/**
+ *  AutoComp Compressibility Probe
+ *  compressibility_probe.hpp
+ *
+ *  Declaration of class CompressibilityProbe, which measures how well the
+ *  data compresses by compressing a few samples of it.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_COMPRESSIBILITY_PROBE_HPP
+#define AC_COMPRESSIBILITY_PROBE_HPP
+
+#include <cstddef>
+
+#include "utils/buffer.hpp"
+#include "utils/constants.hpp"
+#include "compression/zlib_compressor.hpp"
+
+namespace autocomp {
+
+/**
+ * How the samples of the data compressed
+ */
+struct Compressibility
+{
+  float compressionRatio;
+  float compressionRate;            //!< Mbits/s of original data
+};
+
+/**
+ * Compresses three samples of constants::PROBE_SAMPLE_SIZE bytes, at the
+ * positions bytecounting samples, with zlib at level 1. Unlike bytecounting,
+ * which only counts the distinct bytes, it tells data with a large alphabet
+ * but redundant, like base64 or hex dumps, from random data. Zlib rather
+ * than snappy: its Huffman stage also catches the redundancy of small
+ * alphabets, which snappy misses.
+ *
+ * Through get(), the result holds for constants::PROBE_WINDOW bytes before
+ * the data is probed again. AutoComp calls probe() instead, when it detects
+ * that the data changed.
+ *
+ * A probe follows a single session, and must not be used by several threads
+ * at once.
+ */
+class CompressibilityProbe
+{
+  const ZlibCompressor compressor;
+
+  Buffer samples;
+  Buffer compressedSamples;
+
+  Compressibility compressibility;
+  long remainingBytesToProbeAgain;
+
+public:
+
+  CompressibilityProbe();
+
+  CompressibilityProbe(const CompressibilityProbe &) = delete;
+  CompressibilityProbe(CompressibilityProbe &&) = delete;
+  CompressibilityProbe & operator=(const CompressibilityProbe &) = delete;
+  CompressibilityProbe & operator=(CompressibilityProbe &&) = delete;
+
+  /**
+   * Gets the compressibility of the data, probing the chunk if the last
+   * probe is older than the window
+   *
+   * @param inData Chunk about to be compressed
+   */
+  Compressibility get(const Buffer & inData);
+
+  /**
+   * Probes the chunk, whatever the window
+   */
+  Compressibility probe(const Buffer & inData);
+
+  /**
+   * Forgets the last probe
+   */
+  void reset();
+
+}; // class CompressibilityProbe
+
+} // namespace autocomp
+
+#endif // AC_COMPRESSIBILITY_PROBE_HPP
@@ -12,6 +12,7 @@
 #define AC_COMPRESSION_STRATEGY_INTERFACE_HPP
 
 #include <string>
+#include <cstddef>
 
 #include "utils/buffer.hpp"
 
@@ -61,6 +62,17 @@ public:
    */
   virtual void compress(const Buffer & inData, Buffer & outData) const = 0;
 
+  /**
+   * Gets the memory the compressor works with while compressing, besides the
+   * input and output buffers
+   *
+   * @returns The working memory, in bytes
+   */
+  virtual std::size_t getCompressionMemory() const
+  {
+    return 0;
+  }
+
   /**
    * Decompression method
    *
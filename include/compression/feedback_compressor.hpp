@@ -0,0 +1,243 @@
+/**
+ *  AutoComp Feedback Control Compression Strategy
+ *  feedback_compressor.hpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_FEEDBACK_COMPRESSOR_HPP
+#define AC_FEEDBACK_COMPRESSOR_HPP
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "utils/buffer.hpp"
+#include "utils/constants.hpp"
+#include "utils/functions.hpp"
+#include "utils/feedback_controller.hpp"
+#include "utils/floating_point_detector.hpp"
+#include "messaging/compressor.pb.h"
+#include "compression/automatic_compression_strategy.hpp"
+#include "compression/zlib_compressor.hpp"
+#include "compression/snappy_compressor.hpp"
+#include "compression/lzo_compressor.hpp"
+#include "compression/bzip2_compressor.hpp"
+#include "compression/lzma_compressor.hpp"
+#include "compression/fpc_compressor.hpp"
+
+namespace autocomp {
+
+/**
+ * Feedback Compressor class.
+ *
+ * Chooses the compressor from whether the data is piling up before the
+ * network. The occupancy of the transmission queue and the client socket
+ * send buffer feeds a PI controller, which moves along a ladder of
+ * compressors from the fastest to the strongest: up when the data piles up,
+ * since the network is the bottleneck and a better ratio pays, and down when
+ * the network starves waiting for the compressor. The FPC rung only takes
+ * chunks of doubles, and the others go down to the rung below it.
+ *
+ * One compressor serves a single session, and must not be used by several
+ * threads at once.
+ */
+template<class SocketType>
+class FeedbackCompressor : public AutomaticCompressionStrategy
+{
+  // CompressorType => Pair<Compressor, Level>
+  using CompressorType = std::pair<Compressor, int>;
+
+  using CompressorPointer = std::shared_ptr<CompressionStrategy>;
+
+  /**
+   * Compressors from the fastest to the strongest
+   */
+  std::vector<std::pair<CompressorType, CompressorPointer>> ladder;
+
+  mutable FeedbackController controller;
+
+  const std::shared_ptr<SocketType> clientSocket;
+
+  const float clientSocketSendBufferCapacity;
+
+public:
+
+  /**
+   * FeedbackCompressor constructor
+   *
+   * @param clientSocket Socket the compressed chunks are sent through
+   * @param setpoint Occupancy to keep, in [0, 1]
+   *
+   * @ŧhrows std::bad_alloc On a memory allocation failure.
+   */
+  FeedbackCompressor(const std::shared_ptr<SocketType> & clientSocket,
+                     const float & setpoint =
+                       constants::FEEDBACK_SETPOINT / 100.0,
+                     const std::shared_ptr<io::PerformanceDataWriter> &
+                        performanceDataWriter = nullptr);
+
+  /**
+   * @copydoc autocomp::CompressionStrategy::compress()
+   */
+  Compressor compress(const Buffer & inData, Buffer & outData) const;
+
+  /**
+   * Gets the occupancy of the transmission queue and the send buffer, the
+   * average of their loads
+   */
+  float getOccupancy() const;
+
+  /**
+   * Gets the compressor the controller is on
+   */
+  CompressorType getCompressorType() const;
+
+private:
+
+  /**
+   * Compresses with the compressor of the given rung or, if the memory
+   * governor can not fit its working memory, with the first faster one that
+   * fits
+   */
+  Compressor compressWithinBudget(std::size_t rung, const Buffer & inData,
+                                  Buffer & outData) const;
+
+  /**
+   * Whether the chunk is doubles FPC can compress: whole 8 byte words, since
+   * FPC drops the bytes after the last one
+   */
+  bool isFPCData(const Buffer & inData) const;
+
+}; // class FeedbackCompressor
+
+// <--- FeedbackCompressor's methods definition ---> //
+
+template<class SocketType>
+FeedbackCompressor<SocketType>::FeedbackCompressor(
+    const std::shared_ptr<SocketType> & clientSocket, const float & setpoint,
+    const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter
+  )
+  : AutomaticCompressionStrategy(performanceDataWriter),
+    ladder{
+      {{COPY, -1}, nullptr},
+      {{SNAPPY, -1}, std::make_shared<SnappyCompressor>()},
+      {{LZO, 1}, std::make_shared<LZOCompressor>(1)},
+      {{FPC, constants::FPC_FAST_LEVEL},
+       std::make_shared<FPCCompressor>(constants::FPC_FAST_LEVEL)},
+      {{ZLIB, 1}, std::make_shared<ZlibCompressor>(1)},
+      {{ZLIB, 3}, std::make_shared<ZlibCompressor>(3)},
+      {{ZLIB, 6}, std::make_shared<ZlibCompressor>(6)},
+      {{LZMA, 1}, std::make_shared<LZMACompressor>(1)},
+      {{BZIP2, 9}, std::make_shared<Bzip2Compressor>(9)},
+      {{LZMA, 6}, std::make_shared<LZMACompressor>(6)}
+    },
+    // Starts at zlib 1, which suits most links
+    controller(ladder.size(), setpoint, 4),
+    clientSocket(clientSocket),
+    clientSocketSendBufferCapacity(clientSocket
+                                     ? clientSocket->getSendBufferCapacity()
+                                     : 0)
+{
+  if (not clientSocket) {
+    throw std::domain_error("clientSocket must not be null");
+  }
+
+  if (setpoint < 0 or setpoint > 1) {
+    throw std::domain_error("setpoint must be in [0, 1]");
+  }
+}
+
+template<class SocketType>
+Compressor
+FeedbackCompressor<SocketType>::compress(const Buffer & inData,
+                                         Buffer & outData) const
+{
+  std::chrono::nanoseconds cpuTime = getThreadCPUTime();
+
+  std::size_t rung = this->controller.update(this->getOccupancy());
+
+  if (this->performanceDataWriter) {
+    this->performanceDataWriter->write(
+        Compressor_Name(this->ladder[rung].first.first)
+      );
+  }
+
+  Compressor compressor = this->compressWithinBudget(rung, inData, outData);
+
+  this->cpuCommitment.record(getThreadCPUTime() - cpuTime);
+
+  return compressor;
+}
+
+template<class SocketType>
+float FeedbackCompressor<SocketType>::getOccupancy() const
+{
+  float sendBufferLoad =
+    this->clientSocketSendBufferCapacity > 0
+      ? std::min(this->clientSocket->getSendBufferSize() /
+                   this->clientSocketSendBufferCapacity,
+                 1.0f)
+      : 0;
+
+  return this->transmissionQueue
+           ? (this->getTransmissionQueueLoad() + sendBufferLoad) / 2
+           : sendBufferLoad;
+}
+
+template<class SocketType>
+typename FeedbackCompressor<SocketType>::CompressorType
+FeedbackCompressor<SocketType>::getCompressorType() const
+{
+  return this->ladder[this->controller.getLevel()].first;
+}
+
+template<class SocketType>
+Compressor FeedbackCompressor<SocketType>::compressWithinBudget(
+    std::size_t rung, const Buffer & inData, Buffer & outData
+  ) const
+{
+  MemoryGovernor::Reservation workingMemory;
+
+  for (; rung > 0; rung--) {
+    const CompressorPointer & compressor = this->ladder[rung].second;
+
+    if (this->ladder[rung].first.first == FPC and
+        not this->isFPCData(inData)) {
+      continue;
+    }
+
+    if (this->memoryGovernor) {
+      workingMemory = this->memoryGovernor->tryAcquire(
+                        compressor->getCompressionMemory()
+                      );
+
+      if (not workingMemory) {
+        continue;
+      }
+    }
+
+    compressor->compress(inData, outData);
+
+    return this->ladder[rung].first.first;
+  }
+
+  return COPY;
+}
+
+template<class SocketType>
+bool FeedbackCompressor<SocketType>::isFPCData(const Buffer & inData) const
+{
+  return inData.getSize() % 8 == 0 and
+         isFloatingPointData(getFloatingPointFeatures(inData.getData(),
+                                                      inData.getSize()));
+}
+
+} // namespace autocomp
+
+#endif // AC_FEEDBACK_COMPRESSOR_HPP
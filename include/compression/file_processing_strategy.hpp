@@ -147,6 +147,13 @@ public:
    */
   size_t getCurrentFileSize() const;
 
+  /**
+   * Gets the amount of bytes of the current file processed so far.
+   *
+   * @returns The amount of bytes of the current file processed so far.
+   */
+  size_t getCurrentFileReadBytes() const;
+
 protected:
 
   /**
@@ -16,6 +16,7 @@
 
 #include "utils/buffer.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/file_format.hpp"
 #include "messaging/compressor.pb.h"
 #include "io/directory_explorer.hpp"
 #include "compression/automatic_compression_strategy.hpp"
@@ -36,6 +37,17 @@ class FileProcessor : public FileProcessingStrategy
    */
   std::shared_ptr<AutomaticCompressionStrategy> compressor;
 
+  /**
+   * Buffer where the raw chunks are read. It is swapped with the output chunk
+   * when no compression is done, so it has the same capacity as the chunks.
+   */
+  Buffer inData;
+
+  /**
+   * Format of the current file, as told by its first bytes
+   */
+  FileFormat currentFileFormat;
+
 public:
 
   /**
@@ -51,7 +63,8 @@ public:
                 const std::shared_ptr<AutomaticCompressionStrategy> compressor);
 
   /**
-   * Opens and prepares the next file.
+   * Opens and prepares the next file, and tells its format from its
+   * signature.
    *
    * @throws exceptions::IOError If an I/O error occurs
    */
@@ -62,7 +75,8 @@ public:
    * for processing it. In case of no compression at all, COPY is returned. If
    * the processore chooses to compress and a compression error occurs, of if
    * any other kind of error occurs (like I/O), no compression is done, the
-   * whole original chunk is copied to the buffer and COPY is returned.
+   * whole original chunk is copied to the buffer and COPY is returned. The
+   * chunks of files of an already compressed format are always copied.
    *
    * @param chunk The buffer where the processed chunk is going to be stored.
    *
@@ -94,6 +108,13 @@ public:
    */
   size_t getCurrentFileSize() const;
 
+  /**
+   * Gets the format of the current file being processed.
+   *
+   * @returns FileFormat::UNKNOWN if it was not recognized
+   */
+  FileFormat getCurrentFileFormat() const;
+
   /**
    * Sets Compressor to use for file processing
    *
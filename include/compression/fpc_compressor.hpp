@@ -13,6 +13,7 @@
 #define AC_FPC_COMPRESSOR_HPP
 
 #include <string>
+#include <cstddef>
 #include <cassert>
 #include <cstring>
 
@@ -57,6 +58,11 @@ public:
    */
   void compress(const Buffer & inData, Buffer & outData) const;
 
+  /**
+   * @copydoc autocomp::CompressionStrategy::getCompressionMemory()
+   */
+  std::size_t getCompressionMemory() const;
+
   /**
    * @copydoc autocomp::CompressionStrategy::decompress()
    */
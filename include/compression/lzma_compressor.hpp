@@ -13,6 +13,7 @@
 #define AC_LZMA_COMPRESSOR_HPP
 
 #include <string>
+#include <cstddef>
 
 extern "C" {
   #include "lzma.h"
@@ -59,6 +60,11 @@ public:
    */
   void compress(const Buffer & inData, Buffer & outData) const;
 
+  /**
+   * @copydoc autocomp::CompressionStrategy::getCompressionMemory()
+   */
+  std::size_t getCompressionMemory() const;
+
   /**
    * @copydoc autocomp::CompressionStrategy::decompress()
    */
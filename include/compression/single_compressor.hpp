@@ -19,6 +19,7 @@
 
 #include "utils/buffer.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/functions.hpp"
 #include "messaging/compressor.pb.h"
 #include "compression/automatic_compression_strategy.hpp"
 #include "compression/zlib_compressor.hpp"
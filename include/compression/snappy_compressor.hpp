@@ -13,6 +13,7 @@
 #define AC_SNAPPY_COMPRESSOR_HPP
 
 #include <string>
+#include <cstddef>
 #include "snappy.h"
 
 #include "utils/buffer.hpp"
@@ -41,6 +42,11 @@ public:
    */
   void compress(const Buffer & inData, Buffer & outData) const;
 
+  /**
+   * @copydoc autocomp::CompressionStrategy::getCompressionMemory()
+   */
+  std::size_t getCompressionMemory() const;
+
   /**
    * @copydoc autocomp::CompressionStrategy::decompress()
    */
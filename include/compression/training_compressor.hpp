@@ -25,10 +25,13 @@
 
 #include "utils/buffer.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/constants.hpp"
 #include "utils/data_structures.hpp"
 #include "utils/functions.hpp"
-#include "utils/synchronous_queue.hpp"
+#include "utils/bounded_queue.hpp"
+#include "utils/bandwidth_estimator.hpp"
 #include "network/socket/tcp_socket.hpp"
+#include "network/socket/frame.hpp"
 #include "messaging/compressor.pb.h"
 #include "compression/single_compressor.hpp"
 #include "compression/zlib_compressor.hpp"
@@ -43,7 +46,8 @@ namespace autocomp {
 /** 
  * Traning Compressor class.
  *
- * This compressor is intended for retrieving traning data for a classifier
+ * This compressor is intended for retrieving traning data for a classifier.
+ * FPC is only measured on chunks of whole 8 byte words
  */
 class TrainingCompressor : public SingleCompressor
 {
@@ -52,7 +56,11 @@ class TrainingCompressor : public SingleCompressor
    */
   const ResourceState * resourceState;
 
-  const SynchronousQueue<Buffer> * transmissionQueue;
+  /**
+   * Bandwidth of the session's connection. Without it, the server wide
+   * bandwidth of the resource state is used
+   */
+  const std::shared_ptr<const BandwidthEstimator> bandwidthEstimator;
 
   const std::shared_ptr<net::TCPSocket> clientSocket;
 
@@ -68,10 +76,12 @@ public:
    * @ŧhrows std::bad_alloc On a memory allocation failure.
    */
   TrainingCompressor(const ResourceState * resourceState,
-                     const SynchronousQueue<Buffer> * transmissionQueue,
+                     const QueueOccupancy * transmissionQueue,
                      const std::shared_ptr<net::TCPSocket> & clientSocket,
                      std::shared_ptr<io::PerformanceDataWriter> &
-                        performanceDataWriter);
+                        performanceDataWriter,
+                     const std::shared_ptr<const BandwidthEstimator> &
+                        bandwidthEstimator = nullptr);
 
   ~TrainingCompressor();
 
@@ -84,12 +94,12 @@ private:
 
   float getClientSocketSendBufferLoad() const;
 
+  float getBandwidth() const;
+
   float getEfectiveTransmissionRate(const float & availableBandwidth,
                                     const float & compressionRate,
                                     const float & compressionRatio) const;
 
-  int getBytecounting(const Buffer & inData) const;
-
   ::pid_t launchCPUModulator();
 
 }; // class TrainingCompressor
@@ -32,6 +32,14 @@ namespace autocomp
 
   public:
 
+    /**
+    * PerformanceDataWriter constructor
+    *
+    * @param fileNameSuffix Appended to the name of the file, see
+    *                       SynchronizedFile
+    */
+    explicit PerformanceDataWriter(const std::string & fileNameSuffix = "");
+
     /**
     * Writes performance data in csv format to the synchronized file
     *
@@ -56,9 +56,13 @@ namespace autocomp
     /**
      * SynchronizedFile constructor 
      *
+     * @param fileNameSuffix Appended to the file name, before the extension,
+     *                       to tell apart the files of processes started at
+     *                       the same time
+     *
      * @throws exceptions::IOError When an error occurs when opening the file
      */
-    SynchronizedFile();
+    explicit SynchronizedFile(const std::string & fileNameSuffix = "");
 
     ~SynchronizedFile();
   
@@ -14,13 +14,13 @@
 #include <string>
 #include <cstring>
 #include <memory>
-#include <mutex>
-#include <condition_variable>
 #include <vector>
 #include <fstream>
 #include <map>
+#include <cstdint>
 #include <libgen.h> // basename
 #include <cstdio> // remove
+#include <zlib.h> // crc32
 
 #include <g3log/g3log.hpp>
 #include <g3log/logworker.hpp>
@@ -30,7 +30,8 @@
 #include "utils/exceptions.hpp"
 #include "utils/constants.hpp"
 #include "utils/buffer.hpp"
-#include "utils/synchronous_queue.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/blocking_ring_buffer.hpp"
 #include "utils/thread_pool.hpp"
 #include "utils/protobuf_utils.hpp"
 #include "messaging/compressor.pb.h"
@@ -40,6 +41,7 @@
 #include "messaging/file_initial_message.pb.h"
 #include "messaging/file_transmission_request.pb.h"
 #include "network/socket/tcp_socket.hpp"
+#include "network/socket/chunk_frame_header.hpp"
 #include "compression/zlib_compressor.hpp"
 #include "compression/snappy_compressor.hpp"
 #include "compression/lzo_compressor.hpp"
@@ -62,14 +64,18 @@ namespace autocomp
     struct DecompressionQueueEntry
     {
       messaging::FileInitialMessage fileInitialMessage;
-      messaging::ChunkHeader chunkHeader;
+      ChunkFrameHeader chunkHeader; //!< Version 1 headers are converted
       Buffer chunk;
     };
 
     std::thread decompressionThread;
-    SynchronousQueue<DecompressionQueueEntry> decompressionQueue;
-    std::mutex mutex;
-    std::condition_variable condition;
+    SpscQueue<DecompressionQueueEntry> decompressionQueue;
+
+    /**
+     * Buffers the chunks are received into. Set before the first chunk of a
+     * request is queued for decompression
+     */
+    std::shared_ptr<BufferPool> chunkPool;
     bool doneReceiving;
     TCPSocket socket;
     const std::string serverHostname;
@@ -80,6 +86,12 @@ namespace autocomp
     bool preCompression;
     Compressor preCompressingCompressor;
 
+    unsigned int protocolVersion;
+    bool chunkChecksums;
+    unsigned int weight;
+    std::uint64_t maxRate;
+    unsigned int occupancySetpoint;
+
     // Compressors
     std::map<Compressor, std::unique_ptr<CompressionStrategy>> compressors;
 
@@ -103,6 +115,47 @@ namespace autocomp
 
     void init();
 
+    /**
+     * Sets the highest protocol version to request. The server answers with
+     * the highest version both of them speak.
+     *
+     * @param protocolVersion The protocol version
+     */
+    void setProtocolVersion(const unsigned int & protocolVersion);
+
+    /**
+     * Makes the server send a CRC-32 checksum with every chunk, which is
+     * verified before decompressing it (protocol version >= 2).
+     *
+     * @param chunkChecksums Whether to request chunk checksums
+     */
+    void setChunkChecksums(const bool & chunkChecksums);
+
+    /**
+     * Sets the share of the server's compression threads the requests get,
+     * relative to the other sessions.
+     *
+     * @param weight From 1, the default, to constants::MAX_SESSION_WEIGHT
+     */
+    void setWeight(const unsigned int & weight);
+
+    /**
+     * Caps the rate at which the server sends the requested files.
+     *
+     * @param maxRate Bytes per second. 0, the default, means unlimited
+     */
+    void setMaxRate(const std::uint64_t & maxRate);
+
+    /**
+     * Sets the occupancy of the transmission queue and send buffer the
+     * server keeps in FEEDBACK mode. Higher setpoints favour the compression
+     * ratio, lower ones the latency.
+     *
+     * @param occupancySetpoint In percent, up to 100. 0, the default, leaves
+     *                          it to the server
+     */
+    void setOccupancySetpoint(const unsigned int & occupancySetpoint);
+
     void requestFile(const std::string & path, const FileRequestMode & mode,
                      const Compressor * compressor,
                      const int * compressionLevel,
@@ -114,6 +167,19 @@ namespace autocomp
 
     void decompress(); // This should be decompress
 
+    /**
+     * Receives the next chunk frame (protocol version >= 2). An error message
+     * sent instead of the frame is thrown as a NetworkError.
+     *
+     * @param chunkHeader Where the header is stored
+     * @param chunk Where the payload is stored. Its capacity is set to the
+     *              exact size of the payload if it is not big enough
+     *
+     * @throws exceptions::NetworkError If the frame could not be received or
+     *                                  is invalid
+     */
+    void receiveChunkFrame(ChunkFrameHeader & chunkHeader, Buffer & chunk);
+
     messaging::FileTransmissionRequest
     configureFileRequestMessage(const std::string & path, 
                                 const FileRequestMode & mode,
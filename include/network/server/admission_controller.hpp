@@ -0,0 +1,193 @@
+/**
+ *  AutoComp Admission Controller
+ *  admission_controller.hpp
+ *
+ *  Declaration of class AdmissionController, which limits the number of
+ *  sessions the server runs and keeps waiting at the same time.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_ADMISSION_CONTROLLER_HPP
+#define AC_ADMISSION_CONTROLLER_HPP
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <chrono>
+#include <cstddef>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * Saturation metrics of the server
+   */
+  struct AdmissionStats
+  {
+    std::size_t maxSessions;          //!< Sessions that can run at once
+    std::size_t activeSessions;       //!< Sessions running
+    std::size_t peakActiveSessions;   //!< Most sessions ever running at once
+    std::size_t queuedSessions;       //!< Requests waiting for a slot
+    std::size_t admittedSessions;     //!< Sessions run so far
+    std::size_t rejectedSessions;     //!< Refused because the queue was full
+                                      //!< or the server was stopping
+    std::size_t timedOutSessions;     //!< Refused after waiting too long
+    double meanQueueWaitTime;         //!< Of the admitted sessions, in ms
+    double maxQueueWaitTime;          //!< Of the admitted sessions, in ms
+  };
+
+  /**
+   * Admission control of the server sessions.
+   *
+   * At most maxSessions sessions run at once. Requests received while every
+   * slot is taken wait, in order, in a queue of maxQueuedSessions entries
+   * until a session ends; those that find the queue full, or wait longer
+   * than maxQueueWaitTime, are refused with a busy error instead of piling
+   * up. Waiting requests hold no thread: the controller calls them back
+   * when they are admitted or refused, and a thread of its own refuses them
+   * as soon as their wait is over.
+   */
+  class AdmissionController
+  {
+  public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * An admitted session. The controller is told that the session ended
+     * when its Session object is destroyed
+     */
+    class Session
+    {
+      AdmissionController * admissionController;
+
+    public:
+
+      explicit Session(AdmissionController * admissionController = nullptr);
+
+      Session(const Session &) = delete;
+      Session & operator=(const Session &) = delete;
+
+      Session(Session && other);
+      Session & operator=(Session && other);
+
+      ~Session();
+
+      /**
+       * Whether the session was admitted
+       */
+      explicit operator bool() const;
+    };
+
+    /**
+     * Called back with the session of a request, which evaluates to false
+     * if the request was refused
+     */
+    using AdmissionHandler = std::function<void(Session)>;
+
+  private:
+
+    /**
+     * A request waiting for a slot
+     */
+    struct WaitingRequest
+    {
+      Clock::time_point enqueueTime;
+      Clock::time_point deadline;
+      AdmissionHandler handler;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable waitingRequestsChanged;
+
+    std::size_t maxSessions;
+    std::size_t maxQueuedSessions;
+    std::chrono::milliseconds maxQueueWaitTime;
+
+    std::deque<WaitingRequest> waitingRequests;
+
+    AdmissionStats stats;
+    double totalQueueWaitTime;
+
+    bool done;
+    std::thread timeoutThread;
+
+  public:
+
+    /**
+     * AdmissionController constructor
+     *
+     * @param maxSessions Number of sessions that can run at once
+     * @param maxQueuedSessions Number of requests that can wait to be
+     *                          served
+     * @param maxQueueWaitTime Longest time a request can wait
+     */
+    AdmissionController(const std::size_t & maxSessions,
+                        const std::size_t & maxQueuedSessions,
+                        const std::chrono::milliseconds & maxQueueWaitTime);
+
+    AdmissionController(const AdmissionController &) = delete;
+    AdmissionController(AdmissionController &&) = delete;
+    AdmissionController & operator=(const AdmissionController &) = delete;
+    AdmissionController & operator=(AdmissionController &&) = delete;
+
+    ~AdmissionController();
+
+    void setLimits(const std::size_t & maxSessions,
+                   const std::size_t & maxQueuedSessions,
+                   const std::chrono::milliseconds & maxQueueWaitTime);
+
+    /**
+     * Admits a received request, right away if a slot is free and no other
+     * request is waiting, otherwise once a session ends. The handler is
+     * called from this thread, from the thread ending the session, or from
+     * the controller's thread if the request is refused for waiting too long
+     *
+     * @param enqueueTime When the request was received
+     * @param handler Called once with the session of the request
+     */
+    void admit(const Clock::time_point & enqueueTime,
+               AdmissionHandler && handler);
+
+    /**
+     * Refuses the waiting requests and every later one
+     */
+    void shutdown();
+
+    AdmissionStats getStats() const;
+
+  private:
+
+    /**
+     * Frees the slot of a session, and hands it to the first waiting
+     * request that is still in time
+     */
+    void release();
+
+    /**
+     * Takes a slot for a request. The mutex must be held
+     */
+    Session takeSlot(const Clock::time_point & enqueueTime);
+
+    /**
+     * Refuses the waiting requests whose wait is over, as it ends
+     */
+    void expireWaitingRequests();
+
+  }; // class AdmissionController
+
+  std::ostream & operator<<(std::ostream & stream,
+                            const AdmissionStats & stats);
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_ADMISSION_CONTROLLER_HPP
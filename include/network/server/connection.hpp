@@ -0,0 +1,290 @@
+/**
+ *  AutoComp Connection
+ *  connection.hpp
+ *
+ *  Declaration of class Connection, a client connection driven by the
+ *  server's reactor.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_CONNECTION_HPP
+#define AC_CONNECTION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include "utils/buffer_pool.hpp"
+#include "utils/bounded_queue.hpp"
+#include "utils/bandwidth_estimator.hpp"
+#include "utils/memory_governor.hpp"
+#include "utils/data_structures.hpp" // ResourceState
+#include "network/socket/tcp_socket.hpp"
+#include "network/socket/frame.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  class Reactor;
+
+  /**
+   * A client connection whose socket is owned by the reactor.
+   *
+   * The reactor reads the request and hands it to the request handler. From
+   * then on, a producer (a task of the request thread pool) queues frames and
+   * the reactor sends them as the socket becomes writable. The producer never
+   * waits for the client: when the queue is full it suspends itself, and the
+   * reactor resumes it once the queue is half empty.
+   *
+   * The queued frames are charged to the memory governor, if any, until they
+   * are sent. A frame that does not fit in the memory budget is not queued
+   * either, unless the queue is empty, so every session keeps moving however
+   * scarce memory is. Its producer is then resumed once a frame of its own is
+   * sent and gives some memory back.
+   */
+  class Connection : public std::enable_shared_from_this<Connection>
+  {
+  public:
+
+    enum class QueueResult
+    {
+      QUEUED,
+      FULL,     //!< The frame was not queued, see suspend()
+      CLOSED    //!< The connection is closed and takes no more frames
+    };
+
+    using RequestHandler =
+      std::function<void(const std::shared_ptr<Connection> & connection,
+                         std::vector<char> && request)>;
+
+    /**
+     * Called with the reason if the connection failed, with an empty string
+     * otherwise
+     */
+    using CloseHandler = std::function<void(const std::string & error)>;
+
+  private:
+
+    friend class Reactor;
+
+    enum class State
+    {
+      RECEIVING_REQUEST,
+      TRANSMITTING,
+      DRAINING,           //!< Waiting for the zero copy sends to complete
+      DONE,
+      FAILED
+    };
+
+    const std::shared_ptr<TCPSocket> socket;
+    BoundedQueue<Frame> transmissionQueue;
+
+    // Only used by the reactor thread the connection belongs to
+    State state;
+    uint32_t requestSize;
+    std::size_t requestBytesRead;
+    std::vector<char> request;
+    Frame currentFrame;
+    bool hasCurrentFrame;
+    std::size_t currentFrameBytesSent;
+    std::size_t currentFrameSize;     //!< Charged to the memory governor
+
+    /**
+     * Estimated from TCP_INFO as frames are sent. Its share of the server
+     * wide bandwidth in the resource state is the last estimate published
+     */
+    const std::shared_ptr<BandwidthEstimator> bandwidthEstimator;
+    float publishedBandwidth;
+
+    std::shared_ptr<BufferPool> chunkPool;
+    bool frameBatching;
+    ResourceState * resourceState;
+    MemoryGovernor * memoryGovernor;
+
+    RequestHandler requestHandler;
+    std::function<void()> resumeHandler;
+    CloseHandler closeHandler;
+    std::string error;
+
+    std::atomic<bool> producerSuspended;
+    std::atomic<bool> memoryExhausted;  //!< The last frame did not fit
+    std::atomic<bool> flushScheduled;
+
+    Reactor * reactor;
+    std::size_t loopIndex;
+
+  public:
+
+    /**
+     * Connection constructor
+     *
+     * @param socket The client socket. It is made non-blocking
+     * @param queueMaxBytes Maximum number of bytes waiting to be sent
+     * @param queueMaxFrames Maximum number of frames waiting to be sent
+     */
+    Connection(const std::shared_ptr<TCPSocket> & socket,
+               const std::size_t & queueMaxBytes,
+               const std::size_t & queueMaxFrames);
+
+    Connection(const Connection &) = delete;
+    Connection(Connection &&) = delete;
+    Connection & operator=(const Connection &) = delete;
+    Connection & operator=(Connection &&) = delete;
+
+    const std::shared_ptr<TCPSocket> & getSocket() const;
+
+    const BoundedQueue<Frame> & getTransmissionQueue() const;
+
+    /**
+     * Gets the bandwidth estimate of the connection, for the compressors of
+     * its session
+     */
+    std::shared_ptr<const BandwidthEstimator> getBandwidthEstimator() const;
+
+    /**
+     * Sets the function called, from the reactor thread, with the request
+     * once it is received. Must be set before the connection is added to the
+     * reactor
+     */
+    void setRequestHandler(const RequestHandler & requestHandler);
+
+    /**
+     * Sets the function called, from the reactor thread, when the producer
+     * can resume after suspending itself
+     */
+    void setResumeHandler(const std::function<void()> & resumeHandler);
+
+    /**
+     * Sets the function called, from the reactor thread, once the
+     * connection is closed. Must be set before the connection is added to the
+     * reactor
+     */
+    void setCloseHandler(const CloseHandler & closeHandler);
+
+    /**
+     * Sets the pool the frame payloads are handed back to once sent. Must be
+     * set before the first frame with a payload is queued
+     */
+    void setChunkPool(const std::shared_ptr<BufferPool> & chunkPool);
+
+    /**
+     * Whether to cork the socket while frames are queued
+     */
+    void setFrameBatching(const bool & frameBatching);
+
+    /**
+     * Where to add the bandwidth of the connection to the server total
+     */
+    void setResourceState(ResourceState * resourceState);
+
+    /**
+     * Sets the governor the queued frames are charged to. Must be set before
+     * the first frame is queued
+     */
+    void setMemoryGovernor(MemoryGovernor * memoryGovernor);
+
+    /**
+     * Queues a frame to be sent. Producer only
+     *
+     * @param frame The frame. It is left untouched if it is not queued
+     */
+    QueueResult queue(Frame && frame);
+
+    /**
+     * Suspends the producer after queue() returned FULL: the resume handler
+     * is called once the queue is half empty or, if the frame did not fit in
+     * the memory budget, once a frame is sent. Producer only
+     *
+     * @returns false if the queue made room meanwhile, in which case the
+     *          producer must go on instead
+     */
+    bool suspend();
+
+    /**
+     * Drops the frames waiting to be sent. Producer only
+     */
+    void clearQueue();
+
+    /**
+     * Tells that no more frames will be queued. The connection is closed once
+     * the queued ones are sent. Producer only
+     */
+    void finish();
+
+  private:
+
+    /**
+     * Asks the reactor to send the queued frames
+     */
+    void scheduleFlush();
+
+    /**
+     * Reads what the socket has: the request or, once it was received, the
+     * end of the connection
+     */
+    void receive();
+
+    /**
+     * Sends frames until the socket is full or the queue is empty
+     */
+    void flush();
+
+    /**
+     * Hands the buffers of the completed zero copy sends back to their pools
+     */
+    void reap();
+
+    void resumeProducer();
+
+    /**
+     * Whether a suspended producer can go on queueing frames
+     */
+    bool canResumeProducer() const;
+
+    /**
+     * Frees the idle chunks of the chunk pool, which are charged to the
+     * memory governor, and tries to reserve the given bytes again
+     *
+     * @returns false if the reservation was still denied
+     */
+    bool reserveFromChunkPool(const std::size_t & bytes);
+
+    /**
+     * Gives back to the memory governor what the given frames were charged
+     */
+    void releaseMemory(const std::size_t & bytes);
+
+    void fail(const std::string & reason);
+
+    bool isClosed() const;
+
+    /**
+     * Releases everything the connection holds and calls the close handler
+     */
+    void close();
+
+    /**
+     * Samples TCP_INFO if it is time to
+     */
+    void sampleBandwidth();
+
+    /**
+     * Replaces the share of the connection in the server wide bandwidth
+     */
+    void publishBandwidth(const float & bandwidth);
+
+  }; // class Connection
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_CONNECTION_HPP
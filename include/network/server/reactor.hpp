@@ -0,0 +1,145 @@
+/**
+ *  AutoComp Reactor
+ *  reactor.hpp
+ *
+ *  Declaration of class Reactor, which drives the client connections of the
+ *  server with epoll.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_REACTOR_HPP
+#define AC_REACTOR_HPP
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "utils/exceptions.hpp"
+#include "utils/constants.hpp"
+#include "network/server/connection.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * Event loop threads that own the client connections of the server. The
+   * sockets are non-blocking and registered edge triggered, so a thread
+   * serves any number of connections and only works on those that can make
+   * progress: reading the request, or sending the queued frames as the
+   * socket drains.
+   *
+   * Each connection belongs to a single thread for its whole life. Other
+   * threads hand connections over, or ask for their queued frames to be
+   * sent, through a list the thread picks up when its eventfd is signaled.
+   */
+  class Reactor
+  {
+    friend class Connection;
+
+    struct Loop
+    {
+      int epollFileDescriptor;
+      int wakeUpFileDescriptor;
+      std::thread thread;
+
+      std::mutex mutex;
+      std::vector<std::shared_ptr<Connection>> addedConnections;
+      std::vector<std::shared_ptr<Connection>> scheduledConnections;
+
+      // Only used by the loop thread
+      std::unordered_map<Connection *, std::shared_ptr<Connection>>
+        connections;
+      std::vector<Connection *> drainingConnections;
+    };
+
+    unsigned int nThreads;
+    std::vector<std::unique_ptr<Loop>> loops;
+    std::atomic<std::size_t> nextLoop;
+    std::atomic<std::size_t> nConnections;
+    std::atomic<bool> done;
+
+  public:
+
+    explicit Reactor(const unsigned int & nThreads =
+                        constants::REACTOR_THREADS);
+
+    Reactor(const Reactor &) = delete;
+    Reactor(Reactor &&) = delete;
+    Reactor & operator=(const Reactor &) = delete;
+    Reactor & operator=(Reactor &&) = delete;
+
+    ~Reactor();
+
+    /**
+     * Sets the number of threads. Must be called before init()
+     */
+    void setThreadCount(const unsigned int & nThreads);
+
+    std::size_t getThreadCount() const;
+
+    /**
+     * Gets the number of open connections
+     */
+    std::size_t getConnectionCount() const;
+
+    /**
+     * Creates the epoll instances and starts the threads
+     *
+     * @throws exceptions::NetworkError If epoll or eventfd are not available
+     */
+    void init();
+
+    /**
+     * Stops the threads and closes every connection left
+     */
+    void shutdown();
+
+    /**
+     * Hands a connection over to one of the threads, which starts reading its
+     * request
+     */
+    void add(const std::shared_ptr<Connection> & connection);
+
+  private:
+
+    /**
+     * Asks the thread of the connection to send its queued frames
+     */
+    void schedule(const std::shared_ptr<Connection> & connection);
+
+    void wakeUp(Loop & loop);
+
+    /**
+     * Function that each thread runs
+     */
+    void run(Loop & loop);
+
+    void handleWakeUp(Loop & loop);
+
+    void registerConnection(Loop & loop,
+                            const std::shared_ptr<Connection> & connection);
+
+    /**
+     * Tracks a connection after it did some work, removing it once closed
+     */
+    void update(Loop & loop, Connection * connection);
+
+    void remove(Loop & loop, Connection * connection);
+
+  }; // class Reactor
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_REACTOR_HPP
@@ -15,11 +15,14 @@
 #include <memory>
 #include <vector>
 #include <sys/poll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>  // mkfifo
 #include <sys/stat.h>   // mkfifo
 #include <fcntl.h>      // open
 #include <chrono>
 #include <atomic>
+#include <algorithm>
+#include <zlib.h>       // crc32
 
 #include "g3log/g3log.hpp"
 #include "g3log/logworker.hpp"
@@ -28,11 +31,23 @@
 #include "utils/exceptions.hpp"
 #include "utils/constants.hpp"
 #include "utils/buffer.hpp"
+#include "utils/buffer_pool.hpp"
 #include "utils/thread_pool.hpp"
-#include "utils/synchronous_queue.hpp"
+#include "utils/bounded_queue.hpp"
+#include "utils/memory_governor.hpp"
+#include "utils/cpu_budget.hpp"
 #include "utils/protobuf_utils.hpp"
-#include "utils/decision_tree.hpp"
+#include "utils/classification_model.hpp"
+#include "utils/contextual_bandit.hpp"
+#include "utils/codec_calibration.hpp"
 #include "network/socket/tcp_socket.hpp"
+#include "network/socket/frame.hpp"
+#include "network/socket/chunk_frame_header.hpp"
+#include "network/server/admission_controller.hpp"
+#include "network/server/connection.hpp"
+#include "network/server/reactor.hpp"
+#include "network/server/shared_server_state.hpp"
+#include "network/server/session_scheduler.hpp"
 #include "messaging/compressor.pb.h"
 #include "messaging/error_message.pb.h"
 #include "messaging/chunk_header.pb.h"
@@ -44,6 +59,9 @@
 #include "compression/copy_compressor.hpp"
 #include "compression/training_compressor.hpp"
 #include "compression/autocomp_compressor.hpp"
+#include "compression/bandit_compressor.hpp"
+#include "compression/feedback_compressor.hpp"
+#include "compression/analytic_compressor.hpp"
 #include "compression/file_processing_strategy.hpp"
 #include "compression/file_processor.hpp"
 #include "compression/pre_compressing_file_processor.hpp"
@@ -59,11 +77,53 @@ namespace autocomp
    */
   class Server
   {
+    /**
+     * Bounds the memory of the chunks in flight of every session, of the
+     * codecs compressing them, and of the chunks pooled for reuse. It outlives
+     * the connections and pools charging it
+     */
+    MemoryGovernor memoryGovernor;
+
+    /**
+     * Requests are processed, i.e. files are read and compressed, by the
+     * request thread pool, a few chunks at a time. The session scheduler
+     * decides which session runs next, so they share the threads by weight.
+     * The reactor owns the client sockets and sends what the requests
+     * produce, so no thread waits for a client
+     */
     ThreadPool requestThreadPool;
-    ThreadPool transmissionThreadPool;
+    SessionScheduler sessionScheduler;
+    Reactor reactor;
+    AdmissionController admissionController;
+
+    /**
+     * Cores the codecs of every session keep busy, which AutoComp chooses
+     * its codecs with instead of the raw CPU load
+     */
+    CPUBudget cpuBudget;
     std::thread cpuMonitorThread;
     TCPSocket serverSocket;
 
+    /**
+     * Besides the server socket, which serve() polls, each extra acceptor
+     * has its own listening socket bound to the same port with SO_REUSEPORT
+     * and its own thread, so a burst of connections is accepted in parallel.
+     * The kernel spreads the connections among the sockets
+     */
+    unsigned int nAcceptors;
+    std::vector<std::unique_ptr<TCPSocket>> acceptorSockets;
+    std::vector<std::thread> acceptorThreads;
+    int acceptorWakeUpFileDescriptor;
+    std::atomic<std::size_t> acceptedConnections;
+
+    /**
+     * Set when the server is one of several worker processes sharing the
+     * port, to publish its state to the others
+     */
+    std::shared_ptr<SharedServerState> sharedState;
+    std::size_t shardIndex;
+    std::string shardSuffix;    //!< Tells apart the log files of the shards
+
     std::atomic<bool> doneServing;
     const std::string shutdownPipeName;
     int shutdownPipeFileDescriptor;
@@ -80,7 +140,41 @@ namespace autocomp
 
     std::shared_ptr<io::PerformanceDataWriter> performanceDataWriter;
 
-    DecisionTree decisionTree;
+    /**
+     * Decision tree or ensemble AutoComp chooses the compressors with
+     */
+    std::unique_ptr<ClassificationModel> model;
+
+    /**
+     * What the sessions of the BANDIT mode learn, loaded from and saved to
+     * the bandit model file. The model gives it a head start if warm started
+     */
+    ContextualBandit contextualBandit;
+    std::string banditModelFilename;
+    bool banditWarmStart;
+
+    /**
+     * Compression rates and ratios of the codecs on this host, which the
+     * sessions of the ANALYTIC mode predict their throughput with. Measured
+     * at start and refined by every chunk they compress
+     */
+    CodecCalibration codecCalibration;
+
+    /**
+     * Minimum payload size for MSG_ZEROCOPY sends. 0 disables zero copy
+     */
+    std::size_t zeroCopyThreshold;
+
+    /**
+     * Whether to cork the client sockets while frames are queued
+     */
+    bool frameBatching;
+
+    /**
+     * Limits of the transmission queue of each session
+     */
+    std::size_t transmissionQueueMaxBytes;
+    std::size_t transmissionQueueMaxFrames;
 
   public:
     
@@ -101,6 +195,122 @@ namespace autocomp
 
     unsigned short getPort() const;
 
+    /**
+     * Enables MSG_ZEROCOPY transmission of the payloads of at least the given
+     * size. Must be called before init().
+     *
+     * @param zeroCopyThreshold Minimum payload size in bytes. 0 disables it
+     */
+    void setZeroCopyThreshold(const std::size_t & zeroCopyThreshold);
+
+    /**
+     * Enables TCP_CORK batching: while more frames are waiting to be sent,
+     * the client socket is corked so small frames share segments.
+     *
+     * @param frameBatching Whether to batch frames
+     */
+    void setFrameBatching(const bool & frameBatching);
+
+    /**
+     * Sets the limits of the transmission queue of each session. The file
+     * reader blocks while the queue is full, so a slow client holds at most
+     * this much data in memory.
+     *
+     * @param maxBytes Maximum number of bytes waiting to be sent
+     * @param maxFrames Maximum number of frames waiting to be sent
+     */
+    void setTransmissionQueueCapacity(const std::size_t & maxBytes,
+                                      const std::size_t & maxFrames =
+                                        constants::
+                                          TRANSMISSION_QUEUE_MAX_FRAMES);
+
+    /**
+     * Sets how many sessions can run at once, and how many requests can wait
+     * for one of them to end, and for how long, before being refused with a
+     * busy error.
+     *
+     * @param maxSessions Maximum number of running sessions
+     * @param maxQueuedSessions Maximum number of waiting requests
+     * @param maxQueueWaitTime Maximum waiting time, in milliseconds
+     */
+    void setAdmissionLimits(const std::size_t & maxSessions,
+                            const std::size_t & maxQueuedSessions,
+                            const unsigned int & maxQueueWaitTime);
+
+    /**
+     * Sets the memory budget of the server: the bytes every session can hold
+     * in its transmission queue, plus the working memory of the codecs. As it
+     * fills up, the sessions produce chunks only as fast as they send them
+     * and AutoComp picks codecs that need less memory.
+     *
+     * @param memoryBudget Budget in bytes. 0 disables it
+     */
+    void setMemoryBudget(const std::size_t & memoryBudget);
+
+    /**
+     * Sets the file the contextual bandit of the BANDIT mode is loaded from
+     * at init() and saved to at shutdown, if it learned anything. When
+     * sharded, every shard loads it and saves what it learned on top.
+     * Must be called before init()
+     *
+     * @param filename Bandit model file
+     * @param warmStart Whether the contexts not learned yet start with the
+     *                  choice of the decision tree ahead
+     */
+    void setBanditModel(const std::string & filename, const bool & warmStart);
+
+    /**
+     * Gets what the contextual bandit learned and how much it explored
+     */
+    BanditStats getBanditStats() const;
+
+    /**
+     * Sets the number of reactor threads. Must be called before init()
+     */
+    void setReactorThreadCount(const unsigned int & nThreads);
+
+    /**
+     * Sets the number of sockets, each with its own thread, that accept
+     * connections. Must be called before init()
+     */
+    void setAcceptorCount(const unsigned int & nAcceptors);
+
+    /**
+     * Makes the server one of several worker processes sharing its port: it
+     * binds with SO_REUSEPORT, logs to files of its own and periodically
+     * publishes its state to the shared state. Must be called before init()
+     *
+     * @param sharedState State shared by the shards
+     * @param shardIndex Index of this server in the shared state
+     */
+    void setShard(const std::shared_ptr<SharedServerState> & sharedState,
+                  const std::size_t & shardIndex);
+
+    /**
+     * Gets the state of this server, as published to the shared state
+     */
+    ShardStats getShardStats() const;
+
+    /**
+     * Gets the saturation metrics of the server
+     */
+    AdmissionStats getAdmissionStats() const;
+
+    /**
+     * Gets the memory usage of the server, as the memory governor sees it
+     */
+    MemoryStats getMemoryStats() const;
+
+    /**
+     * Gets the compression CPU demand the sessions committed
+     */
+    CPUBudgetStats getCPUBudgetStats() const;
+
+    /**
+     * Gets how the sessions shared the request threads
+     */
+    SchedulerStats getSchedulerStats() const;
+
     void init();
 
     void serve();
@@ -109,26 +319,92 @@ namespace autocomp
 
   private:
 
-    static void processRequest(std::shared_ptr<TCPSocket> clientSocket,
-                               ThreadPool & transmissionThreadPool,
-                               std::shared_ptr<io::PerformanceDataWriter>
-                                  performanceDataWriter,
-                               ResourceState & resourceState,
-                               const DecisionTree & decisionTree);
+    /**
+     * Function that each extra acceptor thread runs
+     */
+    void runAcceptor(TCPSocket & socket);
+
+    /**
+     * Accepts a connection and hands it to the reactor
+     */
+    void acceptConnection(TCPSocket & socket);
+
+    void publishState();
+
+    /**
+     * A request being served
+     */
+    struct Session
+    {
+      std::shared_ptr<Connection> connection;
+      AdmissionController::Session admission;
+      messaging::FileTransmissionRequest fileRequest;
+      std::shared_ptr<FileProcessingStrategy> fileProcessor;
+      std::shared_ptr<BufferPool> chunkPool;
+      std::shared_ptr<SessionScheduler::Flow> flow;
+      unsigned int protocolVersion;
+      bool chunkChecksums;
+      bool sendingFile;     //!< Whether a file was opened and has chunks left
+      uint64_t nChunks;     //!< Chunks of the current file sent so far
+      Frame pendingFrame;   //!< Frame produced but not queued yet
+      bool hasPendingFrame;
+      std::chrono::time_point<std::chrono::high_resolution_clock> tic;
+    };
+
+    /**
+     * Handles a request the reactor received: admits it and hands it to the
+     * request thread pool
+     */
+    void acceptRequest(const std::shared_ptr<Connection> & connection,
+                       std::vector<char> && request);
+
+    /**
+     * Serves an admitted request. The admission is released when the
+     * session ends
+     */
+    void processRequest(std::shared_ptr<Connection> connection,
+                        std::vector<char> & request,
+                        AdmissionController::Session && admission);
+
+    /**
+     * Produces frames for a slice of the scheduler: until the slice is over,
+     * the request is done or the transmission queue is full, in which case it
+     * is scheduled again once the queue drains. A request that fails is
+     * answered with an error message and its connection closed
+     *
+     * @returns Whether the slice ended with work left to do
+     */
+    bool produce(const std::shared_ptr<Session> & session);
+
+    /**
+     * Produces the next frame of the session
+     *
+     * @returns false once there are no more files to send
+     */
+    bool produceFrame(Session & session);
+
+    void finishSession(Session & session);
+
+    /**
+     * Queues an error message to the client
+     */
+    static void queueErrorMessage(Connection & connection,
+                                  std::string && message);
 
-    static void transmit(std::shared_ptr<TCPSocket> clientSocket,
-                         SynchronousQueue<Buffer> & transmissionQueue,
-                         bool & requestDone, std::mutex & mutex,
-                         std::condition_variable & condition,
-                         ResourceState & resourceState);
+    static Frame makeErrorMessageFrame(std::string && message);
 
     static std::shared_ptr<FileProcessingStrategy> configureFileProcessor(
         const messaging::FileTransmissionRequest & fileRequest,
         const ResourceState & resourceState,
-        const SynchronousQueue<Buffer> & transmissionQueue,
+        const BoundedQueue<Frame> & transmissionQueue,
         const std::shared_ptr<TCPSocket> & clientSocket,
         std::shared_ptr<io::PerformanceDataWriter> performanceDataWriter,
-        const DecisionTree & decisionTree
+        const ClassificationModel & model,
+        ContextualBandit & contextualBandit,
+        CodecCalibration & codecCalibration,
+        const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator,
+        MemoryGovernor * memoryGovernor,
+        CPUBudget * cpuBudget
       );
 
     void initLogger();
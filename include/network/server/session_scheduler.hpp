@@ -0,0 +1,285 @@
+/**
+ *  AutoComp Session Scheduler
+ *  session_scheduler.hpp
+ *
+ *  Declaration of class SessionScheduler, which shares the request threads
+ *  among the sessions of the server.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_SESSION_SCHEDULER_HPP
+#define AC_SESSION_SCHEDULER_HPP
+
+#include <map>
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+#include "utils/constants.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * Scheduling metrics of a session
+   */
+  struct FlowStats
+  {
+    unsigned int weight;
+    double maxRate;                 //!< Bytes per second, 0 if unlimited
+    std::size_t nSlices;            //!< Times it ran
+    std::size_t bytes;              //!< Bytes it produced
+    double cpuTime;                 //!< In ms
+    double cpuShare;                //!< Of the CPU time of every session
+                                    //!< since it started, in [0, 1]
+    double meanQueueingDelay;       //!< From ready to running, in ms
+    double maxQueueingDelay;        //!< In ms
+    double throttledTime;           //!< Held back by its rate cap, in ms
+  };
+
+  /**
+   * Scheduling metrics of the server
+   */
+  struct SchedulerStats
+  {
+    std::size_t nFlows;             //!< Sessions scheduled so far
+    std::size_t readyFlows;         //!< Waiting for a thread
+    std::size_t throttledFlows;     //!< Held back by their rate cap
+    std::size_t nSlices;
+    double cpuTime;                 //!< Of every slice, in ms
+    double meanQueueingDelay;       //!< In ms
+    double maxQueueingDelay;        //!< In ms
+  };
+
+  /**
+   * Deficit round robin scheduler of the sessions, on CPU time.
+   *
+   * A session, or flow, is a function that runs a slice of its work: a few
+   * chunks at most, around SCHEDULER_QUANTUM milliseconds. Whenever one of
+   * the flows is ready, a dispatch task is posted to the thread pool, which
+   * runs the slice of whichever flow has credit, not necessarily the one that
+   * posted it. Each round gives every ready flow a quantum of CPU time times
+   * its weight, and each slice is charged the CPU time it took, so heavy
+   * flows (a large directory with bzip2) and light ones (a small file) share
+   * the threads in proportion to their weights, and a new flow waits for a
+   * round at most.
+   *
+   * A flow can also be capped to a rate: it is charged the bytes it produces
+   * from a token bucket, and held back while the bucket is in debt.
+   *
+   * Once the scheduler is shut down no more dispatches are posted, so the
+   * thread pool can be shut down after it while flows are still scheduled.
+   */
+  class SessionScheduler
+  {
+  public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Runs a slice of a flow
+     *
+     * @returns Whether the flow has more work right away. If not, it is
+     *          not run again until it is scheduled. A slice that throws is
+     *          logged and taken for one without more work
+     */
+    using SliceFunction = std::function<bool()>;
+
+    /**
+     * A flow of the scheduler. Created with addFlow()
+     */
+    class Flow
+    {
+      friend class SessionScheduler;
+
+      enum class State
+      {
+        IDLE,
+        READY,
+        THROTTLED,
+        RUNNING
+      };
+
+      const SliceFunction slice;
+      const unsigned int weight;
+      const double maxRate;
+
+      // Guarded by the mutex of the scheduler
+      State state;
+      bool rescheduled;             //!< Scheduled while it was running
+      double deficit;               //!< CPU time it can use, in ns
+      double tokens;                //!< Bytes it can produce
+      Clock::time_point lastRefill;
+      Clock::time_point readyTime;
+      Clock::time_point throttledTime;
+      double initialCpuTime;        //!< Of the scheduler when it was added
+      FlowStats stats;
+      double totalQueueingDelay;
+
+    public:
+
+      Flow(const SliceFunction & slice, const unsigned int & weight,
+           const double & maxRate);
+
+      Flow(const Flow &) = delete;
+      Flow(Flow &&) = delete;
+      Flow & operator=(const Flow &) = delete;
+      Flow & operator=(Flow &&) = delete;
+    };
+
+  private:
+
+    ThreadPool & threadPool;
+
+    /**
+     * CPU time per round and unit of weight, in ns
+     */
+    const double quantum;
+
+    mutable std::mutex mutex;
+    std::condition_variable throttledFlowsChanged;
+
+    std::deque<std::shared_ptr<Flow>> readyFlows;
+
+    /**
+     * Held back by their rate caps, by the time they can run again
+     */
+    std::multimap<Clock::time_point, std::shared_ptr<Flow>> throttledFlows;
+
+    std::thread timerThread;
+    bool done;
+
+    /**
+     * Dispatches about to be posted. Shutting down waits for them, so none is
+     * posted to a pool shut down afterwards
+     */
+    std::size_t nPendingDispatches;
+    std::condition_variable pendingDispatchesPosted;
+
+    SchedulerStats stats;
+    double totalQueueingDelay;
+
+  public:
+
+    /**
+     * SessionScheduler constructor
+     *
+     * @param threadPool Pool that runs the slices of the flows
+     * @param quantum CPU time a flow of weight 1 gets in each round
+     */
+    SessionScheduler(ThreadPool & threadPool,
+                     const std::chrono::nanoseconds & quantum =
+                       std::chrono::milliseconds(
+                         constants::SCHEDULER_QUANTUM));
+
+    SessionScheduler(const SessionScheduler &) = delete;
+    SessionScheduler(SessionScheduler &&) = delete;
+    SessionScheduler & operator=(const SessionScheduler &) = delete;
+    SessionScheduler & operator=(SessionScheduler &&) = delete;
+
+    ~SessionScheduler();
+
+    /**
+     * Starts the thread that releases the throttled flows
+     */
+    void init();
+
+    /**
+     * Stops the timer thread. Throttled flows are not run anymore, and the
+     * flows scheduled from then on are not run either
+     */
+    void shutdown();
+
+    /**
+     * Adds a flow, which does not run until it is scheduled
+     *
+     * @param slice Function that runs a slice of the flow
+     * @param weight Share of the CPU time relative to the other flows, from 1
+     *               to constants::MAX_SESSION_WEIGHT
+     * @param maxRate Bytes per second it can produce. 0 means unlimited
+     *
+     * @throws std::domain_error If the weight is out of range
+     */
+    std::shared_ptr<Flow> addFlow(const SliceFunction & slice,
+                                  const unsigned int & weight = 1,
+                                  const double & maxRate = 0);
+
+    /**
+     * Tells that a flow has work to do. It runs once, or again once its
+     * current slice ends if it is running
+     */
+    void schedule(const std::shared_ptr<Flow> & flow);
+
+    /**
+     * Charges the bytes a flow produced to its rate cap. Called from its
+     * slices
+     */
+    void charge(Flow & flow, const std::size_t & bytes);
+
+    FlowStats getFlowStats(const Flow & flow) const;
+
+    SchedulerStats getStats() const;
+
+  private:
+
+    /**
+     * Runs a slice of the next flow with credit
+     */
+    void dispatch();
+
+    /**
+     * Posts the dispatches of the flows made ready, counted in
+     * nPendingDispatches while the mutex was held
+     */
+    void postDispatches(const std::size_t & nDispatches);
+
+    /**
+     * Takes the next flow with credit out of the ready flows, topping up
+     * those it goes past. Must be called with the mutex held
+     */
+    std::shared_ptr<Flow> pickNext();
+
+    /**
+     * Makes a flow ready, or throttled if its rate cap holds it back. Must be
+     * called with the mutex held
+     *
+     * @returns Whether it is ready, in which case a dispatch must be posted
+     */
+    bool makeReady(const std::shared_ptr<Flow> & flow,
+                   const Clock::time_point & now);
+
+    /**
+     * Adds the bytes a flow earned since the last refill to its bucket. Must
+     * be called with the mutex held
+     */
+    void refill(Flow & flow, const Clock::time_point & now) const;
+
+    /**
+     * Function that the timer thread runs, which makes the throttled flows
+     * ready again once their time comes
+     */
+    void releaseThrottledFlows();
+
+  }; // class SessionScheduler
+
+  std::ostream & operator<<(std::ostream & stream, const FlowStats & stats);
+
+  std::ostream & operator<<(std::ostream & stream,
+                            const SchedulerStats & stats);
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_SESSION_SCHEDULER_HPP
@@ -0,0 +1,125 @@
+/**
+ *  AutoComp Shared Server State
+ *  shared_server_state.hpp
+ *
+ *  Declaration of class SharedServerState, through which the shards of a
+ *  server publish their state to each other.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_SHARED_SERVER_STATE_HPP
+#define AC_SHARED_SERVER_STATE_HPP
+
+#include <atomic>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "utils/exceptions.hpp"
+#include "utils/constants.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * State of a server shard, or of all of them
+   */
+  struct ShardStats
+  {
+    std::size_t nShards;              //!< Shards running
+    float cpuLoad;                    //!< Highest of the shards
+    float bandwidth;                  //!< Sum of the shards, in Mbps
+    std::size_t acceptedConnections;
+    std::size_t activeSessions;
+    std::size_t queuedSessions;
+    std::size_t admittedSessions;
+    std::size_t rejectedSessions;
+    std::size_t timedOutSessions;
+    std::size_t usedMemory;           //!< Sum of the shards, in bytes
+    float committedCores;             //!< Sum of the shards
+  };
+
+  /**
+   * State of the shards of a server, the worker processes that bind the same
+   * port with SO_REUSEPORT.
+   *
+   * It lives in an anonymous shared mapping, so it must be created before
+   * the shards are forked. Each shard writes its own slot and any of them
+   * reads the others: the slots only hold lock free atomics, which work
+   * across processes.
+   */
+  class SharedServerState
+  {
+    struct Slot
+    {
+      std::atomic<int32_t> pid;       //!< 0 while the shard is not running
+      std::atomic<float> cpuLoad;
+      std::atomic<float> bandwidth;
+      std::atomic<uint64_t> acceptedConnections;
+      std::atomic<uint64_t> activeSessions;
+      std::atomic<uint64_t> queuedSessions;
+      std::atomic<uint64_t> admittedSessions;
+      std::atomic<uint64_t> rejectedSessions;
+      std::atomic<uint64_t> timedOutSessions;
+      std::atomic<uint64_t> usedMemory;
+      std::atomic<float> committedCores;
+    };
+
+    Slot * slots;
+    std::size_t nShards;
+
+  public:
+
+    /**
+     * SharedServerState constructor
+     *
+     * @param nShards Number of shards, at most constants::MAX_SHARDS
+     *
+     * @throws std::domain_error If there are too many shards
+     * @throws exceptions::NetworkError If the shared mapping fails
+     */
+    explicit SharedServerState(const std::size_t & nShards);
+
+    SharedServerState(const SharedServerState &) = delete;
+    SharedServerState(SharedServerState &&) = delete;
+    SharedServerState & operator=(const SharedServerState &) = delete;
+    SharedServerState & operator=(SharedServerState &&) = delete;
+
+    ~SharedServerState();
+
+    std::size_t getShardCount() const;
+
+    /**
+     * Publishes the state of a shard, from the shard itself
+     *
+     * @param shardIndex Index of the shard
+     * @param pid Process of the shard, 0 once it stops
+     * @param stats State of the shard. nShards is ignored
+     */
+    void publish(const std::size_t & shardIndex, const pid_t & pid,
+                 const ShardStats & stats);
+
+    /**
+     * Gets the last state a shard published
+     */
+    ShardStats getShardStats(const std::size_t & shardIndex) const;
+
+    /**
+     * Gets the state of the running shards as a whole
+     */
+    ShardStats getAggregate() const;
+
+  }; // class SharedServerState
+
+  std::ostream & operator<<(std::ostream & stream, const ShardStats & stats);
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_SHARED_SERVER_STATE_HPP
@@ -0,0 +1,179 @@
+/**
+ *  AutoComp Chunk Frame Header
+ *  chunk_frame_header.hpp
+ *
+ *  Declaration of struct ChunkFrameHeader, the fixed size header that
+ *  precedes every chunk since version 2 of the protocol.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_CHUNK_FRAME_HEADER_HPP
+#define AC_CHUNK_FRAME_HEADER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <arpa/inet.h>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * First bytes of every chunk frame ("ACHK"). Control messages are sent
+   * length prefixed and a length this big is never sent, so the first four
+   * bytes tell a chunk frame from a control message.
+   */
+  const uint32_t CHUNK_FRAME_MAGIC = 0x4143484B;
+
+  /**
+   * Size of a serialized chunk frame header
+   */
+  const std::size_t CHUNK_FRAME_HEADER_SIZE = 32;
+
+  /**
+   * Header of a chunk, sent right before its payload with no length prefix.
+   *
+   * Wire layout (big endian):
+   *
+   *   offset  size  field
+   *   0       4     magic
+   *   4       1     version
+   *   5       1     flags
+   *   6       1     compressor
+   *   7       1     level (0 if unknown)
+   *   8       8     chunkIndex
+   *   16      4     compressedSize (size of the payload)
+   *   20      4     uncompressedSize
+   *   24      4     checksum (CRC-32 of the payload, if HAS_CHECKSUM is set)
+   *   28      4     reserved, 0
+   */
+  struct ChunkFrameHeader
+  {
+    enum Flag : uint8_t
+    {
+      LAST_CHUNK      = 1 << 0, //!< Last chunk of the file
+      DEPENDENT_CHUNK = 1 << 1, //!< Can not be decoded on its own
+      HAS_CHECKSUM    = 1 << 2  //!< The checksum field is valid
+    };
+
+    uint8_t version;
+    uint8_t flags;
+    uint8_t compressor;
+    uint8_t level;              //!< Known only in the modes the client
+                                //!< asks for a compressor and level in
+    uint64_t chunkIndex;
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    uint32_t checksum;
+
+    ChunkFrameHeader()
+      : version(2),
+        flags(0),
+        compressor(0),
+        level(0),
+        chunkIndex(0),
+        compressedSize(0),
+        uncompressedSize(0),
+        checksum(0)
+    {}
+
+    bool hasFlag(const Flag & flag) const
+    {
+      return this->flags & flag;
+    }
+
+    void setFlag(const Flag & flag, const bool & value = true)
+    {
+      if (value) {
+        this->flags |= flag;
+      }
+      else {
+        this->flags &= ~flag;
+      }
+    }
+
+    /**
+     * Writes the header to the buffer
+     *
+     * @param buffer Where the header is written. It must have room for
+     *               CHUNK_FRAME_HEADER_SIZE bytes
+     */
+    void serialize(char * buffer) const
+    {
+      ChunkFrameHeader::write32(buffer, CHUNK_FRAME_MAGIC);
+      buffer[4] = this->version;
+      buffer[5] = this->flags;
+      buffer[6] = this->compressor;
+      buffer[7] = this->level;
+      ChunkFrameHeader::write32(buffer + 8, this->chunkIndex >> 32);
+      ChunkFrameHeader::write32(buffer + 12, this->chunkIndex);
+      ChunkFrameHeader::write32(buffer + 16, this->compressedSize);
+      ChunkFrameHeader::write32(buffer + 20, this->uncompressedSize);
+      ChunkFrameHeader::write32(buffer + 24, this->checksum);
+      ChunkFrameHeader::write32(buffer + 28, 0);
+    }
+
+    /**
+     * Reads the header from the buffer
+     *
+     * @param buffer CHUNK_FRAME_HEADER_SIZE bytes holding the header
+     *
+     * @returns false if the buffer does not hold a chunk frame header
+     */
+    bool deserialize(const char * buffer)
+    {
+      if (not ChunkFrameHeader::isChunkFrame(buffer) or
+          static_cast<uint8_t>(buffer[4]) < 2) {
+        return false;
+      }
+
+      this->version = buffer[4];
+      this->flags = buffer[5];
+      this->compressor = buffer[6];
+      this->level = buffer[7];
+      this->chunkIndex =
+        static_cast<uint64_t>(ChunkFrameHeader::read32(buffer + 8)) << 32 |
+        ChunkFrameHeader::read32(buffer + 12);
+      this->compressedSize = ChunkFrameHeader::read32(buffer + 16);
+      this->uncompressedSize = ChunkFrameHeader::read32(buffer + 20);
+      this->checksum = ChunkFrameHeader::read32(buffer + 24);
+
+      return true;
+    }
+
+    /**
+     * Checks whether the first four bytes of the buffer are the chunk frame
+     * magic number
+     */
+    static bool isChunkFrame(const char * buffer)
+    {
+      return ChunkFrameHeader::read32(buffer) == CHUNK_FRAME_MAGIC;
+    }
+
+  private:
+
+    static void write32(char * buffer, const uint32_t & value)
+    {
+      uint32_t networkByteOrderValue = htonl(value);
+      std::memcpy(buffer, &networkByteOrderValue, sizeof(value));
+    }
+
+    static uint32_t read32(const char * buffer)
+    {
+      uint32_t networkByteOrderValue;
+      std::memcpy(&networkByteOrderValue, buffer,
+                  sizeof(networkByteOrderValue));
+
+      return ntohl(networkByteOrderValue);
+    }
+  }; // struct ChunkFrameHeader
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_CHUNK_FRAME_HEADER_HPP
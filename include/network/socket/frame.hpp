@@ -0,0 +1,89 @@
+/**
+ *  AutoComp Frame
+ *  frame.hpp
+ *
+ *  Declaration of struct Frame, the unit of transmission of the server.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_FRAME_HPP
+#define AC_FRAME_HPP
+
+#include <utility>
+
+#include "utils/buffer.hpp"
+#include "network/socket/chunk_frame_header.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  /**
+   * A message (the header) optionally followed by a payload, written with a
+   * single system call.
+   *
+   * Serialized messages are sent length prefixed, as is the payload that
+   * follows them, so such a frame is wire compatible with two consecutive
+   * calls to TCPSocket::send(). Chunk frames (protocol version >= 2) carry a
+   * fixed size ChunkFrameHeader instead, and neither part is prefixed.
+   */
+  struct Frame
+  {
+    Buffer header;                  //!< Serialized message
+    ChunkFrameHeader chunkHeader;   //!< Used instead of header if
+                                    //!< hasChunkHeader is set
+    Buffer payload;                 //!< Data the header describes, if any
+    bool hasChunkHeader;            //!< Whether this is a chunk frame
+    bool hasPayload;                //!< Whether the payload is part of the
+                                    //!< frame
+
+    Frame()
+      : hasChunkHeader(false),
+        hasPayload(false)
+    {}
+
+    explicit Frame(Buffer && header)
+      : header(std::move(header)),
+        hasChunkHeader(false),
+        hasPayload(false)
+    {}
+
+    Frame(Buffer && header, Buffer && payload)
+      : header(std::move(header)),
+        payload(std::move(payload)),
+        hasChunkHeader(false),
+        hasPayload(true)
+    {}
+
+    Frame(const ChunkFrameHeader & chunkHeader, Buffer && payload)
+      : chunkHeader(chunkHeader),
+        payload(std::move(payload)),
+        hasChunkHeader(true),
+        hasPayload(true)
+    {}
+
+    Frame(const Frame &) = delete;
+    Frame(Frame &&) = default;
+    Frame & operator=(const Frame &) = delete;
+    Frame & operator=(Frame &&) = default;
+
+    /**
+     * Gets the number of message bytes in the frame, without the length
+     * prefixes
+     */
+    std::size_t getSize() const
+    {
+      return (this->hasChunkHeader ? CHUNK_FRAME_HEADER_SIZE
+                                   : this->header.getSize()) +
+             (this->hasPayload ? this->payload.getSize() : 0);
+    }
+  }; // struct Frame
+
+  } // namespace net
+} // namespace autocomp
+
+#endif // AC_FRAME_HPP
@@ -16,12 +16,23 @@
 #include <utility>
 #include <chrono>
 #include <mutex>
+#include <atomic>
+#include <deque>
+#include <algorithm>
 #include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <netinet/tcp.h>
 #include <linux/sockios.h>
+#include <linux/errqueue.h>
 
 #include "utils/buffer.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/bandwidth_estimator.hpp" // ConnectionInfo
 #include "network/socket/socket.hpp"
+#include "network/socket/frame.hpp"
 
 namespace autocomp
 {
@@ -33,12 +44,35 @@ namespace autocomp
    */
   class TCPSocket : public Socket
   {
-    mutable
-    double lastBandwidth;
-    mutable int previousBytesInSendBuffer;
-    mutable std::chrono::time_point<std::chrono::high_resolution_clock>
-      previousMeasureTime;
-    mutable std::mutex bandwidthMutex;
+    /**
+     * A buffer sent with MSG_ZEROCOPY that the kernel may still be reading
+     */
+    struct ZeroCopyBuffer
+    {
+      uint32_t notificationId;            //!< Id of the last send using it
+      Buffer buffer;                      //!< The pinned buffer
+      std::shared_ptr<BufferPool> pool;   //!< Where to return it when done
+    };
+
+    std::atomic<bool> zeroCopyEnabled;
+    std::atomic<std::size_t> zeroCopyThreshold;
+    uint32_t zeroCopyNextNotificationId;
+    std::deque<ZeroCopyBuffer> zeroCopyPendingBuffers;
+
+    /**
+     * Whether part of the payload of the frame trySendFrame() is sending went
+     * out with MSG_ZEROCOPY
+     */
+    bool partialFramePinned;
+
+    bool corked;
+
+    /**
+     * Data read from the socket but not consumed yet. Its size marks the end
+     * of the valid data
+     */
+    mutable Buffer readAheadBuffer;
+    mutable std::size_t readAheadOffset;
 
   public:
 
@@ -57,7 +91,7 @@ namespace autocomp
     TCPSocket(const TCPSocket &) = delete;
     TCPSocket & operator=(const TCPSocket &) = delete;
 
-    ~TCPSocket() {};
+    ~TCPSocket();
 
     void setSendBufferCapacity(const int & newCapacity);
 
@@ -65,7 +99,68 @@ namespace autocomp
 
     int getSendBufferSize() const;
 
-    double getBandwidth() const;
+    /*
+     * Gets the state of the connection from TCP_INFO, from which its
+     * bandwidth is estimated
+     *
+     * @param connectionInfo Where to store the state
+     *
+     * @throws exceptions::NetworkError If TCP_INFO cannot be read
+     */
+    void getConnectionInfo(ConnectionInfo & connectionInfo) const;
+
+    /*
+     * Enables MSG_ZEROCOPY transmission for the payloads sent through
+     * send(Buffer &&, ...) whose size is at least the given threshold.
+     *
+     * @param threshold Minimum payload size in bytes for a zero copy send
+     *
+     * @throws exceptions::NetworkError If the kernel does not support
+     *                                  SO_ZEROCOPY
+     */
+    void enableZeroCopy(const std::size_t & threshold);
+
+    bool isZeroCopyEnabled() const;
+
+    /*
+     * Gets the number of buffers the kernel has not released yet
+     */
+    std::size_t getPendingZeroCopyBuffers() const;
+
+    /*
+     * Sets or clears TCP_CORK. While the socket is corked, the kernel only
+     * sends full segments, so several small frames can share one.
+     *
+     * @param cork Whether to cork the socket
+     */
+    void setCork(const bool & cork);
+
+    /*
+     * Sets or clears SO_REUSEADDR, which lets a listening socket bind to a
+     * port its previous connections still hold in TIME_WAIT. Must be called
+     * before bind().
+     *
+     * @param reuseAddress Whether to reuse the address
+     */
+    void setReuseAddress(const bool & reuseAddress);
+
+    /*
+     * Sets or clears SO_REUSEPORT. Several listening sockets with it set can
+     * bind to the same port, and the kernel spreads the incoming connections
+     * among them. Must be called before bind().
+     *
+     * @param reusePort Whether to reuse the port
+     */
+    void setReusePort(const bool & reusePort);
+
+    /*
+     * Makes receive() read up to the given amount of bytes at once, keeping
+     * what is not consumed for the next calls. Must be called before any data
+     * is received.
+     *
+     * @param capacity Size of the read ahead buffer. 0 disables it
+     */
+    void enableReadAhead(const std::size_t & capacity);
 
     /*
      * Binds the socket to its configured port
@@ -122,6 +217,109 @@ namespace autocomp
      */
     std::size_t send(const Buffer & message) const;
 
+    /*
+     * Sends the data in the message object, taking ownership of it. The
+     * protocol is the same as the one of the other send() methods.
+     *
+     * The message is handed back to the pool once the kernel is done with it:
+     * right after the write for regular sends or, for zero copy sends, when
+     * the completion notification arrives through the socket's error queue.
+     *
+     * @param message The message to send
+     * @param pool The pool the message buffer belongs to
+     *
+     * @returns The number if bytes sent
+     */
+    std::size_t send(Buffer && message,
+                     const std::shared_ptr<BufferPool> & pool);
+
+    /*
+     * Sends a frame with a single system call. The header and the payload are
+     * sent length prefixed, as send() does, so the peer can read them with two
+     * calls to receive(). Chunk frames are sent with no prefixes.
+     *
+     * If zero copy is enabled and the payload is large enough, the prefixes
+     * and the header are copied and the payload is sent with MSG_ZEROCOPY.
+     * The payload is handed back to the pool once the kernel is done with it.
+     *
+     * @param frame The frame to send
+     * @param pool The pool the payload buffer belongs to, if any
+     *
+     * @returns The number of bytes sent, without the length prefixes
+     */
+    std::size_t sendFrame(Frame && frame,
+                          const std::shared_ptr<BufferPool> & pool = nullptr);
+
+    /*
+     * Reads the zero copy completion notifications and hands the buffers
+     * the kernel is done with back to their pools.
+     *
+     * @param wait Whether to wait until every pending buffer is released,
+     *             as long as the send queue drains
+     * @throws exceptions::NetworkError If the connection fails, or the send
+     *                                  queue does not drain for
+     *                                  constants::ZERO_COPY_STALL_TIMEOUT.
+     *                                  The buffers still pinned are kept
+     */
+    void reapZeroCopyCompletions(const bool & wait = false);
+
+    /*
+     * Waits for every pending zero copy send to complete. If the connection
+     * is broken or stalls, it is reset and closed before the pending buffers
+     * are dropped, so the kernel does not send them once they are reused.
+     */
+    void flushZeroCopy();
+
+    /*
+     * Sets or clears O_NONBLOCK. The blocking send() and receive() methods
+     * must not be used on a non-blocking socket, trySendFrame() and tryRead()
+     * are meant for it.
+     *
+     * @param nonBlocking Whether the socket is non-blocking
+     */
+    void setNonBlocking(const bool & nonBlocking);
+
+    /*
+     * Sends as much of a frame as the socket takes without waiting, resuming
+     * where the previous call left it. The frame goes on the wire as with
+     * sendFrame(), zero copy included.
+     *
+     * @param frame The frame to send. Its payload is handed back to the pool
+     *              once the whole frame is sent
+     * @param bytesSent Bytes of the frame already sent, length prefixes
+     *                  included. Must be 0 for a new frame, and is updated
+     * @param pool The pool the payload buffer belongs to, if any
+     *
+     * @returns true once the whole frame is sent
+     */
+    bool trySendFrame(Frame & frame, std::size_t & bytesSent,
+                      const std::shared_ptr<BufferPool> & pool = nullptr);
+
+    /*
+     * Reads whatever data is available, up to the given amount of bytes,
+     * without waiting.
+     *
+     * @param buffer Where the data is written
+     * @param bytesToRead The maximum amount of bytes to read
+     *
+     * @returns The number of bytes read, 0 if there was nothing to read
+     *
+     * @throws exceptions::NetworkError On errors or if the peer closed the
+     *                                  connection
+     */
+    std::size_t tryRead(char * buffer, const std::size_t & bytesToRead);
+
+    /*
+     * Receives exactly the given amount of bytes, which are not preceded by
+     * a length prefix, e.g. chunk frame headers.
+     *
+     * @param buffer Where the data is going to be written
+     * @param bytesToRead The amount of bytes to receive
+     *
+     * @returns The number of bytes read
+     */
+    std::size_t receive(char * buffer, const std::size_t & bytesToRead) const;
+
     /*
      * Receives data from the sender.
      * The protocol is as follows: the function reads the number of bytes
@@ -165,6 +363,17 @@ namespace autocomp
      */
     TCPSocket(const int & fileDescriptor, const sockaddr_in & address);
 
+    /*
+     * Sends the message preceded by its size, with a single system call
+     *
+     * @param message The message to send
+     * @param messageSize The size of the message
+     *
+     * @returns The number of bytes of the message sent
+     */
+    std::size_t sendMessage(const char * message,
+                            const std::size_t & messageSize) const;
+
     /*
      * Sends the size of the next message to transmit
      *
@@ -203,9 +412,50 @@ namespace autocomp
      */
     std::size_t _receive(char * buffer, std::size_t bytesToRead) const;
 
-    void registerSendBufferAddition(const std::size_t & bytes) const;
+    /*
+     * Performs a single read from the socket
+     *
+     * @param buffer Where the data is written
+     * @param bytesToRead The maximum amount of bytes to read
+     *
+     * @returns The number of bytes read, which is always greater than 0
+     */
+    std::size_t _read(char * buffer, std::size_t bytesToRead) const;
+
+    /*
+     * Sends the data in the vector with as few system calls as possible
+     *
+     * @param vector The parts to send. It is modified on partial writes
+     * @param vectorLength The number of parts
+     * @param flags Flags for sendmsg()
+     *
+     * @returns The number of bytes sent
+     */
+    std::size_t _sendv(iovec * vector, int vectorLength,
+                       const int & flags = 0) const;
+
+    /*
+     * Sends a message with MSG_ZEROCOPY and keeps it until the kernel
+     * releases it, when it is handed back to the pool
+     *
+     * @param message The message to send
+     * @param pool The pool the message buffer belongs to, if any
+     *
+     * @returns The number of bytes sent
+     */
+    std::size_t sendPinned(Buffer && message,
+                           const std::shared_ptr<BufferPool> & pool);
 
-    void estimateBandwidth() const;
+    /*
+     * Sends the data in the buffer with MSG_ZEROCOPY. The buffer must not be
+     * modified nor freed until its completion notification is received.
+     *
+     * @param buffer The data to send
+     * @param bytesToSend The amount of bytes to send
+     *
+     * @returns The number of bytes sent
+     */
+    std::size_t _sendZeroCopy(const char * buffer, std::size_t bytesToSend);
 
   }; // class TCPSocket
 
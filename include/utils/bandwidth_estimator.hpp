@@ -0,0 +1,116 @@
+/**
+ *  AutoComp Bandwidth Estimator
+ *  bandwidth_estimator.hpp
+ *
+ *  Declaration of class BandwidthEstimator, which estimates the bandwidth of
+ *  a connection from the state its TCP stack reports.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_BANDWIDTH_ESTIMATOR_HPP
+#define AC_BANDWIDTH_ESTIMATOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "utils/constants.hpp"
+
+namespace autocomp {
+
+/**
+ * State of a TCP connection, as reported by TCP_INFO
+ */
+struct ConnectionInfo
+{
+  double deliveryRate;        //!< In Mbps, 0 if the kernel does not tell
+  double roundTripTime;       //!< Smoothed, in milliseconds
+  uint32_t congestionWindow;  //!< In segments
+  uint32_t maxSegmentSize;    //!< In bytes
+  uint32_t unacknowledged;    //!< Segments in flight
+  uint32_t totalRetransmits;  //!< Segments retransmitted so far
+};
+
+/**
+ * Bandwidth estimate of a single connection.
+ *
+ * The connection feeds it with its TCP_INFO every so often while it sends.
+ * Each sample is the delivery rate the kernel measured or, on kernels that do
+ * not report it, what the congestion window allows per round trip. Samples
+ * are smoothed with an exponential moving average.
+ *
+ * Samples are added by a single thread, while any thread can read the
+ * estimate.
+ */
+class BandwidthEstimator
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+private:
+
+  const float smoothingFactor;
+  const std::chrono::milliseconds samplingInterval;
+
+  std::atomic<float> bandwidth;
+  std::atomic<float> roundTripTime;
+  std::atomic<uint32_t> totalRetransmits;
+
+  // Only used by the thread adding samples
+  bool hasSamples;
+  Clock::time_point lastSampleTime;
+
+public:
+
+  /**
+   * BandwidthEstimator constructor
+   *
+   * @param smoothingFactor Weight of the newest sample, in (0, 1]
+   * @param samplingInterval Minimum time between samples
+   */
+  explicit BandwidthEstimator(
+      const float & smoothingFactor = constants::BANDWIDTH_SMOOTHING_FACTOR,
+      const std::chrono::milliseconds & samplingInterval =
+        std::chrono::milliseconds(constants::BANDWIDTH_SAMPLING_INTERVAL)
+    );
+
+  BandwidthEstimator(const BandwidthEstimator &) = delete;
+  BandwidthEstimator & operator=(const BandwidthEstimator &) = delete;
+
+  /**
+   * Whether the sampling interval went by since the last sample
+   */
+  bool isSamplingDue(const Clock::time_point & now = Clock::now()) const;
+
+  /**
+   * Updates the estimate with the state of the connection
+   */
+  void addSample(const ConnectionInfo & connectionInfo,
+                 const Clock::time_point & now = Clock::now());
+
+  /**
+   * Gets the estimated bandwidth, in Mbps. 0 until the first sample
+   */
+  float getBandwidth() const;
+
+  /**
+   * Gets the smoothed round trip time, in milliseconds
+   */
+  float getRoundTripTime() const;
+
+  uint32_t getTotalRetransmits() const;
+
+  /**
+   * Forgets every sample
+   */
+  void reset();
+
+}; // class BandwidthEstimator
+
+} // namespace autocomp
+
+#endif // AC_BANDWIDTH_ESTIMATOR_HPP
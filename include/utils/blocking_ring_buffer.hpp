@@ -0,0 +1,334 @@
+/**
+ *  AutoComp Blocking Ring Buffer
+ *  blocking_ring_buffer.hpp
+ *
+ *  Declaration and definition of class BlockingRingBuffer, which adds
+ *  spin-then-park waiting and closing to the lock-free ring buffers, and of
+ *  the queues built on it.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_BLOCKING_RING_BUFFER_HPP
+#define AC_BLOCKING_RING_BUFFER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+#include <utility>
+
+#include "utils/spsc_ring_buffer.hpp"
+#include "utils/mpmc_ring_buffer.hpp"
+
+namespace autocomp {
+
+/**
+ * Waits for a condition by spinning for a while and then parking the thread
+ * on a condition variable. Notifiers only take the lock when some thread is
+ * actually parked, so a hand-off between two busy threads costs no system
+ * call.
+ */
+class SpinParkWaiter
+{
+  static const int spinIterations = 64;
+  static const int yieldIterations = 16;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::atomic<int> parkedThreads;
+
+public:
+
+  SpinParkWaiter()
+    : parkedThreads(0)
+  {}
+
+  SpinParkWaiter(const SpinParkWaiter &) = delete;
+  SpinParkWaiter(SpinParkWaiter &&) = delete;
+  SpinParkWaiter & operator=(const SpinParkWaiter &) = delete;
+  SpinParkWaiter & operator=(SpinParkWaiter &&) = delete;
+
+  /**
+   * Waits until the predicate holds
+   *
+   * @param ready Predicate to wait for. It must be thread safe
+   */
+  template <typename Predicate>
+  void wait(Predicate ready)
+  {
+    for (int i = 0; i < spinIterations; i++) {
+      if (ready()) {
+        return;
+      }
+
+      SpinParkWaiter::relax();
+    }
+
+    for (int i = 0; i < yieldIterations; i++) {
+      if (ready()) {
+        return;
+      }
+
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    // Published before the predicate is checked again, so a notifier that
+    // makes it true either sees this thread parked or is seen by the check
+    this->parkedThreads.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    this->condition.wait(guard, ready);
+    this->parkedThreads.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Wakes up a parked thread, if any. Must be called after making the
+   * predicate of the waiters true
+   */
+  void notifyOne()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->parkedThreads.load(std::memory_order_relaxed) > 0) {
+      { std::unique_lock<std::mutex> guard(this->mutex); }
+      this->condition.notify_one();
+    }
+  }
+
+  /**
+   * Wakes up every parked thread
+   */
+  void notifyAll()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->parkedThreads.load(std::memory_order_relaxed) > 0) {
+      { std::unique_lock<std::mutex> guard(this->mutex); }
+      this->condition.notify_all();
+    }
+  }
+
+private:
+
+  static void relax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+  }
+
+}; // class SpinParkWaiter
+
+/**
+ * A lock-free ring buffer whose producers wait while it is full and whose
+ * consumers wait while it is empty. Once closed, producers are rejected and
+ * consumers get the remaining entries before being told it is exhausted.
+ *
+ * @tparam Ring Ring buffer type (SpscRingBuffer or MpmcRingBuffer)
+ * @tparam T type of entry stored in the ring
+ */
+template <template <typename> class Ring, typename T>
+class BlockingRingBuffer
+{
+  Ring<T> ring;
+  std::atomic<bool> closed;
+  SpinParkWaiter notEmpty;
+  SpinParkWaiter notFull;
+
+public:
+
+  /**
+   * BlockingRingBuffer constructor
+   *
+   * @param capacity Minimum number of entries the ring holds
+   */
+  explicit BlockingRingBuffer(const std::size_t & capacity)
+    : ring(capacity),
+      closed(false)
+  {}
+
+  BlockingRingBuffer(const BlockingRingBuffer &) = delete;
+  BlockingRingBuffer(BlockingRingBuffer &&) = delete;
+  BlockingRingBuffer & operator=(const BlockingRingBuffer &) = delete;
+  BlockingRingBuffer & operator=(BlockingRingBuffer &&) = delete;
+
+  std::size_t getCapacity() const
+  {
+    return this->ring.getCapacity();
+  }
+
+  std::size_t getSize() const
+  {
+    return this->ring.getSize();
+  }
+
+  bool isEmpty() const
+  {
+    return this->ring.isEmpty();
+  }
+
+  bool isClosed() const
+  {
+    return this->closed.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Enqueues an entry, waiting while the ring is full
+   *
+   * @param entry The entry to enqueue
+   *
+   * @returns false if the ring was closed, in which case the entry is dropped
+   */
+  bool push(T && entry)
+  {
+    bool pushed = false;
+
+    this->notFull.wait([this, &entry, &pushed] ()
+                       {
+                         pushed = not this->isClosed() and
+                                  this->ring.tryPush(std::move(entry));
+
+                         return pushed or this->isClosed();
+                       });
+
+    if (pushed) {
+      this->notEmpty.notifyOne();
+    }
+
+    return pushed;
+  }
+
+  /**
+   * Enqueues an entry if the ring is not full
+   *
+   * @returns false if the ring is full or closed
+   */
+  bool tryPush(T && entry)
+  {
+    if (this->isClosed() or not this->ring.tryPush(std::move(entry))) {
+      return false;
+    }
+
+    this->notEmpty.notifyOne();
+
+    return true;
+  }
+
+  /**
+   * Dequeues an entry, waiting while the ring is empty
+   *
+   * @param entry Where the entry is moved to
+   *
+   * @returns false if the ring is closed and empty
+   */
+  bool pop(T & entry)
+  {
+    bool popped = false;
+
+    this->notEmpty.wait([this, &entry, &popped] ()
+                        {
+                          // Entries pushed before closing are still handed
+                          // out, so the flag is read before trying
+                          const bool wasClosed = this->isClosed();
+                          popped = this->ring.tryPop(entry);
+
+                          return popped or wasClosed;
+                        });
+
+    if (popped) {
+      this->notFull.notifyOne();
+    }
+
+    return popped;
+  }
+
+  /**
+   * Dequeues an entry if the ring is not empty
+   *
+   * @returns false if the ring is empty
+   */
+  bool tryPop(T & entry)
+  {
+    if (not this->ring.tryPop(entry)) {
+      return false;
+    }
+
+    this->notFull.notifyOne();
+
+    return true;
+  }
+
+  /**
+   * Dequeues up to maxEntries entries, waiting while the ring is empty
+   *
+   * @param output Output iterator the entries are moved to
+   * @param maxEntries Maximum number of entries to dequeue
+   *
+   * @returns The number of dequeued entries. 0 if the ring is closed and empty
+   */
+  template <typename OutputIterator>
+  std::size_t popBatch(OutputIterator output, const std::size_t & maxEntries)
+  {
+    std::size_t nEntries = 0;
+
+    this->notEmpty.wait([this, &output, &maxEntries, &nEntries] ()
+                        {
+                          const bool wasClosed = this->isClosed();
+                          nEntries = this->ring.tryPopBatch(output,
+                                                            maxEntries);
+
+                          return nEntries > 0 or wasClosed;
+                        });
+
+    if (nEntries > 0) {
+      this->notFull.notifyAll();
+    }
+
+    return nEntries;
+  }
+
+  /**
+   * Closes the ring, waking up every waiting producer and consumer
+   */
+  void close()
+  {
+    this->closed.store(true, std::memory_order_release);
+
+    this->notFull.notifyAll();
+    this->notEmpty.notifyAll();
+  }
+
+  /**
+   * Empties the ring and opens it again. Only safe while no other thread uses
+   * it
+   */
+  void reopen()
+  {
+    this->ring.clear();
+    this->closed.store(false, std::memory_order_release);
+  }
+
+}; // class BlockingRingBuffer
+
+/**
+ * Blocking queue for one producer and one consumer
+ */
+template <typename T>
+using SpscQueue = BlockingRingBuffer<SpscRingBuffer, T>;
+
+/**
+ * Blocking queue for any number of producers and consumers
+ */
+template <typename T>
+using MpmcQueue = BlockingRingBuffer<MpmcRingBuffer, T>;
+
+} // namespace autocomp
+
+#endif // AC_BLOCKING_RING_BUFFER_HPP
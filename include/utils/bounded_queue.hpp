@@ -0,0 +1,309 @@
+/**
+ *  AutoComp Bounded Queue
+ *  bounded_queue.hpp
+ *
+ *  Declaration and definition of class BoundedQueue, a synchronous queue
+ *  with a limited capacity in entries and bytes.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_BOUNDED_QUEUE_HPP
+#define AC_BOUNDED_QUEUE_HPP
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <algorithm>
+
+namespace autocomp {
+
+/**
+ * Occupancy of a bounded queue, readable without knowing the type of its
+ * entries
+ */
+class QueueOccupancy
+{
+public:
+
+  virtual ~QueueOccupancy() = default;
+
+  /**
+   * Gets the fraction of the queue capacity in use, either in entries or in
+   * bytes, whichever is higher.
+   *
+   * @returns The load of the queue, in [0, 1]
+   */
+  virtual float getLoad() const = 0;
+
+  /**
+   * Gets the number of entries in the queue
+   */
+  virtual int getSize() const = 0;
+
+  /**
+   * Gets the number of bytes held by the entries in the queue
+   */
+  virtual std::size_t getBytes() const = 0;
+
+}; // class QueueOccupancy
+
+/**
+ * A synchronous queue with a limited capacity in entries and bytes. Producers
+ * block while the queue is full, so a slow consumer throttles them instead of
+ * letting the queue grow without bound.
+ *
+ * The queue can be closed: producers are no longer accepted and consumers get
+ * the remaining entries, and then are told the queue is exhausted.
+ *
+ * @tparam T type of message stored in the queue. It must provide a
+ *           std::size_t getSize() const method returning its size in bytes
+ */
+template <typename T>
+class BoundedQueue : public QueueOccupancy
+{
+  std::queue<T> queue;
+  std::size_t bytes;
+  const std::size_t maxBytes;
+  const std::size_t maxEntries;
+  bool closed;
+
+  mutable std::mutex mutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+
+public:
+
+  /**
+   * BoundedQueue constructor
+   *
+   * @param maxBytes Maximum number of bytes held by the queued entries
+   * @param maxEntries Maximum number of queued entries
+   */
+  BoundedQueue(const std::size_t & maxBytes, const std::size_t & maxEntries)
+    : bytes(0),
+      maxBytes(std::max<std::size_t>(maxBytes, 1)),
+      maxEntries(std::max<std::size_t>(maxEntries, 1)),
+      closed(false)
+  {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue(BoundedQueue &&) = delete;
+  BoundedQueue & operator=(const BoundedQueue &) = delete;
+  BoundedQueue & operator=(BoundedQueue &&) = delete;
+
+  bool isEmpty() const
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    return this->queue.empty();
+  }
+
+  int getSize() const
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    return this->queue.size();
+  }
+
+  std::size_t getBytes() const
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    return this->bytes;
+  }
+
+  float getLoad() const
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    return std::min(1.0f,
+                    std::max(static_cast<float>(this->bytes) / this->maxBytes,
+                             static_cast<float>(this->queue.size()) /
+                               this->maxEntries));
+  }
+
+  bool isClosed() const
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    return this->closed;
+  }
+
+  /**
+   * Enqueues an entry, waiting while the queue is full. An entry bigger than
+   * the whole byte capacity is accepted once the queue is empty.
+   *
+   * @param entry The entry to enqueue
+   *
+   * @returns false if the queue was closed, in which case the entry is
+   *          dropped
+   */
+  bool push(T && entry)
+  {
+    std::size_t entryBytes = entry.getSize();
+
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+
+      this->notFull.wait(guard,
+                         [this, &entryBytes] ()
+                         {
+                           return this->closed or
+                                  this->queue.empty() or
+                                  (this->queue.size() < this->maxEntries and
+                                   this->bytes + entryBytes <= this->maxBytes);
+                         });
+
+      if (this->closed) {
+        return false;
+      }
+
+      this->queue.push(std::move(entry));
+      this->bytes += entryBytes;
+    }
+
+    this->notEmpty.notify_one();
+
+    return true;
+  }
+
+  /**
+   * Enqueues an entry if there is room for it, without waiting
+   *
+   * @param entry The entry to enqueue. It is left untouched if it is not
+   *              enqueued
+   *
+   * @returns false if the queue is full or closed
+   */
+  bool tryPush(T && entry)
+  {
+    std::size_t entryBytes = entry.getSize();
+
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+
+      if (this->closed or
+          not (this->queue.empty() or
+               (this->queue.size() < this->maxEntries and
+                this->bytes + entryBytes <= this->maxBytes))) {
+        return false;
+      }
+
+      this->queue.push(std::move(entry));
+      this->bytes += entryBytes;
+    }
+
+    this->notEmpty.notify_one();
+
+    return true;
+  }
+
+  /**
+   * Dequeues an entry, if there is any
+   *
+   * @param entry Where the entry is moved to
+   *
+   * @returns false if the queue is empty
+   */
+  bool pop(T & entry)
+  {
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+
+      if (this->queue.empty()) {
+        return false;
+      }
+
+      this->take(entry);
+    }
+
+    this->notFull.notify_all();
+
+    return true;
+  }
+
+  /**
+   * Dequeues an entry, waiting for one if the queue is empty
+   *
+   * @param entry Where the entry is moved to
+   *
+   * @returns false if the queue is closed and empty
+   */
+  bool waitPop(T & entry)
+  {
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+
+      this->notEmpty.wait(guard,
+                          [this] ()
+                          {
+                            return this->closed or not this->queue.empty();
+                          });
+
+      if (this->queue.empty()) {
+        return false;
+      }
+
+      this->take(entry);
+    }
+
+    this->notFull.notify_all();
+
+    return true;
+  }
+
+  /**
+   * Closes the queue, waking up every waiting producer and consumer
+   */
+  void close()
+  {
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+      this->closed = true;
+    }
+
+    this->notFull.notify_all();
+    this->notEmpty.notify_all();
+  }
+
+  /**
+   * Drops every entry
+   *
+   * @returns The bytes the dropped entries added up to
+   */
+  std::size_t clear()
+  {
+    std::size_t clearedBytes;
+
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+
+      std::queue<T> tmpQueue;
+      this->queue.swap(tmpQueue);
+      clearedBytes = this->bytes;
+      this->bytes = 0;
+    }
+
+    this->notFull.notify_all();
+
+    return clearedBytes;
+  }
+
+private:
+
+  void take(T & entry)
+  {
+    entry = std::move(this->queue.front());
+    this->queue.pop();
+    this->bytes -= std::min(this->bytes, entry.getSize());
+  }
+
+}; // class BoundedQueue
+
+} // namespace autocomp
+
+#endif // AC_BOUNDED_QUEUE_HPP
@@ -0,0 +1,132 @@
+/**
+ *  AutoComp Buffer Pool
+ *  buffer_pool.hpp
+ *
+ *  Declaration of class BufferPool, used to recycle chunk buffers between the
+ *  producer of a transmission (file processing) and its consumer (the socket).
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_BUFFER_POOL_HPP
+#define AC_BUFFER_POOL_HPP
+
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+#include "utils/buffer.hpp"
+#include "utils/memory_governor.hpp"
+
+namespace autocomp {
+
+/**
+ * A thread safe pool of equally sized buffers.
+ *
+ * A buffer taken from the pool with acquire() is owned by the caller until it
+ * is handed back with release(). Buffers that are never released are simply
+ * freed when they go out of scope, so the pool never leaks memory; it only
+ * misses the chance of reusing it.
+ *
+ * With a memory governor, the idle buffers are charged to it for as long as
+ * the pool keeps them. A buffer whose capacity does not fit in the budget is
+ * freed instead, and trim() frees them all for the holders of the data in
+ * flight to use the memory.
+ */
+class BufferPool
+{
+  /**
+   * Idle buffers, ready to be acquired
+   */
+  std::vector<Buffer> buffers;
+
+  /**
+   * Minimum capacity of every buffer handed out by the pool
+   */
+  const std::size_t bufferCapacity;
+
+  /**
+   * Maximum number of idle buffers kept by the pool
+   */
+  const std::size_t maxIdleBuffers;
+
+  /**
+   * Governor the idle buffers are charged to, if any. It must outlive the
+   * pool
+   */
+  MemoryGovernor * memoryGovernor;
+
+  /**
+   * Capacity of the idle buffers, charged to the memory governor
+   */
+  std::size_t idleBytes;
+
+  mutable std::mutex mutex;
+
+public:
+
+  /**
+   * BufferPool constructor
+   *
+   * @param bufferCapacity Minimum capacity of the buffers handed out
+   * @param maxIdleBuffers Maximum number of idle buffers kept for reuse
+   */
+  BufferPool(const std::size_t & bufferCapacity,
+             const std::size_t & maxIdleBuffers = 64);
+
+  BufferPool(const BufferPool &) = delete;
+  BufferPool(BufferPool &&) = delete;
+  BufferPool & operator=(const BufferPool &) = delete;
+  BufferPool & operator=(BufferPool &&) = delete;
+
+  ~BufferPool();
+
+  /**
+   * Sets the governor the idle buffers are charged to. Those already idle
+   * move their charge to it
+   *
+   * @param memoryGovernor The governor, or nullptr to charge none
+   */
+  void setMemoryGovernor(MemoryGovernor * memoryGovernor);
+
+  /**
+   * Takes an idle buffer from the pool, or allocates a new one if there is
+   * none. The returned buffer is empty (its size is 0).
+   *
+   * @returns A buffer with at least getBufferCapacity() bytes of capacity
+   *
+   * @throws std::bad_alloc When a new buffer can not be allocated
+   */
+  Buffer acquire();
+
+  /**
+   * Hands a buffer back to the pool. Buffers smaller than the pool's buffer
+   * capacity, exceeding the idle limit, or not fitting in the memory budget,
+   * are freed instead.
+   *
+   * @param buffer The buffer to recycle
+   */
+  void release(Buffer && buffer);
+
+  /**
+   * Frees every idle buffer, giving their charge back to the memory governor
+   */
+  void trim();
+
+  /**
+   * Gets the minimum capacity of the buffers handed out by the pool
+   */
+  std::size_t getBufferCapacity() const;
+
+  /**
+   * Gets the number of idle buffers in the pool
+   */
+  std::size_t getIdleBuffers() const;
+
+}; // class BufferPool
+
+} // namespace autocomp
+
+#endif // AC_BUFFER_POOL_HPP
@@ -0,0 +1,127 @@
+/**
+ *  AutoComp Byte Histogram
+ *  byte_histogram.hpp
+ *
+ *  Declaration of class ByteHistogram, which counts the bytes of the data
+ *  and derives the features the compressors are chosen from.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_BYTE_HISTOGRAM_HPP
+#define AC_BYTE_HISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Features of the byte distribution of some data
+ */
+struct ByteFeatures
+{
+  int bytecount;              //!< Bytes occurring at least 1/256 of the time
+  double entropy;             //!< Order 0 entropy, in bits per byte
+  double zeroRatio;           //!< Share of the bytes that are 0
+  double meanRunLength;       //!< Mean length of the runs of a same byte
+};
+
+/**
+ * Histogram of the bytes of some data.
+ *
+ * The bytes are counted into several lanes of counters, each byte of a
+ * group going to a different lane, so that runs of a same byte do not make
+ * every increment wait on the one before. The runs are counted in the same
+ * pass with SIMD comparisons of the data against itself shifted by a byte,
+ * with AVX2 or SSE2, whichever the CPU supports.
+ *
+ * The data can be added in pieces, as it is read, and the features are the
+ * same as if it was added at once. Each histogram counts its own data, so
+ * there may be one per thread.
+ *
+ * Zeroing the 6 KB of counters costs as much as counting a few KB, so for
+ * small data a histogram is better cleared and reused than made anew, and
+ * clear() only zeroes the counters that may hold counts.
+ */
+class ByteHistogram
+{
+public:
+
+  static const std::size_t N_LANES = 4;
+
+  using Lanes = std::array<std::array<std::uint32_t, 256>, N_LANES>;
+
+private:
+
+  Lanes lanes;
+
+  /**
+   * Bytes counted into the lanes since they were folded into the counts
+   */
+  std::size_t laneSize;
+
+  std::array<std::size_t, 256> counts;
+
+  std::size_t size;
+  std::size_t nRuns;
+
+  /**
+   * Last byte added, or -1 if none
+   */
+  int lastByte;
+
+public:
+
+  ByteHistogram();
+
+  /**
+   * Counts the given data after the one already added
+   */
+  void update(const unsigned char * data, const std::size_t & dataSize);
+
+  void update(const char * data, const std::size_t & dataSize);
+
+  /**
+   * Forgets the data added
+   */
+  void clear();
+
+  std::size_t getSize() const;
+
+  /**
+   * Gets the times a byte occurred
+   */
+  std::size_t getCount(const unsigned char & byte) const;
+
+  ByteFeatures getFeatures() const;
+
+  /**
+   * Gets the features of a chunk as the compressors sample it: the average
+   * of those of three subchunks of a tenth of its size, at 10%, 45% and 80%
+   * of it, the bytecount rounded
+   */
+  static ByteFeatures getSampledFeatures(const char * data,
+                                         const std::size_t & dataSize);
+
+  /**
+   * Gets the name of the kernel the bytes are counted with on this CPU
+   */
+  static const char * getKernelName();
+
+private:
+
+  /**
+   * Adds the lanes to the counts and clears them, before their counters
+   * may overflow
+   */
+  void foldLanes();
+
+}; // class ByteHistogram
+
+} // namespace autocomp
+
+#endif // AC_BYTE_HISTOGRAM_HPP
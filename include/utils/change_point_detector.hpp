@@ -0,0 +1,72 @@
+/**
+ *  AutoComp Change-Point Detector
+ *  change_point_detector.hpp
+ *
+ *  Declaration of class ChangePointDetector, which tells when the mean of a
+ *  stream of observations shifts.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_CHANGE_POINT_DETECTOR_HPP
+#define AC_CHANGE_POINT_DETECTOR_HPP
+
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Two sided CUSUM detector.
+ *
+ * The reference is the mean of the observations since the last reset. Each
+ * observation adds how far it is above the reference, less the drift, to the
+ * upper sum, and how far it is below it, less the drift, to the lower one.
+ * Neither sum goes below 0, so deviations within the drift are forgotten,
+ * while a shift larger than the drift makes one of them grow until it
+ * crosses the threshold.
+ */
+class ChangePointDetector
+{
+  double drift;
+  double threshold;
+
+  double reference;
+  std::size_t nObservations;
+  double upperSum;
+  double lowerSum;
+
+public:
+
+  /**
+   * ChangePointDetector constructor
+   *
+   * @param drift Deviation from the reference taken for noise, at least 0
+   * @param threshold Sum of deviations taken for a change, greater than 0
+   * @throws std::domain_error If the drift or the threshold are out of range
+   */
+  ChangePointDetector(const double & drift, const double & threshold);
+
+  /**
+   * Adds an observation
+   *
+   * @returns Whether either sum is above the threshold
+   */
+  bool update(const double & observation);
+
+  /**
+   * Gets the mean of the observations since the last reset
+   */
+  double getReference() const;
+
+  /**
+   * Forgets every observation, so the next one starts a new reference
+   */
+  void reset();
+
+}; // class ChangePointDetector
+
+} // namespace autocomp
+
+#endif // AC_CHANGE_POINT_DETECTOR_HPP
@@ -0,0 +1,123 @@
+/**
+ *  AutoComp Classification Model
+ *  classification_model.hpp
+ *
+ *  Declaration of the interface of the models AutoComp chooses its
+ *  compressors with.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_CLASSIFICATION_MODEL_HPP
+#define AC_CLASSIFICATION_MODEL_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+#include "messaging/compressor.pb.h"
+
+namespace autocomp {
+
+/**
+ * Model that classifies points of integer features into compressors
+ */
+class ClassificationModel
+{
+protected:
+
+  /**
+   * Compressor and level of each label
+   */
+  std::vector<std::pair<Compressor, int>> compressors;
+
+  unsigned int nFeatures;
+
+public:
+
+  ClassificationModel()
+    : nFeatures(0)
+  {}
+
+  ClassificationModel(const ClassificationModel &) = delete;
+  ClassificationModel(ClassificationModel &&) = delete;
+  ClassificationModel & operator=(const ClassificationModel &) = delete;
+  ClassificationModel & operator=(ClassificationModel &&) = delete;
+
+  virtual ~ClassificationModel() = default;
+
+  /**
+   * Loads a model of whichever type the file holds: an ensemble, or a
+   * decision tree in the text or the binary format
+   *
+   * @throws exceptions::IOError If the file is missing or is not a valid
+   *                             model
+   */
+  static std::unique_ptr<ClassificationModel> load(
+      const std::string & filename
+    );
+
+  /**
+   * Classifies a point
+   *
+   * @throws std::invalid_argument If the point does not have one value per
+   *                               feature
+   */
+  std::pair<Compressor, int> classify(const std::vector<int> & point) const
+  {
+    this->checkDimensionality(point.size());
+
+    return this->compressors[this->classifyPoint(point.data())];
+  }
+
+  /**
+   * Classifies a point of a known number of features, without allocating it
+   *
+   * @throws std::invalid_argument If the point does not have one value per
+   *                               feature
+   */
+  template<std::size_t N>
+  std::pair<Compressor, int> classify(const std::array<int, N> & point) const
+  {
+    this->checkDimensionality(N);
+
+    return this->compressors[this->classifyPoint(point.data())];
+  }
+
+  unsigned int getFeatureCount() const
+  {
+    return this->nFeatures;
+  }
+
+protected:
+
+  /**
+   * Gets the label of a point, which has one value per feature
+   */
+  virtual int classifyPoint(const int * point) const = 0;
+
+  /**
+   * Parses labels such as zlib_6 or snappy into the compressors
+   */
+  bool parseCompressors(const std::vector<std::string> & compressorLabels);
+
+  void checkDimensionality(const std::size_t & dimensionality) const
+  {
+    if (dimensionality != this->nFeatures) {
+      throw std::invalid_argument("Invalid point dimensionality. Shape of " +
+                                  std::to_string(dimensionality) +
+                                  " was given but must be " +
+                                  std::to_string(this->nFeatures));
+    }
+  }
+
+}; // class ClassificationModel
+
+} // namespace autocomp
+
+#endif // AC_CLASSIFICATION_MODEL_HPP
@@ -0,0 +1,139 @@
+/**
+ *  AutoComp Codec Calibration
+ *  codec_calibration.hpp
+ *
+ *  Declaration of class CodecCalibration, which predicts the compression
+ *  rate and ratio of the codecs on this host.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_CODEC_CALIBRATION_HPP
+#define AC_CODEC_CALIBRATION_HPP
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <utility>
+#include <ostream>
+#include <cstddef>
+
+#include "messaging/compressor.pb.h"
+#include "utils/constants.hpp"
+#include "utils/data_structures.hpp"
+
+namespace autocomp {
+
+/**
+ * Predicted performance of a codec on a chunk
+ */
+struct CodecPrediction
+{
+  double compressionRate;           //!< Mbits/s of original data, on a core
+  double compressionRatio;
+};
+
+/**
+ * Table of the performance of each codec on this host, learned from the
+ * chunks it compresses.
+ *
+ * The compression rate of a codec is the exponential moving average of the
+ * rates it compressed at. Its compression ratio is predicted from the order 0
+ * entropy of the chunk: the ratio an entropy coder would get, 8 bits over the
+ * entropy, times a factor the codec learned for chunks of about the same
+ * entropy, which LZ codecs push above 1 on redundant data.
+ *
+ * A calibration is shared by the sessions of the server and is thread safe.
+ */
+class CodecCalibration
+{
+public:
+
+  // Codec => Pair<Compressor, Level>
+  using Codec = std::pair<Compressor, int>;
+
+  /**
+   * Ratio factors are learned for chunks whose entropy is within each bit
+   */
+  static const std::size_t N_ENTROPY_BUCKETS = 8;
+
+private:
+
+  struct CodecState
+  {
+    double compressionRate;
+    std::array<double, N_ENTROPY_BUCKETS> ratioFactors;
+    std::array<bool, N_ENTROPY_BUCKETS> observedBuckets;
+    std::size_t nObservations;
+  };
+
+  std::map<Codec, CodecState> codecs;
+
+  const double smoothingFactor;
+
+  mutable std::mutex mutex;
+
+public:
+
+  /**
+   * CodecCalibration constructor
+   *
+   * @param smoothingFactor Weight of the newest chunk in the averages
+   */
+  explicit CodecCalibration(const double & smoothingFactor =
+                              constants::CALIBRATION_SMOOTHING_FACTOR);
+
+  CodecCalibration(const CodecCalibration &) = delete;
+  CodecCalibration(CodecCalibration &&) = delete;
+  CodecCalibration & operator=(const CodecCalibration &) = delete;
+  CodecCalibration & operator=(CodecCalibration &&) = delete;
+
+  /**
+   * Records how a codec compressed a chunk. Until chunks of every entropy
+   * are seen, the others stand for them
+   *
+   * @param codec Codec the chunk was compressed with
+   * @param performanceData Its sizes and compression time
+   * @param entropy Entropy of the chunk, in bits per byte
+   */
+  void record(const Codec & codec,
+              const CompressionPerformanceData & performanceData,
+              const double & entropy);
+
+  /**
+   * Predicts how a codec would compress a chunk
+   *
+   * @param entropy Entropy of the chunk, in bits per byte
+   *
+   * @returns A compression rate of 0 if nothing was recorded for the codec
+   */
+  CodecPrediction predict(const Codec & codec, const double & entropy) const;
+
+  /**
+   * Whether something was recorded for the codec
+   */
+  bool isCalibrated(const Codec & codec) const;
+
+  friend std::ostream & operator<<(std::ostream & stream,
+                                   const CodecCalibration & calibration);
+
+private:
+
+  static double getRatioFactor(const CodecState & codecState,
+                               const std::size_t & bucket);
+
+  static std::size_t getEntropyBucket(const double & entropy);
+
+}; // class CodecCalibration
+
+/**
+ * Prints the compression rate and mean ratio factor of each codec
+ */
+std::ostream & operator<<(std::ostream & stream,
+                          const CodecCalibration & calibration);
+
+} // namespace autocomp
+
+#endif // AC_CODEC_CALIBRATION_HPP
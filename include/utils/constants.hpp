@@ -34,6 +34,87 @@ namespace autocomp
 
     const unsigned short DEFAULT_SERVER_PORT = 25111;
 
+    const std::size_t CLIENT_READ_AHEAD_SIZE = 64 * 1024;
+
+    // Chunks received and waiting to be decompressed, after which the client
+    // stops reading from the socket
+    const std::size_t CLIENT_DECOMPRESSION_QUEUE_SIZE = 256;
+
+    // Default limits of a session's transmission queue. Once reached, the
+    // file reader waits for the transmission thread to catch up
+    const std::size_t TRANSMISSION_QUEUE_MAX_BYTES = 32 * 1024 * 1024;
+    const std::size_t TRANSMISSION_QUEUE_MAX_FRAMES = 256;
+
+    // Default admission limits of the server: up to MAX_SESSIONS sessions
+    // run at once, and requests waiting for one of them to end wait in a
+    // queue of MAX_QUEUED_SESSIONS entries, for at most MAX_QUEUE_WAIT_TIME
+    // milliseconds, before being refused
+    const std::size_t MAX_SESSIONS = 1024;
+    const std::size_t MAX_QUEUED_SESSIONS = 64;
+    const unsigned int MAX_QUEUE_WAIT_TIME = 5000;
+
+    // Default memory budget of the server, in bytes, for the chunks waiting
+    // to be sent by every session and the working memory of the codecs
+    const std::size_t MEMORY_BUDGET = 1024 * 1024 * 1024;
+
+    // Sessions run in slices of about SCHEDULER_QUANTUM milliseconds, and
+    // each scheduling round gives a session that much CPU time per unit of
+    // weight, up to MAX_SESSION_WEIGHT. Rate capped sessions can get up to
+    // RATE_CAP_BURST milliseconds of their rate ahead
+    const unsigned int SCHEDULER_QUANTUM = 5;
+    const unsigned int MAX_SESSION_WEIGHT = 64;
+    const unsigned int RATE_CAP_BURST = 100;
+
+    // The compression CPU demand of each session is an exponential moving
+    // average, with this weight for the newest chunk, of the CPU time of its
+    // chunks over the time between them
+    const float CPU_DEMAND_SMOOTHING_FACTOR = 0.25;
+
+    // The FEEDBACK mode keeps the occupancy of the transmission queue and the
+    // send buffer, in percent, at this setpoint unless the request sets
+    // another. Its PI controller moves FEEDBACK_PROPORTIONAL_GAIN rungs up
+    // its ladder of compressors per unit of occupancy error, plus
+    // FEEDBACK_INTEGRAL_GAIN rungs per chunk and unit of error. It changes
+    // rungs once its output is FEEDBACK_HYSTERESIS past the midpoint between
+    // them
+    const unsigned int FEEDBACK_SETPOINT = 50;
+    const double FEEDBACK_PROPORTIONAL_GAIN = 2;
+    const double FEEDBACK_INTEGRAL_GAIN = 0.25;
+    const double FEEDBACK_HYSTERESIS = 0.25;
+
+    // Threads of the server reactor, which sends the data of every session
+    const unsigned int REACTOR_THREADS = 2;
+
+    // Events a reactor thread handles per epoll_wait() call
+    const int REACTOR_MAX_EVENTS = 256;
+
+    // Largest request the server reads
+    const std::size_t MAX_REQUEST_SIZE = 64 * 1024;
+
+    // Each connection estimates its bandwidth from TCP_INFO at most every
+    // BANDWIDTH_SAMPLING_INTERVAL milliseconds, as an exponential moving
+    // average with this weight for the newest sample
+    const unsigned int BANDWIDTH_SAMPLING_INTERVAL = 20;
+    const float BANDWIDTH_SMOOTHING_FACTOR = 0.25;
+
+    // Longest time, in milliseconds, a connection waits for its zero copy
+    // sends while the send queue does not drain at all. A slow link that
+    // keeps draining is waited for however long it takes
+    const int ZERO_COPY_STALL_TIMEOUT = 5000;
+
+    // Connections the kernel keeps waiting for accept() on each listening
+    // socket of the server
+    const int SERVER_SOCKET_BACKLOG = 1024;
+
+    // Most server shards (worker processes) sharing a port, and how often,
+    // in milliseconds, each publishes its state for the others to see
+    const std::size_t MAX_SHARDS = 64;
+    const int SHARD_STATE_PUBLISH_INTERVAL = 500;
+
+    // Version 1: chunks are sent as a ChunkHeader message and a payload
+    // Version 2: chunks are sent with a fixed size ChunkFrameHeader
+    const unsigned int PROTOCOL_VERSION = 2;
+
     // Script paths
 
     const std::string ZLIB_SCRIPT("./scripts/zlib.sh");
@@ -62,6 +143,101 @@ namespace autocomp
 
     const std::string DECISION_TREE_FILENAME("./models/decision_tree.txt");
 
+    // Compiled with autocomp_model_compiler, loaded instead of the text model
+    // if it exists and is not older than it
+    const std::string DECISION_TREE_BINARY_FILENAME(
+      "./models/decision_tree.bin"
+    );
+
+    // Exported by export_ensemble.py, loaded instead of the decision tree if
+    // it exists
+    const std::string ENSEMBLE_MODEL_FILENAME("./models/ensemble.txt");
+
+    // Most labels an ensemble model can vote for, and trees it evaluates
+    // together in each batch
+    const std::size_t ENSEMBLE_MAX_CLASSES = 64;
+    const std::size_t ENSEMBLE_BATCH_SIZE = 8;
+
+    // Most points of the dense table a decision tree is compiled into, one
+    // byte each. Larger trees are walked instead
+    const std::size_t DECISION_TREE_MAX_TABLE_SIZE = 4 * 1024 * 1024;
+
+    // What the contextual bandit of the BANDIT mode learned, loaded at start
+    // and saved at shutdown
+    const std::string BANDIT_MODEL_FILENAME("./models/bandit.txt");
+
+    // The reward of a chunk is its effective transmission rate over the
+    // bandwidth, 1 for copying it. Every compressor starts with this reward
+    // as a single observation, and the one the decision tree chooses, if the
+    // bandit is warm started, with the bonus on top
+    const double BANDIT_PRIOR_REWARD = 1;
+    const double BANDIT_WARM_START_BONUS = 0.5;
+
+    // Deviation of the rewards until a compressor has two observations, and
+    // the least deviation Thompson sampling uses
+    const double BANDIT_PRIOR_DEVIATION = 0.5;
+    const double BANDIT_MIN_DEVIATION = 0.05;
+
+    // Observations each compressor remembers per context. Older ones fade, so
+    // the bandit follows changes of the data and the links
+    const double BANDIT_MAX_OBSERVATIONS = 64;
+
+    // Most chunks of a session compressed with a compressor other than the
+    // best known one
+    const float BANDIT_MAX_EXPLORATION = 0.1;
+
+    // The ANALYTIC mode calibrates the codecs at start on a sample of this
+    // size, in chunks of CALIBRATION_CHUNK_SIZE, and then follows the
+    // compression rates and ratios of the chunks it compresses with an
+    // exponential moving average, with this weight for the newest chunk
+    const std::size_t CALIBRATION_SAMPLE_SIZE = 128 * 1024;
+    const std::size_t CALIBRATION_CHUNK_SIZE = 64 * 1024;
+    const double CALIBRATION_SMOOTHING_FACTOR = 0.2;
+
+    // Least share of a core the ANALYTIC mode expects to compress with, even
+    // if the CPU is busy
+    const float CALIBRATION_MIN_CPU_SHARE = 0.1;
+
+    // The compressibility probe compresses three samples of this size of a
+    // chunk, and its result holds for a window of this many bytes. Data
+    // whose samples compress less than PROBE_MIN_RATIO is incompressible
+    const std::size_t PROBE_SAMPLE_SIZE = 4 * 1024;
+    const long PROBE_WINDOW = 512 * 1024;
+    const float PROBE_MIN_RATIO = 1.1;
+
+    // Bytes at the start of a file its format is told from
+    const std::size_t FILE_SIGNATURE_SIZE = 16;
+
+    // Chunks are taken for IEEE-754 doubles from this many of their 8 byte
+    // words, if most of them have a normal exponent, the exponents cluster
+    // around a few values and the top byte, sign and exponent, is this many
+    // bits less random than each of the four low bytes of the mantissa
+    const std::size_t FP_SAMPLE_WORDS = 2048;
+    const double FP_MIN_NORMAL_SHARE = 0.9;
+    const double FP_MIN_EXPONENT_CONCENTRATION = 0.9;
+    const double FP_MIN_ENTROPY_GAP = 3;
+
+    // FPC predicts doubles with tables of 2^FPC_FAST_LEVEL entries if the
+    // last value and stride predictors already hit at least FPC_MIN_HIT_RATE
+    // of them, and of 2^FPC_STRONG_LEVEL entries otherwise, which remember
+    // values further back
+    const int FPC_FAST_LEVEL = 10;
+    const int FPC_STRONG_LEVEL = 16;
+    const double FPC_MIN_HIT_RATE = 0.5;
+
+    // AutoComp takes the measure of the data again, bytecounting, probe and
+    // floating-point detector, when a CUSUM detects a shift in the entropy
+    // of its chunks or in the share of them left after compression, but no
+    // sooner than REEVALUATION_MIN_BYTES after the last time, and anyway
+    // after REEVALUATION_MAX_BYTES. Drifts and thresholds are in bits per
+    // byte for the entropy and in shares of the chunk for the compression
+    const long REEVALUATION_MIN_BYTES = 64 * 1024;
+    const long REEVALUATION_MAX_BYTES = 4 * 1024 * 1024;
+    const double CUSUM_ENTROPY_DRIFT = 0.25;
+    const double CUSUM_ENTROPY_THRESHOLD = 2;
+    const double CUSUM_COMPRESSION_DRIFT = 0.05;
+    const double CUSUM_COMPRESSION_THRESHOLD = 0.5;
+
   } // namespace constants
 } // namespace autocomp
 
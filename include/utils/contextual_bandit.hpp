@@ -0,0 +1,177 @@
+/**
+ *  AutoComp Contextual Bandit
+ *  contextual_bandit.hpp
+ *
+ *  Declaration of class ContextualBandit, which learns online which
+ *  compressor transmits faster in each resource state.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_CONTEXTUAL_BANDIT_HPP
+#define AC_CONTEXTUAL_BANDIT_HPP
+
+#include <array>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include "messaging/compressor.pb.h"
+#include "utils/classification_model.hpp"
+
+namespace autocomp {
+
+/**
+ * What the bandit has learned and how much it explored
+ */
+struct BanditStats
+{
+  std::size_t nContexts;            //!< Contexts seen, or loaded
+  std::size_t nChoices;
+  std::size_t nExplorations;        //!< Choices other than the best known one
+  std::size_t nObservations;        //!< Rewards recorded since the start
+};
+
+/**
+ * Contextual bandit with a compressor and level per arm, and the discretised
+ * CPU load, bandwidth and bytecounting, as the decision tree sees them, as
+ * context.
+ *
+ * The reward of a chunk is its effective transmission rate over the
+ * bandwidth. Each arm keeps the mean and variance of its rewards in each
+ * context, over a sliding number of observations, and arms are chosen by
+ * Thompson sampling: the one whose sample of the posterior of its mean is
+ * the highest. Unseen contexts start with the same prior for every arm,
+ * except, if the bandit is warm started, for the arm the decision tree
+ * chooses, which starts ahead.
+ *
+ * A bandit is shared by the sessions of the server and is thread safe.
+ */
+class ContextualBandit
+{
+public:
+
+  using Arm = std::pair<Compressor, int>;
+  using Context = std::array<int, 3>;
+
+  struct Choice
+  {
+    Arm arm;
+    bool exploratory;               //!< Whether it is not the best known arm
+  };
+
+private:
+
+  struct ArmState
+  {
+    double nObservations;           //!< Including the prior
+    double meanReward;
+    double squaredDeviations;       //!< Sum of, as in Welford's algorithm
+  };
+
+  const std::vector<Arm> arms;
+
+  /**
+   * State of every arm, in the order of the arms, by packed context
+   */
+  std::unordered_map<std::uint64_t, std::vector<ArmState>> contexts;
+
+  const ClassificationModel * warmStartModel;
+
+  BanditStats stats;
+
+  mutable std::mutex mutex;
+
+public:
+
+  /**
+   * ContextualBandit constructor
+   *
+   * @param arms Compressors and levels to choose from. Empty for the default
+   *             ones: copy, snappy, a few levels of lzo, zlib, bzip2 and
+   *             lzma, and fpc at the levels doubles are compressed with
+   */
+  explicit ContextualBandit(const std::vector<Arm> & arms = {});
+
+  ContextualBandit(const ContextualBandit &) = delete;
+  ContextualBandit(ContextualBandit &&) = delete;
+  ContextualBandit & operator=(const ContextualBandit &) = delete;
+  ContextualBandit & operator=(ContextualBandit &&) = delete;
+
+  /**
+   * Sets the model whose choice the contexts not seen yet favour. Models
+   * that take other features than the context are ignored
+   *
+   * @param warmStartModel The model, or nullptr to start every arm alike
+   */
+  void setWarmStartModel(const ClassificationModel * warmStartModel);
+
+  /**
+   * Chooses the arm for a chunk
+   *
+   * @param context CPU load, bandwidth and bytecounting levels
+   * @param generator Random generator of the caller
+   * @param explore Whether an arm other than the best known one may be
+   *                chosen
+   */
+  Choice choose(const Context & context, std::mt19937 & generator,
+                const bool & explore);
+
+  /**
+   * Records the reward of an arm, which is ignored if it is not one of the
+   * arms of the bandit
+   */
+  void record(const Context & context, const Arm & arm, const double & reward);
+
+  /**
+   * Gets the mean reward learned for an arm in a context, the prior if
+   * nothing was learned
+   */
+  double getMeanReward(const Context & context, const Arm & arm) const;
+
+  const std::vector<Arm> & getArms() const;
+
+  BanditStats getStats() const;
+
+  /**
+   * Replaces what was learned with the contents of a file written by save().
+   * Arms the bandit does not have are skipped
+   *
+   * @returns false if the file does not exist
+   *
+   * @throws exceptions::IOError If the file is not a valid bandit
+   */
+  bool load(const std::string & filename);
+
+  /**
+   * Writes what was learned, replacing the file at once
+   *
+   * @throws exceptions::IOError If the file can not be written
+   */
+  void save(const std::string & filename) const;
+
+private:
+
+  std::vector<ArmState> & getArmStates(const Context & context);
+
+  int findArm(const Arm & arm) const;
+
+  static std::uint64_t pack(const Context & context);
+
+  static Context unpack(const std::uint64_t & key);
+
+}; // class ContextualBandit
+
+std::ostream & operator<<(std::ostream & stream, const BanditStats & stats);
+
+} // namespace autocomp
+
+#endif // AC_CONTEXTUAL_BANDIT_HPP
@@ -0,0 +1,158 @@
+/**
+ *  AutoComp CPU Budget
+ *  cpu_budget.hpp
+ *
+ *  Declaration of class CPUBudget, which keeps the account of the CPU time
+ *  the sessions of the server commit to compression.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_CPU_BUDGET_HPP
+#define AC_CPU_BUDGET_HPP
+
+#include <mutex>
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Compression CPU demand of the server, as seen by the budget
+ */
+struct CPUBudgetStats
+{
+  unsigned int nCores;              //!< Cores the server can run on
+  std::size_t nCommitments;         //!< Sessions compressing right now
+  double committedCores;            //!< Cores their codecs keep busy
+  double peakCommittedCores;
+};
+
+/**
+ * Account of the cores the codecs of the server keep busy.
+ *
+ * The CPU load of the system can not tell the sessions of the server apart
+ * from other processes, and it is only sampled every so often: sessions
+ * starting together all see an idle CPU, all pick heavy codecs and overload
+ * it together. Instead, each session holds a commitment with the cores its
+ * codec uses, measured as the CPU time of each chunk over the time between
+ * chunks, and chooses from the headroom that the other sessions and the
+ * other processes leave.
+ */
+class CPUBudget
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * CPU demand of a session, accounted for as long as the object lives
+   */
+  class Commitment
+  {
+    CPUBudget * cpuBudget;
+    double cores;
+    bool measured;
+    Clock::time_point lastRecord;
+
+  public:
+
+    explicit Commitment(CPUBudget * cpuBudget = nullptr);
+
+    Commitment(const Commitment &) = delete;
+    Commitment & operator=(const Commitment &) = delete;
+
+    Commitment(Commitment && other);
+    Commitment & operator=(Commitment && other);
+
+    ~Commitment();
+
+    /**
+     * Records the CPU time the session took to compress a chunk
+     *
+     * @param cpuTime CPU time of the calling thread
+     */
+    void record(const std::chrono::nanoseconds & cpuTime);
+
+    /**
+     * Gets the smoothed demand of the session, in cores
+     */
+    double getCores() const;
+
+    /**
+     * Whether the demand is accounted by a budget
+     */
+    explicit operator bool() const;
+  };
+
+private:
+
+  mutable std::mutex mutex;
+
+  CPUBudgetStats stats;
+
+public:
+
+  /**
+   * CPUBudget constructor
+   *
+   * @param nCores Cores the server can run on. 0 means the CPUs the process
+   *               is allowed to run on
+   */
+  explicit CPUBudget(const unsigned int & nCores = 0);
+
+  CPUBudget(const CPUBudget &) = delete;
+  CPUBudget(CPUBudget &&) = delete;
+  CPUBudget & operator=(const CPUBudget &) = delete;
+  CPUBudget & operator=(CPUBudget &&) = delete;
+
+  void setCores(const unsigned int & nCores);
+
+  unsigned int getCores() const;
+
+  /**
+   * Starts accounting the demand of a session, none until it records some
+   */
+  Commitment commit();
+
+  /**
+   * Gets the cores available to a session: those that neither the other
+   * sessions nor the other processes use
+   *
+   * @param commitment Demand of the session
+   * @param cpuLoad Load of the whole system, in [0, 1]
+   */
+  double getHeadroom(const Commitment & commitment, const float & cpuLoad)
+    const;
+
+  /**
+   * Gets the CPU load a session should choose its codec with: the load of
+   * the system as if its headroom were the idle CPU
+   *
+   * @param commitment Demand of the session
+   * @param cpuLoad Load of the whole system, in [0, 1]
+   * @returns A load in [0, 1]
+   */
+  float getLoad(const Commitment & commitment, const float & cpuLoad) const;
+
+  CPUBudgetStats getStats() const;
+
+private:
+
+  /**
+   * Replaces the demand of a commitment in the account
+   */
+  void update(const double & previousCores, const double & cores);
+
+  void withdraw(const double & cores);
+
+}; // class CPUBudget
+
+std::ostream & operator<<(std::ostream & stream, const CPUBudgetStats & stats);
+
+} // namespace autocomp
+
+#endif // AC_CPU_BUDGET_HPP
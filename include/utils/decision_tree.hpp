@@ -13,16 +13,28 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #include "messaging/compressor.pb.h"
 #include "utils/exceptions.hpp"
+#include "utils/classification_model.hpp"
 
 namespace autocomp {
 
-
-class DecisionTree
+/**
+ * Decision tree on integer features, which AutoComp chooses its compressors
+ * with.
+ *
+ * The tree is loaded either from the text file the training scripts write,
+ * or from the binary model save() writes, which is mapped in place. Once
+ * loaded it is flattened, so that the children of a node are next to each
+ * other, and, if the feature space is small enough, compiled into a dense
+ * table with the label of every point: classifying is then a single lookup.
+ */
+class DecisionTree : public ClassificationModel
 {
   struct Node
   {
@@ -33,22 +45,102 @@ class DecisionTree
     int value;
   };
 
-  std::vector<Node> nodes;
+  // <--- Flattened tree ---> //
+
+  std::vector<int> features;          //!< -1 on the leaves
+  std::vector<float> thresholds;
+  std::vector<int> children;          //!< Left child, the right one is next.
+                                      //!< Label on the leaves
+
+  // <--- Dense table ---> //
+
+  /**
+   * Range of each feature in the table. Values out of it are classified as
+   * the closest bound, since the tree does not tell them apart
+   */
+  std::vector<int> lowerBounds;
+  std::vector<int> upperBounds;
+  std::vector<std::size_t> strides;
 
-  std::vector<std::pair<Compressor, int>> compressors;
+  /**
+   * Label of every point of the table, nullptr if there is no table. It is
+   * either tableData or part of the mapped binary model
+   */
+  const std::uint8_t * table;
+  std::size_t tableSize;
+  std::vector<std::uint8_t> tableData;
 
-  unsigned int nFeatures;
+  void * mapping;
+  std::size_t mappingSize;
 
 public:
 
-  DecisionTree(const std::string & filename);
+  /**
+   * DecisionTree constructor
+   *
+   * @param filename A text or binary model
+   *
+   * @throws exceptions::IOError If the file is missing or is not a valid
+   *                             decision tree
+   */
+  explicit DecisionTree(const std::string & filename);
 
   DecisionTree(const DecisionTree &) = delete;
   DecisionTree(DecisionTree &&) = delete;
   DecisionTree & operator=(const DecisionTree &) = delete;
   DecisionTree & operator=(DecisionTree &&) = delete;
 
-  std::pair<Compressor, int> classify(const std::vector<int> & point) const;
+  ~DecisionTree();
+
+  /**
+   * Whether the tree was compiled into a dense table
+   */
+  bool hasTable() const;
+
+  /**
+   * Writes the binary model, which loads without parsing
+   *
+   * @throws exceptions::IOError If the file can not be written
+   */
+  void save(const std::string & filename) const;
+
+protected:
+
+  int classifyPoint(const int * point) const override
+  {
+    return this->table ? this->lookUp(point) : this->walk(point);
+  }
+
+  /**
+   * Gets the label of a point from the flattened tree
+   */
+  int walk(const int * point) const
+  {
+    std::size_t node = 0;
+
+    while (this->features[node] >= 0) {
+      node = this->children[node] +
+             (point[this->features[node]] > this->thresholds[node]);
+    }
+
+    return this->children[node];
+  }
+
+  /**
+   * Gets the label of a point from the dense table
+   */
+  int lookUp(const int * point) const
+  {
+    std::size_t index = 0;
+
+    for (unsigned int i = 0; i < this->nFeatures; i++) {
+      int value = std::min(std::max(point[i], this->lowerBounds[i]),
+                           this->upperBounds[i]);
+      index += (value - this->lowerBounds[i]) * this->strides[i];
+    }
+
+    return this->table[index];
+  }
 
 private:
 
@@ -62,10 +154,28 @@ private:
     }
   }
 
-  bool parseCompressors(const std::vector<std::string> & compressor_labels);
+  void loadText(std::ifstream & input, const std::string & filename);
+
+  /**
+   * Maps a binary model, whose table is used in place
+   *
+   * @returns false if the file is not a binary model
+   */
+  bool loadBinary(const std::string & filename);
+
+  /**
+   * Lays out the nodes so that the children of a node are next to each other
+   */
+  void flatten(const std::vector<Node> & nodes);
+
+  /**
+   * Fills the dense table, unless it would be larger than
+   * constants::DECISION_TREE_MAX_TABLE_SIZE
+   */
+  void compileTable();
 
 }; // class DecisionTree
 
 } // namespace autocomp
 
-#endif // AC_DECISION_TREE_HPP
\ No newline at end of file
+#endif // AC_DECISION_TREE_HPP
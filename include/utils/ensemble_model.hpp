@@ -0,0 +1,123 @@
+/**
+ *  AutoComp Ensemble Model
+ *  ensemble_model.hpp
+ *
+ *  Declaration of class EnsembleModel, a forest or boosted trees that
+ *  AutoComp can choose its compressors with instead of a decision tree.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_ENSEMBLE_MODEL_HPP
+#define AC_ENSEMBLE_MODEL_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+#include "utils/classification_model.hpp"
+
+namespace autocomp {
+
+/**
+ * Ensemble of decision trees: a random forest, voting either for the label
+ * of each tree or with the label probabilities of its leaves, or gradient
+ * boosted trees, each of which adds a score to one label. The label with
+ * the highest score wins.
+ *
+ * The text format, as export_ensemble.py writes it:
+ *
+ *   kind                       forest_majority, forest_probability or boosted
+ *   nLabels
+ *   label...                   zlib_6, snappy, copy...
+ *   nFeatures
+ *   nTrees
+ *   initialScore...            One per label, boosted trees only
+ *   then, for each tree:
+ *   label nNodes               Label the tree scores, -1 in forests
+ *   leftChild rightChild feature threshold value...    nNodes lines
+ *
+ * The values of a node are its label in a majority vote forest, the
+ * probability of every label in a probability vote forest, and its score in
+ * boosted trees. Only those of the leaves are used.
+ *
+ * The nodes of every tree share one flattened array, in which the leaves
+ * loop onto themselves. A batch of trees is then walked in lockstep for as
+ * many steps as the deepest of them needs, with no branches besides the
+ * loops, so the compiler can vectorize it.
+ */
+class EnsembleModel : public ClassificationModel
+{
+public:
+
+  enum class Kind
+  {
+    MAJORITY_VOTE,
+    PROBABILITY_VOTE,
+    BOOSTED
+  };
+
+private:
+
+  Kind kind;
+
+  // <--- Nodes of every tree ---> //
+
+  std::vector<int> features;
+  std::vector<float> thresholds;      //!< Infinite on the leaves
+  std::vector<int> children;          //!< Left child, the right one is next.
+                                      //!< The leaf itself on the leaves
+  std::vector<int> leafValues;        //!< Offset of the values of the leaves
+
+  std::vector<float> values;
+
+  // <--- Trees ---> //
+
+  std::vector<int> roots;
+  std::vector<int> treeLabels;        //!< Label each boosted tree scores
+  std::vector<unsigned int> batchDepths; //!< Depth of the deepest tree of
+                                         //!< each batch
+
+  std::vector<float> initialScores;
+
+public:
+
+  /**
+   * EnsembleModel constructor
+   *
+   * @throws exceptions::IOError If the file is missing or is not a valid
+   *                             ensemble
+   */
+  explicit EnsembleModel(const std::string & filename);
+
+  /**
+   * Whether a word is the kind an ensemble file starts with
+   */
+  static bool isKind(const std::string & word);
+
+  Kind getKind() const;
+
+  std::size_t getTreeCount() const;
+
+protected:
+
+  int classifyPoint(const int * point) const override;
+
+private:
+
+  /**
+   * Reads a tree into the shared node array
+   *
+   * @returns The depth of the tree
+   */
+  unsigned int loadTree(std::ifstream & input, const std::size_t & nNodes);
+
+  void checkInputStream(const std::ios & stream, const std::string & a) const;
+
+}; // class EnsembleModel
+
+} // namespace autocomp
+
+#endif // AC_ENSEMBLE_MODEL_HPP
@@ -0,0 +1,87 @@
+/**
+ *  AutoComp Feedback Controller
+ *  feedback_controller.hpp
+ *
+ *  Declaration of class FeedbackController, a PI controller with discrete
+ *  output levels.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_FEEDBACK_CONTROLLER_HPP
+#define AC_FEEDBACK_CONTROLLER_HPP
+
+#include <cstddef>
+
+#include "utils/constants.hpp"
+
+namespace autocomp {
+
+/**
+ * Proportional-integral controller whose output is one of a number of
+ * levels.
+ *
+ * The output is the gain times the error, the measurement minus the
+ * setpoint, plus the integral of the error, in levels. The integral only
+ * builds up while the output is within the levels, or while the error
+ * brings it back, so it does not wind up while the controller is stuck at
+ * the first or the last level. The level changes once the output is past
+ * the midpoint to the next one by the hysteresis, so that noise around a
+ * midpoint does not make it flap.
+ */
+class FeedbackController
+{
+  std::size_t nLevels;
+  double setpoint;
+  double proportionalGain;
+  double integralGain;
+  double hysteresis;
+
+  double integral;
+  double output;
+  std::size_t level;
+
+public:
+
+  /**
+   * FeedbackController constructor
+   *
+   * @param nLevels Number of output levels
+   * @param setpoint Measurement to keep
+   * @param initialLevel Level to start at
+   *
+   * @throws std::domain_error If there are no levels or the initial level
+   *                           is not one of them
+   */
+  FeedbackController(const std::size_t & nLevels, const double & setpoint,
+                     const std::size_t & initialLevel,
+                     const double & proportionalGain =
+                       constants::FEEDBACK_PROPORTIONAL_GAIN,
+                     const double & integralGain =
+                       constants::FEEDBACK_INTEGRAL_GAIN,
+                     const double & hysteresis =
+                       constants::FEEDBACK_HYSTERESIS);
+
+  /**
+   * Feeds a measurement to the controller
+   *
+   * @returns The level to use until the next measurement
+   */
+  std::size_t update(const double & measurement);
+
+  std::size_t getLevel() const;
+
+  /**
+   * Gets the output before rounding it to a level
+   */
+  double getOutput() const;
+
+  double getSetpoint() const;
+
+}; // class FeedbackController
+
+} // namespace autocomp
+
+#endif // AC_FEEDBACK_CONTROLLER_HPP
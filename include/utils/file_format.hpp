@@ -0,0 +1,72 @@
+/**
+ *  AutoComp File Format
+ *  file_format.hpp
+ *
+ *  Declaration of the formats of the files the server tells apart by their
+ *  signatures.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_FILE_FORMAT_HPP
+#define AC_FILE_FORMAT_HPP
+
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Format of a file, as its first bytes tell
+ */
+enum class FileFormat
+{
+  UNKNOWN,
+
+  // Compressed files and archives
+  GZIP,
+  BZIP2,
+  XZ,
+  ZSTD,
+  LZ4,
+  ZIP,
+  SEVEN_ZIP,
+  RAR,
+
+  // Images, audio and video
+  JPEG,
+  PNG,
+  GIF,
+  WEBP,
+  MP4,
+  MATROSKA,
+  OGG,
+  FLAC,
+
+  // Columnar data
+  PARQUET
+};
+
+/**
+ * Tells the format of a file from its first bytes
+ *
+ * @param signature First bytes of the file, constants::FILE_SIGNATURE_SIZE
+ *                  or all of them if it is smaller
+ *
+ * @returns FileFormat::UNKNOWN if no format is recognized
+ */
+FileFormat sniffFileFormat(const char * signature,
+                           const std::size_t & signatureSize);
+
+/**
+ * Whether the files of a format are already compressed, so that
+ * compressing them again would spend CPU for nothing
+ */
+bool isCompressedFormat(const FileFormat & format);
+
+const char * getFileFormatName(const FileFormat & format);
+
+} // namespace autocomp
+
+#endif // AC_FILE_FORMAT_HPP
@@ -0,0 +1,56 @@
+/**
+ *  AutoComp Floating-Point Detector
+ *  floating_point_detector.hpp
+ *
+ *  Declaration of the functions that tell IEEE-754 double precision data
+ *  apart from the rest.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#ifndef AC_FLOATING_POINT_DETECTOR_HPP
+#define AC_FLOATING_POINT_DETECTOR_HPP
+
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Statistics of the 8 byte words of a chunk, read as little endian doubles
+ */
+struct FloatingPointFeatures
+{
+  double normalShare;               //!< Words with a normal exponent
+  double exponentConcentration;     //!< Normal ones in the 16 top exponents
+  double lowByteEntropy;            //!< Least of the four low bytes, in bits
+  double highByteEntropy;           //!< Of the top byte, in bits
+  double predictorHitRate;          //!< Words the last value or stride
+                                    //!< predict to within 6 bytes
+};
+
+/**
+ * Gets the statistics of up to constants::FP_SAMPLE_WORDS words from the
+ * middle of a chunk. Chunks whose size is not a multiple of 8 are not
+ * words, and get all statistics at 0
+ */
+FloatingPointFeatures getFloatingPointFeatures(const char * data,
+                                               const std::size_t & dataSize);
+
+/**
+ * Whether the statistics are those of doubles: mostly normal exponents,
+ * clustered around a few values, and a top byte far less random than the
+ * low bytes of the mantissa
+ */
+bool isFloatingPointData(const FloatingPointFeatures & features);
+
+/**
+ * Gets the level FPC should compress the doubles with, from how often the
+ * simple predictors hit
+ */
+int getFPCLevel(const FloatingPointFeatures & features);
+
+} // namespace autocomp
+
+#endif // AC_FLOATING_POINT_DETECTOR_HPP
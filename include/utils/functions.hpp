@@ -11,8 +11,13 @@
 #define AC_COMMON_FUNCTIONS_HPP
 
 #include <unistd.h>
+#include <ctime>
 #include <array>
-#include <strings.h>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "utils/byte_histogram.hpp"
 
 namespace autocomp
 {
@@ -20,30 +25,51 @@ namespace autocomp
 inline int bytecounting(const unsigned char * data,
                         const std::size_t & dataSize)
 {
-  const int nBytes = 256;
-  static std::array<std::size_t, nBytes> byteOccurrenceContainer;
-  std::size_t * byteOccurrences = byteOccurrenceContainer.data();
-  ::bzero(byteOccurrences, nBytes * sizeof(std::size_t));
+  ByteHistogram histogram;
+  histogram.update(data, dataSize);
 
-  for (int i = 0; i < dataSize; i++) {
-    byteOccurrences[data[i]]++;
-  }
+  return histogram.getFeatures().bytecount;
+}
 
-  std::size_t threshold = dataSize / nBytes;
-  int bytecount = 0;
+inline int bytecounting(const char * data, const std::size_t & dataSize)
+{
+  return bytecounting(reinterpret_cast<const unsigned char *>(data), dataSize);
+}
 
-  for (int i = 0; i < nBytes; i++) {
-    if (byteOccurrences[i] >= threshold) {
-      bytecount++;
-    }
-  }
+// Order 0 entropy of the data, in bits per byte
+inline double shannonEntropy(const unsigned char * data,
+                             const std::size_t & dataSize)
+{
+  ByteHistogram histogram;
+  histogram.update(data, dataSize);
 
-  return bytecount;
+  return histogram.getFeatures().entropy;
 }
 
-inline int bytecounting(const char * data, const std::size_t & dataSize)
+inline double shannonEntropy(const char * data, const std::size_t & dataSize)
 {
-  return bytecounting(reinterpret_cast<const unsigned char *>(data), dataSize);
+  return shannonEntropy(reinterpret_cast<const unsigned char *>(data),
+                        dataSize);
+}
+
+// Rate at which the original data gets through when it is compressed at
+// compressionRate, in Mbits/s of compressed data, and sent through the
+// available bandwidth
+inline float effectiveTransmissionRate(const float & availableBandwidth,
+                                       const float & compressionRate,
+                                       const float & compressionRatio)
+{
+  return std::min(availableBandwidth, compressionRate) * compressionRatio;
+}
+
+// CPU time used by the calling thread
+inline std::chrono::nanoseconds getThreadCPUTime()
+{
+  timespec time;
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+  return std::chrono::seconds(time.tv_sec) +
+         std::chrono::nanoseconds(time.tv_nsec);
 }
 
 } // namespace autocomp
@@ -0,0 +1,158 @@
+/**
+ *  AutoComp Memory Governor
+ *  memory_governor.hpp
+ *
+ *  Declaration of class MemoryGovernor, which bounds the memory the server
+ *  holds for the data in flight of every session.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_MEMORY_GOVERNOR_HPP
+#define AC_MEMORY_GOVERNOR_HPP
+
+#include <mutex>
+#include <ostream>
+#include <cstddef>
+
+namespace autocomp {
+
+/**
+ * Memory usage of the process, as seen by the governor
+ */
+struct MemoryStats
+{
+  std::size_t budget;               //!< Bytes that can be held, 0 if unbounded
+  std::size_t usedBytes;            //!< Bytes held right now
+  std::size_t peakUsedBytes;        //!< Most bytes ever held at once
+  std::size_t deniedReservations;   //!< Reservations that did not fit
+};
+
+/**
+ * Process wide budget of the memory held for the data in flight: the chunks
+ * waiting in the transmission queues and the working memory of the codecs
+ * compressing them.
+ *
+ * Nothing is allocated through the governor, it only keeps the account. The
+ * holders of the memory reserve it before taking it and release it once they
+ * are done, and back off when a reservation is denied: the producers of the
+ * sessions wait for their queues to drain, and the compressors fall back to
+ * codecs that need less memory.
+ */
+class MemoryGovernor
+{
+public:
+
+  /**
+   * Memory reserved for as long as the Reservation object lives
+   */
+  class Reservation
+  {
+    MemoryGovernor * memoryGovernor;
+    std::size_t bytes;
+
+  public:
+
+    explicit Reservation(MemoryGovernor * memoryGovernor = nullptr,
+                         const std::size_t & bytes = 0);
+
+    Reservation(const Reservation &) = delete;
+    Reservation & operator=(const Reservation &) = delete;
+
+    Reservation(Reservation && other);
+    Reservation & operator=(Reservation && other);
+
+    ~Reservation();
+
+    std::size_t getBytes() const;
+
+    /**
+     * Whether the memory was reserved
+     */
+    explicit operator bool() const;
+  };
+
+private:
+
+  mutable std::mutex mutex;
+
+  MemoryStats stats;
+
+public:
+
+  /**
+   * MemoryGovernor constructor
+   *
+   * @param budget Bytes that can be held at once. 0 means unbounded, in which
+   *               case the usage is still accounted
+   */
+  explicit MemoryGovernor(const std::size_t & budget);
+
+  MemoryGovernor(const MemoryGovernor &) = delete;
+  MemoryGovernor(MemoryGovernor &&) = delete;
+  MemoryGovernor & operator=(const MemoryGovernor &) = delete;
+  MemoryGovernor & operator=(MemoryGovernor &&) = delete;
+
+  void setBudget(const std::size_t & budget);
+
+  std::size_t getBudget() const;
+
+  /**
+   * Reserves memory if it fits in the budget
+   *
+   * @param bytes Bytes to reserve
+   * @returns false if the reservation was denied
+   */
+  bool tryReserve(const std::size_t & bytes);
+
+  /**
+   * Reserves memory even if it does not fit in the budget, for holders that
+   * can not back off without stalling
+   *
+   * @param bytes Bytes to reserve
+   */
+  void forceReserve(const std::size_t & bytes);
+
+  /**
+   * Reserves memory, if it fits in the budget, until the returned object is
+   * destroyed
+   *
+   * @param bytes Bytes to reserve
+   * @returns A reservation that evaluates to false if it was denied
+   */
+  Reservation tryAcquire(const std::size_t & bytes);
+
+  /**
+   * Reserves memory, even if it does not fit in the budget, until the
+   * returned object is destroyed
+   *
+   * @param bytes Bytes to reserve
+   */
+  Reservation acquire(const std::size_t & bytes);
+
+  /**
+   * Gives back reserved memory
+   *
+   * @param bytes Bytes to release
+   */
+  void release(const std::size_t & bytes);
+
+  /**
+   * Gets how much of the budget is in use
+   *
+   * @returns The used fraction of the budget, above 1 if it was exceeded, or 0
+   *          if the budget is unbounded
+   */
+  float getLoad() const;
+
+  MemoryStats getStats() const;
+
+}; // class MemoryGovernor
+
+std::ostream & operator<<(std::ostream & stream, const MemoryStats & stats);
+
+} // namespace autocomp
+
+#endif // AC_MEMORY_GOVERNOR_HPP
@@ -0,0 +1,230 @@
+/**
+ *  AutoComp MPMC Ring Buffer
+ *  mpmc_ring_buffer.hpp
+ *
+ *  Declaration and definition of class MpmcRingBuffer, a bounded lock-free
+ *  queue for any number of producers and consumers.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_MPMC_RING_BUFFER_HPP
+#define AC_MPMC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace autocomp {
+
+/**
+ * Bounded lock-free queue for any number of producer and consumer threads.
+ *
+ * Every slot carries a sequence number telling whether it is ready to be
+ * written or read in the current lap around the ring (D. Vyukov's bounded
+ * MPMC queue), so producers and consumers only contend on their own index.
+ *
+ * @tparam T type of entry stored in the ring. It must be default
+ *           constructible and move assignable
+ */
+template <typename T>
+class MpmcRingBuffer
+{
+  static const std::size_t cacheLineSize = 64;
+
+  struct Slot
+  {
+    std::atomic<std::size_t> sequence;
+    T entry;
+  };
+
+  const std::size_t capacity;
+  const std::size_t mask;
+  std::unique_ptr<Slot[]> slots;
+
+  alignas(cacheLineSize) std::atomic<std::size_t> head;  //!< Next to pop
+  alignas(cacheLineSize) std::atomic<std::size_t> tail;  //!< Next to push
+
+public:
+
+  /**
+   * MpmcRingBuffer constructor
+   *
+   * @param capacity Minimum number of entries the ring holds. It is rounded up
+   *                 to a power of two
+   */
+  explicit MpmcRingBuffer(const std::size_t & capacity)
+    : capacity(MpmcRingBuffer::roundUpToPowerOfTwo(capacity)),
+      mask(this->capacity - 1),
+      slots(new Slot[this->capacity]),
+      head(0),
+      tail(0)
+  {
+    for (std::size_t i = 0; i < this->capacity; i++) {
+      this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+  MpmcRingBuffer(MpmcRingBuffer &&) = delete;
+  MpmcRingBuffer & operator=(const MpmcRingBuffer &) = delete;
+  MpmcRingBuffer & operator=(MpmcRingBuffer &&) = delete;
+
+  std::size_t getCapacity() const
+  {
+    return this->capacity;
+  }
+
+  /**
+   * Gets the approximate number of entries in the ring
+   */
+  std::size_t getSize() const
+  {
+    const std::size_t currentHead = this->head.load(std::memory_order_acquire);
+    const std::size_t currentTail = this->tail.load(std::memory_order_acquire);
+
+    return currentTail > currentHead ? currentTail - currentHead : 0;
+  }
+
+  bool isEmpty() const
+  {
+    return this->getSize() == 0;
+  }
+
+  /**
+   * Enqueues an entry
+   *
+   * @param entry The entry to enqueue. It is left untouched if the ring is
+   *              full
+   *
+   * @returns false if the ring is full
+   */
+  bool tryPush(T && entry)
+  {
+    Slot * slot;
+    std::size_t position = this->tail.load(std::memory_order_relaxed);
+
+    while (true) {
+      slot = &this->slots[position & this->mask];
+      const std::size_t sequence =
+        slot->sequence.load(std::memory_order_acquire);
+      const std::intptr_t difference =
+        static_cast<std::intptr_t>(sequence) -
+        static_cast<std::intptr_t>(position);
+
+      if (difference == 0) {
+        if (this->tail.compare_exchange_weak(position, position + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      // The slot still holds an entry from the previous lap
+      else if (difference < 0) {
+        return false;
+      }
+      else {
+        position = this->tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->entry = std::move(entry);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Dequeues an entry
+   *
+   * @param entry Where the entry is moved to
+   *
+   * @returns false if the ring is empty
+   */
+  bool tryPop(T & entry)
+  {
+    Slot * slot;
+    std::size_t position = this->head.load(std::memory_order_relaxed);
+
+    while (true) {
+      slot = &this->slots[position & this->mask];
+      const std::size_t sequence =
+        slot->sequence.load(std::memory_order_acquire);
+      const std::intptr_t difference =
+        static_cast<std::intptr_t>(sequence) -
+        static_cast<std::intptr_t>(position + 1);
+
+      if (difference == 0) {
+        if (this->head.compare_exchange_weak(position, position + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      // The slot has not been written in this lap yet
+      else if (difference < 0) {
+        return false;
+      }
+      else {
+        position = this->head.load(std::memory_order_relaxed);
+      }
+    }
+
+    entry = std::move(slot->entry);
+    slot->sequence.store(position + this->mask + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Dequeues up to maxEntries entries
+   *
+   * @param output Output iterator the entries are moved to
+   * @param maxEntries Maximum number of entries to dequeue
+   *
+   * @returns The number of dequeued entries
+   */
+  template <typename OutputIterator>
+  std::size_t tryPopBatch(OutputIterator output, const std::size_t & maxEntries)
+  {
+    std::size_t nEntries = 0;
+    T entry;
+
+    while (nEntries < maxEntries and this->tryPop(entry)) {
+      *output++ = std::move(entry);
+      nEntries++;
+    }
+
+    return nEntries;
+  }
+
+  /**
+   * Empties the ring
+   */
+  void clear()
+  {
+    T entry;
+
+    while (this->tryPop(entry)) {}
+  }
+
+private:
+
+  static std::size_t roundUpToPowerOfTwo(const std::size_t & value)
+  {
+    std::size_t powerOfTwo = 2;
+
+    while (powerOfTwo < value) {
+      powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+  }
+
+}; // class MpmcRingBuffer
+
+} // namespace autocomp
+
+#endif // AC_MPMC_RING_BUFFER_HPP
@@ -0,0 +1,202 @@
+/**
+ *  AutoComp SPSC Ring Buffer
+ *  spsc_ring_buffer.hpp
+ *
+ *  Declaration and definition of class SpscRingBuffer, a bounded lock-free
+ *  queue for a single producer and a single consumer.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_SPSC_RING_BUFFER_HPP
+#define AC_SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace autocomp {
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Each side caches the index of the other one, so the shared indexes
+ * are only read when the cached one says the ring is full (or empty).
+ *
+ * @tparam T type of entry stored in the ring. It must be default
+ *           constructible and move assignable
+ */
+template <typename T>
+class SpscRingBuffer
+{
+  static const std::size_t cacheLineSize = 64;
+
+  const std::size_t capacity;
+  const std::size_t mask;
+  std::unique_ptr<T[]> entries;
+
+  alignas(cacheLineSize) std::atomic<std::size_t> head;  //!< Next to pop
+  std::size_t cachedTail;                                //!< Consumer's copy
+
+  alignas(cacheLineSize) std::atomic<std::size_t> tail;  //!< Next to push
+  std::size_t cachedHead;                                //!< Producer's copy
+
+public:
+
+  /**
+   * SpscRingBuffer constructor
+   *
+   * @param capacity Minimum number of entries the ring holds. It is rounded up
+   *                 to a power of two
+   */
+  explicit SpscRingBuffer(const std::size_t & capacity)
+    : capacity(SpscRingBuffer::roundUpToPowerOfTwo(capacity)),
+      mask(this->capacity - 1),
+      entries(new T[this->capacity]),
+      head(0),
+      cachedTail(0),
+      tail(0),
+      cachedHead(0)
+  {}
+
+  SpscRingBuffer(const SpscRingBuffer &) = delete;
+  SpscRingBuffer(SpscRingBuffer &&) = delete;
+  SpscRingBuffer & operator=(const SpscRingBuffer &) = delete;
+  SpscRingBuffer & operator=(SpscRingBuffer &&) = delete;
+
+  std::size_t getCapacity() const
+  {
+    return this->capacity;
+  }
+
+  /**
+   * Gets the number of entries in the ring. Exact only when called from the
+   * producer or the consumer while the other one is idle
+   */
+  std::size_t getSize() const
+  {
+    return this->tail.load(std::memory_order_acquire) -
+           this->head.load(std::memory_order_acquire);
+  }
+
+  bool isEmpty() const
+  {
+    return this->getSize() == 0;
+  }
+
+  /**
+   * Enqueues an entry. Producer only.
+   *
+   * @param entry The entry to enqueue. It is left untouched if the ring is
+   *              full
+   *
+   * @returns false if the ring is full
+   */
+  bool tryPush(T && entry)
+  {
+    const std::size_t currentTail =
+      this->tail.load(std::memory_order_relaxed);
+
+    if (currentTail - this->cachedHead == this->capacity) {
+      this->cachedHead = this->head.load(std::memory_order_acquire);
+
+      if (currentTail - this->cachedHead == this->capacity) {
+        return false;
+      }
+    }
+
+    this->entries[currentTail & this->mask] = std::move(entry);
+    this->tail.store(currentTail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Dequeues an entry. Consumer only.
+   *
+   * @param entry Where the entry is moved to
+   *
+   * @returns false if the ring is empty
+   */
+  bool tryPop(T & entry)
+  {
+    const std::size_t currentHead =
+      this->head.load(std::memory_order_relaxed);
+
+    if (currentHead == this->cachedTail) {
+      this->cachedTail = this->tail.load(std::memory_order_acquire);
+
+      if (currentHead == this->cachedTail) {
+        return false;
+      }
+    }
+
+    entry = std::move(this->entries[currentHead & this->mask]);
+    this->head.store(currentHead + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Dequeues up to maxEntries entries, publishing the new head only once.
+   * Consumer only.
+   *
+   * @param output Output iterator the entries are moved to
+   * @param maxEntries Maximum number of entries to dequeue
+   *
+   * @returns The number of dequeued entries
+   */
+  template <typename OutputIterator>
+  std::size_t tryPopBatch(OutputIterator output, const std::size_t & maxEntries)
+  {
+    const std::size_t currentHead =
+      this->head.load(std::memory_order_relaxed);
+
+    this->cachedTail = this->tail.load(std::memory_order_acquire);
+
+    std::size_t nEntries = this->cachedTail - currentHead;
+    if (nEntries > maxEntries) {
+      nEntries = maxEntries;
+    }
+
+    for (std::size_t i = 0; i < nEntries; i++) {
+      *output++ = std::move(this->entries[(currentHead + i) & this->mask]);
+    }
+
+    if (nEntries > 0) {
+      this->head.store(currentHead + nEntries, std::memory_order_release);
+    }
+
+    return nEntries;
+  }
+
+  /**
+   * Empties the ring. Only safe while no other thread uses it
+   */
+  void clear()
+  {
+    T entry;
+
+    while (this->tryPop(entry)) {}
+  }
+
+private:
+
+  static std::size_t roundUpToPowerOfTwo(const std::size_t & value)
+  {
+    std::size_t powerOfTwo = 2;
+
+    while (powerOfTwo < value) {
+      powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+  }
+
+}; // class SpscRingBuffer
+
+} // namespace autocomp
+
+#endif // AC_SPSC_RING_BUFFER_HPP
@@ -0,0 +1,201 @@
+/**
+ *  AutoComp Task
+ *  task.hpp
+ *
+ *  Declaration and definition of class Task, a move-only callable wrapper
+ *  that stores small callables without allocating.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_TASK_HPP
+#define AC_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace autocomp {
+
+/**
+ * A move-only void() callable. Callables of up to inlineSize bytes are stored
+ * inside the task itself; bigger ones are moved to the heap.
+ *
+ * Unlike std::function, the callable does not need to be copyable, so a
+ * std::packaged_task can be stored as is.
+ */
+class Task
+{
+public:
+
+  static const std::size_t inlineSize = 48;
+
+private:
+
+  using Storage =
+    std::aligned_storage<inlineSize, alignof(std::max_align_t)>::type;
+
+  /**
+   * Operations on the stored callable
+   */
+  struct Operations
+  {
+    void (*invoke)(void * storage);
+    void (*move)(void * from, void * to);
+    void (*destroy)(void * storage);
+  };
+
+  template <typename F>
+  struct InlineOperations
+  {
+    static void invoke(void * storage)
+    {
+      (*static_cast<F *>(storage))();
+    }
+
+    static void move(void * from, void * to)
+    {
+      new (to) F(std::move(*static_cast<F *>(from)));
+      static_cast<F *>(from)->~F();
+    }
+
+    static void destroy(void * storage)
+    {
+      static_cast<F *>(storage)->~F();
+    }
+  };
+
+  template <typename F>
+  struct HeapOperations
+  {
+    static void invoke(void * storage)
+    {
+      (**static_cast<F **>(storage))();
+    }
+
+    static void move(void * from, void * to)
+    {
+      *static_cast<F **>(to) = *static_cast<F **>(from);
+    }
+
+    static void destroy(void * storage)
+    {
+      delete *static_cast<F **>(storage);
+    }
+  };
+
+  template <typename F>
+  using IsInline =
+    std::integral_constant<bool,
+                           sizeof(F) <= inlineSize and
+                           alignof(std::max_align_t) % alignof(F) == 0 and
+                           std::is_nothrow_move_constructible<F>::value>;
+
+  Storage storage;
+  const Operations * operations;
+
+public:
+
+  Task()
+    : operations(nullptr)
+  {}
+
+  template <typename F,
+            typename = typename std::enable_if<
+              not std::is_same<typename std::decay<F>::type, Task>::value
+            >::type>
+  Task(F && callable)
+    : operations(nullptr)
+  {
+    this->store<typename std::decay<F>::type>(
+        std::forward<F>(callable),
+        IsInline<typename std::decay<F>::type>()
+      );
+  }
+
+  Task(const Task &) = delete;
+  Task & operator=(const Task &) = delete;
+
+  Task(Task && other) noexcept
+    : operations(other.operations)
+  {
+    if (this->operations) {
+      this->operations->move(&other.storage, &this->storage);
+      other.operations = nullptr;
+    }
+  }
+
+  Task & operator=(Task && other) noexcept
+  {
+    if (this != &other) {
+      this->reset();
+
+      if (other.operations) {
+        other.operations->move(&other.storage, &this->storage);
+        this->operations = other.operations;
+        other.operations = nullptr;
+      }
+    }
+
+    return *this;
+  }
+
+  ~Task()
+  {
+    this->reset();
+  }
+
+  explicit operator bool() const
+  {
+    return this->operations != nullptr;
+  }
+
+  void operator()()
+  {
+    this->operations->invoke(&this->storage);
+  }
+
+  /**
+   * Destroys the stored callable, releasing whatever it holds
+   */
+  void reset()
+  {
+    if (this->operations) {
+      this->operations->destroy(&this->storage);
+      this->operations = nullptr;
+    }
+  }
+
+private:
+
+  template <typename F, typename Callable>
+  void store(Callable && callable, std::true_type)
+  {
+    static const Operations operations{&InlineOperations<F>::invoke,
+                                       &InlineOperations<F>::move,
+                                       &InlineOperations<F>::destroy};
+
+    new (&this->storage) F(std::forward<Callable>(callable));
+    this->operations = &operations;
+  }
+
+  template <typename F, typename Callable>
+  void store(Callable && callable, std::false_type)
+  {
+    static const Operations operations{&HeapOperations<F>::invoke,
+                                       &HeapOperations<F>::move,
+                                       &HeapOperations<F>::destroy};
+
+    *reinterpret_cast<F **>(&this->storage) =
+      new F(std::forward<Callable>(callable));
+    this->operations = &operations;
+  }
+
+}; // class Task
+
+} // namespace autocomp
+
+#endif // AC_TASK_HPP
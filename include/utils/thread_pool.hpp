@@ -12,32 +12,102 @@
 
 #include <thread>
 #include <vector>
-#include <mutex>
 #include <future>
-#include <functional> // std::function
+#include <functional> // std::bind
 #include <memory>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
-#include "utils/synchronous_queue.hpp"
+#include "utils/task.hpp"
+#include "utils/work_stealing_deque.hpp"
+#include "utils/mpmc_ring_buffer.hpp"
+#include "utils/blocking_ring_buffer.hpp" // SpinParkWaiter
 
 namespace autocomp {
 
 /**
- * A thread pool for avoiding creating new threads for certain operations
+ * A work stealing thread pool for avoiding creating new threads for certain
+ * operations.
+ *
+ * Each worker has its own deque: tasks submitted by a worker go to its deque
+ * and idle workers steal from the others. Tasks submitted by any other
+ * thread go through a shared injection queue. Task objects are recycled, so
+ * submitting a small callable does not allocate.
  */
 class ThreadPool
 {
-  using VoidFunction = std::function<void()>;
+  static const std::size_t cacheLineSize = 64;
+
+  /**
+   * Base of the parts of the pool with cache line aligned members. Before
+   * C++17, new does not align objects beyond alignof(std::max_align_t)
+   */
+  struct CacheLineAllocated
+  {
+    static void * operator new(std::size_t size);
+    static void operator delete(void * pointer) noexcept;
+  };
+
+  /**
+   * A worker thread and its task deque
+   */
+  struct Worker : CacheLineAllocated
+  {
+    WorkStealingDeque<Task *> deque;
+    std::thread thread;
+    std::uint32_t victimSeed;   //!< Picks the first worker to steal from
+  };
+
+  /**
+   * Queues shared by the workers. They are kept out of line, so neither the
+   * pool nor the objects holding one need an extended alignment
+   */
+  struct SharedQueues : CacheLineAllocated
+  {
+    MpmcRingBuffer<Task *> injectionQueue;  //!< Submitted from outside
+    MpmcRingBuffer<Task *> freeTasks;       //!< Ready to be reused
+
+    explicit SharedQueues(const std::size_t & capacity)
+      : injectionQueue(capacity),
+        freeTasks(capacity)
+    {}
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
 
-  SynchronousQueue<VoidFunction> taskQueue;         //!< Task queue
-  std::vector<std::thread> threads;   //!< Thread pool
-  std::mutex mutex;                   //!< Mutex for task dequeuing
-  std::condition_variable condition;  //!< Condition for task dequeuing
-  bool done;                          //!< Shutdown flag
+  const std::unique_ptr<SharedQueues> queues;
+
+  SpinParkWaiter idleWorkers;
+  std::atomic<bool> done;           //!< Shutdown flag
+  std::atomic<bool> initialized;
+
+  /**
+   * Submissions from outside the pool in progress, which shutdown() waits
+   * for before it runs the tasks left
+   */
+  std::atomic<std::size_t> activeSubmissions;
+
+  /**
+   * Pool and index of the worker running in the current thread, if any
+   */
+  static thread_local const ThreadPool * currentPool;
+  static thread_local std::size_t currentWorker;
 
 public:
 
+  /**
+   * ThreadPool constructor
+   *
+   * @param nThreads Number of worker threads
+   * @param queueCapacity Number of tasks submitted from outside the pool that
+   *                      can be waiting, after which submitting waits
+   */
   ThreadPool(const unsigned int & nThreads =
-                std::thread::hardware_concurrency());
+                std::thread::hardware_concurrency(),
+             const std::size_t & queueCapacity = 1024);
 
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool(ThreadPool &&) = delete;
@@ -48,47 +118,150 @@ public:
 
   void init();
 
+  /**
+   * Runs the pending tasks and stops the workers. Those the workers did not
+   * get to, if the pool was never initialized, are run by the calling thread
+   */
   void shutdown();
 
+  std::size_t getThreadCount() const;
+
+  /**
+   * Submits a task without a future. Exceptions it throws are discarded.
+   * Workers can still submit tasks while the pool shuts down
+   *
+   * @throws std::runtime_error If the pool is shut down, or if the queue is
+   *                            full and no worker is running to empty it
+   */
+  void post(Task && task);
+
+  /**
+   * Runs one pending task in the calling thread, if there is any. Lets a
+   * thread waiting for tasks of the pool help instead of blocking
+   *
+   * @returns false if no task was found
+   */
+  bool runPendingTask();
+
 private:
 
   /**
-   * Function that each thread runs, which dequeues a task and executes it
+   * Function that each thread runs, which dequeues tasks and executes them
+   */
+  void worker(const std::size_t index);
+
+  /**
+   * Looks for a task in the deque of the worker, then in the injection queue
+   * and then in the deques of the others
    */
-  void worker();
+  bool findTask(Task * & task, const std::size_t & workerIndex);
+
+  bool stealTask(Task * & task, std::uint32_t & victimSeed,
+                 const std::size_t & thiefIndex);
+
+  bool hasPendingTasks() const;
+
+  Task * acquireTask(Task && task);
+
+  void runTask(Task * task);
 
 public:
 
+  /**
+   * Submits a task and gets the future of its result
+   *
+   * @throws std::runtime_error Like post()
+   */
   template<typename F, typename...Args>
   auto run(F && function, Args && ... arguments)
     -> std::future<decltype(function(arguments...))>
   {
-    using ArgumentlessFunction = decltype(function(arguments...))();
+    using ReturnType = decltype(function(arguments...));
+
+    // packaged_task is move-only, which Task allows, so neither a copyable
+    // wrapper nor a shared pointer is needed
+    std::packaged_task<ReturnType()> task(
+        std::bind(std::forward<F>(function), std::forward<Args>(arguments)...)
+      );
+
+    auto future = task.get_future();
+
+    this->post(Task(std::move(task)));
+
+    return future;
+  }
+
+  /**
+   * Splits [begin, end) into ranges of grainSize indexes and calls
+   * body(rangeBegin, rangeEnd) for each of them in the pool. The calling
+   * thread runs tasks too until every range is done, so it may be a worker.
+   *
+   * @throws The first exception thrown by body, once every range is done
+   */
+  template<typename F>
+  void parallelFor(const std::size_t & begin, const std::size_t & end,
+                   const std::size_t & grainSize, F && body)
+  {
+    if (begin >= end) {
+      return;
+    }
+
+    const std::size_t step = std::max<std::size_t>(grainSize, 1);
+
+    // Nobody would run the ranges
+    if (this->done.load() or this->workers.empty()) {
+      for (std::size_t i = begin; i < end; i += step) {
+        body(i, std::min(i + step, end));
+      }
+
+      return;
+    }
 
-    std::function<ArgumentlessFunction> task = 
-      std::bind(std::forward<F>(function), std::forward<Args>(arguments)...);
+    const std::size_t nRanges = (end - begin + step - 1) / step;
+    std::atomic<std::size_t> pendingRanges(nRanges);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
 
-    // Make shared ptr to be able to copy or assign it
-    auto taskPtr =
-      std::make_shared<std::packaged_task<ArgumentlessFunction>>(task);
+    auto runRange = [&body, &pendingRanges, &failed, &error]
+                    (std::size_t rangeBegin, std::size_t rangeEnd)
+                    {
+                      try {
+                        body(rangeBegin, rangeEnd);
+                      }
+                      catch (...) {
+                        if (not failed.exchange(true)) {
+                          error = std::current_exception();
+                        }
+                      }
 
-    // Wrap task in generic void function
-    VoidFunction voidFunctionWrapper = [taskPtr]() {
-        (*taskPtr)(); 
-      };
+                      pendingRanges.fetch_sub(1, std::memory_order_release);
+                    };
 
-    // Enqueue generic wrapper function
-    this->taskQueue.push(voidFunctionWrapper);
+    for (std::size_t i = 1; i < nRanges; i++) {
+      const std::size_t rangeBegin = begin + i * step;
+      const std::size_t rangeEnd = std::min(rangeBegin + step, end);
 
-    // Wake up one thread if its waiting
-    this->condition.notify_one();
+      this->post(Task([&runRange, rangeBegin, rangeEnd] ()
+                      {
+                        runRange(rangeBegin, rangeEnd);
+                      }));
+    }
 
-    // Return future from promise
-    return taskPtr->get_future();
+    runRange(begin, std::min(begin + step, end));
+
+    while (pendingRanges.load(std::memory_order_acquire) > 0) {
+      if (not this->runPendingTask()) {
+        std::this_thread::yield();
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
   }
-  
+
 }; // class ThreadPool
 
 } // namespace autocomp
 
-#endif // AC_THREAD_POOL_HPP
\ No newline at end of file
+#endif // AC_THREAD_POOL_HPP
@@ -0,0 +1,223 @@
+/**
+ *  AutoComp Work Stealing Deque
+ *  work_stealing_deque.hpp
+ *
+ *  Declaration and definition of class WorkStealingDeque, the per-worker task
+ *  deque of the thread pool.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#ifndef AC_WORK_STEALING_DEQUE_HPP
+#define AC_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace autocomp {
+
+/**
+ * Chase-Lev work stealing deque. Its owner pushes and pops at the bottom
+ * without contention; any other thread may steal from the top. The deque
+ * grows as needed, and the arrays it outgrows are kept until it is destroyed
+ * since a thief may still be reading them.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê, Pop, Cohen and Zappa Nardelli, 2013).
+ *
+ * @tparam T type of entry. It must be trivially copyable (e.g. a pointer)
+ */
+template <typename T>
+class WorkStealingDeque
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "WorkStealingDeque entries must be trivially copyable");
+
+  static const std::size_t cacheLineSize = 64;
+
+  class Array
+  {
+    const std::int64_t capacity;
+    const std::int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> entries;
+
+  public:
+
+    explicit Array(const std::int64_t & capacity)
+      : capacity(capacity),
+        mask(capacity - 1),
+        entries(new std::atomic<T>[capacity])
+    {}
+
+    std::int64_t getCapacity() const
+    {
+      return this->capacity;
+    }
+
+    void put(const std::int64_t & index, const T & entry)
+    {
+      this->entries[index & this->mask].store(entry,
+                                              std::memory_order_relaxed);
+    }
+
+    T get(const std::int64_t & index) const
+    {
+      return this->entries[index & this->mask].load(std::memory_order_relaxed);
+    }
+
+    Array * grow(const std::int64_t & bottom, const std::int64_t & top) const
+    {
+      Array * array = new Array(2 * this->capacity);
+
+      for (std::int64_t i = top; i < bottom; i++) {
+        array->put(i, this->get(i));
+      }
+
+      return array;
+    }
+  };
+
+  alignas(cacheLineSize) std::atomic<std::int64_t> top;
+  alignas(cacheLineSize) std::atomic<std::int64_t> bottom;
+  std::atomic<Array *> array;
+
+  /**
+   * Every array the deque has used, owned by it
+   */
+  std::vector<std::unique_ptr<Array>> arrays;
+
+public:
+
+  /**
+   * WorkStealingDeque constructor
+   *
+   * @param capacity Initial capacity. It must be a power of two
+   */
+  explicit WorkStealingDeque(const std::size_t & capacity = 256)
+    : top(0),
+      bottom(0)
+  {
+    this->arrays.emplace_back(new Array(capacity));
+    this->array.store(this->arrays.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque(WorkStealingDeque &&) = delete;
+  WorkStealingDeque & operator=(const WorkStealingDeque &) = delete;
+  WorkStealingDeque & operator=(WorkStealingDeque &&) = delete;
+
+  /**
+   * Gets the approximate number of entries in the deque
+   */
+  std::size_t getSize() const
+  {
+    const std::int64_t currentBottom =
+      this->bottom.load(std::memory_order_relaxed);
+    const std::int64_t currentTop = this->top.load(std::memory_order_relaxed);
+
+    return currentBottom > currentTop ? currentBottom - currentTop : 0;
+  }
+
+  bool isEmpty() const
+  {
+    return this->getSize() == 0;
+  }
+
+  /**
+   * Pushes an entry at the bottom. Owner only
+   */
+  void push(const T & entry)
+  {
+    const std::int64_t currentBottom =
+      this->bottom.load(std::memory_order_relaxed);
+    const std::int64_t currentTop = this->top.load(std::memory_order_acquire);
+    Array * currentArray = this->array.load(std::memory_order_relaxed);
+
+    if (currentBottom - currentTop > currentArray->getCapacity() - 1) {
+      currentArray = currentArray->grow(currentBottom, currentTop);
+      this->arrays.emplace_back(currentArray);
+      this->array.store(currentArray, std::memory_order_release);
+    }
+
+    currentArray->put(currentBottom, entry);
+    this->bottom.store(currentBottom + 1, std::memory_order_release);
+  }
+
+  /**
+   * Pops the entry at the bottom, the most recently pushed one. Owner only
+   *
+   * @returns false if the deque is empty
+   */
+  bool pop(T & entry)
+  {
+    const std::int64_t currentBottom =
+      this->bottom.load(std::memory_order_relaxed) - 1;
+    Array * currentArray = this->array.load(std::memory_order_relaxed);
+
+    this->bottom.store(currentBottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::int64_t currentTop = this->top.load(std::memory_order_relaxed);
+
+    if (currentTop > currentBottom) {
+      this->bottom.store(currentBottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    entry = currentArray->get(currentBottom);
+
+    // Last entry: race against the thieves for it
+    if (currentTop == currentBottom) {
+      const bool won =
+        this->top.compare_exchange_strong(currentTop, currentTop + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed);
+      this->bottom.store(currentBottom + 1, std::memory_order_relaxed);
+
+      return won;
+    }
+
+    return true;
+  }
+
+  /**
+   * Steals the entry at the top, the oldest one. Any thread
+   *
+   * @returns false if the deque is empty or another thread took the entry
+   */
+  bool steal(T & entry)
+  {
+    std::int64_t currentTop = this->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t currentBottom =
+      this->bottom.load(std::memory_order_acquire);
+
+    if (currentTop >= currentBottom) {
+      return false;
+    }
+
+    Array * currentArray = this->array.load(std::memory_order_acquire);
+    T stolenEntry = currentArray->get(currentTop);
+
+    if (not this->top.compare_exchange_strong(currentTop, currentTop + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+      return false;
+    }
+
+    entry = stolenEntry;
+
+    return true;
+  }
+
+}; // class WorkStealingDeque
+
+} // namespace autocomp
+
+#endif // AC_WORK_STEALING_DEQUE_HPP
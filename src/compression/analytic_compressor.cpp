@@ -0,0 +1,374 @@
+/**
+ *  AutoComp Analytic Compression Strategy
+ *  analytic_compressor.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "compression/analytic_compressor.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+#include "utils/constants.hpp"
+#include "utils/byte_histogram.hpp"
+#include "utils/floating_point_detector.hpp"
+#include "utils/functions.hpp"
+#include "compression/zlib_compressor.hpp"
+#include "compression/snappy_compressor.hpp"
+#include "compression/lzo_compressor.hpp"
+#include "compression/bzip2_compressor.hpp"
+#include "compression/lzma_compressor.hpp"
+#include "compression/fpc_compressor.hpp"
+
+namespace autocomp {
+
+namespace
+{
+  // Words of a random vocabulary, the most frequent ones drawn far more
+  // often, like text
+  std::string makeTextSample(const std::size_t & size,
+                             std::mt19937 & generator)
+  {
+    const std::size_t vocabularySize = 4096;
+    std::uniform_int_distribution<int> letters('a', 'z');
+    std::uniform_int_distribution<int> wordLengths(2, 10);
+    std::uniform_real_distribution<double> uniform;
+
+    std::vector<std::string> vocabulary(vocabularySize);
+
+    for (std::string & word : vocabulary) {
+      int wordLength = wordLengths(generator);
+
+      for (int i = 0; i < wordLength; i++) {
+        word.push_back(letters(generator));
+      }
+    }
+
+    std::string sample;
+    sample.reserve(size + 16);
+
+    while (sample.size() < size) {
+      sample += vocabulary[vocabularySize * std::pow(uniform(generator), 3)];
+      sample.push_back(uniform(generator) < 0.1 ? '\n' : ' ');
+    }
+
+    return sample;
+  }
+
+  // Records of 32 bit integers, mostly small, like counters and identifiers
+  std::string makeRecordSample(const std::size_t & size,
+                               std::mt19937 & generator)
+  {
+    std::geometric_distribution<std::uint32_t> values(0.01);
+    std::string sample;
+    sample.reserve(size + 4);
+
+    while (sample.size() < size) {
+      std::uint32_t value = values(generator);
+      sample.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    return sample;
+  }
+
+  // Doubles of a noisy random walk, like measurements
+  std::string makeFloatingPointSample(const std::size_t & size,
+                                      std::mt19937 & generator)
+  {
+    std::normal_distribution<double> steps(0, 0.01);
+    std::string sample;
+    sample.reserve(size + 8);
+    double value = 100;
+
+    while (sample.size() < size) {
+      value += steps(generator);
+      sample.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    return sample;
+  }
+
+  std::string makeRandomSample(const std::size_t & size,
+                               std::mt19937 & generator)
+  {
+    std::uniform_int_distribution<int> bytes(0, 255);
+    std::string sample(size, '\0');
+
+    for (char & byte : sample) {
+      byte = bytes(generator);
+    }
+
+    return sample;
+  }
+
+  // Compresses a chunk, telling how long it took
+  CompressionPerformanceData
+  compressAndMeasure(const CompressionStrategy & compressor,
+                     const int & compressionLevel, const Buffer & inData,
+                     Buffer & outData)
+  {
+    auto startTime = std::chrono::steady_clock::now();
+    compressor.compress(inData, outData);
+    auto endTime = std::chrono::steady_clock::now();
+
+    return CompressionPerformanceData{
+      .compressor = compressor.getCompressorName(),
+      .compressionLevel = (short) compressionLevel,
+      .elapsedTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                              startTime)
+                                                           .count(),
+      .originalSize = inData.getSize(),
+      .finalSize = outData.getSize()
+    };
+  }
+}
+
+// AnalyticCompressor constructor
+AnalyticCompressor::AnalyticCompressor(
+    CodecCalibration * calibration, const ResourceState * resourceState,
+    const std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter,
+    const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator
+  )
+  : AutomaticCompressionStrategy(performanceDataWriter),
+    compressors(createCompressors()),
+    calibration(calibration),
+    resourceState(resourceState),
+    bandwidthEstimator(bandwidthEstimator)
+{
+  if (not calibration) {
+    throw std::domain_error("calibration must not be null");
+  }
+
+  if (not resourceState) {
+    throw std::domain_error("resourceState must not be null");
+  }
+}
+
+// Compresses with the best ranked codec whose working memory fits in the
+// memory budget, and teaches the calibration how it did
+Compressor
+AnalyticCompressor::compress(const Buffer & inData, Buffer & outData) const
+{
+  std::chrono::nanoseconds cpuTime = getThreadCPUTime();
+
+  double entropy = this->getEntropy(inData);
+  std::vector<CompressorType> ranking =
+    this->rankCompressors(entropy, this->getFPCLevel(inData));
+  Compressor usedCompressor = COPY;
+
+  if (this->performanceDataWriter) {
+    this->performanceDataWriter->write(Compressor_Name(ranking.front().first));
+  }
+
+  for (const CompressorType & compressorType : ranking) {
+    if (compressorType.first == COPY) {
+      break;
+    }
+
+    const CompressorPointer & compressor =
+      this->compressors.at(compressorType);
+    MemoryGovernor::Reservation workingMemory;
+
+    if (this->memoryGovernor) {
+      workingMemory = this->memoryGovernor->tryAcquire(
+                        compressor->getCompressionMemory()
+                      );
+
+      if (not workingMemory) {
+        continue;
+      }
+    }
+
+    CompressionPerformanceData performanceData =
+      compressAndMeasure(*compressor, compressorType.second, inData, outData);
+
+    this->calibration->record(compressorType, performanceData, entropy);
+
+#ifdef MEASURE_COMPRESSION_TIME
+
+    if (this->performanceDataWriter) {
+      this->performanceDataWriter->write(performanceData);
+    }
+
+#endif
+
+    usedCompressor = compressorType.first;
+    break;
+  }
+
+  this->cpuCommitment.record(getThreadCPUTime() - cpuTime);
+
+  return usedCompressor;
+}
+
+std::vector<AnalyticCompressor::CompressorType>
+AnalyticCompressor::rankCompressors(const Buffer & inData) const
+{
+  return this->rankCompressors(this->getEntropy(inData),
+                               this->getFPCLevel(inData));
+}
+
+// Copying compresses at no cost, so it gets through at the bandwidth.
+// Codecs not calibrated yet are not ranked, nor FPC but at the level for
+// the doubles in the chunk
+std::vector<AnalyticCompressor::CompressorType>
+AnalyticCompressor::rankCompressors(const double & entropy,
+                                    const int & fpcLevel) const
+{
+  float bandwidth = this->getBandwidth();
+  float cpuShare = std::max(1 - this->getCPULoad(),
+                            constants::CALIBRATION_MIN_CPU_SHARE);
+
+  std::vector<std::pair<float, CompressorType>> rates{
+    {effectiveTransmissionRate(bandwidth, std::numeric_limits<float>::max(),
+                               1),
+     {COPY, -1}}
+  };
+
+  for (const auto & compressorEntry : this->compressors) {
+    if (compressorEntry.first.first == FPC and
+        compressorEntry.first.second != fpcLevel) {
+      continue;
+    }
+
+    CodecPrediction prediction =
+      this->calibration->predict(compressorEntry.first, entropy);
+
+    if (prediction.compressionRate <= 0) {
+      continue;
+    }
+
+    // Rate of the compressed data, as the training compressor measures it
+    float compressionRate = prediction.compressionRate * cpuShare /
+                            prediction.compressionRatio;
+
+    rates.emplace_back(
+        effectiveTransmissionRate(bandwidth, compressionRate,
+                                  prediction.compressionRatio),
+        compressorEntry.first
+      );
+  }
+
+  // Copying wins ties: it spares the CPU
+  std::stable_sort(rates.begin(), rates.end(),
+                   [] (const std::pair<float, CompressorType> & a,
+                       const std::pair<float, CompressorType> & b)
+                   {
+                     return a.first > b.first;
+                   });
+
+  std::vector<CompressorType> ranking;
+  ranking.reserve(rates.size());
+
+  for (const auto & rate : rates) {
+    ranking.push_back(rate.second);
+  }
+
+  return ranking;
+}
+
+// The codecs are timed on the text sample, which is as large as the sample
+// size, and their ratios also learned on smaller samples of records, doubles
+// and random bytes, so that they are known for low and high entropies too.
+// FPC only ever compresses doubles, so it is calibrated on them alone
+void AnalyticCompressor::calibrate(CodecCalibration & calibration,
+                                   const std::size_t & sampleSize)
+{
+  std::mt19937 generator(0);
+  std::size_t chunkSize = std::min(constants::CALIBRATION_CHUNK_SIZE,
+                                   sampleSize);
+  std::vector<std::string> samples{
+    makeTextSample(sampleSize, generator),
+    makeRecordSample(chunkSize, generator),
+    makeFloatingPointSample(chunkSize, generator),
+    makeRandomSample(chunkSize, generator)
+  };
+  std::vector<std::string> floatingPointSamples{
+    makeFloatingPointSample(sampleSize, generator)
+  };
+
+  Buffer chunk(chunkSize), compressedChunk(2 * chunkSize);
+
+  for (const auto & compressorEntry : createCompressors()) {
+    for (const std::string & sample : compressorEntry.first.first == FPC
+                                        ? floatingPointSamples
+                                        : samples) {
+      for (std::size_t offset = 0; offset + chunkSize <= sample.size();
+           offset += chunkSize) {
+        chunk.setData(sample.data() + offset, chunkSize);
+        compressedChunk.setSize(0);
+
+        calibration.record(compressorEntry.first,
+                           compressAndMeasure(*compressorEntry.second,
+                                              compressorEntry.first.second,
+                                              chunk, compressedChunk),
+                           getEntropy(chunk));
+      }
+    }
+  }
+}
+
+std::map<AnalyticCompressor::CompressorType,
+         AnalyticCompressor::CompressorPointer>
+AnalyticCompressor::createCompressors()
+{
+  return {
+    {{SNAPPY, -1}, std::make_shared<SnappyCompressor>()},
+    {{LZO, 1}, std::make_shared<LZOCompressor>(1)},
+    {{ZLIB, 1}, std::make_shared<ZlibCompressor>(1)},
+    {{ZLIB, 3}, std::make_shared<ZlibCompressor>(3)},
+    {{ZLIB, 6}, std::make_shared<ZlibCompressor>(6)},
+    {{ZLIB, 9}, std::make_shared<ZlibCompressor>(9)},
+    {{BZIP2, 5}, std::make_shared<Bzip2Compressor>(5)},
+    {{BZIP2, 9}, std::make_shared<Bzip2Compressor>(9)},
+    {{LZMA, 1}, std::make_shared<LZMACompressor>(1)},
+    {{LZMA, 6}, std::make_shared<LZMACompressor>(6)},
+    {{FPC, constants::FPC_FAST_LEVEL},
+     std::make_shared<FPCCompressor>(constants::FPC_FAST_LEVEL)},
+    {{FPC, constants::FPC_STRONG_LEVEL},
+     std::make_shared<FPCCompressor>(constants::FPC_STRONG_LEVEL)}
+  };
+}
+
+// Sampled as the bytecounting of AutoComp is, and the same way for the
+// calibration, which learns the ratios for this estimate
+double AnalyticCompressor::getEntropy(const Buffer & inData)
+{
+  return ByteHistogram::getSampledFeatures(inData.getData(),
+                                           inData.getSize()).entropy;
+}
+
+// 0 unless the chunk is made of doubles
+int AnalyticCompressor::getFPCLevel(const Buffer & inData)
+{
+  FloatingPointFeatures features =
+    getFloatingPointFeatures(inData.getData(), inData.getSize());
+
+  return isFloatingPointData(features) ? autocomp::getFPCLevel(features) : 0;
+}
+
+inline float AnalyticCompressor::getCPULoad() const
+{
+  float cpuLoad = this->resourceState->cpuLoad;
+
+  return this->cpuBudget ? this->cpuBudget->getLoad(this->cpuCommitment,
+                                                    cpuLoad)
+                         : cpuLoad;
+}
+
+inline float AnalyticCompressor::getBandwidth() const
+{
+  return this->bandwidthEstimator ? this->bandwidthEstimator->getBandwidth()
+                                  : this->resourceState->bandwidth.load();
+}
+
+} // namespace autocomp
@@ -58,6 +58,12 @@ void Bzip2Compressor::compress(const Buffer & inData, Buffer & outData) const
   }
 }
 
+// Gets the memory bzip2 needs for blocks of level * 100 KB.
+std::size_t Bzip2Compressor::getCompressionMemory() const
+{
+  return 400 * 1024 + 8 * this->compressionLevel * 100000;
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void Bzip2Compressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -0,0 +1,103 @@
+/**
+ *  AutoComp Compressibility Probe
+ *  compressibility_probe.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "compression/compressibility_probe.hpp"
+
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+namespace autocomp {
+
+namespace
+{
+  const std::vector<float> relativeSamplePositions({0.10, 0.45, 0.80});
+}
+
+// CompressibilityProbe constructor
+CompressibilityProbe::CompressibilityProbe()
+  : compressor(1),
+    compressibility{1, 0},
+    remainingBytesToProbeAgain(0)
+{}
+
+Compressibility CompressibilityProbe::get(const Buffer & inData)
+{
+  if (this->remainingBytesToProbeAgain <= 0) {
+    this->compressibility = this->probe(inData);
+    this->remainingBytesToProbeAgain = constants::PROBE_WINDOW;
+  }
+
+  this->remainingBytesToProbeAgain -= inData.getSize();
+
+  return this->compressibility;
+}
+
+// Chunks smaller than the samples together are compressed whole
+Compressibility CompressibilityProbe::probe(const Buffer & inData)
+{
+  std::size_t samplesSize = relativeSamplePositions.size() *
+                            constants::PROBE_SAMPLE_SIZE;
+
+  if (inData.getSize() == 0) {
+    return {1, 0};
+  }
+
+  if (this->samples.getCapacity() < samplesSize) {
+    this->samples.resize(samplesSize);
+    this->compressedSamples.resize(2 * samplesSize);
+  }
+
+  if (inData.getSize() <= samplesSize) {
+    this->samples.setData(inData.getData(), inData.getSize());
+  }
+  else {
+    std::size_t offset, size = 0;
+
+    for (const float & relativePosition : relativeSamplePositions) {
+      offset = std::min<std::size_t>(relativePosition * inData.getSize(),
+                                     inData.getSize() -
+                                       constants::PROBE_SAMPLE_SIZE);
+
+      std::memcpy(this->samples.getData() + size, inData.getData() + offset,
+                  constants::PROBE_SAMPLE_SIZE);
+      size += constants::PROBE_SAMPLE_SIZE;
+    }
+
+    this->samples.setSize(size);
+  }
+
+  this->compressedSamples.setSize(0);
+
+  auto tic = std::chrono::steady_clock::now();
+  this->compressor.compress(this->samples, this->compressedSamples);
+  auto toc = std::chrono::steady_clock::now();
+
+  double microseconds =
+    std::chrono::duration<double, std::micro>(toc - tic).count();
+
+  return {
+    this->samples.getSize() /
+      static_cast<float>(std::max<std::size_t>(
+                           this->compressedSamples.getSize(), 1
+                         )),
+    // Compression rate in Mbits/s (8e-6 Mbits in 1 byte and 1e-6 sec in 1 us)
+    static_cast<float>(8 * this->samples.getSize() /
+                       std::max(microseconds, 1.0))
+  };
+}
+
+void CompressibilityProbe::reset()
+{
+  this->compressibility = {1, 0};
+  this->remainingBytesToProbeAgain = 0;
+}
+
+} // namespace autocomp
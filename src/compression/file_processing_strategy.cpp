@@ -64,6 +64,11 @@ size_t FileProcessingStrategy::getCurrentFileSize() const
   return this->currentFileSize;
 }
 
+size_t FileProcessingStrategy::getCurrentFileReadBytes() const
+{
+  return this->currentFileReadBytes;
+}
+
 // Calculates the current file size
 void FileProcessingStrategy::calculateFileSize()
 {
@@ -9,6 +9,8 @@
 
 #include "compression/file_processor.hpp"
 
+#include "utils/constants.hpp"
+
 namespace autocomp {
 
 // Instantiates a file processor. The files are going to be processed in
@@ -17,10 +19,11 @@ FileProcessor::FileProcessor(const unsigned int & chunkSize,
                              const std::shared_ptr<AutomaticCompressionStrategy>
                                 compressor)
  : FileProcessingStrategy(chunkSize),
-   compressor(compressor)
+   compressor(compressor),
+   currentFileFormat(FileFormat::UNKNOWN)
 {}
 
-// Opens and prepares the next file
+// Opens and prepares the next file, and tells its format from its signature
 size_t FileProcessor::openNextFile()
 {
   if (not this->hasNextFile()) {
@@ -43,6 +46,20 @@ size_t FileProcessor::openNextFile()
   this->calculateFileSize();
   this->currentFileReadBytes = 0;
 
+  char signature[constants::FILE_SIGNATURE_SIZE];
+  this->source.read(signature, sizeof(signature));
+  this->currentFileFormat = sniffFileFormat(signature,
+                                            this->source.gcount());
+
+  // Back to the start, past the end of a file smaller than the signature
+  this->source.clear();
+  this->source.seekg(0, std::ifstream::beg);
+
+  if (this->source.fail()) {
+    throw exceptions::IOError(std::string("Could not read current file: ")
+                                .append(this->currentFileName));
+  }
+
   return this->currentFileSize;
 }
 
@@ -70,22 +87,30 @@ Compressor FileProcessor::getNextChunk(Buffer & chunk)
     chunk.resize(1.1 * this->chunkSizeBytes);
   }
 
-  Buffer inData(this->chunkSizeBytes);
-  this->source.read(inData.getData(), this->chunkSizeBytes);
-  this->currentFileReadBytes += this->source.gcount();
-  inData.setSize(this->source.gcount());
-
-  Compressor usedCompressor;
-
-  try {
-    usedCompressor = this->compressor->compress(inData, chunk);
+  if (this->inData.getCapacity() < 1.1 * this->chunkSizeBytes) {
+    this->inData.resize(1.1 * this->chunkSizeBytes);
   }
-  catch (exceptions::CompressionError & error) {
-    usedCompressor = COPY;
+
+  this->source.read(this->inData.getData(), this->chunkSizeBytes);
+  this->currentFileReadBytes += this->source.gcount();
+  this->inData.setSize(this->source.gcount());
+
+  Compressor usedCompressor = COPY;
+
+  // Already compressed files are not worth the compressor's time
+  if (not isCompressedFormat(this->currentFileFormat)) {
+    try {
+      usedCompressor = this->compressor->compress(this->inData, chunk);
+    }
+    catch (exceptions::CompressionError & error) {
+      usedCompressor = COPY;
+    }
   }
 
+  // The chunk keeps the raw data and the read buffer gets the chunk's
+  // storage, so no buffer is allocated per chunk
   if (usedCompressor == COPY) {
-    chunk.swap(inData);
+    chunk.swap(this->inData);
   }
 
   return usedCompressor;
@@ -118,6 +143,11 @@ Compressor FileProcessor::getNextChunk(
   return usedCompressor;
 }
 
+FileFormat FileProcessor::getCurrentFileFormat() const
+{
+  return this->currentFileFormat;
+}
+
 // Sets Compressor to use for file processing
 void FileProcessor::setCompressor(
     const std::shared_ptr<AutomaticCompressionStrategy> compressor
@@ -38,6 +38,12 @@ void FPCCompressor::compress(const Buffer & inData, Buffer & outData) const
   this->_compress(inData, outData);
 }
 
+// Gets the memory of the two predictor tables, 2^level entries each.
+std::size_t FPCCompressor::getCompressionMemory() const
+{
+  return 2 * sizeof(long long) << this->compressionLevel;
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void FPCCompressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -28,6 +28,12 @@ void LZMACompressor::compress(const Buffer & inData, Buffer & outData) const
   this->_compress(inData, outData);
 }
 
+// Gets the memory of an encoder of the preset of the compression level.
+std::size_t LZMACompressor::getCompressionMemory() const
+{
+  return lzma_easy_encoder_memusage(this->compressionLevel);
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void LZMACompressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -66,6 +66,12 @@ void LZOCompressor::compress(const Buffer & inData, Buffer & outData) const
   }
 }
 
+// Gets the size of the work memory the compressor allocated.
+std::size_t LZOCompressor::getCompressionMemory() const
+{
+  return this->workMemorySize * sizeof(lzo_align_t);
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void LZOCompressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -105,6 +105,16 @@ SingleCompressor::compress(const Buffer & inData, Buffer & outData) const
   if (this->currentCompressor != COPY) {
     auto compressor = this->compressors[this->currentCompressor];
 
+    // The client asked for this compressor, so its memory is only accounted
+    MemoryGovernor::Reservation workingMemory;
+
+    if (this->memoryGovernor) {
+      workingMemory =
+        this->memoryGovernor->acquire(compressor->getCompressionMemory());
+    }
+
+    std::chrono::nanoseconds cpuTime = getThreadCPUTime();
+
     // Compressing while measuring compression time
 #ifdef MEASURE_COMPRESSION_TIME
 
@@ -114,6 +124,8 @@ SingleCompressor::compress(const Buffer & inData, Buffer & outData) const
 
     compressor->compress(inData, outData);
 
+    this->cpuCommitment.record(getThreadCPUTime() - cpuTime);
+
 #ifdef MEASURE_COMPRESSION_TIME
 
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -39,6 +39,15 @@ void SnappyCompressor::compress(const Buffer & inData, Buffer & outData) const
   }
 }
 
+// Gets the memory of the hash table and the scratch output of a block.
+std::size_t SnappyCompressor::getCompressionMemory() const
+{
+  const std::size_t blockSize = 1 << 16;
+
+  return blockSize / 2 * sizeof(uint16_t) +
+         snappy::MaxCompressedLength(blockSize);
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void SnappyCompressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -14,13 +14,14 @@ namespace autocomp {
 // TrainingCompressor constructor
 TrainingCompressor::TrainingCompressor(
     const ResourceState * resourceState,
-    const SynchronousQueue<Buffer> * transmissionQueue,
+    const QueueOccupancy * transmissionQueue,
     const std::shared_ptr<net::TCPSocket> & clientSocket,
-    std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter
+    std::shared_ptr<io::PerformanceDataWriter> & performanceDataWriter,
+    const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator
   )
   : SingleCompressor(performanceDataWriter),
     resourceState(resourceState),
-    transmissionQueue(transmissionQueue),
+    bandwidthEstimator(bandwidthEstimator),
     clientSocket(clientSocket),
     clientSocketSendBufferCapacity(clientSocket->getSendBufferCapacity()),
     cpuModulatorPID(-1)
@@ -37,6 +38,8 @@ TrainingCompressor::TrainingCompressor(
     throw std::domain_error("transmissionQueue must not be null");
   }
 
+  this->setTransmissionQueue(transmissionQueue);
+
   /*
   // Insert snappy
   this->compressors.insert(
@@ -121,7 +124,7 @@ TrainingCompressor::compress(const Buffer & inData, Buffer & outData) const
 
   // Get resource state (current opportunity)
   float cpuLoad = this->resourceState->cpuLoad;
-  float availableBandwidth = this->resourceState->bandwidth;
+  float availableBandwidth = this->getBandwidth();
   float sendBufferLoad = this->getClientSocketSendBufferLoad();
   int transmissionQueueSize = this->transmissionQueue->getSize();
   int bytecounting = this->getBytecounting(inData);
@@ -230,9 +233,17 @@ TrainingCompressor::compress(const Buffer & inData, Buffer & outData) const
   test = not test;
   */
 
+  // FPC drops the bytes after the last whole 8 byte word, so those chunks
+  // are sent uncompressed and left out of the training data
+  if (this->currentCompressor == FPC and inData.getSize() % 8 != 0) {
+    return COPY;
+  }
+
   int bytecounting = this->getBytecounting(inData);
+  Compressibility compressibility = this->getCompressibility(inData);
 
-  if (bytecounting > 100) {
+  if (bytecounting > 100 and
+      compressibility.compressionRatio < constants::PROBE_MIN_RATIO) {
     return COPY;
   }
 
@@ -240,7 +251,7 @@ TrainingCompressor::compress(const Buffer & inData, Buffer & outData) const
 
   // Get resource state (current opportunity)
   float cpuLoad = this->resourceState->cpuLoad;
-  float availableBandwidth = this->resourceState->bandwidth;
+  float availableBandwidth = this->getBandwidth();
   int transmissionQueueSize = this->transmissionQueue->getSize();
 
   if (this->currentCompressor != COPY) {
@@ -265,7 +276,9 @@ TrainingCompressor::compress(const Buffer & inData, Buffer & outData) const
   // NOTE: In production, this should be saved in memory.
   this->performanceDataWriter->write(
       Compressor_Name(this->currentCompressor), this->currentCompressionLevel,
-      cpuLoad, availableBandwidth, bytecounting, compressionRate, compressionRatio
+      cpuLoad, availableBandwidth, bytecounting, compressionRate,
+      compressionRatio, compressibility.compressionRatio,
+      compressibility.compressionRate
       //this->getEfectiveTransmissionRate(availableBandwidth, compressionRate,
       //                                  compressionRatio)
     );
@@ -279,33 +292,20 @@ inline float TrainingCompressor::getClientSocketSendBufferLoad() const
           (float) this->clientSocketSendBufferCapacity;
 }
 
+inline float TrainingCompressor::getBandwidth() const
+{
+  return this->bandwidthEstimator ? this->bandwidthEstimator->getBandwidth()
+                                  : this->resourceState->bandwidth.load();
+}
+
 inline float TrainingCompressor::getEfectiveTransmissionRate(
     const float & availableBandwidth,
     const float & compressionRate,
     const float & compressionRatio
   ) const
 {
-  return std::min(availableBandwidth, compressionRate) * compressionRatio;
-}
-
-inline int TrainingCompressor::getBytecounting(const Buffer & inData) const
-{
-  static const float subChunkProportion = 0.1;
-  static const std::vector<float> relativeSubChunkPositions({0.10, 0.45, 0.80});
-
-  int subChunkSize = subChunkProportion * inData.getSize();
-  int offset;
-
-  float averageBytecounting = 0;
-
-  for (const float & relativePosition : relativeSubChunkPositions) {
-    offset = relativePosition * inData.getSize();
-    averageBytecounting += bytecounting(inData.getData() + offset,
-                                        subChunkSize);
-  }
-
-  return std::round(averageBytecounting /
-                      (float) relativeSubChunkPositions.size());
+  return effectiveTransmissionRate(availableBandwidth, compressionRate,
+                                   compressionRatio);
 }
 
 ::pid_t TrainingCompressor::launchCPUModulator()
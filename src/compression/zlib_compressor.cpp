@@ -60,6 +60,15 @@ void ZlibCompressor::compress(const Buffer & inData, Buffer & outData) const
   }
 }
 
+// Gets the memory of a deflate stream with the window and memory level
+// compress2() uses.
+std::size_t ZlibCompressor::getCompressionMemory() const
+{
+  const int memoryLevel = 8;    // Default of deflateInit()
+
+  return (1 << (MAX_WBITS + 2)) + (1 << (memoryLevel + 9));
+}
+
 // Decompresses the data in the input buffer into the output buffer.
 void ZlibCompressor::decompress(const Buffer & inData, Buffer & outData) const
 {
@@ -16,6 +16,12 @@ namespace autocomp
 
   //SynchronizedFile PerformanceDataWriter::file;
 
+  PerformanceDataWriter::PerformanceDataWriter(
+      const std::string & fileNameSuffix
+    )
+    : file(fileNameSuffix)
+  {}
+
   void PerformanceDataWriter::write(const CompressionPerformanceData & data)
   {
     this->file.write(this->formatData(data));
@@ -15,7 +15,7 @@ namespace autocomp
   {
 
   // SynchronizedFile constructor
-  SynchronizedFile::SynchronizedFile()
+  SynchronizedFile::SynchronizedFile(const std::string & fileNameSuffix)
     : out(nullptr)
   {
     std::time_t currentTime = std::time(nullptr);
@@ -27,6 +27,7 @@ namespace autocomp
                   .append("/")
                   .append(constants::PERFORMANCE_LOG_FILE_NAME_PREFIX)
                   .append(timestamp)
+                  .append(fileNameSuffix)
                   .append(constants::CSV_LOG_FILE_EXTENSSION);
 
     this->outBuffer = std::unique_ptr<AsynchronousBuffer>(
@@ -18,10 +18,16 @@ namespace autocomp
 
   Client::Client(const std::string & serverHostname,
                  const unsigned short & serverPort)
-    : serverHostname(serverHostname),
+    : decompressionQueue(constants::CLIENT_DECOMPRESSION_QUEUE_SIZE),
+      serverHostname(serverHostname),
       serverPort(serverPort),
       doneReceiving(true),
       preCompression(false),
+      protocolVersion(constants::PROTOCOL_VERSION),
+      chunkChecksums(false),
+      weight(1),
+      maxRate(0),
+      occupancySetpoint(0),
       bandwidthModulatorPID(-1)
   {
     this->compressors.emplace(
@@ -52,6 +58,7 @@ namespace autocomp
 
     this->doneReceiving = false;
     this->preCompression = false;
+    this->decompressionQueue.reopen();
 
     // ---> Decompression thread <--- //
     LOG(INFO) << "Initializing decompression thread";
@@ -59,6 +66,11 @@ namespace autocomp
 
     // ---> Connecting with server <--- //
     LOG(INFO) << "Connecting to server";
+
+    // Chunk headers and small chunks are read along with the data that
+    // follows them, saving a system call per message
+    this->socket.enableReadAhead(constants::CLIENT_READ_AHEAD_SIZE);
+
     try {
       this->socket.connect(serverHostname, serverPort);
     }
@@ -86,17 +98,39 @@ namespace autocomp
     }
 
     LOG(INFO) << "Joining decompression thread";
-    {
-      std::unique_lock<std::mutex> guard(this->mutex);
-      this->doneReceiving = true;
-    }
-    this->condition.notify_all();
+    this->doneReceiving = true;
+    this->decompressionQueue.close();
 
     if (this->decompressionThread.joinable()) {
       this->decompressionThread.join();
     }
   }
 
+  void Client::setProtocolVersion(const unsigned int & protocolVersion)
+  {
+    this->protocolVersion = protocolVersion;
+  }
+
+  void Client::setChunkChecksums(const bool & chunkChecksums)
+  {
+    this->chunkChecksums = chunkChecksums;
+  }
+
+  void Client::setWeight(const unsigned int & weight)
+  {
+    this->weight = weight;
+  }
+
+  void Client::setMaxRate(const std::uint64_t & maxRate)
+  {
+    this->maxRate = maxRate;
+  }
+
+  void Client::setOccupancySetpoint(const unsigned int & occupancySetpoint)
+  {
+    this->occupancySetpoint = occupancySetpoint;
+  }
+
   void Client::requestFile(const std::string & path,
                            const FileRequestMode & mode,
                            const Compressor * compressor,
@@ -204,40 +238,76 @@ namespace autocomp
                 << ", chunkSize: " << fileInitialMessage.chunksize()
                 << ", lastFile: " << fileInitialMessage.lastfile();
 
+      // Chunk buffers go back and forth between this thread and the
+      // decompression thread, which returns them once they are written. The
+      // pool is never replaced while the decompression thread may use it;
+      // buffers that are too small for a chunk grow when it is received
+      if (not this->chunkPool) {
+        this->chunkPool = std::make_shared<BufferPool>(
+                              1.1 * fileInitialMessage.chunksize() * 1024
+                            );
+      }
+
       // <--- Send file info to the decompression thread ---> //
       this->decompressionQueue.push({
                                       fileInitialMessage,
-                                      messaging::ChunkHeader(),
+                                      ChunkFrameHeader(),
                                       Buffer()
                                     });
-      this->condition.notify_one();
 
       // <--- Receive and enqueue chunks ---> //
-      Buffer chunk;
+      const unsigned int fileProtocolVersion =
+        fileInitialMessage.has_protocolversion()
+          ? fileInitialMessage.protocolversion()
+          : 1;
       bool lastChunk = false;
       int nChunks = 0;
 
       while (not lastChunk) {
-        // <--- Receive chunk header ---> //
-        receiveMessage(chunkHeaderBuffer);
-        messaging::ChunkHeader chunkHeader;
-
-        if(not deserializeAndCheckMessage(chunkHeaderBuffer, chunkHeader,
-                                          errorMessage)) {
-          std::string errorMessageStr(errorMessage.IsInitialized()
-                                        ? errorMessage.message()
-                                        : "Received invalid chunk header from "
-                                          "server");
-          LOG(ERROR) << "Error receiving chunk header: " << errorMessageStr;
-          this->shutdown();
-          throw exceptions::NetworkError(errorMessageStr);
+        ChunkFrameHeader chunkHeader;
+        Buffer chunk = this->chunkPool->acquire();
+
+        if (fileProtocolVersion >= 2) {
+          try {
+            this->receiveChunkFrame(chunkHeader, chunk);
+          }
+          catch (exceptions::NetworkError & error) {
+            LOG(ERROR) << "Error receiving chunk: " << error.what();
+            this->shutdown();
+            throw error;
+          }
         }
+        else {
+          // <--- Receive chunk header ---> //
+          receiveMessage(chunkHeaderBuffer);
+          messaging::ChunkHeader chunkHeaderMessage;
+
+          if(not deserializeAndCheckMessage(chunkHeaderBuffer,
+                                            chunkHeaderMessage,
+                                            errorMessage)) {
+            std::string errorMessageStr(errorMessage.IsInitialized()
+                                          ? errorMessage.message()
+                                          : "Received invalid chunk header "
+                                            "from server");
+            LOG(ERROR) << "Error receiving chunk header: "
+                       << errorMessageStr;
+            this->shutdown();
+            throw exceptions::NetworkError(errorMessageStr);
+          }
 
-        LOG(INFO) << "Receiving chunk";
+          chunkHeader.version = 1;
+          chunkHeader.compressor = chunkHeaderMessage.compressor();
+          chunkHeader.chunkIndex = chunkHeaderMessage.chunkposition();
+          chunkHeader.setFlag(ChunkFrameHeader::LAST_CHUNK,
+                              chunkHeaderMessage.has_lastchunk() and
+                                chunkHeaderMessage.lastchunk());
 
-        // <--- Receive chunk ---> //
-        size_t bytesReceived = receiveMessage(chunk);
-        chunk.setSize(bytesReceived);
+          LOG(INFO) << "Receiving chunk";
+
+          // <--- Receive chunk ---> //
+          size_t bytesReceived = receiveMessage(chunk);
+          chunk.setSize(bytesReceived);
+        }
 
         LOG(INFO) << "Received chunk #" << ++nChunks << " with size " 
                   << chunk.getSize();
@@ -248,12 +318,9 @@ namespace autocomp
                                         chunkHeader,
                                         std::move(chunk)
                                       });
-        this->condition.notify_one();
 
         // <--- Check and possibly change lastChunk flag ---> //
-        if (chunkHeader.has_lastchunk()) {
-          lastChunk = chunkHeader.lastchunk();
-        }
+        lastChunk = chunkHeader.hasFlag(ChunkFrameHeader::LAST_CHUNK);
       }
 
       // <--- Check and possibly change lastFile flag ---> //
@@ -270,37 +337,18 @@ namespace autocomp
   void
   Client::decompress()
   {
-    bool done = false;
-    bool dequeued;
     Buffer decompressedChunk;
     DecompressionQueueEntry entry;
     std::string currentFileName;
     PreCompressingFileProcessor preCompressingFileProcessor;
 
     std::ofstream out;
-    size_t bytesReceived = 0, currentFileSize = 0;
+    size_t bytesReceived = 0, currentFileSize = 0, chunkSizeBytes = 0;
 
     char absoluteFilename[constants::MAX_STRING_LENGTH];
 
-    while(not done) {
-      {
-        std::unique_lock<std::mutex> guard(this->mutex);
-        condition.wait(guard,
-                       [this]()
-                       { 
-                          return not this->decompressionQueue.isEmpty() or
-                                 this->doneReceiving;
-                       });
-
-        dequeued = this->decompressionQueue.pop(entry);
-
-        done = this->decompressionQueue.isEmpty() and this->doneReceiving;
-      }
-
-      if (not dequeued) {
-        continue;
-      }
-
+    // Runs until the queue is closed and drained
+    while(this->decompressionQueue.pop(entry)) {
       // File initial message
       if (entry.fileInitialMessage.IsInitialized()) {
         ::strncpy(absoluteFilename, entry.fileInitialMessage.filename().c_str(),
@@ -325,17 +373,26 @@ namespace autocomp
 
         bytesReceived = 0;
         currentFileSize = entry.fileInitialMessage.filesize();
+        chunkSizeBytes = entry.fileInitialMessage.chunksize() * 1024;
 
         decompressedChunk.setData("");
-        decompressedChunk.resize(entry.fileInitialMessage.chunksize() * 1024);
+        decompressedChunk.resize(chunkSizeBytes);
       }
       // New chunk of already open file. Decompress
       else {
+        const Compressor chunkCompressor =
+          static_cast<Compressor>(entry.chunkHeader.compressor);
+
+        // Since version 2 the exact size of the decompressed chunk is known
+        if (decompressedChunk.getCapacity() <
+              entry.chunkHeader.uncompressedSize) {
+          decompressedChunk.resize(entry.chunkHeader.uncompressedSize);
+        }
+
         // <--- Decompress chunk ---> //
-        if (entry.chunkHeader.compressor() != COPY
-            and not this->preCompression) {
+        if (chunkCompressor != COPY and not this->preCompression) {
           try {
-            this->compressors.at(entry.chunkHeader.compressor())
+            this->compressors.at(chunkCompressor)
                              ->decompress(entry.chunk, decompressedChunk);
           }
           catch (exceptions::DecompressionError & error) {
@@ -345,15 +402,29 @@ namespace autocomp
                        << currentFileName << ": " << error.what();
           }
         }
-        else {
-          decompressedChunk.swap(entry.chunk);
+
+        // Uncompressed chunks are written straight from the received buffer
+        const Buffer & outputChunk =
+          (chunkCompressor != COPY and not this->preCompression)
+            ? decompressedChunk
+            : entry.chunk;
+
+        // Every chunk but the last one has chunkSizeBytes bytes, so chunks
+        // can be written in any order
+        std::streampos chunkPosition =
+          entry.chunkHeader.chunkIndex * chunkSizeBytes;
+
+        if (out.tellp() != chunkPosition) {
+          out.seekp(chunkPosition);
         }
 
-        out.write(decompressedChunk.getData(), decompressedChunk.getSize());
-        bytesReceived += decompressedChunk.getSize();
+        out.write(outputChunk.getData(), outputChunk.getSize());
+        bytesReceived += outputChunk.getSize();
 
-        if (entry.chunkHeader.has_lastchunk() and
-            entry.chunkHeader.lastchunk()) {
+        // The receiving thread reuses the buffer for the next chunks
+        this->chunkPool->release(std::move(entry.chunk));
+
+        if (entry.chunkHeader.hasFlag(ChunkFrameHeader::LAST_CHUNK)) {
           out.close();
 
           // Decompress file
@@ -394,6 +465,58 @@ namespace autocomp
     }
   }
 
+  // Receives the next chunk frame. Control messages are length prefixed and
+  // no valid length matches the chunk frame magic number, so the first four
+  // bytes tell them apart
+  void Client::receiveChunkFrame(ChunkFrameHeader & chunkHeader, Buffer & chunk)
+  {
+    char chunkHeaderBuffer[CHUNK_FRAME_HEADER_SIZE];
+
+    this->socket.receive(chunkHeaderBuffer, sizeof(uint32_t));
+
+    if (not ChunkFrameHeader::isChunkFrame(chunkHeaderBuffer)) {
+      uint32_t networkByteOrderMessageSize;
+      std::memcpy(&networkByteOrderMessageSize, chunkHeaderBuffer,
+                  sizeof(networkByteOrderMessageSize));
+
+      std::vector<char> messageBuffer(ntohl(networkByteOrderMessageSize));
+      this->socket.receive(messageBuffer.data(), messageBuffer.size());
+
+      messaging::ErrorMessage errorMessage;
+
+      throw exceptions::NetworkError(
+          deserializeMessage(messageBuffer, errorMessage)
+            ? errorMessage.message()
+            : "Received invalid chunk frame from server"
+        );
+    }
+
+    this->socket.receive(chunkHeaderBuffer + sizeof(uint32_t),
+                         CHUNK_FRAME_HEADER_SIZE - sizeof(uint32_t));
+
+    if (not chunkHeader.deserialize(chunkHeaderBuffer)) {
+      throw exceptions::NetworkError("Received chunk frame with unsupported "
+                                     "version from server");
+    }
+
+    if (chunk.getCapacity() < chunkHeader.compressedSize) {
+      chunk.resize(chunkHeader.compressedSize);
+    }
+
+    this->socket.receive(chunk.getData(), chunkHeader.compressedSize);
+    chunk.setSize(chunkHeader.compressedSize);
+
+    if (chunkHeader.hasFlag(ChunkFrameHeader::HAS_CHECKSUM) and
+        chunkHeader.checksum !=
+          ::crc32(0, reinterpret_cast<const Bytef *>(chunk.getData()),
+                  chunk.getSize())) {
+      throw exceptions::NetworkError(std::string("Checksum mismatch in chunk #")
+                                       .append(std::to_string(
+                                                  chunkHeader.chunkIndex
+                                                )));
+    }
+  }
+
   messaging::FileTransmissionRequest
   Client::configureFileRequestMessage(const std::string & path,
                                       const FileRequestMode & mode,
@@ -420,6 +543,24 @@ namespace autocomp
       message.set_compressionlevel(*compressionLevel);
     }
 
+    message.set_protocolversion(this->protocolVersion);
+
+    if (this->chunkChecksums) {
+      message.set_chunkchecksums(true);
+    }
+
+    if (this->weight != 1) {
+      message.set_weight(this->weight);
+    }
+
+    if (this->maxRate > 0) {
+      message.set_maxrate(this->maxRate);
+    }
+
+    if (this->occupancySetpoint > 0) {
+      message.set_occupancysetpoint(this->occupancySetpoint);
+    }
+
     return message;
   }
 
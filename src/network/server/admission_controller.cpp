@@ -0,0 +1,293 @@
+/**
+ *  AutoComp Admission Controller
+ *  admission_controller.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "network/server/admission_controller.hpp"
+
+#include <algorithm>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  AdmissionController::Session::Session(
+      AdmissionController * admissionController
+    )
+    : admissionController(admissionController)
+  {}
+
+  AdmissionController::Session::Session(Session && other)
+    : admissionController(other.admissionController)
+  {
+    other.admissionController = nullptr;
+  }
+
+  AdmissionController::Session & AdmissionController::Session::operator=(
+      Session && other
+    )
+  {
+    if (this != &other) {
+      if (this->admissionController) {
+        this->admissionController->release();
+      }
+
+      this->admissionController = other.admissionController;
+      other.admissionController = nullptr;
+    }
+
+    return *this;
+  }
+
+  AdmissionController::Session::~Session()
+  {
+    if (this->admissionController) {
+      this->admissionController->release();
+    }
+  }
+
+  AdmissionController::Session::operator bool() const
+  {
+    return this->admissionController != nullptr;
+  }
+
+  AdmissionController::AdmissionController(
+      const std::size_t & maxSessions,
+      const std::size_t & maxQueuedSessions,
+      const std::chrono::milliseconds & maxQueueWaitTime
+    )
+    : maxSessions(maxSessions),
+      maxQueuedSessions(maxQueuedSessions),
+      maxQueueWaitTime(maxQueueWaitTime),
+      stats(),
+      totalQueueWaitTime(0),
+      done(false)
+  {
+    this->stats.maxSessions = maxSessions;
+    this->timeoutThread =
+      std::thread(&AdmissionController::expireWaitingRequests, this);
+  }
+
+  AdmissionController::~AdmissionController()
+  {
+    this->shutdown();
+  }
+
+  void AdmissionController::setLimits(
+      const std::size_t & maxSessions,
+      const std::size_t & maxQueuedSessions,
+      const std::chrono::milliseconds & maxQueueWaitTime
+    )
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    this->maxSessions = maxSessions;
+    this->stats.maxSessions = maxSessions;
+    this->maxQueuedSessions = maxQueuedSessions;
+    this->maxQueueWaitTime = maxQueueWaitTime;
+  }
+
+  // Requests are admitted in order, so a free slot goes to one that is
+  // already waiting before a new one
+  void AdmissionController::admit(const Clock::time_point & enqueueTime,
+                                  AdmissionHandler && handler)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    if (not this->done and
+        this->stats.activeSessions < this->maxSessions and
+        this->waitingRequests.empty()) {
+      Session session = this->takeSlot(enqueueTime);
+      lock.unlock();
+      handler(std::move(session));
+
+      return;
+    }
+
+    if (this->done or
+        this->waitingRequests.size() >= this->maxQueuedSessions) {
+      this->stats.rejectedSessions++;
+      lock.unlock();
+      handler(Session());
+
+      return;
+    }
+
+    this->waitingRequests.push_back({enqueueTime,
+                                     enqueueTime + this->maxQueueWaitTime,
+                                     std::move(handler)});
+    this->stats.queuedSessions = this->waitingRequests.size();
+    this->waitingRequestsChanged.notify_one();
+  }
+
+  void AdmissionController::shutdown()
+  {
+    std::deque<WaitingRequest> refusedRequests;
+
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      this->done = true;
+      this->stats.rejectedSessions += this->waitingRequests.size();
+      this->stats.queuedSessions = 0;
+      refusedRequests.swap(this->waitingRequests);
+      this->waitingRequestsChanged.notify_one();
+    }
+
+    if (this->timeoutThread.joinable()) {
+      this->timeoutThread.join();
+    }
+
+    for (WaitingRequest & refusedRequest : refusedRequests) {
+      refusedRequest.handler(Session());
+    }
+  }
+
+  AdmissionStats AdmissionController::getStats() const
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    return this->stats;
+  }
+
+  // The handlers are called without the mutex, since they may end sessions
+  // or admit requests themselves
+  void AdmissionController::release()
+  {
+    std::deque<WaitingRequest> refusedRequests;
+    WaitingRequest admittedRequest;
+    Session session;
+
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      this->stats.activeSessions--;
+
+      const Clock::time_point now = Clock::now();
+
+      while (not this->waitingRequests.empty() and
+             this->stats.activeSessions < this->maxSessions) {
+        WaitingRequest waitingRequest =
+          std::move(this->waitingRequests.front());
+        this->waitingRequests.pop_front();
+
+        if (waitingRequest.deadline < now) {
+          this->stats.timedOutSessions++;
+          refusedRequests.push_back(std::move(waitingRequest));
+          continue;
+        }
+
+        session = this->takeSlot(waitingRequest.enqueueTime);
+        admittedRequest = std::move(waitingRequest);
+        break;
+      }
+
+      this->stats.queuedSessions = this->waitingRequests.size();
+    }
+
+    for (WaitingRequest & refusedRequest : refusedRequests) {
+      refusedRequest.handler(Session());
+    }
+
+    if (session) {
+      admittedRequest.handler(std::move(session));
+    }
+  }
+
+  AdmissionController::Session AdmissionController::takeSlot(
+      const Clock::time_point & enqueueTime
+    )
+  {
+    const double waitTimeMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - enqueueTime)
+        .count();
+
+    this->stats.activeSessions++;
+    this->stats.admittedSessions++;
+    this->stats.peakActiveSessions = std::max(this->stats.peakActiveSessions,
+                                              this->stats.activeSessions);
+
+    this->totalQueueWaitTime += waitTimeMs;
+    this->stats.meanQueueWaitTime =
+      this->totalQueueWaitTime / this->stats.admittedSessions;
+    this->stats.maxQueueWaitTime = std::max(this->stats.maxQueueWaitTime,
+                                            waitTimeMs);
+
+    return Session(this);
+  }
+
+  // Sleeps until the earliest deadline of the waiting requests. The limits
+  // may have changed while they waited, so they are not in deadline order
+  void AdmissionController::expireWaitingRequests()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (not this->done) {
+      if (this->waitingRequests.empty()) {
+        this->waitingRequestsChanged.wait(lock);
+        continue;
+      }
+
+      const Clock::time_point earliestDeadline =
+        std::min_element(this->waitingRequests.begin(),
+                         this->waitingRequests.end(),
+                         [] (const WaitingRequest & first,
+                             const WaitingRequest & second)
+                         {
+                           return first.deadline < second.deadline;
+                         })->deadline;
+
+      if (Clock::now() < earliestDeadline) {
+        this->waitingRequestsChanged.wait_until(lock, earliestDeadline);
+        continue;
+      }
+
+      std::deque<WaitingRequest> refusedRequests;
+      const Clock::time_point now = Clock::now();
+
+      for (auto waitingRequest = this->waitingRequests.begin();
+           waitingRequest != this->waitingRequests.end(); ) {
+        if (waitingRequest->deadline <= now) {
+          refusedRequests.push_back(std::move(*waitingRequest));
+          waitingRequest = this->waitingRequests.erase(waitingRequest);
+        }
+        else {
+          ++waitingRequest;
+        }
+      }
+
+      this->stats.timedOutSessions += refusedRequests.size();
+      this->stats.queuedSessions = this->waitingRequests.size();
+
+      lock.unlock();
+
+      for (WaitingRequest & refusedRequest : refusedRequests) {
+        refusedRequest.handler(Session());
+      }
+
+      lock.lock();
+    }
+  }
+
+  std::ostream & operator<<(std::ostream & stream,
+                            const AdmissionStats & stats)
+  {
+    return stream << "{activeSessions: " << stats.activeSessions
+                  << "/" << stats.maxSessions
+                  << ", peakActiveSessions: " << stats.peakActiveSessions
+                  << ", queuedSessions: " << stats.queuedSessions
+                  << ", admittedSessions: " << stats.admittedSessions
+                  << ", rejectedSessions: " << stats.rejectedSessions
+                  << ", timedOutSessions: " << stats.timedOutSessions
+                  << ", meanQueueWaitTime: " << stats.meanQueueWaitTime
+                  << " ms, maxQueueWaitTime: " << stats.maxQueueWaitTime
+                  << " ms}";
+  }
+
+  } // namespace net
+} // namespace autocomp
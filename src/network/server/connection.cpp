@@ -0,0 +1,425 @@
+/**
+ *  AutoComp Connection
+ *  connection.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "network/server/connection.hpp"
+#include "network/server/reactor.hpp"
+
+#include <algorithm>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  Connection::Connection(const std::shared_ptr<TCPSocket> & socket,
+                         const std::size_t & queueMaxBytes,
+                         const std::size_t & queueMaxFrames)
+    : socket(socket),
+      transmissionQueue(queueMaxBytes, queueMaxFrames),
+      state(State::RECEIVING_REQUEST),
+      requestSize(0),
+      requestBytesRead(0),
+      hasCurrentFrame(false),
+      currentFrameBytesSent(0),
+      currentFrameSize(0),
+      bandwidthEstimator(std::make_shared<BandwidthEstimator>()),
+      publishedBandwidth(0),
+      frameBatching(false),
+      resourceState(nullptr),
+      memoryGovernor(nullptr),
+      producerSuspended(false),
+      memoryExhausted(false),
+      flushScheduled(false),
+      reactor(nullptr),
+      loopIndex(0)
+  {
+    this->socket->setNonBlocking(true);
+  }
+
+  const std::shared_ptr<TCPSocket> & Connection::getSocket() const
+  {
+    return this->socket;
+  }
+
+  const BoundedQueue<Frame> & Connection::getTransmissionQueue() const
+  {
+    return this->transmissionQueue;
+  }
+
+  std::shared_ptr<const BandwidthEstimator>
+  Connection::getBandwidthEstimator() const
+  {
+    return this->bandwidthEstimator;
+  }
+
+  void Connection::setRequestHandler(const RequestHandler & requestHandler)
+  {
+    this->requestHandler = requestHandler;
+  }
+
+  void Connection::setResumeHandler(
+      const std::function<void()> & resumeHandler
+    )
+  {
+    this->resumeHandler = resumeHandler;
+  }
+
+  void Connection::setCloseHandler(const CloseHandler & closeHandler)
+  {
+    this->closeHandler = closeHandler;
+  }
+
+  void Connection::setChunkPool(const std::shared_ptr<BufferPool> & chunkPool)
+  {
+    this->chunkPool = chunkPool;
+  }
+
+  void Connection::setFrameBatching(const bool & frameBatching)
+  {
+    this->frameBatching = frameBatching;
+  }
+
+  void Connection::setResourceState(ResourceState * resourceState)
+  {
+    this->resourceState = resourceState;
+  }
+
+  void Connection::setMemoryGovernor(MemoryGovernor * memoryGovernor)
+  {
+    this->memoryGovernor = memoryGovernor;
+  }
+
+  Connection::QueueResult Connection::queue(Frame && frame)
+  {
+    std::size_t frameSize = frame.getSize();
+
+    if (this->memoryGovernor) {
+      if (this->transmissionQueue.isEmpty()) {
+        this->memoryGovernor->forceReserve(frameSize);
+      }
+      else if (not this->memoryGovernor->tryReserve(frameSize) and
+               not this->reserveFromChunkPool(frameSize)) {
+        this->memoryExhausted.store(true);
+
+        return this->transmissionQueue.isClosed() ? QueueResult::CLOSED
+                                                  : QueueResult::FULL;
+      }
+    }
+
+    if (not this->transmissionQueue.tryPush(std::move(frame))) {
+      this->releaseMemory(frameSize);
+
+      return this->transmissionQueue.isClosed() ? QueueResult::CLOSED
+                                                : QueueResult::FULL;
+    }
+
+    this->scheduleFlush();
+
+    return QueueResult::QUEUED;
+  }
+
+  // The producer and the reactor race for the suspended flag: whichever
+  // clears it resumes the producer, so it is resumed exactly once
+  bool Connection::suspend()
+  {
+    this->producerSuspended.store(true);
+
+    if (this->canResumeProducer() and
+        this->producerSuspended.exchange(false)) {
+      return false;
+    }
+
+    return true;
+  }
+
+  void Connection::clearQueue()
+  {
+    this->releaseMemory(this->transmissionQueue.clear());
+  }
+
+  void Connection::finish()
+  {
+    this->transmissionQueue.close();
+    this->scheduleFlush();
+  }
+
+  void Connection::scheduleFlush()
+  {
+    if (not this->flushScheduled.exchange(true)) {
+      this->reactor->schedule(this->shared_from_this());
+    }
+  }
+
+  // Reads the request, which is sent length prefixed. Edge triggered
+  // notifications require reading until the socket is empty
+  void Connection::receive()
+  {
+    const std::size_t prefixSize = sizeof(this->requestSize);
+
+    try {
+      while (this->state == State::RECEIVING_REQUEST) {
+        std::size_t bytesRead;
+
+        if (this->requestBytesRead < prefixSize) {
+          bytesRead = this->socket->tryRead(
+              reinterpret_cast<char *>(&this->requestSize) +
+                this->requestBytesRead,
+              prefixSize - this->requestBytesRead
+            );
+
+          if (bytesRead == 0) {
+            return;
+          }
+
+          this->requestBytesRead += bytesRead;
+
+          if (this->requestBytesRead < prefixSize) {
+            continue;
+          }
+
+          this->requestSize = ntohl(this->requestSize);
+
+          if (this->requestSize > constants::MAX_REQUEST_SIZE) {
+            this->fail("Request too big");
+            return;
+          }
+
+          this->request.resize(this->requestSize);
+        }
+        else if (this->requestBytesRead < prefixSize + this->requestSize) {
+          bytesRead = this->socket->tryRead(
+              this->request.data() + this->requestBytesRead - prefixSize,
+              prefixSize + this->requestSize - this->requestBytesRead
+            );
+
+          if (bytesRead == 0) {
+            return;
+          }
+
+          this->requestBytesRead += bytesRead;
+        }
+
+        if (this->requestBytesRead == prefixSize + this->requestSize) {
+          this->state = State::TRANSMITTING;
+          this->requestHandler(this->shared_from_this(),
+                               std::move(this->request));
+        }
+      }
+    }
+    catch (exceptions::NetworkError & error) {
+      this->fail(error.what());
+      return;
+    }
+
+    // Nothing else is expected from the client. It may close its end once
+    // the request is out, and real errors show up when sending
+    try {
+      char buffer[256];
+      while (this->socket->tryRead(buffer, sizeof(buffer)) > 0) {
+      }
+    }
+    catch (exceptions::NetworkError & error) {
+    }
+  }
+
+  void Connection::flush()
+  {
+    if (this->state != State::TRANSMITTING) {
+      return;
+    }
+
+    // Frames queued from now on schedule a new flush
+    this->flushScheduled.store(false);
+
+    try {
+      while (true) {
+        if (not this->hasCurrentFrame) {
+          if (not this->transmissionQueue.pop(this->currentFrame)) {
+            break;
+          }
+
+          this->hasCurrentFrame = true;
+          this->currentFrameBytesSent = 0;
+          this->currentFrameSize = this->currentFrame.getSize();
+          this->resumeProducer();
+        }
+
+        // Corking while the queue has frames lets the small ones share
+        // segments. Uncorking flushes whatever is left
+        if (this->frameBatching) {
+          this->socket->setCork(not this->transmissionQueue.isEmpty());
+        }
+
+        if (not this->socket->trySendFrame(this->currentFrame,
+                                           this->currentFrameBytesSent,
+                                           this->chunkPool)) {
+          // Resumed when the socket is writable again
+          this->sampleBandwidth();
+          return;
+        }
+
+        this->hasCurrentFrame = false;
+        this->releaseMemory(this->currentFrameSize);
+        this->resumeProducer();
+        this->sampleBandwidth();
+      }
+
+      // Checked in this order since nothing is queued once it is closed
+      if (this->transmissionQueue.isClosed() and
+          this->transmissionQueue.isEmpty()) {
+        if (this->frameBatching) {
+          this->socket->setCork(false);
+        }
+
+        this->state = State::DRAINING;
+        this->reap();
+      }
+    }
+    catch (exceptions::NetworkError & error) {
+      this->fail(error.what());
+    }
+  }
+
+  void Connection::reap()
+  {
+    if (this->state != State::DRAINING) {
+      return;
+    }
+
+    try {
+      this->socket->reapZeroCopyCompletions();
+    }
+    catch (exceptions::NetworkError & error) {
+      this->fail(error.what());
+      return;
+    }
+
+    if (this->socket->getPendingZeroCopyBuffers() == 0) {
+      this->state = State::DONE;
+    }
+  }
+
+  void Connection::resumeProducer()
+  {
+    if (this->producerSuspended.load() and
+        this->canResumeProducer() and
+        this->producerSuspended.exchange(false) and
+        this->resumeHandler) {
+      this->resumeHandler();
+    }
+  }
+
+  bool Connection::canResumeProducer() const
+  {
+    if (this->transmissionQueue.isClosed() or
+        this->transmissionQueue.isEmpty()) {
+      return true;
+    }
+
+    return not this->memoryExhausted.load() and
+           this->transmissionQueue.getLoad() <= 0.5;
+  }
+
+  // The idle chunks are only kept to save allocations, so the data in flight
+  // takes their memory first
+  bool Connection::reserveFromChunkPool(const std::size_t & bytes)
+  {
+    if (not this->chunkPool or this->chunkPool->getIdleBuffers() == 0) {
+      return false;
+    }
+
+    this->chunkPool->trim();
+
+    return this->memoryGovernor->tryReserve(bytes);
+  }
+
+  void Connection::releaseMemory(const std::size_t & bytes)
+  {
+    if (not this->memoryGovernor or bytes == 0) {
+      return;
+    }
+
+    this->memoryGovernor->release(bytes);
+    this->memoryExhausted.store(false);
+  }
+
+  void Connection::fail(const std::string & reason)
+  {
+    this->state = State::FAILED;
+    this->error = reason;
+  }
+
+  bool Connection::isClosed() const
+  {
+    return this->state == State::DONE or this->state == State::FAILED;
+  }
+
+  void Connection::close()
+  {
+    // A producer still running sees the queue closed and stops
+    this->transmissionQueue.close();
+    this->releaseMemory(this->transmissionQueue.clear());
+
+    if (this->hasCurrentFrame) {
+      this->releaseMemory(this->currentFrameSize);
+    }
+
+    this->hasCurrentFrame = false;
+    this->currentFrame = Frame();
+
+    if (this->state != State::FAILED) {
+      this->state = State::DONE;
+    }
+
+    this->socket->close();
+
+    this->publishBandwidth(0);
+
+    if (this->closeHandler) {
+      this->closeHandler(this->error);
+    }
+
+    // They may hold the producer, which holds the connection
+    this->requestHandler = nullptr;
+    this->resumeHandler = nullptr;
+    this->closeHandler = nullptr;
+  }
+
+  void Connection::sampleBandwidth()
+  {
+    if (not this->bandwidthEstimator->isSamplingDue()) {
+      return;
+    }
+
+    ConnectionInfo connectionInfo;
+    this->socket->getConnectionInfo(connectionInfo);
+
+    this->bandwidthEstimator->addSample(connectionInfo);
+    this->publishBandwidth(this->bandwidthEstimator->getBandwidth());
+  }
+
+  void Connection::publishBandwidth(const float & bandwidth)
+  {
+    if (not this->resourceState) {
+      return;
+    }
+
+    float difference = bandwidth - this->publishedBandwidth;
+    float totalBandwidth = this->resourceState->bandwidth.load();
+
+    while (not this->resourceState->bandwidth.compare_exchange_weak(
+                 totalBandwidth, std::max(totalBandwidth + difference, 0.0f)
+               )) {
+    }
+
+    this->publishedBandwidth = bandwidth;
+  }
+
+  } // namespace net
+} // namespace autocomp
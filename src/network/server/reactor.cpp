@@ -0,0 +1,323 @@
+/**
+ *  AutoComp Reactor
+ *  reactor.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "network/server/reactor.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  Reactor::Reactor(const unsigned int & nThreads)
+    : nThreads(std::max(nThreads, 1u)),
+      nextLoop(0),
+      nConnections(0),
+      done(true)
+  {}
+
+  Reactor::~Reactor()
+  {
+    this->shutdown();
+  }
+
+  void Reactor::setThreadCount(const unsigned int & nThreads)
+  {
+    if (this->loops.empty()) {
+      this->nThreads = std::max(nThreads, 1u);
+    }
+  }
+
+  std::size_t Reactor::getThreadCount() const
+  {
+    return this->nThreads;
+  }
+
+  std::size_t Reactor::getConnectionCount() const
+  {
+    return this->nConnections.load();
+  }
+
+  void Reactor::init()
+  {
+    if (not this->loops.empty()) {
+      return;
+    }
+
+    for (unsigned int i = 0; i < this->nThreads; i++) {
+      std::unique_ptr<Loop> loop(new Loop());
+
+      loop->epollFileDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+      loop->wakeUpFileDescriptor = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+      // The wake up descriptor is the only one without a connection
+      epoll_event event;
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+
+      if (loop->epollFileDescriptor == -1 or
+          loop->wakeUpFileDescriptor == -1 or
+          ::epoll_ctl(loop->epollFileDescriptor, EPOLL_CTL_ADD,
+                      loop->wakeUpFileDescriptor, &event) == -1) {
+        std::string errorMessage(std::string("Error initializing reactor: ")
+                                   .append(std::strerror(errno)));
+
+        ::close(loop->epollFileDescriptor);
+        ::close(loop->wakeUpFileDescriptor);
+        this->shutdown();
+
+        throw exceptions::NetworkError(errorMessage);
+      }
+
+      this->loops.push_back(std::move(loop));
+    }
+
+    this->done.store(false);
+
+    for (auto & loop : this->loops) {
+      loop->thread = std::thread(&Reactor::run, this, std::ref(*loop));
+    }
+  }
+
+  void Reactor::shutdown()
+  {
+    this->done.store(true);
+
+    for (auto & loop : this->loops) {
+      this->wakeUp(*loop);
+    }
+
+    for (auto & loop : this->loops) {
+      if (loop->thread.joinable()) {
+        loop->thread.join();
+      }
+
+      // Connections the thread never picked up, or left open
+      for (auto & connection : loop->addedConnections) {
+        loop->connections.emplace(connection.get(), connection);
+      }
+
+      loop->addedConnections.clear();
+      loop->scheduledConnections.clear();
+
+      while (not loop->connections.empty()) {
+        this->remove(*loop, loop->connections.begin()->first);
+      }
+
+      ::close(loop->epollFileDescriptor);
+      ::close(loop->wakeUpFileDescriptor);
+    }
+
+    this->loops.clear();
+  }
+
+  // Hands the connection over to a thread, round robin
+  void Reactor::add(const std::shared_ptr<Connection> & connection)
+  {
+    if (this->loops.empty()) {
+      connection->fail("Reactor not running");
+      connection->close();
+      return;
+    }
+
+    std::size_t loopIndex = this->nextLoop.fetch_add(1) % this->loops.size();
+    Loop & loop = *this->loops[loopIndex];
+
+    connection->reactor = this;
+    connection->loopIndex = loopIndex;
+    this->nConnections.fetch_add(1);
+
+    {
+      std::lock_guard<std::mutex> guard(loop.mutex);
+      loop.addedConnections.push_back(connection);
+    }
+
+    this->wakeUp(loop);
+  }
+
+  void Reactor::schedule(const std::shared_ptr<Connection> & connection)
+  {
+    Loop & loop = *this->loops[connection->loopIndex];
+
+    {
+      std::lock_guard<std::mutex> guard(loop.mutex);
+      loop.scheduledConnections.push_back(connection);
+    }
+
+    this->wakeUp(loop);
+  }
+
+  void Reactor::wakeUp(Loop & loop)
+  {
+    uint64_t value = 1;
+
+    while (::write(loop.wakeUpFileDescriptor, &value, sizeof(value)) == -1 and
+           errno == EINTR) {
+    }
+  }
+
+  // Function that each thread runs
+  void Reactor::run(Loop & loop)
+  {
+    epoll_event events[constants::REACTOR_MAX_EVENTS];
+
+    while (not this->done.load()) {
+      // Zero copy completions are polled while connections wait for them,
+      // in case no event reports them
+      int timeout = loop.drainingConnections.empty() ? -1 : 10;
+
+      int nEvents = ::epoll_wait(loop.epollFileDescriptor, events,
+                                 constants::REACTOR_MAX_EVENTS, timeout);
+
+      if (nEvents == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        break;
+      }
+
+      for (int i = 0; i < nEvents; i++) {
+        auto connection = static_cast<Connection *>(events[i].data.ptr);
+
+        if (connection == nullptr) {
+          this->handleWakeUp(loop);
+          continue;
+        }
+
+        // Removed while handling a previous event of this batch
+        if (loop.connections.find(connection) == loop.connections.end()) {
+          continue;
+        }
+
+        if (events[i].events & EPOLLERR) {
+          connection->reap();
+        }
+
+        if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+          connection->receive();
+        }
+
+        if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+          connection->flush();
+        }
+
+        this->update(loop, connection);
+      }
+
+      auto drainingConnections = loop.drainingConnections;
+
+      for (Connection * connection : drainingConnections) {
+        connection->reap();
+        this->update(loop, connection);
+      }
+    }
+  }
+
+  void Reactor::handleWakeUp(Loop & loop)
+  {
+    uint64_t value;
+    while (::read(loop.wakeUpFileDescriptor, &value, sizeof(value)) > 0) {
+    }
+
+    std::vector<std::shared_ptr<Connection>> addedConnections;
+    std::vector<std::shared_ptr<Connection>> scheduledConnections;
+
+    {
+      std::lock_guard<std::mutex> guard(loop.mutex);
+      addedConnections.swap(loop.addedConnections);
+      scheduledConnections.swap(loop.scheduledConnections);
+    }
+
+    for (auto & connection : addedConnections) {
+      this->registerConnection(loop, connection);
+    }
+
+    for (auto & connection : scheduledConnections) {
+      if (loop.connections.find(connection.get()) == loop.connections.end()) {
+        continue;
+      }
+
+      connection->flush();
+      this->update(loop, connection.get());
+    }
+  }
+
+  void Reactor::registerConnection(
+      Loop & loop,
+      const std::shared_ptr<Connection> & connection
+    )
+  {
+    loop.connections.emplace(connection.get(), connection);
+
+    // Edge triggered: the connection is told when the socket becomes
+    // readable or writable, and works until it would block
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = connection.get();
+
+    if (::epoll_ctl(loop.epollFileDescriptor, EPOLL_CTL_ADD,
+                    connection->socket->getFileDescriptor(), &event) == -1) {
+      connection->fail(std::string("Error registering connection: ")
+                         .append(std::strerror(errno)));
+    }
+
+    this->update(loop, connection.get());
+  }
+
+  void Reactor::update(Loop & loop, Connection * connection)
+  {
+    auto draining = std::find(loop.drainingConnections.begin(),
+                              loop.drainingConnections.end(), connection);
+
+    if (connection->state == Connection::State::DRAINING) {
+      if (draining == loop.drainingConnections.end()) {
+        loop.drainingConnections.push_back(connection);
+      }
+    }
+    else if (draining != loop.drainingConnections.end()) {
+      loop.drainingConnections.erase(draining);
+    }
+
+    if (connection->isClosed()) {
+      this->remove(loop, connection);
+    }
+  }
+
+  void Reactor::remove(Loop & loop, Connection * connection)
+  {
+    auto entry = loop.connections.find(connection);
+
+    if (entry == loop.connections.end()) {
+      return;
+    }
+
+    // Keeps the connection alive until it is closed
+    std::shared_ptr<Connection> removedConnection = entry->second;
+    loop.connections.erase(entry);
+
+    loop.drainingConnections.erase(
+        std::remove(loop.drainingConnections.begin(),
+                    loop.drainingConnections.end(), connection),
+        loop.drainingConnections.end()
+      );
+
+    ::epoll_ctl(loop.epollFileDescriptor, EPOLL_CTL_DEL,
+                removedConnection->socket->getFileDescriptor(), nullptr);
+
+    removedConnection->close();
+    this->nConnections.fetch_sub(1);
+  }
+
+  } // namespace net
+} // namespace autocomp
@@ -9,32 +9,107 @@
 
 #include "network/server/server.hpp"
 
+#include <unistd.h>
+#include <sys/stat.h>
+
 namespace autocomp
 {
   namespace net
   {
 
+  namespace
+  {
+    // Whether the compiled tree was written after the text one was last
+    // changed. A text model retrained since then makes it stale
+    bool isBinaryDecisionTreeCurrent()
+    {
+      struct stat binaryStatus, textStatus;
+
+      if (::access(constants::DECISION_TREE_BINARY_FILENAME.c_str(),
+                   R_OK) != 0 or
+          ::stat(constants::DECISION_TREE_BINARY_FILENAME.c_str(),
+                 &binaryStatus) != 0) {
+        return false;
+      }
+
+      if (::stat(constants::DECISION_TREE_FILENAME.c_str(),
+                 &textStatus) != 0) {
+        return true;
+      }
+
+      return binaryStatus.st_mtim.tv_sec > textStatus.st_mtim.tv_sec or
+             (binaryStatus.st_mtim.tv_sec == textStatus.st_mtim.tv_sec and
+              binaryStatus.st_mtim.tv_nsec >= textStatus.st_mtim.tv_nsec);
+    }
+
+    // An ensemble, if one was exported, is preferred to the decision tree,
+    // and the compiled tree, which loads without parsing, to the text one
+    // unless it is older
+    const std::string & getModelFilename()
+    {
+      if (::access(constants::ENSEMBLE_MODEL_FILENAME.c_str(), R_OK) == 0) {
+        return constants::ENSEMBLE_MODEL_FILENAME;
+      }
+
+      return isBinaryDecisionTreeCurrent()
+               ? constants::DECISION_TREE_BINARY_FILENAME
+               : constants::DECISION_TREE_FILENAME;
+    }
+  }
+
   const LEVELS Server::ERROR{g3::kWarningValue + 1, {"ERROR"}};
 
   Server::Server(const unsigned short & port, const unsigned int & nThreads,
                  const std::string & shutdownPipeName)
-    : serverSocket(port),
+    : memoryGovernor(constants::MEMORY_BUDGET),
+      serverSocket(port, constants::SERVER_SOCKET_BACKLOG),
       requestThreadPool(nThreads),
-      transmissionThreadPool(nThreads),
+      sessionScheduler(requestThreadPool),
+      reactor(constants::REACTOR_THREADS),
+      admissionController(constants::MAX_SESSIONS,
+                          constants::MAX_QUEUED_SESSIONS,
+                          std::chrono::milliseconds(
+                            constants::MAX_QUEUE_WAIT_TIME)),
+      nAcceptors(1),
+      acceptorWakeUpFileDescriptor(-1),
+      acceptedConnections(0),
+      shardIndex(0),
       doneServing(true),
       shutdownPipeName(shutdownPipeName),
-      decisionTree(constants::DECISION_TREE_FILENAME)
+      model(ClassificationModel::load(getModelFilename())),
+      banditModelFilename(constants::BANDIT_MODEL_FILENAME),
+      banditWarmStart(true),
+      zeroCopyThreshold(0),
+      frameBatching(false),
+      transmissionQueueMaxBytes(constants::TRANSMISSION_QUEUE_MAX_BYTES),
+      transmissionQueueMaxFrames(constants::TRANSMISSION_QUEUE_MAX_FRAMES)
   {}
 
   Server::Server(const unsigned short & port,
                  const std::string & shutdownPipeName,
                  const unsigned int & nThreads)
-    : serverSocket(port),
+    : memoryGovernor(constants::MEMORY_BUDGET),
+      serverSocket(port, constants::SERVER_SOCKET_BACKLOG),
       requestThreadPool(nThreads),
-      transmissionThreadPool(nThreads),
+      sessionScheduler(requestThreadPool),
+      reactor(constants::REACTOR_THREADS),
+      admissionController(constants::MAX_SESSIONS,
+                          constants::MAX_QUEUED_SESSIONS,
+                          std::chrono::milliseconds(
+                            constants::MAX_QUEUE_WAIT_TIME)),
+      nAcceptors(1),
+      acceptorWakeUpFileDescriptor(-1),
+      acceptedConnections(0),
+      shardIndex(0),
       doneServing(true),
       shutdownPipeName(shutdownPipeName),
-      decisionTree(constants::DECISION_TREE_FILENAME)
+      model(ClassificationModel::load(getModelFilename())),
+      banditModelFilename(constants::BANDIT_MODEL_FILENAME),
+      banditWarmStart(true),
+      zeroCopyThreshold(0),
+      frameBatching(false),
+      transmissionQueueMaxBytes(constants::TRANSMISSION_QUEUE_MAX_BYTES),
+      transmissionQueueMaxFrames(constants::TRANSMISSION_QUEUE_MAX_FRAMES)
   {}
 
   Server::~Server()
@@ -47,6 +122,108 @@ namespace autocomp
     return this->serverSocket.getPort();
   }
 
+  void Server::setZeroCopyThreshold(const std::size_t & zeroCopyThreshold)
+  {
+    this->zeroCopyThreshold = zeroCopyThreshold;
+  }
+
+  void Server::setFrameBatching(const bool & frameBatching)
+  {
+    this->frameBatching = frameBatching;
+  }
+
+  void Server::setTransmissionQueueCapacity(const std::size_t & maxBytes,
+                                            const std::size_t & maxFrames)
+  {
+    this->transmissionQueueMaxBytes = maxBytes;
+    this->transmissionQueueMaxFrames = maxFrames;
+  }
+
+  void Server::setAdmissionLimits(const std::size_t & maxSessions,
+                                  const std::size_t & maxQueuedSessions,
+                                  const unsigned int & maxQueueWaitTime)
+  {
+    this->admissionController.setLimits(
+        maxSessions, maxQueuedSessions,
+        std::chrono::milliseconds(maxQueueWaitTime)
+      );
+  }
+
+  void Server::setMemoryBudget(const std::size_t & memoryBudget)
+  {
+    this->memoryGovernor.setBudget(memoryBudget);
+  }
+
+  void Server::setBanditModel(const std::string & filename,
+                              const bool & warmStart)
+  {
+    this->banditModelFilename = filename;
+    this->banditWarmStart = warmStart;
+  }
+
+  BanditStats Server::getBanditStats() const
+  {
+    return this->contextualBandit.getStats();
+  }
+
+  void Server::setReactorThreadCount(const unsigned int & nThreads)
+  {
+    this->reactor.setThreadCount(nThreads);
+  }
+
+  void Server::setAcceptorCount(const unsigned int & nAcceptors)
+  {
+    this->nAcceptors = std::max(nAcceptors, 1u);
+  }
+
+  void Server::setShard(const std::shared_ptr<SharedServerState> & sharedState,
+                        const std::size_t & shardIndex)
+  {
+    this->sharedState = sharedState;
+    this->shardIndex = shardIndex;
+    this->shardSuffix = ".shard" + std::to_string(shardIndex);
+  }
+
+  AdmissionStats Server::getAdmissionStats() const
+  {
+    return this->admissionController.getStats();
+  }
+
+  MemoryStats Server::getMemoryStats() const
+  {
+    return this->memoryGovernor.getStats();
+  }
+
+  CPUBudgetStats Server::getCPUBudgetStats() const
+  {
+    return this->cpuBudget.getStats();
+  }
+
+  SchedulerStats Server::getSchedulerStats() const
+  {
+    return this->sessionScheduler.getStats();
+  }
+
+  ShardStats Server::getShardStats() const
+  {
+    AdmissionStats admissionStats = this->admissionController.getStats();
+
+    ShardStats stats;
+    stats.nShards = 1;
+    stats.cpuLoad = this->resourceState.cpuLoad.load();
+    stats.bandwidth = this->resourceState.bandwidth.load();
+    stats.acceptedConnections = this->acceptedConnections.load();
+    stats.activeSessions = admissionStats.activeSessions;
+    stats.queuedSessions = admissionStats.queuedSessions;
+    stats.admittedSessions = admissionStats.admittedSessions;
+    stats.rejectedSessions = admissionStats.rejectedSessions;
+    stats.timedOutSessions = admissionStats.timedOutSessions;
+    stats.usedMemory = this->memoryGovernor.getStats().usedBytes;
+    stats.committedCores = this->cpuBudget.getStats().committedCores;
+
+    return stats;
+  }
+
   void Server::init()
   {
     if (not this->doneServing) {
@@ -56,14 +233,46 @@ namespace autocomp
     // ---> Logging <--- //
     this->initLogger();
     this->performanceDataWriter =
-      std::make_shared<autocomp::io::PerformanceDataWriter>();
+      std::make_shared<autocomp::io::PerformanceDataWriter>(this->shardSuffix);
 
     LOG(INFO) << "Initializing AutoComp server at port "
                << this->serverSocket.getPort();
 
+    // ---> Contextual bandit initialization <--- //
+    this->contextualBandit.setWarmStartModel(
+        this->banditWarmStart ? this->model.get() : nullptr
+      );
+
+    try {
+      if (this->contextualBandit.load(this->banditModelFilename)) {
+        LOG(INFO) << "Loaded contextual bandit " << this->banditModelFilename
+                  << " " << this->contextualBandit.getStats();
+      }
+    }
+    catch (exceptions::IOError & error) {
+      LOG(WARNING) << error.what() << ". Learning from scratch";
+    }
+
+    // ---> Codec calibration <--- //
+    AnalyticCompressor::calibrate(this->codecCalibration);
+
+    LOG(INFO) << "Calibrated codecs " << this->codecCalibration;
+
     // ---> Request processing thread pool initialization <--- //
     LOG(INFO) << "Initializing request thread pool";
     this->requestThreadPool.init();
+    this->sessionScheduler.init();
+
+    // ---> Reactor initialization <--- //
+    LOG(INFO) << "Initializing reactor with " << this->reactor.getThreadCount()
+              << " threads";
+    try {
+      this->reactor.init();
+    }
+    catch (exceptions::NetworkError & error) {
+      LOG(ERROR) << error.what();
+      throw error;
+    }
 
     // ---> Shutdown named pipe initialization <--- //
     LOG(INFO) << "Initializing shutdown named pipe";
@@ -94,7 +303,12 @@ namespace autocomp
 
     // ---> Server socket initialization <--- //
     LOG(INFO) << "Initialized server socket";
+    bool sharedPort = this->nAcceptors > 1 or this->sharedState;
+
     try {
+      // Connections are closed by the server, so they linger in TIME_WAIT
+      this->serverSocket.setReuseAddress(true);
+      this->serverSocket.setReusePort(sharedPort);
       this->serverSocket.bind();
       this->serverSocket.listen();
       this->serverSocket.setSendBufferCapacity(12000000);
@@ -104,6 +318,43 @@ namespace autocomp
       throw error;
     }
 
+    // ---> Acceptor sockets initialization <--- //
+    if (this->nAcceptors > 1) {
+      LOG(INFO) << "Initializing " << this->nAcceptors - 1
+                << " extra acceptor sockets";
+
+      this->acceptorWakeUpFileDescriptor = ::eventfd(0, EFD_CLOEXEC);
+
+      if (this->acceptorWakeUpFileDescriptor == -1) {
+        std::string errorMessage(std::string("Error creating eventfd: ")
+                                   .append(std::strerror(errno)));
+
+        LOG(ERROR) << errorMessage;
+
+        throw exceptions::NetworkError(errorMessage);
+      }
+
+      try {
+        for (unsigned int i = 1; i < this->nAcceptors; i++) {
+          std::unique_ptr<TCPSocket> socket(
+              new TCPSocket(this->serverSocket.getPort(),
+                            constants::SERVER_SOCKET_BACKLOG)
+            );
+
+          socket->setReuseAddress(true);
+          socket->setReusePort(true);
+          socket->bind();
+          socket->listen();
+
+          this->acceptorSockets.push_back(std::move(socket));
+        }
+      }
+      catch (exceptions::NetworkError & error) {
+        LOG(ERROR) << error.what();
+        throw error;
+      }
+    }
+
     // Serve
     this->doneServing = false;
 
@@ -127,12 +378,61 @@ namespace autocomp
     LOG(INFO) << "Closing shutdown named pipe";
     ::close(this->shutdownPipeFileDescriptor);
 
-    LOG(INFO) << "Closing server socket";
+    if (not this->acceptorThreads.empty()) {
+      LOG(INFO) << "Stopping acceptor threads";
+      uint64_t value = 1;
+      ::write(this->acceptorWakeUpFileDescriptor, &value, sizeof(value));
+
+      for (auto & acceptorThread : this->acceptorThreads) {
+        acceptorThread.join();
+      }
+
+      this->acceptorThreads.clear();
+    }
+
+    LOG(INFO) << "Closing server sockets";
     this->serverSocket.close();
+    this->acceptorSockets.clear();
+
+    if (this->acceptorWakeUpFileDescriptor != -1) {
+      ::close(this->acceptorWakeUpFileDescriptor);
+      this->acceptorWakeUpFileDescriptor = -1;
+    }
+
+    LOG(INFO) << "Refusing the requests waiting for admission";
+    this->admissionController.shutdown();
+
+    // The scheduler stops posting slices before the pool is shut down, since
+    // the reactor threads, shut down last as the slices queue frames to them,
+    // keep resuming sessions until then
+    LOG(INFO) << "Shutting session scheduler down";
+    this->sessionScheduler.shutdown();
 
     LOG(INFO) << "Shutting request thread pool down";
     this->requestThreadPool.shutdown();
 
+    LOG(INFO) << "Shutting reactor down";
+    this->reactor.shutdown();
+
+    LOG(INFO) << "Admission stats " << this->admissionController.getStats();
+    LOG(INFO) << "Memory stats " << this->memoryGovernor.getStats();
+    LOG(INFO) << "Scheduler stats " << this->sessionScheduler.getStats();
+    LOG(INFO) << "CPU budget stats " << this->cpuBudget.getStats();
+    LOG(INFO) << "Bandit stats " << this->contextualBandit.getStats();
+
+    if (this->contextualBandit.getStats().nObservations > 0) {
+      try {
+        this->contextualBandit.save(this->banditModelFilename);
+      }
+      catch (exceptions::IOError & error) {
+        LOG(ERROR) << error.what();
+      }
+    }
+
+    if (this->sharedState) {
+      this->sharedState->publish(this->shardIndex, 0, this->getShardStats());
+    }
+
     LOG(INFO) << "Shutting CPU monitor thread down";
     this->doneServing = true;
     this->cpuMonitorThread.join();
@@ -149,7 +449,8 @@ namespace autocomp
     auto logHandle= this->logWorker
                         ->addDefaultLogger(constants::LOG_FILE_PREFIX,
                                            constants::LOG_DIR,
-                                           constants::LOG_FILE_ID);
+                                           constants::LOG_FILE_ID +
+                                             this->shardSuffix);
     g3::initializeLogging(this->logWorker.get());
     auto logFormatChanging = logHandle->call(&g3::FileSink::overrideLogDetails, 
                                              Server::logFormatter);
@@ -178,28 +479,23 @@ namespace autocomp
   {
     LOG(INFO) << "Starting server at port " << this->serverSocket.getPort();
 
+    for (auto & socket : this->acceptorSockets) {
+      this->acceptorThreads.emplace_back(&Server::runAcceptor, this,
+                                         std::ref(*socket));
+    }
+
+    // Shards wake up regularly to publish their state
+    int timeout = this->sharedState ? constants::SHARD_STATE_PUBLISH_INTERVAL
+                                    : this->infiniteTime;
+
     while (not this->doneServing) {
-      poll(this->pollFileDescriptors, this->nInputFileDescriptors,
-           this->infiniteTime);
+      poll(this->pollFileDescriptors, this->nInputFileDescriptors, timeout);
 
       for (const pollfd & fileDescriptor : this->pollFileDescriptors) {
         if (fileDescriptor.revents & POLLIN) {
           // User request
           if (fileDescriptor.fd == this->serverSocket.getFileDescriptor()) {
-
-            std::shared_ptr<TCPSocket> clientSocket = this->serverSocket
-                                                            .accept();
-
-            this->requestThreadPool.run(Server::processRequest, clientSocket,
-                                        std::ref(this->requestThreadPool),
-                                        performanceDataWriter,
-                                        std::ref(this->resourceState),
-                                        std::ref(this->decisionTree));
-
-            LOG(INFO) << "Received incoming connection from "
-                      << clientSocket->getHostname() << ":"
-                      << clientSocket->getPort()
-                      << ". Enqueued to thread pool";
+            this->acceptConnection(this->serverSocket);
           }
           // Shutdown pipe, so shut down!
           else {
@@ -210,54 +506,183 @@ namespace autocomp
           }
         }
       }
+
+      if (this->sharedState and not this->doneServing) {
+        this->publishState();
+      }
     }
 
     LOG(INFO) << "Server stopped";
   }
 
-  // This is the core, the actual server!
-  void Server::processRequest(std::shared_ptr<TCPSocket> clientSocket,
-                              ThreadPool & transmissionThreadPool,
-                              std::shared_ptr<io::PerformanceDataWriter>
-                                performanceDataWriter,
-                              ResourceState & resourceState,
-                              const DecisionTree & decisionTree)
-  {
-    SynchronousQueue<Buffer> transmissionQueue;
-    bool requestDone = false;
-    std::mutex mutex;
-    std::condition_variable condition;
-
-    auto sendErrorMessage = 
-      [&transmissionQueue, &condition] (std::string && message)
-      {
-        messaging::ErrorMessage errorMessage;
-        errorMessage.set_message(std::move(message));
-        Buffer errorMessageBuffer;
-        serializeMessage(errorMessage, errorMessageBuffer);
+  void Server::runAcceptor(TCPSocket & socket)
+  {
+    pollfd fileDescriptors[2];
+    fileDescriptors[0].fd = socket.getFileDescriptor();
+    fileDescriptors[0].events = POLLIN;
+    fileDescriptors[1].fd = this->acceptorWakeUpFileDescriptor;
+    fileDescriptors[1].events = POLLIN;
+
+    while (true) {
+      if (poll(fileDescriptors, 2, this->infiniteTime) == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
 
-        transmissionQueue.push(std::move(errorMessageBuffer));
-        condition.notify_one();
-      };
+        LOG(ERROR) << "Error polling acceptor socket: "
+                   << std::strerror(errno);
+        break;
+      }
 
-    LOG(INFO) << "Serving request from " << clientSocket->getHostname() << ":"
-              << clientSocket->getPort();
+      // Shutting down
+      if (fileDescriptors[1].revents & POLLIN) {
+        break;
+      }
+
+      if (fileDescriptors[0].revents & POLLIN) {
+        this->acceptConnection(socket);
+      }
+    }
+  }
+
+  void Server::acceptConnection(TCPSocket & socket)
+  {
+    std::shared_ptr<TCPSocket> clientSocket;
+
+    try {
+      clientSocket = socket.accept();
+    }
+    catch (exceptions::NetworkError & error) {
+      LOG(ERROR) << error.what();
+      return;
+    }
+
+    this->acceptedConnections.fetch_add(1);
 
-    // <--- Receving user request ---> //
-    std::vector<char> buffer;
-    size_t readBytes;
+    LOG(INFO) << "Received incoming connection from "
+              << clientSocket->getHostname() << ":"
+              << clientSocket->getPort()
+              << ". Handed to the reactor";
+
+    std::shared_ptr<Connection> connection;
 
     try {
-      readBytes = clientSocket->receive(buffer);
+      connection =
+        std::make_shared<Connection>(clientSocket,
+                                     this->transmissionQueueMaxBytes,
+                                     this->transmissionQueueMaxFrames);
     }
     catch (exceptions::NetworkError & error) {
-      LOG(ERROR) << "Error receiving client's request";
+      LOG(ERROR) << "Error setting connection up: " << error.what();
       return;
     }
 
+    connection->setFrameBatching(this->frameBatching);
+    connection->setResourceState(&this->resourceState);
+    connection->setMemoryGovernor(&this->memoryGovernor);
+    connection->setRequestHandler(
+        [this] (const std::shared_ptr<Connection> & connection,
+                std::vector<char> && request)
+        {
+          this->acceptRequest(connection, std::move(request));
+        }
+      );
+    connection->setCloseHandler(
+        [clientSocket] (const std::string & error)
+        {
+          if (error.empty()) {
+            LOG(INFO) << "Closed connection to "
+                      << clientSocket->getHostname() << ":"
+                      << clientSocket->getPort();
+          }
+          else {
+            LOG(ERROR) << "Error sending message to client "
+                       << clientSocket->getHostname() << ":"
+                       << clientSocket->getPort() << ": " << error;
+          }
+        }
+      );
+
+    this->reactor.add(connection);
+  }
+
+  void Server::publishState()
+  {
+    this->sharedState->publish(this->shardIndex, ::getpid(),
+                               this->getShardStats());
+  }
+
+  // Called from the reactor thread. The request waits for a session slot
+  // without holding a thread, and is handed to the request thread pool once
+  // it gets one
+  void Server::acceptRequest(const std::shared_ptr<Connection> & connection,
+                             std::vector<char> && request)
+  {
+    auto refuseRequest =
+      [this, connection] (const std::string & reason)
+      {
+        const std::shared_ptr<TCPSocket> & clientSocket =
+          connection->getSocket();
+
+        LOG(WARNING) << "Refusing request from "
+                     << clientSocket->getHostname() << ":"
+                     << clientSocket->getPort() << ", " << reason
+                     << ". Admission stats "
+                     << this->admissionController.getStats();
+        Server::queueErrorMessage(*connection, "Server busy");
+        connection->finish();
+      };
+
+    this->admissionController.admit(
+        AdmissionController::Clock::now(),
+        [this, connection, request = std::move(request), refuseRequest]
+        (AdmissionController::Session admission) mutable
+        {
+          if (not admission) {
+            refuseRequest("server busy");
+            return;
+          }
+
+          try {
+            this->requestThreadPool.post(
+                Task([this, connection, request = std::move(request),
+                      admission = std::move(admission)] () mutable
+                     {
+                       this->processRequest(connection, request,
+                                            std::move(admission));
+                     })
+              );
+          }
+          catch (std::runtime_error & error) {
+            // The server is shutting down
+            refuseRequest(error.what());
+          }
+        }
+      );
+  }
+
+  // This is the core, the actual server!
+  void Server::processRequest(std::shared_ptr<Connection> connection,
+                              std::vector<char> & request,
+                              AdmissionController::Session && admission)
+  {
+    const std::shared_ptr<TCPSocket> & clientSocket = connection->getSocket();
+
+    auto sendErrorMessage =
+      [&connection] (std::string && message)
+      {
+        Server::queueErrorMessage(*connection, std::move(message));
+        connection->finish();
+      };
+
+    LOG(INFO) << "Serving request from " << clientSocket->getHostname() << ":"
+              << clientSocket->getPort();
+
     // <--- Parsing user request ---> //
-    messaging::FileTransmissionRequest fileRequest;
-    if (not deserializeMessage(buffer, fileRequest)) {
+    auto session = std::make_shared<Session>();
+    messaging::FileTransmissionRequest & fileRequest = session->fileRequest;
+
+    if (not deserializeMessage(request, fileRequest)) {
       LOG(ERROR) << "Error parsing client's request";
       sendErrorMessage("Invalid request message");
 
@@ -269,18 +694,38 @@ namespace autocomp
               << ", mode: " << FileRequestMode_Name(fileRequest.mode())
               << ", compressor: " << Compressor_Name(fileRequest.compressor())
               << ", compressionLevel: " << fileRequest.compressionlevel()
+              << ", protocolVersion: " << fileRequest.protocolversion()
+              << ", weight: " << fileRequest.weight()
+              << ", maxRate: " << fileRequest.maxrate()
+              << ", occupancySetpoint: " << fileRequest.occupancysetpoint()
               << "}";
 
+    // Clients that do not send a version only speak the first one
+    session->protocolVersion =
+      std::min(fileRequest.has_protocolversion()
+                 ? fileRequest.protocolversion()
+                 : 1,
+               constants::PROTOCOL_VERSION);
+    session->chunkChecksums = session->protocolVersion >= 2 and
+                              fileRequest.chunkchecksums();
+
     // <--- Preparing users file user request ---> //
-    std::shared_ptr<FileProcessingStrategy> fileProcessor;
+    std::shared_ptr<FileProcessingStrategy> & fileProcessor =
+      session->fileProcessor;
 
     try {
-      fileProcessor = Server::configureFileProcessor(fileRequest,
-                                                     resourceState,
-                                                     transmissionQueue,
-                                                     clientSocket,
-                                                     performanceDataWriter,
-                                                     decisionTree);
+      fileProcessor =
+        Server::configureFileProcessor(fileRequest,
+                                       this->resourceState,
+                                       connection->getTransmissionQueue(),
+                                       clientSocket,
+                                       this->performanceDataWriter,
+                                       *this->model,
+                                       this->contextualBandit,
+                                       this->codecCalibration,
+                                       connection->getBandwidthEstimator(),
+                                       &this->memoryGovernor,
+                                       &this->cpuBudget);
     }
     catch (exceptions::InvalidCompressorError & error) {
       sendErrorMessage(error.what());
@@ -311,43 +756,159 @@ namespace autocomp
       return;
     }
 
-    // <--- Setting up transmission thread ---> //
-    LOG(INFO) << "Setting transmission thread up";
-    auto transmissionThread =
-      transmissionThreadPool.run(Server::transmit, clientSocket,
-                                 std::ref(transmissionQueue),
-                                 std::ref(requestDone), std::ref(mutex),
-                                 std::ref(condition),
-                                 std::ref(resourceState));
+    if (this->zeroCopyThreshold > 0) {
+      try {
+        clientSocket->enableZeroCopy(this->zeroCopyThreshold);
+      }
+      catch (exceptions::NetworkError & error) {
+        LOG(WARNING) << "Zero copy transmission not available: "
+                     << error.what();
+      }
+    }
+
+    // Chunk buffers go back and forth between the request threads and the
+    // reactor, which returns them once they are sent
+    session->chunkPool =
+      std::make_shared<BufferPool>(1.1 * fileProcessor->getChunkSize() * 1024);
+    session->chunkPool->setMemoryGovernor(&this->memoryGovernor);
+    connection->setChunkPool(session->chunkPool);
+
+    session->connection = connection;
+    session->admission = std::move(admission);
+    session->sendingFile = false;
+    session->nChunks = 0;
+    session->hasPendingFrame = false;
+
+    // Out of range weights are clamped rather than refused
+    unsigned int weight =
+      std::min(std::max(fileRequest.has_weight() ? fileRequest.weight() : 1,
+                        1u),
+               static_cast<unsigned int>(constants::MAX_SESSION_WEIGHT));
+
+    // The flow must not hold the session, which holds the flow
+    std::weak_ptr<Session> weakSession = session;
+    session->flow =
+      this->sessionScheduler.addFlow([this, weakSession] ()
+                                     {
+                                       auto session = weakSession.lock();
+                                       return session and
+                                              this->produce(session);
+                                     },
+                                     weight, fileRequest.maxrate());
+
+    // The connection holds the session until it is closed
+    connection->setResumeHandler(
+        [this, session] ()
+        {
+          this->sessionScheduler.schedule(session->flow);
+        }
+      );
 
-    Buffer chunk(1.1 * fileProcessor->getChunkSize() * 1024);
-    Buffer fileInitialMessageBuffer;
-    Buffer chunkHeaderBuffer;
+    session->tic = std::chrono::high_resolution_clock::now();
+
+    this->sessionScheduler.schedule(session->flow);
+  }
+
+  bool Server::produce(const std::shared_ptr<Session> & session)
+  {
+    Connection & connection = *session->connection;
+    auto sliceEnd = SessionScheduler::Clock::now() +
+                    std::chrono::milliseconds(constants::SCHEDULER_QUANTUM);
+
+    while (true) {
+      if (session->hasPendingFrame) {
+        std::size_t frameSize = session->pendingFrame.getSize();
+        Connection::QueueResult result =
+          connection.queue(std::move(session->pendingFrame));
+
+        if (result == Connection::QueueResult::CLOSED) {
+          LOG(INFO) << "Client gone, stopped processing its request";
+          return false;
+        }
+
+        if (result == Connection::QueueResult::FULL) {
+          // Resumed by the reactor once the client catches up
+          if (connection.suspend()) {
+            return false;
+          }
+
+          continue;
+        }
+
+        session->hasPendingFrame = false;
+        this->sessionScheduler.charge(*session->flow, frameSize);
+      }
+
+      // Lets the other sessions run
+      if (SessionScheduler::Clock::now() >= sliceEnd) {
+        return true;
+      }
+
+      try {
+        if (not this->produceFrame(*session)) {
+          break;
+        }
+      }
+      catch (exceptions::NetworkError & error) {
+        // The compressors query the socket, which may be closed already
+        LOG(ERROR) << "Error processing request: " << error.what();
+        connection.finish();
+        return false;
+      }
+      catch (std::exception & error) {
+        // A failing codec or allocation ends the request, and the client is
+        // told so instead of waiting for the rest of it
+        LOG(ERROR) << "Error processing request: " << error.what();
+        connection.clearQueue();
+        Server::queueErrorMessage(connection, error.what());
+        connection.finish();
+        return false;
+      }
+    }
 
-    auto tic = std::chrono::high_resolution_clock::now();
+    this->finishSession(*session);
+
+    return false;
+  }
+
+  bool Server::produceFrame(Session & session)
+  {
+    std::shared_ptr<FileProcessingStrategy> & fileProcessor =
+      session.fileProcessor;
+    const messaging::FileTransmissionRequest & fileRequest =
+      session.fileRequest;
+
+    if (not session.sendingFile) {
+      if (not fileProcessor->hasNextFile()) {
+        return false;
+      }
 
-    while(fileProcessor->hasNextFile()) {
       size_t fileSize;
 
       try {
         fileSize = fileProcessor->openNextFile();
       }
       catch (exceptions::IOError & error) {
-        sendErrorMessage(error.what());
-        continue;
+        session.pendingFrame = Server::makeErrorMessageFrame(error.what());
+        session.hasPendingFrame = true;
+        return true;
       }
       catch (exceptions::CompressionError & error) {
-        sendErrorMessage(error.what());
-        continue;
+        session.pendingFrame = Server::makeErrorMessageFrame(error.what());
+        session.hasPendingFrame = true;
+        return true;
       }
 
       messaging::FileInitialMessage fileInitialMessage;
       fileInitialMessage.set_filename(fileProcessor->getCurrentFileName());
       fileInitialMessage.set_filesize(fileSize);
       fileInitialMessage.set_chunksize(fileProcessor->getChunkSize());
+      fileInitialMessage.set_protocolversion(session.protocolVersion);
       if (not fileProcessor->hasNextFile()) {
         fileInitialMessage.set_lastfile(true);
       }
+
+      Buffer fileInitialMessageBuffer;
       serializeMessage(fileInitialMessage, fileInitialMessageBuffer);
 
       LOG(INFO) << "Sending initial message for file "
@@ -356,140 +917,140 @@ namespace autocomp
                 << (fileInitialMessage.lastfile() ? "" : "not ")
                 << "the last file";
 
-      transmissionQueue.push(std::move(fileInitialMessageBuffer));
-      condition.notify_one();
+      session.pendingFrame = Frame(std::move(fileInitialMessageBuffer));
+      session.hasPendingFrame = true;
+      session.sendingFile = true;
+      session.nChunks = 0;
 
-      uint64_t nChunks = 0;
-      Compressor usedCompressor;
+      return true;
+    }
 
-      while(fileProcessor->hasNextChunk()) {
-        try {
-          usedCompressor = fileProcessor->getNextChunk(chunk);
-        }
-        catch (exceptions::IOError & error) {
-          // Should anything be done?
-          LOG(ERROR) << "Error retreiving chunk #" << nChunks + 1;
-          break;
-        }
+    if (not fileProcessor->hasNextChunk()) {
+      session.sendingFile = false;
+      return true;
+    }
 
-        // Antes de enviar el chunk, debo enviar el chunk header
-        messaging::ChunkHeader chunkHeader;
-        chunkHeader.set_compressor(usedCompressor);
-        chunkHeader.set_chunkposition(nChunks++);
-        if (not fileProcessor->hasNextChunk()) {
-          chunkHeader.set_lastchunk(true);
-        }
-        serializeMessage(chunkHeader, chunkHeaderBuffer);
+    Buffer chunk = session.chunkPool->acquire();
+    std::size_t readBytes = fileProcessor->getCurrentFileReadBytes();
+    Compressor usedCompressor;
 
-        LOG(INFO) << "Sending header and chunk #" << nChunks << " with size "
-                  << chunk.getSize();
+    try {
+      usedCompressor = fileProcessor->getNextChunk(chunk);
+    }
+    catch (exceptions::IOError & error) {
+      // Should anything be done?
+      LOG(ERROR) << "Error retreiving chunk #" << session.nChunks + 1;
+      session.sendingFile = false;
+      return true;
+    }
 
-        transmissionQueue.push(std::move(chunkHeaderBuffer));
-        transmissionQueue.push(std::move(chunk));
-        condition.notify_one();
+    LOG(INFO) << "Sending header and chunk #" << session.nChunks + 1
+              << " with size " << chunk.getSize();
+
+    if (session.protocolVersion >= 2) {
+      ChunkFrameHeader chunkHeader;
+      chunkHeader.compressor = usedCompressor;
+      chunkHeader.chunkIndex = session.nChunks++;
+      chunkHeader.compressedSize = chunk.getSize();
+      chunkHeader.uncompressedSize =
+        fileProcessor->getCurrentFileReadBytes() - readBytes;
+      chunkHeader.setFlag(ChunkFrameHeader::LAST_CHUNK,
+                          not fileProcessor->hasNextChunk());
+
+      // The adaptive modes do not tell the level they compressed with
+      bool namesCompressor = fileRequest.mode() == COMPRESS or
+                             fileRequest.mode() == PRE_COMPRESS or
+                             fileRequest.mode() == TRAIN;
+
+      if (namesCompressor and fileRequest.has_compressionlevel() and
+          usedCompressor == fileRequest.compressor()) {
+        chunkHeader.level = fileRequest.compressionlevel();
       }
-    }
 
-    auto toc = std::chrono::high_resolution_clock::now();
+      // Pre-compressed chunks are pieces of a single compressed file
+      if (fileRequest.mode() == PRE_COMPRESS) {
+        chunkHeader.setFlag(ChunkFrameHeader::DEPENDENT_CHUNK);
+      }
 
-    std::cout << std::chrono::duration_cast<std::chrono::seconds>(
-                    toc - tic).count() << " secs" << std::endl;
+      if (session.chunkChecksums) {
+        chunkHeader.checksum =
+          ::crc32(0, reinterpret_cast<const Bytef *>(chunk.getData()),
+                  chunk.getSize());
+        chunkHeader.setFlag(ChunkFrameHeader::HAS_CHECKSUM);
+      }
 
-    if (fileRequest.mode() == TRAIN) {
-      transmissionQueue.clear();
-      sendErrorMessage("Done traning");
-      sendErrorMessage("Done traning");
-    }
+      session.pendingFrame = Frame(chunkHeader, std::move(chunk));
+      session.hasPendingFrame = true;
 
-    {
-      std::unique_lock<std::mutex> guard(mutex);
-      requestDone = true;
+      return true;
     }
-    condition.notify_one();
-    transmissionThread.wait();
-
-    LOG(INFO) << "Finished sending file to client";
-  }
-
-  void Server::transmit(std::shared_ptr<TCPSocket> clientSocket,
-                        SynchronousQueue<Buffer> & transmissionQueue,
-                        bool & requestDone, std::mutex & mutex,
-                        std::condition_variable & condition,
-                        ResourceState & resourceState)
-  {
-    LOG(INFO) << "Transmission thread set up"; 
 
-    Buffer buffer;
-    bool dequeued;
-    bool done = false;
-    std::size_t bytesSent = 0, currentBytesInBuffer;
-    std::chrono::time_point<std::chrono::high_resolution_clock> baseTime,
-                                                                currentTime;
-    float elapsedTime;
+    // Antes de enviar el chunk, debo enviar el chunk header
+    messaging::ChunkHeader chunkHeader;
+    chunkHeader.set_compressor(usedCompressor);
+    chunkHeader.set_chunkposition(session.nChunks++);
+    if (not fileProcessor->hasNextChunk()) {
+      chunkHeader.set_lastchunk(true);
+    }
 
-    baseTime = std::chrono::high_resolution_clock::now();
+    Buffer chunkHeaderBuffer;
+    serializeMessage(chunkHeader, chunkHeaderBuffer);
 
-    auto conditionChecker = [&transmissionQueue, &requestDone] ()
-                            {
-                              return not transmissionQueue.isEmpty() or
-                                     requestDone;
-                            };
+    session.pendingFrame = Frame(std::move(chunkHeaderBuffer),
+                                 std::move(chunk));
+    session.hasPendingFrame = true;
 
-    while (not done) {   
-      {
-        std::unique_lock<std::mutex> guard(mutex);
-        condition.wait(guard, conditionChecker);
-
-        dequeued = transmissionQueue.pop(buffer);
-        done = transmissionQueue.isEmpty() and requestDone;
-      }
+    return true;
+  }
 
-      if (dequeued) {
-        try {
-          currentTime = std::chrono::high_resolution_clock::now();
-          elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                            currentTime - baseTime
-                          ).count();
+  void Server::finishSession(Session & session)
+  {
+    auto toc = std::chrono::high_resolution_clock::now();
 
-          if (elapsedTime < 10) {
-          //if (elapsedTime == 0) {
-            bytesSent += clientSocket->send(buffer);
-          }
-          else {
-            currentBytesInBuffer = clientSocket->getSendBufferSize();
-            resourceState.bandwidth.store(8E-3 *
-                                          (bytesSent - currentBytesInBuffer) /
-                                            elapsedTime);
+    std::cout << std::chrono::duration_cast<std::chrono::seconds>(
+                    toc - session.tic).count() << " secs" << std::endl;
 
-#ifdef BANDWIDTH_TEST
+    if (session.fileRequest.mode() == TRAIN) {
+      session.connection->clearQueue();
+      Server::queueErrorMessage(*session.connection, "Done traning");
+      Server::queueErrorMessage(*session.connection, "Done traning");
+    }
 
-            std::cout << resourceState.bandwidth << " Mbits/s" << std::endl;
+    session.connection->finish();
 
-#endif
+    LOG(INFO) << "Finished processing request. Scheduling stats "
+              << this->sessionScheduler.getFlowStats(*session.flow);
+  }
 
-            bytesSent = currentBytesInBuffer + clientSocket->send(buffer);
-            baseTime = std::chrono::high_resolution_clock::now();
-          }
-        }
-        catch (exceptions::NetworkError & error) {
-          LOG(ERROR) << "Error sending message to client: " << error.what();
-          break;
-        }
-      }
-    }
+  void Server::queueErrorMessage(Connection & connection,
+                                 std::string && message)
+  {
+    // Sent when nothing, or next to nothing, is queued, so there is room
+    connection.queue(Server::makeErrorMessageFrame(std::move(message)));
+  }
 
-    resourceState.bandwidth.store(0);
+  Frame Server::makeErrorMessageFrame(std::string && message)
+  {
+    messaging::ErrorMessage errorMessage;
+    errorMessage.set_message(std::move(message));
+    Buffer errorMessageBuffer;
+    serializeMessage(errorMessage, errorMessageBuffer);
 
-    LOG(INFO) << "Transmission thread finished";
+    return Frame(std::move(errorMessageBuffer));
   }
 
   std::shared_ptr<FileProcessingStrategy> Server::configureFileProcessor(
       const messaging::FileTransmissionRequest & fileRequest,
       const ResourceState & resourceState,
-      const SynchronousQueue<Buffer> & transmissionQueue,
+      const BoundedQueue<Frame> & transmissionQueue,
       const std::shared_ptr<TCPSocket> & clientSocket,
       std::shared_ptr<io::PerformanceDataWriter> performanceDataWriter,
-      const DecisionTree & decisionTree
+      const ClassificationModel & model,
+      ContextualBandit & contextualBandit,
+      CodecCalibration & codecCalibration,
+      const std::shared_ptr<const BandwidthEstimator> & bandwidthEstimator,
+      MemoryGovernor * memoryGovernor,
+      CPUBudget * cpuBudget
     )
   {
     if (not fileRequest.IsInitialized()) {
@@ -506,9 +1067,39 @@ namespace autocomp
 
       case AUTOCOMP:
         compressor = std::make_shared<AutoCompCompressor<net::TCPSocket>>(
-                        &decisionTree, &resourceState, clientSocket,
-                        performanceDataWriter);
+                        &model, &resourceState, clientSocket,
+                        performanceDataWriter, bandwidthEstimator);
+        break;
+
+      case BANDIT:
+        compressor = std::make_shared<BanditCompressor<net::TCPSocket>>(
+                        &contextualBandit, &model, &resourceState,
+                        clientSocket, performanceDataWriter,
+                        bandwidthEstimator);
+        break;
+
+      case ANALYTIC:
+        compressor = std::make_shared<AnalyticCompressor>(
+                        &codecCalibration, &resourceState,
+                        performanceDataWriter, bandwidthEstimator);
+        break;
+
+      case FEEDBACK:
+      {
+        unsigned int setpoint = fileRequest.has_occupancysetpoint()
+                                  ? fileRequest.occupancysetpoint()
+                                  : constants::FEEDBACK_SETPOINT;
+
+        if (setpoint > 100) {
+          throw exceptions::InvalidRequestParameterError(
+              "Invalid occupancy setpoint " + std::to_string(setpoint)
+            );
+        }
+
+        compressor = std::make_shared<FeedbackCompressor<net::TCPSocket>>(
+                        clientSocket, setpoint / 100.0, performanceDataWriter);
         break;
+      }
 
       case COMPRESS:
       {
@@ -544,7 +1135,8 @@ namespace autocomp
           std::make_shared<TrainingCompressor>(&resourceState,
                                                &transmissionQueue,
                                                clientSocket,
-                                               performanceDataWriter);
+                                               performanceDataWriter,
+                                               bandwidthEstimator);
 
         trainCompressor->setCompressor(fileRequest.has_compressor()
                                       ? fileRequest.compressor()
@@ -564,6 +1156,10 @@ namespace autocomp
       }
     }
 
+    compressor->setTransmissionQueue(&transmissionQueue);
+    compressor->setMemoryGovernor(memoryGovernor);
+    compressor->setCPUBudget(cpuBudget);
+
     return std::make_shared<FileProcessor>(chunkSize, compressor);
   }
 
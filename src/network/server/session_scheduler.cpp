@@ -0,0 +1,462 @@
+/**
+ *  AutoComp Session Scheduler
+ *  session_scheduler.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "network/server/session_scheduler.hpp"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#include "utils/functions.hpp"
+
+#include "g3log/g3log.hpp"
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  namespace
+  {
+    double toMilliseconds(const SessionScheduler::Clock::duration & duration)
+    {
+      return std::chrono::duration<double, std::milli>(duration).count();
+    }
+  }
+
+  SessionScheduler::Flow::Flow(const SliceFunction & slice,
+                               const unsigned int & weight,
+                               const double & maxRate)
+    : slice(slice),
+      weight(weight),
+      maxRate(maxRate),
+      state(State::IDLE),
+      rescheduled(false),
+      deficit(0),
+      tokens(maxRate * constants::RATE_CAP_BURST / 1000),
+      lastRefill(Clock::now()),
+      initialCpuTime(0),
+      stats(),
+      totalQueueingDelay(0)
+  {
+    this->stats.weight = weight;
+    this->stats.maxRate = maxRate;
+  }
+
+  SessionScheduler::SessionScheduler(ThreadPool & threadPool,
+                                     const std::chrono::nanoseconds & quantum)
+    : threadPool(threadPool),
+      quantum(quantum.count()),
+      done(true),
+      nPendingDispatches(0),
+      stats(),
+      totalQueueingDelay(0)
+  {}
+
+  SessionScheduler::~SessionScheduler()
+  {
+    this->shutdown();
+  }
+
+  void SessionScheduler::init()
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    if (not this->done) {
+      return;
+    }
+
+    this->done = false;
+    this->timerThread =
+      std::thread(&SessionScheduler::releaseThrottledFlows, this);
+  }
+
+  void SessionScheduler::shutdown()
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->done = true;
+      this->throttledFlows.clear();
+
+      this->pendingDispatchesPosted.wait(lock, [this] ()
+                                         {
+                                           return this->nPendingDispatches ==
+                                                  0;
+                                         });
+    }
+
+    this->throttledFlowsChanged.notify_all();
+
+    if (this->timerThread.joinable()) {
+      this->timerThread.join();
+    }
+  }
+
+  std::shared_ptr<SessionScheduler::Flow>
+  SessionScheduler::addFlow(const SliceFunction & slice,
+                            const unsigned int & weight,
+                            const double & maxRate)
+  {
+    if (weight == 0 or weight > constants::MAX_SESSION_WEIGHT) {
+      throw std::domain_error("Invalid session weight: " +
+                              std::to_string(weight));
+    }
+
+    auto flow = std::make_shared<Flow>(slice, weight, std::max(maxRate, 0.0));
+
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    flow->initialCpuTime = this->stats.cpuTime;
+    this->stats.nFlows++;
+
+    return flow;
+  }
+
+  void SessionScheduler::schedule(const std::shared_ptr<Flow> & flow)
+  {
+    bool ready = false;
+
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      if (this->done) {
+        return;
+      }
+
+      switch (flow->state) {
+        case Flow::State::IDLE:
+          ready = this->makeReady(flow, Clock::now());
+          break;
+
+        case Flow::State::RUNNING:
+          flow->rescheduled = true;
+          break;
+
+        case Flow::State::READY:
+        case Flow::State::THROTTLED:
+          break;
+      }
+
+      this->nPendingDispatches += ready;
+    }
+
+    if (ready) {
+      this->postDispatches(1);
+    }
+  }
+
+  void SessionScheduler::charge(Flow & flow, const std::size_t & bytes)
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    flow.stats.bytes += bytes;
+
+    if (flow.maxRate > 0) {
+      this->refill(flow, Clock::now());
+      flow.tokens -= bytes;
+    }
+  }
+
+  FlowStats SessionScheduler::getFlowStats(const Flow & flow) const
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    FlowStats stats = flow.stats;
+    double elapsedCpuTime = this->stats.cpuTime - flow.initialCpuTime;
+
+    stats.cpuShare = elapsedCpuTime > 0 ? stats.cpuTime / elapsedCpuTime : 0;
+    stats.meanQueueingDelay =
+      stats.nSlices > 0 ? flow.totalQueueingDelay / stats.nSlices : 0;
+
+    return stats;
+  }
+
+  SchedulerStats SessionScheduler::getStats() const
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    SchedulerStats stats = this->stats;
+    stats.readyFlows = this->readyFlows.size();
+    stats.throttledFlows = this->throttledFlows.size();
+    stats.meanQueueingDelay =
+      stats.nSlices > 0 ? this->totalQueueingDelay / stats.nSlices : 0;
+
+    return stats;
+  }
+
+  // Each ready flow has a dispatch task posted, so the flow this one picks
+  // is never missing, though it may be another one than the flow it was
+  // posted for
+  void SessionScheduler::dispatch()
+  {
+    std::shared_ptr<Flow> flow;
+
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      flow = this->pickNext();
+
+      if (not flow) {
+        return;
+      }
+
+      double queueingDelay = toMilliseconds(Clock::now() - flow->readyTime);
+
+      flow->state = Flow::State::RUNNING;
+      flow->totalQueueingDelay += queueingDelay;
+      flow->stats.maxQueueingDelay =
+        std::max(flow->stats.maxQueueingDelay, queueingDelay);
+      this->totalQueueingDelay += queueingDelay;
+      this->stats.maxQueueingDelay =
+        std::max(this->stats.maxQueueingDelay, queueingDelay);
+    }
+
+    std::chrono::nanoseconds startCpuTime = getThreadCPUTime();
+    bool hasMoreWork = false;
+
+    // Slices handle their own errors. One that throws anyway goes idle, so it
+    // does not fail again and again
+    try {
+      hasMoreWork = flow->slice();
+    }
+    catch (std::exception & error) {
+      LOG(WARNING) << "Uncaught error in a session slice: " << error.what();
+    }
+    catch (...) {
+      LOG(WARNING) << "Uncaught unknown error in a session slice";
+    }
+
+    double cpuTime = (getThreadCPUTime() - startCpuTime).count();
+
+    bool ready = false;
+
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      flow->deficit -= cpuTime;
+      flow->stats.nSlices++;
+      flow->stats.cpuTime += cpuTime / 1E6;
+      this->stats.nSlices++;
+      this->stats.cpuTime += cpuTime / 1E6;
+
+      if ((hasMoreWork or flow->rescheduled) and not this->done) {
+        flow->rescheduled = false;
+        ready = this->makeReady(flow, Clock::now());
+        this->nPendingDispatches += ready;
+      }
+      else {
+        // An idle flow does not keep its credit, but keeps its debt
+        flow->state = Flow::State::IDLE;
+        flow->deficit = std::min(flow->deficit, 0.0);
+      }
+    }
+
+    if (ready) {
+      this->postDispatches(1);
+    }
+  }
+
+  // Counted as posted even if the pool refuses them, so that shutting down
+  // does not wait forever
+  void SessionScheduler::postDispatches(const std::size_t & nDispatches)
+  {
+    auto finishPosting = [this, &nDispatches] ()
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+
+      this->nPendingDispatches -= nDispatches;
+
+      if (this->nPendingDispatches == 0) {
+        this->pendingDispatchesPosted.notify_all();
+      }
+    };
+
+    try {
+      for (std::size_t i = 0; i < nDispatches; i++) {
+        this->threadPool.post(Task([this] ()
+                                   {
+                                     this->dispatch();
+                                   }));
+      }
+    }
+    catch (...) {
+      finishPosting();
+      throw;
+    }
+
+    finishPosting();
+  }
+
+  // Each pass over the ready flows is a round: the first flow with credit
+  // runs, and those without it get their quantum and go to the back
+  std::shared_ptr<SessionScheduler::Flow> SessionScheduler::pickNext()
+  {
+    if (this->readyFlows.empty()) {
+      return nullptr;
+    }
+
+    for (std::size_t i = 0; i < this->readyFlows.size(); i++) {
+      std::shared_ptr<Flow> flow = this->readyFlows.front();
+      this->readyFlows.pop_front();
+
+      if (flow->deficit > 0) {
+        return flow;
+      }
+
+      flow->deficit += this->quantum * flow->weight;
+      this->readyFlows.push_back(flow);
+    }
+
+    // Every flow is still in debt after a long slice: skip the rounds until
+    // the first of them has credit
+    double rounds = std::numeric_limits<double>::max();
+
+    for (const std::shared_ptr<Flow> & flow : this->readyFlows) {
+      rounds = std::min(rounds, std::floor(-flow->deficit /
+                                           (this->quantum * flow->weight)) +
+                                  1);
+    }
+
+    for (const std::shared_ptr<Flow> & flow : this->readyFlows) {
+      flow->deficit += rounds * this->quantum * flow->weight;
+    }
+
+    auto flowIterator =
+      std::find_if(this->readyFlows.begin(), this->readyFlows.end(),
+                   [] (const std::shared_ptr<Flow> & flow)
+                   {
+                     return flow->deficit > 0;
+                   });
+
+    std::shared_ptr<Flow> flow = *flowIterator;
+    this->readyFlows.erase(flowIterator);
+
+    return flow;
+  }
+
+  bool SessionScheduler::makeReady(const std::shared_ptr<Flow> & flow,
+                                   const Clock::time_point & now)
+  {
+    if (flow->maxRate > 0) {
+      this->refill(*flow, now);
+
+      if (flow->tokens < 0 and not this->done) {
+        auto releaseTime =
+          now + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(-flow->tokens /
+                                                flow->maxRate));
+
+        flow->state = Flow::State::THROTTLED;
+        flow->throttledTime = now;
+        this->throttledFlows.emplace(releaseTime, flow);
+        this->throttledFlowsChanged.notify_one();
+
+        return false;
+      }
+    }
+
+    flow->state = Flow::State::READY;
+    flow->readyTime = now;
+
+    // A flow with credit left is in the middle of its turn. Idle flows drop
+    // their credit, so those are only the ones that just ran
+    if (flow->deficit > 0) {
+      this->readyFlows.push_front(flow);
+    }
+    else {
+      this->readyFlows.push_back(flow);
+    }
+
+    return true;
+  }
+
+  void SessionScheduler::refill(Flow & flow, const Clock::time_point & now)
+    const
+  {
+    double elapsedTime =
+      std::chrono::duration<double>(now - flow.lastRefill).count();
+
+    flow.tokens = std::min(flow.tokens + flow.maxRate * elapsedTime,
+                           flow.maxRate * constants::RATE_CAP_BURST / 1000);
+    flow.lastRefill = now;
+  }
+
+  void SessionScheduler::releaseThrottledFlows()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (not this->done) {
+      if (this->throttledFlows.empty()) {
+        this->throttledFlowsChanged.wait(lock);
+        continue;
+      }
+
+      Clock::time_point releaseTime = this->throttledFlows.begin()->first;
+      Clock::time_point now = Clock::now();
+
+      if (now < releaseTime) {
+        this->throttledFlowsChanged.wait_until(lock, releaseTime);
+        continue;
+      }
+
+      std::size_t nReleasedFlows = 0;
+
+      while (not this->throttledFlows.empty() and
+             this->throttledFlows.begin()->first <= now) {
+        std::shared_ptr<Flow> flow = this->throttledFlows.begin()->second;
+        this->throttledFlows.erase(this->throttledFlows.begin());
+
+        flow->stats.throttledTime += toMilliseconds(now -
+                                                    flow->throttledTime);
+        flow->state = Flow::State::READY;
+        flow->readyTime = now;
+        this->readyFlows.push_back(flow);
+        nReleasedFlows++;
+      }
+
+      this->nPendingDispatches += nReleasedFlows;
+      lock.unlock();
+
+      this->postDispatches(nReleasedFlows);
+
+      lock.lock();
+    }
+  }
+
+  std::ostream & operator<<(std::ostream & stream, const FlowStats & stats)
+  {
+    return stream << "{weight: " << stats.weight
+                  << ", maxRate: " << stats.maxRate
+                  << " B/s, nSlices: " << stats.nSlices
+                  << ", bytes: " << stats.bytes
+                  << ", cpuTime: " << stats.cpuTime
+                  << " ms, cpuShare: " << stats.cpuShare
+                  << ", meanQueueingDelay: " << stats.meanQueueingDelay
+                  << " ms, maxQueueingDelay: " << stats.maxQueueingDelay
+                  << " ms, throttledTime: " << stats.throttledTime
+                  << " ms}";
+  }
+
+  std::ostream & operator<<(std::ostream & stream,
+                            const SchedulerStats & stats)
+  {
+    return stream << "{nFlows: " << stats.nFlows
+                  << ", readyFlows: " << stats.readyFlows
+                  << ", throttledFlows: " << stats.throttledFlows
+                  << ", nSlices: " << stats.nSlices
+                  << ", cpuTime: " << stats.cpuTime
+                  << " ms, meanQueueingDelay: " << stats.meanQueueingDelay
+                  << " ms, maxQueueingDelay: " << stats.maxQueueingDelay
+                  << " ms}";
+  }
+
+  } // namespace net
+} // namespace autocomp
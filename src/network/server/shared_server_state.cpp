@@ -0,0 +1,147 @@
+/**
+ *  AutoComp Shared Server State
+ *  shared_server_state.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "network/server/shared_server_state.hpp"
+
+#include <new>
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/mman.h>
+
+namespace autocomp
+{
+  namespace net
+  {
+
+  SharedServerState::SharedServerState(const std::size_t & nShards)
+    : slots(nullptr),
+      nShards(nShards)
+  {
+    if (nShards == 0 or nShards > constants::MAX_SHARDS) {
+      throw std::domain_error("Invalid number of shards: " +
+                              std::to_string(nShards));
+    }
+
+    void * memory = ::mmap(nullptr, nShards * sizeof(Slot),
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                           -1, 0);
+
+    if (memory == MAP_FAILED) {
+      throw exceptions::NetworkError(std::string("Error mapping the shared "
+                                                 "server state: ")
+                                       .append(std::strerror(errno)));
+    }
+
+    this->slots = static_cast<Slot *>(memory);
+
+    for (std::size_t i = 0; i < nShards; i++) {
+      new (&this->slots[i]) Slot();
+    }
+  }
+
+  SharedServerState::~SharedServerState()
+  {
+    ::munmap(this->slots, this->nShards * sizeof(Slot));
+  }
+
+  std::size_t SharedServerState::getShardCount() const
+  {
+    return this->nShards;
+  }
+
+  void SharedServerState::publish(const std::size_t & shardIndex,
+                                  const pid_t & pid,
+                                  const ShardStats & stats)
+  {
+    Slot & slot = this->slots[shardIndex];
+
+    slot.cpuLoad.store(stats.cpuLoad);
+    slot.bandwidth.store(stats.bandwidth);
+    slot.acceptedConnections.store(stats.acceptedConnections);
+    slot.activeSessions.store(stats.activeSessions);
+    slot.queuedSessions.store(stats.queuedSessions);
+    slot.admittedSessions.store(stats.admittedSessions);
+    slot.rejectedSessions.store(stats.rejectedSessions);
+    slot.timedOutSessions.store(stats.timedOutSessions);
+    slot.usedMemory.store(stats.usedMemory);
+    slot.committedCores.store(stats.committedCores);
+    slot.pid.store(pid);
+  }
+
+  ShardStats SharedServerState::getShardStats(
+      const std::size_t & shardIndex
+    ) const
+  {
+    const Slot & slot = this->slots[shardIndex];
+
+    ShardStats stats;
+    stats.nShards = slot.pid.load() != 0 ? 1 : 0;
+    stats.cpuLoad = slot.cpuLoad.load();
+    stats.bandwidth = slot.bandwidth.load();
+    stats.acceptedConnections = slot.acceptedConnections.load();
+    stats.activeSessions = slot.activeSessions.load();
+    stats.queuedSessions = slot.queuedSessions.load();
+    stats.admittedSessions = slot.admittedSessions.load();
+    stats.rejectedSessions = slot.rejectedSessions.load();
+    stats.timedOutSessions = slot.timedOutSessions.load();
+    stats.usedMemory = slot.usedMemory.load();
+    stats.committedCores = slot.committedCores.load();
+
+    return stats;
+  }
+
+  // Counters of every shard that ran, load of those still running
+  ShardStats SharedServerState::getAggregate() const
+  {
+    ShardStats aggregate = {};
+
+    for (std::size_t i = 0; i < this->nShards; i++) {
+      ShardStats stats = this->getShardStats(i);
+
+      if (stats.nShards > 0) {
+        aggregate.nShards++;
+        aggregate.cpuLoad = std::max(aggregate.cpuLoad, stats.cpuLoad);
+        aggregate.bandwidth += stats.bandwidth;
+        aggregate.activeSessions += stats.activeSessions;
+        aggregate.queuedSessions += stats.queuedSessions;
+        aggregate.usedMemory += stats.usedMemory;
+        aggregate.committedCores += stats.committedCores;
+      }
+
+      aggregate.acceptedConnections += stats.acceptedConnections;
+      aggregate.admittedSessions += stats.admittedSessions;
+      aggregate.rejectedSessions += stats.rejectedSessions;
+      aggregate.timedOutSessions += stats.timedOutSessions;
+    }
+
+    return aggregate;
+  }
+
+  std::ostream & operator<<(std::ostream & stream, const ShardStats & stats)
+  {
+    return stream << "{nShards: " << stats.nShards
+                  << ", cpuLoad: " << stats.cpuLoad
+                  << ", bandwidth: " << stats.bandwidth
+                  << " Mbps, acceptedConnections: "
+                  << stats.acceptedConnections
+                  << ", activeSessions: " << stats.activeSessions
+                  << ", queuedSessions: " << stats.queuedSessions
+                  << ", admittedSessions: " << stats.admittedSessions
+                  << ", rejectedSessions: " << stats.rejectedSessions
+                  << ", timedOutSessions: " << stats.timedOutSessions
+                  << ", usedMemory: " << stats.usedMemory
+                  << ", committedCores: " << stats.committedCores
+                  << "}";
+  }
+
+  } // namespace net
+} // namespace autocomp
@@ -9,47 +9,120 @@
 
 #include "network/socket/tcp_socket.hpp"
 
+#include "utils/constants.hpp"
+
+// Older C library and kernel headers lack the zero copy definitions
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
 namespace autocomp
 {
   namespace net
   {
 
+  namespace
+  {
+    // Moved sockets are not shared yet, so the two loads and stores need not
+    // be a single atomic step
+    template<class T>
+    void swapAtomics(std::atomic<T> & first, std::atomic<T> & second)
+    {
+      T value = first.load();
+      first.store(second.load());
+      second.store(value);
+    }
+
+    // How often, in milliseconds, the send queue is checked for progress
+    // while waiting for zero copy completions
+    const int zeroCopyProgressInterval = 100;
+
+    // The tcp_info of <netinet/tcp.h> stops at tcpi_total_retrans, while
+    // newer kernels append these fields
+    struct ExtendedTCPInfo
+    {
+      tcp_info info;
+      uint64_t pacingRate;
+      uint64_t maxPacingRate;
+      uint64_t bytesAcked;
+      uint64_t bytesReceived;
+      uint32_t segmentsOut;
+      uint32_t segmentsIn;
+      uint32_t notSentBytes;
+      uint32_t minRoundTripTime;
+      uint32_t dataSegmentsIn;
+      uint32_t dataSegmentsOut;
+      uint64_t deliveryRate;        //!< In bytes per second
+    };
+  }
+
   // Instantiates a TCP socket object with a port numb
   TCPSocket::TCPSocket(const unsigned short & port, const int & backlog)
     : Socket(port, backlog),
-      previousBytesInSendBuffer(0),
-      previousMeasureTime(std::chrono::high_resolution_clock::now())
+      zeroCopyEnabled(false),
+      zeroCopyThreshold(0),
+      zeroCopyNextNotificationId(0),
+      partialFramePinned(false),
+      corked(false),
+      readAheadOffset(0)
   {}
 
   // Instantiates a TCP socket object with an address
   TCPSocket::TCPSocket(const int & fileDescriptor, const sockaddr_in & address)
     : Socket(fileDescriptor, address),
-      previousBytesInSendBuffer(0),
-      previousMeasureTime(std::chrono::high_resolution_clock::now())
+      zeroCopyEnabled(false),
+      zeroCopyThreshold(0),
+      zeroCopyNextNotificationId(0),
+      partialFramePinned(false),
+      corked(false),
+      readAheadOffset(0)
   {}
 
   TCPSocket::TCPSocket(TCPSocket && other)
+    : zeroCopyEnabled(false),
+      zeroCopyThreshold(0),
+      zeroCopyNextNotificationId(0),
+      partialFramePinned(false),
+      corked(false),
+      readAheadOffset(0)
   {
     *this = std::move(other);    
   }
 
+  TCPSocket::~TCPSocket()
+  {
+    // The kernel may still be reading from the pinned buffers
+    this->flushZeroCopy();
+  }
+
   TCPSocket & TCPSocket::operator=(TCPSocket && other)
   {
-    std::swap(this->lastBandwidth, other.lastBandwidth);
-    std::swap(this->previousBytesInSendBuffer,
-              other.previousBytesInSendBuffer);
-    std::swap(this->previousMeasureTime, other.previousMeasureTime);
+    swapAtomics(this->zeroCopyEnabled, other.zeroCopyEnabled);
+    swapAtomics(this->zeroCopyThreshold, other.zeroCopyThreshold);
+    std::swap(this->zeroCopyNextNotificationId,
+              other.zeroCopyNextNotificationId);
+    std::swap(this->zeroCopyPendingBuffers, other.zeroCopyPendingBuffers);
+    std::swap(this->partialFramePinned, other.partialFramePinned);
+    std::swap(this->corked, other.corked);
+    this->readAheadBuffer.swap(other.readAheadBuffer);
+    std::swap(this->readAheadOffset, other.readAheadOffset);
     Socket::operator=(std::move(other));
 
     return *this;
   }
 
-  void TCPSocket::registerSendBufferAddition(const std::size_t & bytes) const
-  {
-    this->previousMeasureTime = std::chrono::high_resolution_clock::now();
-    this->previousBytesInSendBuffer = this->getSendBufferSize();
-  }
-
   void TCPSocket::setSendBufferCapacity(const int & newCapacity)
   {
     if (::setsockopt(this->fileDescriptor, SOL_SOCKET, SO_SNDBUF, &newCapacity,
@@ -93,10 +166,106 @@ namespace autocomp
     return sendBufferSize;
   }
 
-  double TCPSocket::getBandwidth() const
+  // Reads TCP_INFO
+  void TCPSocket::getConnectionInfo(ConnectionInfo & connectionInfo) const
+  {
+    ExtendedTCPInfo extendedInfo;
+    socklen_t infoSize = sizeof(extendedInfo);
+
+    std::memset(&extendedInfo, 0, sizeof(extendedInfo));
+
+    if (::getsockopt(this->fileDescriptor, IPPROTO_TCP, TCP_INFO,
+                     &extendedInfo, &infoSize) == -1) {
+      throw exceptions::NetworkError(std::string("Error reading TCP_INFO: ")
+                                       .append(this->getErrnoMessage()));
+    }
+
+    const tcp_info & info = extendedInfo.info;
+
+    // Older kernels fill less, leaving the delivery rate at 0
+    connectionInfo.deliveryRate = 8E-6 * extendedInfo.deliveryRate;
+    connectionInfo.roundTripTime = 1E-3 * info.tcpi_rtt;
+    connectionInfo.congestionWindow = info.tcpi_snd_cwnd;
+    connectionInfo.maxSegmentSize = info.tcpi_snd_mss;
+    connectionInfo.unacknowledged = info.tcpi_unacked;
+    connectionInfo.totalRetransmits = info.tcpi_total_retrans;
+  }
+
+  // Enables MSG_ZEROCOPY transmission for payloads of at least threshold bytes
+  void TCPSocket::enableZeroCopy(const std::size_t & threshold)
+  {
+    int enable = 1;
+
+    if (::setsockopt(this->fileDescriptor, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                     sizeof(enable)) == -1) {
+      throw exceptions::NetworkError(std::string("Error enabling zero copy "
+                                                 "transmission: ")
+                                         .append(this->getErrnoMessage()));
+    }
+
+    this->zeroCopyEnabled = true;
+    this->zeroCopyThreshold = threshold;
+  }
+
+  bool TCPSocket::isZeroCopyEnabled() const
+  {
+    return this->zeroCopyEnabled;
+  }
+
+  std::size_t TCPSocket::getPendingZeroCopyBuffers() const
   {
-    std::unique_lock<std::mutex> lock(this->bandwidthMutex);
-    return this->lastBandwidth;
+    return this->zeroCopyPendingBuffers.size();
+  }
+
+  // Sets or clears TCP_CORK
+  void TCPSocket::setCork(const bool & cork)
+  {
+    if (cork == this->corked) {
+      return;
+    }
+
+    int value = cork ? 1 : 0;
+
+    if (::setsockopt(this->fileDescriptor, IPPROTO_TCP, TCP_CORK, &value,
+                     sizeof(value)) == -1) {
+      throw exceptions::NetworkError(std::string("Error setting TCP_CORK: ")
+                                       .append(this->getErrnoMessage()));
+    }
+
+    this->corked = cork;
+  }
+
+  // Sets or clears SO_REUSEADDR
+  void TCPSocket::setReuseAddress(const bool & reuseAddress)
+  {
+    int value = reuseAddress ? 1 : 0;
+
+    if (::setsockopt(this->fileDescriptor, SOL_SOCKET, SO_REUSEADDR, &value,
+                     sizeof(value)) == -1) {
+      throw exceptions::NetworkError(std::string("Error setting "
+                                                 "SO_REUSEADDR: ")
+                                       .append(this->getErrnoMessage()));
+    }
+  }
+
+  // Lets several listening sockets bind to the same port
+  void TCPSocket::setReusePort(const bool & reusePort)
+  {
+    int value = reusePort ? 1 : 0;
+
+    if (::setsockopt(this->fileDescriptor, SOL_SOCKET, SO_REUSEPORT, &value,
+                     sizeof(value)) == -1) {
+      throw exceptions::NetworkError(std::string("Error setting "
+                                                 "SO_REUSEPORT: ")
+                                       .append(this->getErrnoMessage()));
+    }
+  }
+
+  // Makes receive() read up to capacity bytes at once
+  void TCPSocket::enableReadAhead(const std::size_t & capacity)
+  {
+    this->readAheadBuffer = Buffer(capacity);
+    this->readAheadOffset = 0;
   }
 
   // Binds the socket to its configured port
@@ -213,12 +382,7 @@ namespace autocomp
   // that message has. Then, the message itself is sent
   std::size_t TCPSocket::send(const std::string & message) const
   {
-    this->sendMessageSize(message.size());
-    //this->estimateBandwidth();
-
-    std::size_t bytesSent = this->_send(message.data(), message.size());
-
-    //this->registerSendBufferAddition(bytesSent);
+    std::size_t bytesSent = this->sendMessage(message.data(), message.size());
 
     return bytesSent;
   }
@@ -228,12 +392,7 @@ namespace autocomp
   // that message has. Then, the message itself is sent
   std::size_t TCPSocket::send(const std::vector<char> & message) const
   {
-    this->sendMessageSize(message.size());
-    //this->estimateBandwidth();
-
-    std::size_t bytesSent = this->_send(message.data(), message.size());
-    
-    //this->registerSendBufferAddition(bytesSent);
+    std::size_t bytesSent = this->sendMessage(message.data(), message.size());
 
     return bytesSent;
   }
@@ -243,16 +402,469 @@ namespace autocomp
   // that message has. Then, the message itself is sent
   std::size_t TCPSocket::send(const Buffer & message) const
   {
+    std::size_t bytesSent = this->sendMessage(message.getData(),
+                                              message.getSize());
+
+    return bytesSent;
+  }
+
+  // Sends the data in the message object, taking ownership of it. The buffer
+  // goes back to the pool once the kernel is done with it
+  std::size_t TCPSocket::send(Buffer && message,
+                              const std::shared_ptr<BufferPool> & pool)
+  {
+    if (not this->zeroCopyEnabled or
+        message.getSize() < this->zeroCopyThreshold) {
+      std::size_t bytesSent = this->send(static_cast<const Buffer &>(message));
+
+      if (pool) {
+        pool->release(std::move(message));
+      }
+
+      return bytesSent;
+    }
+
     this->sendMessageSize(message.getSize());
-    //this->estimateBandwidth();
 
-    std::size_t bytesSent = this->_send(message.getData(), message.getSize());
-    
-    //this->registerSendBufferAddition(bytesSent);
+    return this->sendPinned(std::move(message), pool);
+  }
+
+  // Sends a frame with a single system call: the prefixes, the header and the
+  // payload are gathered by the kernel
+  std::size_t TCPSocket::sendFrame(Frame && frame,
+                                   const std::shared_ptr<BufferPool> & pool)
+  {
+    std::size_t frameSize = frame.getSize();
+    uint32_t networkByteOrderHeaderSize = htonl(frame.header.getSize());
+    uint32_t networkByteOrderPayloadSize = htonl(frame.payload.getSize());
+    char chunkHeader[CHUNK_FRAME_HEADER_SIZE];
+
+    iovec vector[4];
+    int vectorLength = 0;
+
+    if (frame.hasChunkHeader) {
+      frame.chunkHeader.serialize(chunkHeader);
+      vector[vectorLength++] = {chunkHeader, sizeof(chunkHeader)};
+    }
+    else {
+      vector[vectorLength++] = {&networkByteOrderHeaderSize,
+                                sizeof(networkByteOrderHeaderSize)};
+      vector[vectorLength++] = {frame.header.getData(),
+                                frame.header.getSize()};
+
+      if (frame.hasPayload) {
+        vector[vectorLength++] = {&networkByteOrderPayloadSize,
+                                  sizeof(networkByteOrderPayloadSize)};
+      }
+    }
+
+    if (not frame.hasPayload) {
+      this->_sendv(vector, vectorLength);
+
+      return frameSize;
+    }
+
+    if (not this->zeroCopyEnabled or
+        frame.payload.getSize() < this->zeroCopyThreshold) {
+      vector[vectorLength++] = {frame.payload.getData(),
+                                frame.payload.getSize()};
+      this->_sendv(vector, vectorLength);
+
+      if (pool) {
+        pool->release(std::move(frame.payload));
+      }
+
+      return frameSize;
+    }
+
+    // Only the payload is worth pinning
+    this->_sendv(vector, vectorLength, MSG_MORE);
+    this->sendPinned(std::move(frame.payload), pool);
+
+    return frameSize;
+  }
+
+  // Sends a message with MSG_ZEROCOPY and keeps it until the kernel releases
+  // it
+  std::size_t TCPSocket::sendPinned(Buffer && message,
+                                    const std::shared_ptr<BufferPool> & pool)
+  {
+    uint32_t firstNotificationId = this->zeroCopyNextNotificationId;
+
+    std::size_t bytesSent = this->_sendZeroCopy(message.getData(),
+                                                message.getSize());
+
+    // The data might have been copied if the kernel ran out of memory for
+    // the notifications, in which case none will arrive for it
+    if (this->zeroCopyNextNotificationId == firstNotificationId) {
+      if (pool) {
+        pool->release(std::move(message));
+      }
+
+      return bytesSent;
+    }
+
+    this->zeroCopyPendingBuffers.push_back({
+                                             this->zeroCopyNextNotificationId
+                                               - 1,
+                                             std::move(message),
+                                             pool
+                                           });
+
+    this->reapZeroCopyCompletions();
 
     return bytesSent;
   }
 
+  // Reads the zero copy completion notifications and hands the buffers the
+  // kernel is done with back to their pools. For TCP sockets notifications
+  // arrive in order, so every buffer up to the last completed id is released.
+  // A peer that stops acknowledging could keep the wait going for as long as
+  // TCP retransmits, so the wait ends once the send queue stops draining.
+  // The buffers still pinned are kept either way, since the kernel may still
+  // send them
+  void TCPSocket::reapZeroCopyCompletions(const bool & wait)
+  {
+    const std::chrono::milliseconds stallTimeout(
+                                      constants::ZERO_COPY_STALL_TIMEOUT
+                                    );
+    char control[128];
+    auto stallDeadline = std::chrono::steady_clock::now() + stallTimeout;
+    int queuedBytes = -1;
+
+    while (not this->zeroCopyPendingBuffers.empty()) {
+      msghdr message;
+      std::memset(&message, 0, sizeof(message));
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+
+      if (::recvmsg(this->fileDescriptor, &message,
+                    MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        if (errno != EAGAIN and errno != EWOULDBLOCK) {
+          throw exceptions::NetworkError(std::string("Error reading zero copy "
+                                                     "completions: ")
+                                           .append(this->getErrnoMessage()));
+        }
+
+        if (not wait) {
+          return;
+        }
+
+        // Any byte acknowledged is progress, however slow the link is
+        int nowQueuedBytes = this->getSendBufferSize();
+        auto now = std::chrono::steady_clock::now();
+
+        if (queuedBytes == -1 or nowQueuedBytes < queuedBytes) {
+          queuedBytes = nowQueuedBytes;
+          stallDeadline = now + stallTimeout;
+        }
+
+        int timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        stallDeadline - now
+                      ).count();
+
+        if (timeout <= 0) {
+          throw exceptions::NetworkError("The send queue stopped draining "
+                                         "with zero copy sends in flight");
+        }
+
+        // POLLERR is always reported, so no events need to be requested
+        pollfd pollFileDescriptor{this->fileDescriptor, 0, 0};
+
+        if (::poll(&pollFileDescriptor, 1,
+                   std::min(timeout, zeroCopyProgressInterval)) == -1 and
+            errno != EINTR) {
+          throw exceptions::NetworkError(std::string("Error waiting for zero "
+                                                     "copy completions: ")
+                                           .append(this->getErrnoMessage()));
+        }
+
+        if (pollFileDescriptor.revents & (POLLHUP | POLLNVAL)) {
+          throw exceptions::NetworkError("Connection closed with zero copy "
+                                         "sends in flight");
+        }
+
+        continue;
+      }
+
+      for (cmsghdr * controlMessage = CMSG_FIRSTHDR(&message);
+           controlMessage != nullptr;
+           controlMessage = CMSG_NXTHDR(&message, controlMessage)) {
+        if (not ((controlMessage->cmsg_level == SOL_IP and
+                  controlMessage->cmsg_type == IP_RECVERR) or
+                 (controlMessage->cmsg_level == SOL_IPV6 and
+                  controlMessage->cmsg_type == IPV6_RECVERR))) {
+          continue;
+        }
+
+        auto error = reinterpret_cast<const sock_extended_err *>(
+                        CMSG_DATA(controlMessage)
+                      );
+
+        if (error->ee_origin != SO_EE_ORIGIN_ZEROCOPY or error->ee_errno != 0) {
+          throw exceptions::NetworkError(std::string("Error in zero copy "
+                                                     "transmission: ")
+                                           .append(std::strerror(
+                                                      error->ee_errno)));
+        }
+
+        // The kernel had to copy the data anyway (e.g. loopback or a device
+        // without scatter-gather), so zero copy only adds overhead
+        if (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+          this->zeroCopyEnabled = false;
+        }
+
+        while (not this->zeroCopyPendingBuffers.empty() and
+               static_cast<int32_t>(
+                  this->zeroCopyPendingBuffers.front().notificationId -
+                    error->ee_data
+                ) <= 0) {
+          ZeroCopyBuffer & pendingBuffer =
+            this->zeroCopyPendingBuffers.front();
+
+          if (pendingBuffer.pool) {
+            pendingBuffer.pool->release(std::move(pendingBuffer.buffer));
+          }
+
+          this->zeroCopyPendingBuffers.pop_front();
+        }
+      }
+    }
+  }
+
+  // Waits for every pending zero copy send to complete. Otherwise an
+  // abortive close makes the kernel drop the data it had not sent, which is
+  // the only way to make sure it does not read the buffers anymore
+  void TCPSocket::flushZeroCopy()
+  {
+    try {
+      this->reapZeroCopyCompletions(true);
+    }
+    catch (exceptions::NetworkError & error) {
+      linger abort{1, 0};
+
+      ::setsockopt(this->fileDescriptor, SOL_SOCKET, SO_LINGER, &abort,
+                   sizeof(abort));
+      this->close();
+      this->zeroCopyPendingBuffers.clear();
+    }
+  }
+
+  // Sets or clears O_NONBLOCK
+  void TCPSocket::setNonBlocking(const bool & nonBlocking)
+  {
+    int flags = ::fcntl(this->fileDescriptor, F_GETFL, 0);
+
+    if (flags == -1 or
+        ::fcntl(this->fileDescriptor, F_SETFL,
+                nonBlocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) == -1) {
+      throw exceptions::NetworkError(std::string("Error setting O_NONBLOCK: ")
+                                       .append(this->getErrnoMessage()));
+    }
+  }
+
+  // Sends as much of a frame as the socket takes without waiting. The
+  // prefixes, the header and a payload not worth pinning go out with a
+  // single system call; a pinned payload follows with MSG_ZEROCOPY
+  bool TCPSocket::trySendFrame(Frame & frame, std::size_t & bytesSent,
+                               const std::shared_ptr<BufferPool> & pool)
+  {
+    uint32_t networkByteOrderHeaderSize = htonl(frame.header.getSize());
+    uint32_t networkByteOrderPayloadSize = htonl(frame.payload.getSize());
+    char chunkHeader[CHUNK_FRAME_HEADER_SIZE];
+
+    iovec vector[4];
+    int vectorLength = 0;
+
+    if (frame.hasChunkHeader) {
+      frame.chunkHeader.serialize(chunkHeader);
+      vector[vectorLength++] = {chunkHeader, sizeof(chunkHeader)};
+    }
+    else {
+      vector[vectorLength++] = {&networkByteOrderHeaderSize,
+                                sizeof(networkByteOrderHeaderSize)};
+      vector[vectorLength++] = {frame.header.getData(),
+                                frame.header.getSize()};
+
+      if (frame.hasPayload) {
+        vector[vectorLength++] = {&networkByteOrderPayloadSize,
+                                  sizeof(networkByteOrderPayloadSize)};
+      }
+    }
+
+    const bool pinPayload = frame.hasPayload and this->zeroCopyEnabled and
+                            frame.payload.getSize() >= this->zeroCopyThreshold;
+
+    if (frame.hasPayload and not pinPayload) {
+      vector[vectorLength++] = {frame.payload.getData(),
+                                frame.payload.getSize()};
+    }
+
+    std::size_t copiedSize = 0;
+
+    for (int i = 0; i < vectorLength; i++) {
+      copiedSize += vector[i].iov_len;
+    }
+
+    const std::size_t frameSize =
+      copiedSize + (pinPayload ? frame.payload.getSize() : 0);
+
+    while (bytesSent < copiedSize) {
+      // Skips what previous calls sent
+      iovec * remainingVector = vector;
+      int remainingVectorLength = vectorLength;
+      std::size_t bytesToSkip = bytesSent;
+
+      while (bytesToSkip >= remainingVector->iov_len) {
+        bytesToSkip -= remainingVector->iov_len;
+        remainingVector++;
+        remainingVectorLength--;
+      }
+
+      remainingVector->iov_base =
+        static_cast<char *>(remainingVector->iov_base) + bytesToSkip;
+      remainingVector->iov_len -= bytesToSkip;
+
+      msghdr message;
+      std::memset(&message, 0, sizeof(message));
+      message.msg_iov = remainingVector;
+      message.msg_iovlen = remainingVectorLength;
+
+      ssize_t result =
+        ::sendmsg(this->fileDescriptor, &message,
+                  MSG_DONTWAIT | MSG_NOSIGNAL | (pinPayload ? MSG_MORE : 0));
+
+      // The vector is rebuilt from bytesSent on the next iteration
+      remainingVector->iov_base =
+        static_cast<char *>(remainingVector->iov_base) - bytesToSkip;
+      remainingVector->iov_len += bytesToSkip;
+
+      if (result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        if (errno == EAGAIN or errno == EWOULDBLOCK) {
+          return false;
+        }
+
+        throw exceptions::NetworkError(std::string("Error sending data to ")
+                                        .append(this->getHostname())
+                                        .append(":")
+                                        .append(std::to_string(this->port))
+                                        .append(": ")
+                                        .append(this->getErrnoMessage()));
+      }
+
+      bytesSent += result;
+    }
+
+    while (bytesSent < frameSize) {
+      const std::size_t payloadOffset = bytesSent - copiedSize;
+
+      ssize_t result = ::send(this->fileDescriptor,
+                              frame.payload.getData() + payloadOffset,
+                              frame.payload.getSize() - payloadOffset,
+                              MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL);
+
+      // Out of memory for the notifications: copy this part
+      if (result == -1 and errno == ENOBUFS) {
+        result = ::send(this->fileDescriptor,
+                        frame.payload.getData() + payloadOffset,
+                        frame.payload.getSize() - payloadOffset,
+                        MSG_DONTWAIT | MSG_NOSIGNAL);
+      }
+      else if (result != -1) {
+        this->zeroCopyNextNotificationId++;
+        this->partialFramePinned = true;
+      }
+
+      if (result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        if (errno == EAGAIN or errno == EWOULDBLOCK) {
+          return false;
+        }
+
+        throw exceptions::NetworkError(std::string("Error sending data to ")
+                                        .append(this->getHostname())
+                                        .append(":")
+                                        .append(std::to_string(this->port))
+                                        .append(": ")
+                                        .append(this->getErrnoMessage()));
+      }
+
+      bytesSent += result;
+    }
+
+    if (this->partialFramePinned) {
+      this->zeroCopyPendingBuffers.push_back({
+                                               this->zeroCopyNextNotificationId
+                                                 - 1,
+                                               std::move(frame.payload),
+                                               pool
+                                             });
+      this->partialFramePinned = false;
+      this->reapZeroCopyCompletions();
+    }
+    else if (frame.hasPayload and pool) {
+      pool->release(std::move(frame.payload));
+    }
+
+    return true;
+  }
+
+  // Reads whatever data is available without waiting
+  std::size_t TCPSocket::tryRead(char * buffer,
+                                 const std::size_t & bytesToRead)
+  {
+    ssize_t bytesRead;
+
+    do {
+      bytesRead = ::recv(this->fileDescriptor, buffer, bytesToRead,
+                         MSG_DONTWAIT);
+    } while (bytesRead == -1 and errno == EINTR);
+
+    if (bytesRead == -1) {
+      if (errno == EAGAIN or errno == EWOULDBLOCK) {
+        return 0;
+      }
+
+      throw exceptions::NetworkError(std::string("Error receiving data "
+                                                 "from ")
+                                      .append(this->getHostname())
+                                      .append(":")
+                                      .append(std::to_string(this->port))
+                                      .append(": ")
+                                      .append(this->getErrnoMessage()));
+    }
+
+    if (bytesRead == 0) {
+      throw exceptions::NetworkError(std::string("Error receiving data "
+                                                 "from ")
+                                      .append(this->getHostname())
+                                      .append(":")
+                                      .append(std::to_string(this->port))
+                                      .append(": the peer has performed an "
+                                              "orderly shutdown"));
+    }
+
+    return bytesRead;
+  }
+
+  // Receives exactly bytesToRead bytes, with no length prefix
+  std::size_t TCPSocket::receive(char * buffer,
+                                 const std::size_t & bytesToRead) const
+  {
+    return this->_receive(buffer, bytesToRead);
+  }
+
   // Receives data from the sender.
   // The protocol is as follows: the function reads the number of bytes
   // that the incoming message has. Then, the message itself is read
@@ -302,6 +914,20 @@ namespace autocomp
     return bytesRead;
   }
 
+  // Sends the message preceded by its size, with a single system call
+  std::size_t TCPSocket::sendMessage(const char * message,
+                                     const std::size_t & messageSize) const
+  {
+    uint32_t networkByteOrderMessageSize = htonl(messageSize);
+
+    iovec vector[] = {
+      {&networkByteOrderMessageSize, sizeof(networkByteOrderMessageSize)},
+      {const_cast<char *>(message), messageSize}
+    };
+
+    return this->_sendv(vector, 2) - sizeof(networkByteOrderMessageSize);
+  }
+
   // Sends the size of the next message to transmit
   void TCPSocket::sendMessageSize(const uint32_t & messageSize) const
   {
@@ -350,70 +976,173 @@ namespace autocomp
     return bytesToSend;
   }
 
-  // Sends the data in the message object.
-  // The protocol is as follows: the function sends the number of bytes
-  // that message has. Then, the message itself is sent
+  // Sends the data in the buffer with MSG_ZEROCOPY. Every successful call is
+  // assigned the next notification id by the kernel
+  std::size_t
+  TCPSocket::_sendZeroCopy(const char * buffer, std::size_t bytesToSend)
+  {
+    ssize_t bytesSent;
+    std::size_t bytesLeftToSend = bytesToSend;
+
+    do {
+      bytesSent = ::send(this->fileDescriptor, buffer, bytesLeftToSend,
+                         MSG_ZEROCOPY);
+
+      if (bytesSent == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        // Out of memory for the notifications: wait for the ones in flight
+        // or, if there are none, copy the rest of the data
+        if (errno == ENOBUFS) {
+          if (this->zeroCopyPendingBuffers.empty()) {
+            this->_send(buffer, bytesLeftToSend);
+            break;
+          }
+
+          this->reapZeroCopyCompletions(true);
+          continue;
+        }
+
+        throw exceptions::NetworkError(std::string("Error sending data to ")
+                                        .append(this->getHostname())
+                                        .append(":")
+                                        .append(std::to_string(this->port))
+                                        .append(": ")
+                                        .append(this->getErrnoMessage()));
+      }
+
+      this->zeroCopyNextNotificationId++;
+
+      buffer += bytesSent;
+      bytesLeftToSend -= bytesSent;
+    } while (bytesLeftToSend > 0);
+
+    return bytesToSend;
+  }
+
+  // Receives bytesToRead bytes. Small reads are served from the read ahead
+  // buffer, which is refilled with as much data as the socket has, so
+  // consecutive messages cost a single system call
   std::size_t TCPSocket::_receive(char * buffer, std::size_t bytesToRead) const
   {
-    std::size_t bytesRead;
     std::size_t bytesLeftToRead = bytesToRead;
+    std::size_t bytesRead;
 
-    do {
-      bytesRead = read(this->fileDescriptor, buffer, bytesLeftToRead);
-
-      switch (bytesRead) {
-        default:
-          buffer += bytesRead;
-          bytesLeftToRead -= bytesRead;
-          break;
-
-        case -1:
-          throw exceptions::NetworkError(std::string("Error receiving data "
-                                                     "from ")
-                                          .append(this->getHostname())
-                                          .append(":")
-                                          .append(std::to_string(this->port))
-                                          .append(": ")
-                                          .append(this->getErrnoMessage()));
-          break;
-      
-        case 0:
-          throw exceptions::NetworkError(std::string("Error receiving data "
-                                                     "from ")
-                                          .append(this->getHostname())
-                                          .append(":")
-                                          .append(std::to_string(this->port))
-                                          .append(": the peer has performed an "
-                                                  "orderly shutdown"));
-          break;
+    while (bytesLeftToRead > 0) {
+      std::size_t bufferedBytes = this->readAheadBuffer.getSize() -
+                                  this->readAheadOffset;
+
+      if (bufferedBytes > 0) {
+        bytesRead = std::min(bufferedBytes, bytesLeftToRead);
+        std::memcpy(buffer,
+                    this->readAheadBuffer.getData() + this->readAheadOffset,
+                    bytesRead);
+        this->readAheadOffset += bytesRead;
+      }
+      else if (bytesLeftToRead >= this->readAheadBuffer.getCapacity()) {
+        // Big reads go straight to the destination
+        bytesRead = this->_read(buffer, bytesLeftToRead);
       }
-    } while (bytesLeftToRead > 0);
+      else {
+        this->readAheadBuffer.setSize(
+            this->_read(this->readAheadBuffer.getData(),
+                        this->readAheadBuffer.getCapacity())
+          );
+        this->readAheadOffset = 0;
+        continue;
+      }
+
+      buffer += bytesRead;
+      bytesLeftToRead -= bytesRead;
+    }
 
     return bytesToRead;
   }
 
-  void TCPSocket::estimateBandwidth() const
+  // Performs a single read from the socket
+  std::size_t TCPSocket::_read(char * buffer, std::size_t bytesToRead) const
+  {
+    ssize_t bytesRead;
+
+    do {
+      bytesRead = ::read(this->fileDescriptor, buffer, bytesToRead);
+    } while (bytesRead == -1 and errno == EINTR);
+
+    if (bytesRead == -1) {
+      throw exceptions::NetworkError(std::string("Error receiving data "
+                                                 "from ")
+                                      .append(this->getHostname())
+                                      .append(":")
+                                      .append(std::to_string(this->port))
+                                      .append(": ")
+                                      .append(this->getErrnoMessage()));
+    }
+
+    if (bytesRead == 0) {
+      throw exceptions::NetworkError(std::string("Error receiving data "
+                                                 "from ")
+                                      .append(this->getHostname())
+                                      .append(":")
+                                      .append(std::to_string(this->port))
+                                      .append(": the peer has performed an "
+                                              "orderly shutdown"));
+    }
+
+    return bytesRead;
+  }
+
+  // Sends the data in the vector, resuming from the first part not fully
+  // written on partial writes
+  std::size_t TCPSocket::_sendv(iovec * vector, int vectorLength,
+                                const int & flags) const
   {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    int currentBytesInSendBuffer = this->getSendBufferSize();
+    std::size_t bytesToSend = 0;
+
+    for (int i = 0; i < vectorLength; i++) {
+      bytesToSend += vector[i].iov_len;
+    }
+
+    std::size_t bytesLeftToSend = bytesToSend;
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
 
-    double elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            currentTime - this->previousMeasureTime
-                          ).count();
-    double bandwidth;
+    while (bytesLeftToSend > 0) {
+      message.msg_iov = vector;
+      message.msg_iovlen = vectorLength;
 
-    //std::cout << elapsedTime << std::endl;
+      ssize_t bytesSent = ::sendmsg(this->fileDescriptor, &message, flags);
 
-    if (elapsedTime != 0) {
-      // 8E3 = 8E-6 (Mbits in byte ) / 1E-9 (seconds in a nanosecond)
-      std::cout << previousBytesInSendBuffer << " - " << currentBytesInSendBuffer << " in " << 1E-9 * elapsedTime << std::endl;
-      bandwidth =
-        8E3 * (this->previousBytesInSendBuffer - currentBytesInSendBuffer) /
-          elapsedTime;
+      if (bytesSent == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
 
-      std::unique_lock<std::mutex> lock(this->bandwidthMutex);
-      this->lastBandwidth = bandwidth;
+        throw exceptions::NetworkError(std::string("Error sending data to ")
+                                        .append(this->getHostname())
+                                        .append(":")
+                                        .append(std::to_string(this->port))
+                                        .append(": ")
+                                        .append(this->getErrnoMessage()));
+      }
+
+      bytesLeftToSend -= bytesSent;
+
+      while (vectorLength > 0 and
+             static_cast<std::size_t>(bytesSent) >= vector->iov_len) {
+        bytesSent -= vector->iov_len;
+        vector++;
+        vectorLength--;
+      }
+
+      if (vectorLength > 0) {
+        vector->iov_base = static_cast<char *>(vector->iov_base) + bytesSent;
+        vector->iov_len -= bytesSent;
+      }
     }
+
+    return bytesToSend;
   }
 
   } // namespace net
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+# Exports a scikit-learn random forest or gradient boosting classifier in the
+# text format autocomp::EnsembleModel reads. The server loads it instead of
+# the decision tree if it is saved as models/ensemble.txt:
+#
+#   from export_ensemble import save_ensemble
+#   save_ensemble(random_forest, "../../../models/ensemble.txt", labels)
+#
+# labels are the compressor labels (zlib_6, snappy...) in the order of the
+# classes of the model, as for save_decision_tree in the classification
+# notebook.
+
+import csv
+
+import numpy as np
+from sklearn.ensemble import RandomForestClassifier
+from sklearn.ensemble import GradientBoostingClassifier
+
+##################################################
+
+def tree_rows(tree, leaf_values):
+  rows = []
+
+  for node in range(tree.node_count):
+    rows.append([tree.children_left[node],
+                 tree.children_right[node],
+                 max(tree.feature[node], 0),
+                 tree.threshold[node]] +
+                list(leaf_values(tree.value[node])))
+
+  return rows
+
+##################################################
+
+def save_forest(forest, writer, probability_vote):
+  def class_probabilities(value):
+    counts = value[0]
+    return counts / counts.sum()
+
+  def majority_class(value):
+    return [value[0].argmax()]
+
+  for estimator in forest.estimators_:
+    rows = tree_rows(estimator.tree_,
+                     class_probabilities if probability_vote
+                     else majority_class)
+    writer.writerow([-1, len(rows)])
+    writer.writerows(rows)
+
+##################################################
+
+# Binary classifiers have a single tree per stage, which scores the second
+# class against a first class that stays at 0
+def save_boosted_trees(boosted_trees, writer):
+  n_classes = len(boosted_trees.classes_)
+  learning_rate = boosted_trees.learning_rate
+
+  def score(value):
+    return [learning_rate * value[0][0]]
+
+  for stage in boosted_trees.estimators_:
+    for k, estimator in enumerate(stage):
+      label = 1 if n_classes == 2 else k
+      rows = tree_rows(estimator.tree_, score)
+      writer.writerow([label, len(rows)])
+      writer.writerows(rows)
+
+##################################################
+
+def initial_scores(boosted_trees):
+  n_classes = len(boosted_trees.classes_)
+  # The initial estimator is a prior, which does not depend on the point
+  point = np.zeros((1, boosted_trees.n_features_in_))
+  scores = boosted_trees._raw_predict_init(point)[0]
+
+  if n_classes == 2:
+    return [0.0, scores[0]]
+
+  return list(scores)
+
+##################################################
+
+def save_ensemble(model, filename, labels, probability_vote = True):
+  if isinstance(model, RandomForestClassifier):
+    kind = "forest_probability" if probability_vote else "forest_majority"
+    n_trees = len(model.estimators_)
+  elif isinstance(model, GradientBoostingClassifier):
+    kind = "boosted"
+    n_trees = model.estimators_.size
+  else:
+    raise TypeError("Unsupported model " + type(model).__name__)
+
+  if len(labels) != len(model.classes_):
+    raise ValueError("There must be one label per class")
+
+  with open(filename, "w") as file:
+    writer = csv.writer(file, delimiter = " ", lineterminator = "\n")
+    writer.writerow([kind])
+    writer.writerow([len(labels)])
+    writer.writerow(labels)
+    writer.writerow([model.n_features_in_])
+    writer.writerow([n_trees])
+
+    if kind == "boosted":
+      writer.writerow(initial_scores(model))
+      save_boosted_trees(model, writer)
+    else:
+      save_forest(model, writer, probability_vote)
+
+##################################################
+
+if __name__ == "__main__":
+  import sys
+  import pickle
+
+  if len(sys.argv) < 4:
+    print("usage: export_ensemble.py model.pickle ensemble.txt label...")
+    sys.exit(1)
+
+  with open(sys.argv[1], "rb") as file:
+    model = pickle.load(file)
+
+  save_ensemble(model, sys.argv[2], sys.argv[3:])
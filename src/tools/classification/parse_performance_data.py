@@ -9,13 +9,23 @@ import pprint
 class PerformanceData:
   N_CPU_LOAD_LEVELS = 11
   N_BANDWDITH_LEVELS = 29 # 20 (intervals of 5 until 99) + 9 (intervals of 100 until 1000)
-  N_BYTECOUNTING_LEVELS = 10
+  N_BYTECOUNTING_LEVELS = 26 # Above 100 too, if the probe finds them redundant
+  N_COMPRESSIBILITY_LEVELS = 101 # Tenths of the probe ratio, up to 10
+
+  def __init__(self, with_probe = False):
+    self.with_probe = with_probe
 
-  def __init__(self):
     # A list of N_CPU_LOAD_LEVELS elements, each of which is a list of
     # N_BANDWDITH_LEVELS, each of which is a list of N_BYTECOUNTING_LEVELS,
-    # each of which is an empty dictionary
-    self.data = list([[[{} for k in range(self.N_BYTECOUNTING_LEVELS)]
+    # each of which is an empty dictionary or, with the probe, a list of
+    # N_COMPRESSIBILITY_LEVELS empty dictionaries
+    def leaf():
+      if self.with_probe:
+        return [{} for l in range(self.N_COMPRESSIBILITY_LEVELS)]
+
+      return {}
+
+    self.data = list([[[leaf() for k in range(self.N_BYTECOUNTING_LEVELS)]
                        for j in range(self.N_BANDWDITH_LEVELS)]
                       for i in range(self.N_CPU_LOAD_LEVELS)])
 
@@ -48,28 +58,57 @@ class PerformanceData:
 
   ##################################################
 
-  def indices(self, cpu_load, bandwidth, bytecounting):
-    return self.cpu_load_level(cpu_load), self.bandwidth_level(bandwidth), \
-           self.bytecounting_level(bytecounting)
+  def compressibility_level(self, probe_ratio):
+    return int(min(probe_ratio, 10.0) * 10)
+
+  ##################################################
+
+  def indices(self, cpu_load, bandwidth, bytecounting, probe_ratio = None):
+    levels = (self.cpu_load_level(cpu_load), self.bandwidth_level(bandwidth),
+              self.bytecounting_level(bytecounting))
+
+    if self.with_probe:
+      levels += (self.compressibility_level(probe_ratio),)
+
+    return levels
 
   ##################################################
 
   def __getitem__(self, indicesValues):
+    levels = self.indices(*indicesValues)
+    entry = self.data
 
-    cpu_load, bandwidth, bytecounting = indicesValues
-    cpu_load_level, bandwidth_level, bytecounting_level = \
-      self.indices(cpu_load, bandwidth, bytecounting)
+    for level in levels:
+      entry = entry[level]
 
-    return self.data[cpu_load_level][bandwidth_level][bytecounting_level]
+    return entry
 
   ##################################################
 
   def __setitem__(self, indicesValues, value):
-    cpu_load, bandwidth, bytecounting = indicesValues
-    cpu_load_level, bandwidth_level, bytecounting_level = \
-      self.indices(cpu_load, bandwidth, bytecounting)
+    levels = self.indices(*indicesValues)
+    entry = self.data
+
+    for level in levels[:-1]:
+      entry = entry[level]
+
+    entry[levels[-1]] = value
+
+  ##################################################
 
-    self.data[cpu_load_level][bandwidth_level][bytecounting_level] = value
+  def entries(self):
+    for cpu_level, data_level_1 in enumerate(self.data):
+      for bandwidth_level, data_level_2 in enumerate(data_level_1):
+        for bytecounting_level, data_level_3 in enumerate(data_level_2):
+          levels = [cpu_level, bandwidth_level, bytecounting_level]
+
+          if not self.with_probe:
+            yield levels, data_level_3
+            continue
+
+          for compressibility_level, compressors_data in \
+              enumerate(data_level_3):
+            yield levels + [compressibility_level], compressors_data
 
   ##################################################
 
@@ -93,9 +132,7 @@ class PerformanceData:
       csv_writer = csv.writer(file, delimiter = ",", quotechar = '"',
                               quoting = csv.QUOTE_MINIMAL)
 
-      for cpu_level, data_level_1 in enumerate(self.data):
-        for bandwidth_level, data_level_2 in enumerate(data_level_1):
-          for bytecounting_level, compressors_data in enumerate(data_level_2):
+      for levels, compressors_data in self.entries():
             if compressors_data == {}:# or len(compressors_data) < 2:
             #  if bandwidth_level < 2:
             #    best_compressor = "zlib_6"
@@ -111,20 +148,19 @@ class PerformanceData:
             else:
               best_compressor = self.get_best_compressor(compressors_data)
 
-            entry = [cpu_level, bandwidth_level, bytecounting_level,
-                     best_compressor]
+            entry = levels + [best_compressor]
             csv_writer.writerow(entry)
 
   def show(self):
     pp = pprint.PrettyPrinter(indent = 4)
 
     i = 1;
-    for cpu_level, data_level_1 in enumerate(self.data):
-      for bandwidth_level, data_level_2 in enumerate(data_level_1):
-        for bytecounting_level, compressors_data in enumerate(data_level_2):
-          print("CPU:", cpu_level)
-          print("BW:", bandwidth_level)
-          print("BC:", bytecounting_level)
+    for levels, compressors_data in self.entries():
+          print("CPU:", levels[0])
+          print("BW:", levels[1])
+          print("BC:", levels[2])
+          if self.with_probe:
+            print("CR:", levels[3])
           pp.pprint(compressors_data)
           print("\n")
           print("-" * 80)
@@ -146,11 +182,18 @@ class AutoCompPerformanceDataParser:
   BYTECOUNTING_INDEX = 4
   COMPRESSION_RATE_INDEX = 5
   COMPRESSION_RATIO_INDEX = 6
+  PROBE_RATIO_INDEX = 7
+  PROBE_RATE_INDEX = 8
   #TRANSMISSION_RATE_INDEX = -1
 
-  def __init__(self, filename):
+  # Data with more distinct bytes is only incompressible if its samples
+  # compress less than this, as in AutoComp
+  PROBE_MIN_RATIO = 1.1
+
+  def __init__(self, filename, with_probe = False):
     self.filename = filename
-    self.data = PerformanceData()
+    self.with_probe = with_probe
+    self.data = PerformanceData(with_probe)
 
   ##################################################
 
@@ -163,8 +206,14 @@ class AutoCompPerformanceDataParser:
         bandwidth = float(row[self.BANDWIDTH_INDEX])
         #transmission_rate = float(row[self.TRANSMISSION_RATE_INDEX])
 
+        incompressible = bytecounting > 100
+
+        if incompressible and len(row) > self.PROBE_RATIO_INDEX:
+          incompressible = \
+            float(row[self.PROBE_RATIO_INDEX]) < self.PROBE_MIN_RATIO
+
         #if (bandwidth == 0 or transmission_rate == 0):
-        if (compressor == "LZO" or bytecounting > 100 or bandwidth == 0):
+        if (compressor == "LZO" or incompressible or bandwidth == 0):
         #if (bytecounting > 100 or bandwidth == 0):
           continue
 
@@ -192,7 +241,12 @@ class AutoCompPerformanceDataParser:
       compression_ratio = float(line[self.COMPRESSION_RATIO_INDEX])
       transmission_rate = min(bandwidth, compression_rate) * compression_ratio
 
-      entry = self.data[cpu_load, bandwidth, bytecounting]
+      indices = (cpu_load, bandwidth, bytecounting)
+
+      if self.with_probe:
+        indices += (float(line[self.PROBE_RATIO_INDEX]),)
+
+      entry = self.data[indices]
       compressor_data = entry.get(compressor)
 
       if compressor_data is None:
@@ -212,7 +266,7 @@ class AutoCompPerformanceDataParser:
         compressor_data["count"] += 1
 
       entry[compressor] = compressor_data
-      self.data[cpu_load, bandwidth, bytecounting] = entry
+      self.data[indices] = entry
 
     return self.data
 
@@ -236,9 +290,13 @@ class AutoCompPerformanceDataParser:
 # main #########################################################################
 
 def main(argv):
+  with_probe = "--with-probe" in argv
+  argv = [arg for arg in argv if arg != "--with-probe"]
+
   if len(argv) != 1:
     print("Invalid number of arguments:", len(argv),
           "were given but 1 are required")
+    print("Usage: parse_performance_data.py [--with-probe] performance_data")
     exit(1)
 
   performanceDataFilename = argv[0]
@@ -246,7 +304,8 @@ def main(argv):
   outputFilename = "./log/traning_data_" + timestamp + ".csv"
 
 
-  parser = AutoCompPerformanceDataParser(performanceDataFilename)
+  # With the probe, the compressibility level is a fourth feature
+  parser = AutoCompPerformanceDataParser(performanceDataFilename, with_probe)
   #print(parser.parse().show())
   parser.parse()
   parser.save(outputFilename)
@@ -14,6 +14,7 @@
 #include <csignal>
 #include <cstdlib>
 #include <cctype>
+#include <cstdint>
 
 #include "utils/constants.hpp"
 #include "network/client/client.hpp"
@@ -37,12 +38,15 @@ int main(int argc, char * argv[])
   std::unique_ptr<autocomp::Compressor> compressor;
   std::unique_ptr<int> compressionLevel;
   autocomp::FileRequestMode mode = autocomp::AUTOCOMP;
+  unsigned int weight = 1;
+  std::uint64_t maxRate = 0;
+  unsigned int occupancySetpoint = 0;
 
   int option;
   bool compressMode = false;
   bool precompressMode = false;
 
-  while ((option = getopt(argc, argv, "f:d:m:c:l:H:P:h?")) != -1) {
+  while ((option = getopt(argc, argv, "f:d:m:c:l:w:r:o:H:P:h?")) != -1) {
     switch (option) {
       case 'H':
         hostname = optarg;
@@ -94,6 +98,20 @@ int main(int argc, char * argv[])
         compressionLevel = std::unique_ptr<int>(new int(std::atoi(optarg)));
         break;
 
+      case 'w':
+        weight = std::atoi(optarg);
+        break;
+
+      case 'r':
+        // In KB/s
+        maxRate = std::strtoull(optarg, nullptr, 10) * 1024;
+        break;
+
+      case 'o':
+        // In percent
+        occupancySetpoint = std::atoi(optarg);
+        break;
+
       case 'h':
         usage(argv[0]);
         std::exit(EXIT_SUCCESS);
@@ -104,6 +122,9 @@ int main(int argc, char * argv[])
           case 'd':
           case 'c':
           case 'l':
+          case 'w':
+          case 'r':
+          case 'o':
             std::cerr << "Option -" << (char) optopt
                       << " requires an argument\n";
             break;
@@ -134,7 +155,25 @@ int main(int argc, char * argv[])
     std::exit(EXIT_FAILURE);
   }
 
+  if (weight == 0 or weight > autocomp::constants::MAX_SESSION_WEIGHT) {
+    std::cerr << "The weight must be between 1 and "
+              << autocomp::constants::MAX_SESSION_WEIGHT << std::endl;
+    usage(argv[0]);
+
+    std::exit(EXIT_FAILURE);
+  }
+
+  if (occupancySetpoint > 100) {
+    std::cerr << "The occupancy setpoint must be at most 100" << std::endl;
+    usage(argv[0]);
+
+    std::exit(EXIT_FAILURE);
+  }
+
   autocomp::net::Client client(hostname, port);
+  client.setWeight(weight);
+  client.setMaxRate(maxRate);
+  client.setOccupancySetpoint(occupancySetpoint);
 
   try {
     client.init();
@@ -168,7 +207,9 @@ void usage(const std::string & binaryName)
   std::cerr << "usage: " << binaryName
             << "-H hostname [-P port] -f requested_path_or_file "
             << "-d destination_directory [-m file_request_mode] "
-            << "[-c compressor_name] [-l compression_level]\n";
+            << "[-c compressor_name] [-l compression_level] "
+            << "[-w weight] [-r max_rate_in_KB/s] "
+            << "[-o occupancy_setpoint_in_percent]\n";
 }
 
 void closeout(int signalNumber)
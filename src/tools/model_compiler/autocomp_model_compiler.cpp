@@ -0,0 +1,56 @@
+/**
+ *  AutoComp Model Compiler Executable
+ *  autocomp_model_compiler.cpp
+ *
+ *  Compiles a decision tree, as the training scripts write it, into the
+ *  binary model the server maps at startup.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "utils/constants.hpp"
+#include "utils/exceptions.hpp"
+#include "utils/decision_tree.hpp"
+
+void usage(const std::string &);
+
+int main(int argc, char * argv[])
+{
+  if (argc > 3 or (argc > 1 and std::string(argv[1]) == "-h")) {
+    usage(argv[0]);
+    std::exit(EXIT_FAILURE);
+  }
+
+  std::string inputFilename =
+    argc > 1 ? argv[1] : autocomp::constants::DECISION_TREE_FILENAME;
+  std::string outputFilename =
+    argc > 2 ? argv[2] : autocomp::constants::DECISION_TREE_BINARY_FILENAME;
+
+  try {
+    autocomp::DecisionTree decisionTree(inputFilename);
+    decisionTree.save(outputFilename);
+
+    std::cout << "Compiled " << inputFilename << " into " << outputFilename
+              << (decisionTree.hasTable() ? " with a dense table"
+                                          : " without a dense table")
+              << std::endl;
+  }
+  catch (autocomp::exceptions::IOError & error) {
+    std::cerr << "Could not compile the model: " << error.what() << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  return 0;
+}
+
+void usage(const std::string & binaryName)
+{
+  std::cerr << "usage: " << binaryName
+            << " [text_model [binary_model]]\n";
+}
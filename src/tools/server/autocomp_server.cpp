@@ -14,6 +14,9 @@
 #include <csignal>
 #include <cstdlib>
 #include <cctype>
+#include <memory>
+#include <sched.h>      // sched_setaffinity
+#include <sys/wait.h>   // waitpid
 
 #include "utils/constants.hpp"
 #include "network/server/server.hpp"
@@ -23,19 +26,60 @@ namespace
   volatile std::sig_atomic_t closeoutInProgres = 0;
 
   int shutdownPipeFileDescriptor;
+
+  // Worker processes, when the server runs sharded
+  pid_t shardPids[autocomp::constants::MAX_SHARDS];
+  std::size_t nRunningShards = 0;
+
+  struct ServerOptions
+  {
+    unsigned short port;
+    unsigned int nThreads;
+    std::size_t zeroCopyThreshold;
+    bool frameBatching;
+    std::size_t transmissionQueueMaxBytes;
+    std::size_t memoryBudget;
+    std::size_t maxSessions;
+    std::size_t maxQueuedSessions;
+    unsigned int maxQueueWaitTime;
+    unsigned int nReactorThreads;
+    unsigned int nAcceptors;
+    bool banditWarmStart;
+  };
 }
 
 void usage(const std::string &);
 
 void closeout(int);
 
+void forwardCloseout(int);
+
+int runServer(const ServerOptions & options,
+              const std::shared_ptr<autocomp::net::SharedServerState> &
+                sharedState,
+              const std::size_t & shardIndex);
+
+void pinToCpus(const std::size_t & shardIndex, const std::size_t & nShards);
+
 int main(int argc, char * argv[])
 {
   unsigned short port = autocomp::constants::DEFAULT_SERVER_PORT;
   unsigned int nThreads = std::thread::hardware_concurrency();
+  std::size_t zeroCopyThreshold = 0;
+  bool frameBatching = false;
+  std::size_t transmissionQueueMaxBytes =
+    autocomp::constants::TRANSMISSION_QUEUE_MAX_BYTES;
+  std::size_t memoryBudget = autocomp::constants::MEMORY_BUDGET;
+  std::size_t maxSessions = autocomp::constants::MAX_SESSIONS;
+  std::size_t maxQueuedSessions = autocomp::constants::MAX_QUEUED_SESSIONS;
+  unsigned int maxQueueWaitTime = autocomp::constants::MAX_QUEUE_WAIT_TIME;
+  unsigned int nReactorThreads = autocomp::constants::REACTOR_THREADS;
+  unsigned int nAcceptors = 1;
+  bool banditWarmStart = true;
+  std::size_t nShards = 1;
   int option;
 
-  while ((option = getopt(argc, argv, "p:t:h?")) != -1) {
+  while ((option = getopt(argc, argv, "p:t:r:a:s:z:q:g:m:b:w:cuh?")) != -1) {
     switch (option) {
       case 'p':
         port = std::atoi(optarg);
@@ -45,11 +89,64 @@ int main(int argc, char * argv[])
         nThreads = std::atoi(optarg);
         break;
 
+      case 'r':
+        nReactorThreads = std::atoi(optarg);
+        break;
+
+      case 'a':
+        nAcceptors = std::atoi(optarg);
+        break;
+
+      case 's':
+        nShards = std::atoi(optarg);
+        break;
+
+      case 'z':
+        zeroCopyThreshold = std::atoi(optarg) * 1024;
+        break;
+
+      case 'q':
+        transmissionQueueMaxBytes = std::atoi(optarg) * 1024 * 1024;
+        break;
+
+      case 'g':
+        memoryBudget = std::atoll(optarg) * 1024 * 1024;
+        break;
+
+      case 'm':
+        maxSessions = std::atoi(optarg);
+        break;
+
+      case 'b':
+        maxQueuedSessions = std::atoi(optarg);
+        break;
+
+      case 'w':
+        maxQueueWaitTime = std::atoi(optarg);
+        break;
+
+      case 'c':
+        frameBatching = true;
+        break;
+
+      case 'u':
+        banditWarmStart = false;
+        break;
+
       case 'h':
       case '?':
         switch (optopt) {
           case 'p':
           case 't':
+          case 'r':
+          case 'a':
+          case 's':
+          case 'z':
+          case 'q':
+          case 'g':
+          case 'm':
+          case 'b':
+          case 'w':
             std::cerr << "Option -" << (char) optopt
                       << " requires an argument\n";
             break;
@@ -72,28 +169,130 @@ int main(int argc, char * argv[])
     }
   }
 
+  ServerOptions options;
+  options.port = port;
+  options.nThreads = nThreads;
+  options.zeroCopyThreshold = zeroCopyThreshold;
+  options.frameBatching = frameBatching;
+  options.transmissionQueueMaxBytes = transmissionQueueMaxBytes;
+  options.memoryBudget = memoryBudget;
+  options.maxSessions = maxSessions;
+  options.maxQueuedSessions = maxQueuedSessions;
+  options.maxQueueWaitTime = maxQueueWaitTime;
+  options.nReactorThreads = nReactorThreads;
+  options.nAcceptors = nAcceptors;
+  options.banditWarmStart = banditWarmStart;
+
+  if (nShards <= 1) {
+    return runServer(options, nullptr, 0);
+  }
+
+  // ---> Sharded mode <--- //
+  // Each shard is a worker process with its own server, pools and CPUs, all
+  // of them bound to the same port. The memory budget is split among them
+  options.memoryBudget = memoryBudget / nShards;
+
+  std::shared_ptr<autocomp::net::SharedServerState> sharedState;
+
+  try {
+    sharedState =
+      std::make_shared<autocomp::net::SharedServerState>(nShards);
+  }
+  catch (std::exception & error) {
+    std::cerr << "Could not create AutoComp server shards: " << error.what()
+              << std::endl;
+
+    std::exit(EXIT_FAILURE);
+  }
+
+  for (std::size_t i = 0; i < nShards; i++) {
+    pid_t pid = ::fork();
+
+    if (pid == -1) {
+      std::cerr << "Could not create AutoComp server shard (fork): "
+                << std::strerror(errno) << std::endl;
+      break;
+    }
+
+    if (pid == 0) {
+      pinToCpus(i, nShards);
+      std::exit(runServer(options, sharedState, i));
+    }
+
+    shardPids[nRunningShards++] = pid;
+  }
+
+  std::signal(SIGINT, forwardCloseout);
+  std::signal(SIGTERM, forwardCloseout);
+  std::signal(SIGQUIT, forwardCloseout);
+
+  int exitStatus = EXIT_SUCCESS;
+
+  for (std::size_t i = 0; i < nRunningShards; i++) {
+    int status;
+
+    while (::waitpid(shardPids[i], &status, 0) == -1 and errno == EINTR) {
+    }
+
+    if (not WIFEXITED(status) or WEXITSTATUS(status) != EXIT_SUCCESS) {
+      exitStatus = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "AutoComp server shards stats " << sharedState->getAggregate()
+            << std::endl;
+
+  return exitStatus;
+}
+
+int runServer(const ServerOptions & options,
+              const std::shared_ptr<autocomp::net::SharedServerState> &
+                sharedState,
+              const std::size_t & shardIndex)
+{
+  // Each shard is shut down through a pipe of its own
+  std::string shutdownPipeName = autocomp::constants::SHUTDOWN_PIPE_NAME;
+  if (sharedState) {
+    shutdownPipeName.append(".shard").append(std::to_string(shardIndex));
+  }
+
   std::unique_ptr<autocomp::net::Server> server;
 
   try {
     server =
       std::unique_ptr<autocomp::net::Server>(
-          new autocomp::net::Server(port, nThreads,
-                                    autocomp::constants::SHUTDOWN_PIPE_NAME)
+          new autocomp::net::Server(options.port, options.nThreads,
+                                    shutdownPipeName)
         );
   }
   catch (autocomp::exceptions::NetworkError & error) {
     std::cerr << "Could not create AutoComp server instance: " << error.what()
               << std::endl;
 
-    std::exit(EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
+
+  server->setZeroCopyThreshold(options.zeroCopyThreshold);
+  server->setFrameBatching(options.frameBatching);
+  server->setTransmissionQueueCapacity(options.transmissionQueueMaxBytes);
+  server->setMemoryBudget(options.memoryBudget);
+  server->setAdmissionLimits(options.maxSessions, options.maxQueuedSessions,
+                             options.maxQueueWaitTime);
+  server->setReactorThreadCount(options.nReactorThreads);
+  server->setAcceptorCount(options.nAcceptors);
+  server->setBanditModel(autocomp::constants::BANDIT_MODEL_FILENAME,
+                         options.banditWarmStart);
+
+  if (sharedState) {
+    server->setShard(sharedState, shardIndex);
   }
 
-  ::unlink(autocomp::constants::SHUTDOWN_PIPE_NAME.c_str());
-  if (::mkfifo(autocomp::constants::SHUTDOWN_PIPE_NAME.c_str(), 0600) == -1) {
+  ::unlink(shutdownPipeName.c_str());
+  if (::mkfifo(shutdownPipeName.c_str(), 0600) == -1) {
     std::cerr << "An error ocurred during server instantiation (mkfifo): "
               << std::strerror(errno) << std::endl;
 
-    std::exit(EXIT_FAILURE);
+    return EXIT_FAILURE;
   }
 
   try {
@@ -103,18 +302,18 @@ int main(int argc, char * argv[])
     std::cerr << "Could not initialize AutoComp server: " << error.what()
               << std::endl;
 
-    std::exit(EXIT_FAILURE);
+    return EXIT_FAILURE;
   }
 
   shutdownPipeFileDescriptor =
-    ::open(autocomp::constants::SHUTDOWN_PIPE_NAME.c_str(),
+    ::open(shutdownPipeName.c_str(),
            O_WRONLY | O_NONBLOCK);
 
   if (shutdownPipeFileDescriptor == -1) {
     std::cerr << "An error ocurred during server instantiation (open): "
               << std::strerror(errno) << std::endl;
 
-    std::exit(EXIT_FAILURE);
+    return EXIT_FAILURE;
   }
 
   std::signal(SIGINT, closeout);
@@ -123,12 +322,19 @@ int main(int argc, char * argv[])
 
   server->serve();
   
-  return 0;
+  return EXIT_SUCCESS;
 }
 
 void usage(const std::string & binaryName)
 {
-  std::cerr << "usage: " << binaryName << " [-p port] [-t number_of_threads]\n";
+  std::cerr << "usage: " << binaryName << " [-p port] [-t number_of_threads]"
+            << " [-r number_of_reactor_threads]"
+            << " [-a number_of_acceptor_threads] [-s number_of_processes]"
+            << " [-z zero_copy_threshold_in_KB] [-q queue_capacity_in_MB]"
+            << " [-g memory_budget_in_MB]"
+            << " [-m max_sessions] [-b max_waiting_requests]"
+            << " [-w max_waiting_time_in_ms]"
+            << " [-c] [-u]\n";
 }
 
 void closeout(int signalNumber)
@@ -144,4 +350,48 @@ void closeout(int signalNumber)
   std::signal(SIGINT, SIG_IGN);
   std::signal(SIGTERM, SIG_IGN);
   std::signal(SIGQUIT, SIG_IGN);
-}
\ No newline at end of file
+}
+void forwardCloseout(int signalNumber)
+{
+  if (closeoutInProgres) {
+    std::raise(signalNumber);
+  }
+
+  closeoutInProgres = 1;
+
+  for (std::size_t i = 0; i < nRunningShards; i++) {
+    ::kill(shardPids[i], SIGTERM);
+  }
+
+  std::signal(SIGINT, SIG_IGN);
+  std::signal(SIGTERM, SIG_IGN);
+  std::signal(SIGQUIT, SIG_IGN);
+}
+
+// Gives each shard its share of the CPUs, so their threads do not compete
+void pinToCpus(const std::size_t & shardIndex, const std::size_t & nShards)
+{
+  std::size_t nCpus = std::thread::hardware_concurrency();
+
+  if (nCpus == 0) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+
+  if (nCpus < nShards) {
+    CPU_SET(shardIndex % nCpus, &cpuSet);
+  }
+  else {
+    for (std::size_t cpu = shardIndex * nCpus / nShards;
+         cpu < (shardIndex + 1) * nCpus / nShards; cpu++) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+
+  if (::sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == -1) {
+    std::cerr << "Could not set the CPU affinity of shard " << shardIndex
+              << ": " << std::strerror(errno) << std::endl;
+  }
+}
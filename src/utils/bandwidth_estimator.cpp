@@ -0,0 +1,89 @@
+/**
+ *  AutoComp Bandwidth Estimator
+ *  bandwidth_estimator.cpp
+ *
+ *  Definition of class BandwidthEstimator methods, which estimates the
+ *  bandwidth of a connection from the state its TCP stack reports.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "utils/bandwidth_estimator.hpp"
+
+#include <stdexcept>
+
+namespace autocomp {
+
+// BandwidthEstimator constructor
+BandwidthEstimator::BandwidthEstimator(
+    const float & smoothingFactor,
+    const std::chrono::milliseconds & samplingInterval
+  )
+  : smoothingFactor(smoothingFactor),
+    samplingInterval(samplingInterval),
+    bandwidth(0),
+    roundTripTime(0),
+    totalRetransmits(0),
+    hasSamples(false)
+{
+  if (smoothingFactor <= 0 or smoothingFactor > 1) {
+    throw std::domain_error("smoothingFactor must be in (0, 1]");
+  }
+}
+
+bool BandwidthEstimator::isSamplingDue(const Clock::time_point & now) const
+{
+  return not this->hasSamples or
+         now - this->lastSampleTime >= this->samplingInterval;
+}
+
+// Smooths the delivery rate or, without it, the congestion window rate
+void BandwidthEstimator::addSample(const ConnectionInfo & connectionInfo,
+                                   const Clock::time_point & now)
+{
+  float sample = connectionInfo.deliveryRate;
+
+  if (sample <= 0 and connectionInfo.roundTripTime > 0) {
+    // Bytes per millisecond to Mbps
+    sample = 8E-3 * connectionInfo.congestionWindow *
+               connectionInfo.maxSegmentSize / connectionInfo.roundTripTime;
+  }
+
+  if (this->hasSamples) {
+    sample = this->smoothingFactor * sample +
+             (1 - this->smoothingFactor) * this->bandwidth.load();
+  }
+
+  this->bandwidth.store(sample);
+  this->roundTripTime.store(connectionInfo.roundTripTime);
+  this->totalRetransmits.store(connectionInfo.totalRetransmits);
+  this->hasSamples = true;
+  this->lastSampleTime = now;
+}
+
+float BandwidthEstimator::getBandwidth() const
+{
+  return this->bandwidth.load();
+}
+
+float BandwidthEstimator::getRoundTripTime() const
+{
+  return this->roundTripTime.load();
+}
+
+uint32_t BandwidthEstimator::getTotalRetransmits() const
+{
+  return this->totalRetransmits.load();
+}
+
+void BandwidthEstimator::reset()
+{
+  this->bandwidth.store(0);
+  this->roundTripTime.store(0);
+  this->totalRetransmits.store(0);
+  this->hasSamples = false;
+}
+
+} // namespace autocomp
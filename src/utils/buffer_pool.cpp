@@ -0,0 +1,123 @@
+/**
+ *  AutoComp Buffer Pool
+ *  buffer_pool.cpp
+ *
+ *  Definition of class BufferPool methods, used to recycle chunk buffers
+ *  between the producer of a transmission and its consumer.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "utils/buffer_pool.hpp"
+
+namespace autocomp {
+
+// BufferPool constructor
+BufferPool::BufferPool(const std::size_t & bufferCapacity,
+                       const std::size_t & maxIdleBuffers)
+  : bufferCapacity(bufferCapacity),
+    maxIdleBuffers(maxIdleBuffers),
+    memoryGovernor(nullptr),
+    idleBytes(0)
+{
+  this->buffers.reserve(maxIdleBuffers);
+}
+
+BufferPool::~BufferPool()
+{
+  this->trim();
+}
+
+// The governors only keep the account, so the charge moves without touching
+// the buffers
+void BufferPool::setMemoryGovernor(MemoryGovernor * memoryGovernor)
+{
+  std::unique_lock<std::mutex> guard(this->mutex);
+
+  if (this->memoryGovernor) {
+    this->memoryGovernor->release(this->idleBytes);
+  }
+
+  if (memoryGovernor) {
+    memoryGovernor->forceReserve(this->idleBytes);
+  }
+
+  this->memoryGovernor = memoryGovernor;
+}
+
+// Takes an idle buffer from the pool, or allocates a new one
+Buffer BufferPool::acquire()
+{
+  {
+    std::unique_lock<std::mutex> guard(this->mutex);
+
+    if (not this->buffers.empty()) {
+      Buffer buffer(std::move(this->buffers.back()));
+      this->buffers.pop_back();
+
+      // Its new holder accounts for it
+      this->idleBytes -= buffer.getCapacity();
+
+      if (this->memoryGovernor) {
+        this->memoryGovernor->release(buffer.getCapacity());
+      }
+
+      return buffer;
+    }
+  }
+
+  return Buffer(this->bufferCapacity);
+}
+
+// Hands a buffer back to the pool
+void BufferPool::release(Buffer && buffer)
+{
+  if (buffer.getCapacity() < this->bufferCapacity) {
+    return;
+  }
+
+  buffer.setSize(0);
+
+  std::unique_lock<std::mutex> guard(this->mutex);
+
+  if (this->buffers.size() >= this->maxIdleBuffers) {
+    return;
+  }
+
+  if (this->memoryGovernor and
+      not this->memoryGovernor->tryReserve(buffer.getCapacity())) {
+    return;
+  }
+
+  this->idleBytes += buffer.getCapacity();
+  this->buffers.push_back(std::move(buffer));
+}
+
+// Frees every idle buffer
+void BufferPool::trim()
+{
+  std::unique_lock<std::mutex> guard(this->mutex);
+
+  if (this->memoryGovernor) {
+    this->memoryGovernor->release(this->idleBytes);
+  }
+
+  this->buffers.clear();
+  this->idleBytes = 0;
+}
+
+std::size_t BufferPool::getBufferCapacity() const
+{
+  return this->bufferCapacity;
+}
+
+std::size_t BufferPool::getIdleBuffers() const
+{
+  std::unique_lock<std::mutex> guard(this->mutex);
+
+  return this->buffers.size();
+}
+
+} // namespace autocomp
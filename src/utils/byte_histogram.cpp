@@ -0,0 +1,359 @@
+/**
+ *  AutoComp Byte Histogram
+ *  byte_histogram.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/byte_histogram.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#if defined(__GNUC__) and defined(__x86_64__)
+#define AC_BYTE_HISTOGRAM_SIMD
+#include <immintrin.h>
+#endif
+
+namespace autocomp {
+
+namespace
+{
+  // Counts the bytes into the lanes, and the places where a byte differs
+  // from the one before it within the data
+  using Kernel = void (*)(const unsigned char * data,
+                          const std::size_t & dataSize,
+                          ByteHistogram::Lanes & lanes,
+                          std::size_t & nRunBreaks);
+
+  inline void countBytes(const unsigned char * data,
+                         const std::size_t & dataSize,
+                         ByteHistogram::Lanes & lanes)
+  {
+    static_assert(ByteHistogram::N_LANES == 4, "One lane per byte of a group");
+
+    std::size_t i = 0;
+
+    for (; i + 4 <= dataSize; i += 4) {
+      lanes[0][data[i]]++;
+      lanes[1][data[i + 1]]++;
+      lanes[2][data[i + 2]]++;
+      lanes[3][data[i + 3]]++;
+    }
+
+    for (; i < dataSize; i++) {
+      lanes[0][data[i]]++;
+    }
+  }
+
+  // Run breaks between the bytes from position begin on
+  inline std::size_t countRunBreaks(const unsigned char * data,
+                                    std::size_t begin,
+                                    const std::size_t & dataSize)
+  {
+    std::size_t nRunBreaks = 0;
+
+    for (begin = std::max<std::size_t>(begin, 1); begin < dataSize; begin++) {
+      nRunBreaks += data[begin] != data[begin - 1];
+    }
+
+    return nRunBreaks;
+  }
+
+  void scalarKernel(const unsigned char * data, const std::size_t & dataSize,
+                    ByteHistogram::Lanes & lanes, std::size_t & nRunBreaks)
+  {
+    countBytes(data, dataSize, lanes);
+    nRunBreaks += countRunBreaks(data, 0, dataSize);
+  }
+
+#ifdef AC_BYTE_HISTOGRAM_SIMD
+
+  // Each block of bytes is compared with itself shifted by one byte while
+  // it is counted, so the data is read once
+  __attribute__((target("sse2")))
+  void sse2Kernel(const unsigned char * data, const std::size_t & dataSize,
+                  ByteHistogram::Lanes & lanes, std::size_t & nRunBreaks)
+  {
+    const std::size_t blockSize = sizeof(__m128i);
+    std::size_t offset = 0;
+
+    for (; offset + blockSize < dataSize; offset += blockSize) {
+      __m128i block = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(data + offset)
+                      );
+      __m128i nextBlock = _mm_loadu_si128(
+                            reinterpret_cast<const __m128i *>(data + offset +
+                                                              1)
+                          );
+      unsigned int equalBytes =
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, nextBlock));
+
+      nRunBreaks += blockSize - __builtin_popcount(equalBytes);
+      countBytes(data + offset, blockSize, lanes);
+    }
+
+    countBytes(data + offset, dataSize - offset, lanes);
+    nRunBreaks += countRunBreaks(data, offset + 1, dataSize);
+  }
+
+  __attribute__((target("avx2")))
+  void avx2Kernel(const unsigned char * data, const std::size_t & dataSize,
+                  ByteHistogram::Lanes & lanes, std::size_t & nRunBreaks)
+  {
+    const std::size_t blockSize = sizeof(__m256i);
+    std::size_t offset = 0;
+
+    for (; offset + blockSize < dataSize; offset += blockSize) {
+      __m256i block = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(data + offset)
+                      );
+      __m256i nextBlock = _mm256_loadu_si256(
+                            reinterpret_cast<const __m256i *>(data + offset +
+                                                              1)
+                          );
+      unsigned int equalBytes =
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, nextBlock));
+
+      nRunBreaks += blockSize - __builtin_popcount(equalBytes);
+      countBytes(data + offset, blockSize, lanes);
+    }
+
+    countBytes(data + offset, dataSize - offset, lanes);
+    nRunBreaks += countRunBreaks(data, offset + 1, dataSize);
+  }
+
+#endif
+
+  struct KernelEntry
+  {
+    Kernel kernel;
+    const char * name;
+  };
+
+  KernelEntry selectKernel()
+  {
+#ifdef AC_BYTE_HISTOGRAM_SIMD
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+      return {avx2Kernel, "avx2"};
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+      return {sse2Kernel, "sse2"};
+    }
+
+#endif
+
+    return {scalarKernel, "scalar"};
+  }
+
+  // Selected once, by the first thread to count bytes
+  const KernelEntry & getKernel()
+  {
+    static const KernelEntry kernel = selectKernel();
+
+    return kernel;
+  }
+
+  // Each lane counts at most this many bytes before they are folded
+  const std::size_t maxLaneSize = std::numeric_limits<std::uint32_t>::max();
+}
+
+const std::size_t ByteHistogram::N_LANES;
+
+// ByteHistogram constructor
+ByteHistogram::ByteHistogram()
+  : lanes(),
+    laneSize(0),
+    counts(),
+    size(0),
+    nRuns(0),
+    lastByte(-1)
+{}
+
+// The data is counted in pieces small enough for the lanes not to overflow
+void ByteHistogram::update(const unsigned char * data,
+                           const std::size_t & dataSize)
+{
+  if (dataSize == 0) {
+    return;
+  }
+
+  const Kernel & kernel = getKernel().kernel;
+  std::size_t nRunBreaks = 0;
+
+  if (this->lastByte != data[0]) {
+    nRunBreaks++;
+  }
+
+  for (std::size_t offset = 0; offset < dataSize;) {
+    if (this->laneSize == maxLaneSize) {
+      this->foldLanes();
+    }
+
+    std::size_t pieceSize = std::min(dataSize - offset,
+                                     maxLaneSize - this->laneSize);
+
+    // The first byte of each piece after the first one is compared with the
+    // last one of the piece before
+    if (offset > 0 and data[offset] != data[offset - 1]) {
+      nRunBreaks++;
+    }
+
+    kernel(data + offset, pieceSize, this->lanes, nRunBreaks);
+
+    this->laneSize += pieceSize;
+    offset += pieceSize;
+  }
+
+  this->size += dataSize;
+  this->nRuns += nRunBreaks;
+  this->lastByte = data[dataSize - 1];
+}
+
+void ByteHistogram::update(const char * data, const std::size_t & dataSize)
+{
+  this->update(reinterpret_cast<const unsigned char *>(data), dataSize);
+}
+
+// The lanes hold counts only if bytes were counted since they were last
+// folded, and the counts only if they were ever folded
+void ByteHistogram::clear()
+{
+  if (this->laneSize > 0) {
+    for (auto & lane : this->lanes) {
+      lane.fill(0);
+    }
+  }
+
+  if (this->size > this->laneSize) {
+    this->counts.fill(0);
+  }
+
+  this->laneSize = 0;
+  this->size = 0;
+  this->nRuns = 0;
+  this->lastByte = -1;
+}
+
+std::size_t ByteHistogram::getSize() const
+{
+  return this->size;
+}
+
+std::size_t ByteHistogram::getCount(const unsigned char & byte) const
+{
+  std::size_t count = this->counts[byte];
+
+  for (const auto & lane : this->lanes) {
+    count += lane[byte];
+  }
+
+  return count;
+}
+
+// A byte counts if it occurs at least as often as each would in uniformly
+// random data. The lanes are added one after the other, which vectorizes
+ByteFeatures ByteHistogram::getFeatures() const
+{
+  ByteFeatures features{0, 0, 0, 0};
+  std::array<std::size_t, 256> totalCounts = this->counts;
+
+  for (const auto & lane : this->lanes) {
+    for (int byte = 0; byte < 256; byte++) {
+      totalCounts[byte] += lane[byte];
+    }
+  }
+
+  std::size_t threshold = this->size / 256;
+
+  for (std::size_t count : totalCounts) {
+    if (count >= threshold) {
+      features.bytecount++;
+    }
+
+    if (count > 0) {
+      double probability = count / static_cast<double>(this->size);
+      features.entropy -= probability * std::log2(probability);
+    }
+  }
+
+  if (this->size > 0) {
+    features.zeroRatio = totalCounts[0] / static_cast<double>(this->size);
+    features.meanRunLength = this->size / static_cast<double>(this->nRuns);
+  }
+
+  return features;
+}
+
+// A chunk too small for its subchunks to hold a byte is counted whole. Each
+// thread reuses its histogram, which is cheaper to clear than to make
+ByteFeatures ByteHistogram::getSampledFeatures(const char * data,
+                                               const std::size_t & dataSize)
+{
+  static const double subChunkProportion = 0.1;
+  static const std::vector<double> relativeSubChunkPositions({0.10, 0.45,
+                                                              0.80});
+  static thread_local ByteHistogram histogram;
+
+  std::size_t subChunkSize = subChunkProportion * dataSize;
+
+  if (subChunkSize == 0) {
+    histogram.clear();
+    histogram.update(data, dataSize);
+
+    return histogram.getFeatures();
+  }
+
+  double averageBytecount = 0;
+  ByteFeatures averageFeatures{0, 0, 0, 0};
+
+  for (const double & relativePosition : relativeSubChunkPositions) {
+    std::size_t offset = relativePosition * dataSize;
+
+    histogram.clear();
+    histogram.update(data + offset, subChunkSize);
+
+    ByteFeatures features = histogram.getFeatures();
+    averageBytecount += features.bytecount;
+    averageFeatures.entropy += features.entropy;
+    averageFeatures.zeroRatio += features.zeroRatio;
+    averageFeatures.meanRunLength += features.meanRunLength;
+  }
+
+  double nSubChunks = relativeSubChunkPositions.size();
+
+  averageFeatures.bytecount = std::round(averageBytecount / nSubChunks);
+  averageFeatures.entropy /= nSubChunks;
+  averageFeatures.zeroRatio /= nSubChunks;
+  averageFeatures.meanRunLength /= nSubChunks;
+
+  return averageFeatures;
+}
+
+const char * ByteHistogram::getKernelName()
+{
+  return getKernel().name;
+}
+
+void ByteHistogram::foldLanes()
+{
+  for (auto & lane : this->lanes) {
+    for (int byte = 0; byte < 256; byte++) {
+      this->counts[byte] += lane[byte];
+    }
+
+    lane.fill(0);
+  }
+
+  this->laneSize = 0;
+}
+
+} // namespace autocomp
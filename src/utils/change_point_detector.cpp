@@ -0,0 +1,70 @@
+/**
+ *  AutoComp Change-Point Detector
+ *  change_point_detector.cpp
+ *
+ *  Definition of class ChangePointDetector methods, which tells when the
+ *  mean of a stream of observations shifts.
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/change_point_detector.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace autocomp {
+
+// ChangePointDetector constructor
+ChangePointDetector::ChangePointDetector(const double & drift,
+                                         const double & threshold)
+  : drift(drift),
+    threshold(threshold),
+    reference(0),
+    nObservations(0),
+    upperSum(0),
+    lowerSum(0)
+{
+  if (drift < 0) {
+    throw std::domain_error("drift must not be negative");
+  }
+
+  if (threshold <= 0) {
+    throw std::domain_error("threshold must be greater than 0");
+  }
+}
+
+// The observation is measured against the reference before it joins it, so
+// the first one only sets the reference
+bool ChangePointDetector::update(const double & observation)
+{
+  if (this->nObservations > 0) {
+    double deviation = observation - this->reference;
+
+    this->upperSum = std::max(0.0, this->upperSum + deviation - this->drift);
+    this->lowerSum = std::max(0.0, this->lowerSum - deviation - this->drift);
+  }
+
+  this->nObservations++;
+  this->reference += (observation - this->reference) / this->nObservations;
+
+  return this->upperSum > this->threshold or
+         this->lowerSum > this->threshold;
+}
+
+double ChangePointDetector::getReference() const
+{
+  return this->reference;
+}
+
+void ChangePointDetector::reset()
+{
+  this->reference = 0;
+  this->nObservations = 0;
+  this->upperSum = 0;
+  this->lowerSum = 0;
+}
+
+} // namespace autocomp
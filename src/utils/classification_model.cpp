@@ -0,0 +1,75 @@
+/**
+ *  AutoComp Classification Model
+ *  classification_model.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/classification_model.hpp"
+
+#include <fstream>
+#include <algorithm>
+
+#include "utils/exceptions.hpp"
+#include "utils/decision_tree.hpp"
+#include "utils/ensemble_model.hpp"
+
+namespace autocomp {
+
+// Ensembles start with their kind, the rest is left to the decision tree
+std::unique_ptr<ClassificationModel>
+ClassificationModel::load(const std::string & filename)
+{
+  std::ifstream input(filename);
+
+  if (!input) {
+    throw exceptions::IOError("File " + filename + " does not exist");
+  }
+
+  std::string kind;
+  input >> kind;
+  input.close();
+
+  if (EnsembleModel::isKind(kind)) {
+    return std::unique_ptr<ClassificationModel>(new EnsembleModel(filename));
+  }
+
+  return std::unique_ptr<ClassificationModel>(new DecisionTree(filename));
+}
+
+bool
+ClassificationModel::parseCompressors(const std::vector<std::string> &
+                                        compressorLabels)
+{
+  Compressor compressor;
+  std::string compressorName;
+  int compressionLevel;
+
+  for (const std::string & label : compressorLabels) {
+    std::size_t delimiterPosition = label.find("_");
+
+    compressorName = label.substr(0, delimiterPosition);
+    std::transform(compressorName.begin(), compressorName.end(),
+                   compressorName.begin(), ::toupper);
+
+    try {
+      compressionLevel = (delimiterPosition == std::string::npos)
+                          ? -1 : std::stoi(label.substr(delimiterPosition + 1));
+    }
+    catch (...) {
+      return false;
+    }
+
+    if (not Compressor_Parse(compressorName, &compressor)) {
+      return false;
+    }
+
+    this->compressors.push_back(std::make_pair(compressor, compressionLevel));
+  }
+
+  return true;
+}
+
+} // namespace autocomp
@@ -0,0 +1,183 @@
+/**
+ *  AutoComp Codec Calibration
+ *  codec_calibration.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/codec_calibration.hpp"
+
+#include <algorithm>
+
+namespace autocomp {
+
+namespace
+{
+  // Lower entropies are taken as this one, so that the ratio of an entropy
+  // coder stays finite on constant data
+  const double minEntropy = 0.1;
+
+  double getEntropyCoderRatio(const double & entropy)
+  {
+    return 8 / std::max(entropy, minEntropy);
+  }
+}
+
+const std::size_t CodecCalibration::N_ENTROPY_BUCKETS;
+
+CodecCalibration::CodecCalibration(const double & smoothingFactor)
+  : smoothingFactor(smoothingFactor)
+{}
+
+void CodecCalibration::record(
+    const Codec & codec, const CompressionPerformanceData & performanceData,
+    const double & entropy
+  )
+{
+  if (performanceData.originalSize == 0 or performanceData.finalSize == 0) {
+    return;
+  }
+
+  // Compression rate in Mbits/s (8e-6 Mbits in 1 byte and 1e-6 sec in 1 us)
+  double compressionRate = 8.0 * performanceData.originalSize /
+                           std::max(performanceData.elapsedTime, 1L);
+  double ratioFactor =
+    performanceData.originalSize /
+    static_cast<double>(performanceData.finalSize) /
+    getEntropyCoderRatio(entropy);
+  std::size_t bucket = getEntropyBucket(entropy);
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  auto found = this->codecs.find(codec);
+
+  if (found == this->codecs.end()) {
+    CodecState codecState;
+    codecState.compressionRate = compressionRate;
+    codecState.ratioFactors.fill(0);
+    codecState.observedBuckets.fill(false);
+    codecState.nObservations = 0;
+
+    found = this->codecs.emplace(codec, codecState).first;
+  }
+  else {
+    found->second.compressionRate +=
+      this->smoothingFactor * (compressionRate -
+                               found->second.compressionRate);
+  }
+
+  CodecState & codecState = found->second;
+  double & bucketRatioFactor = codecState.ratioFactors[bucket];
+
+  if (codecState.observedBuckets[bucket]) {
+    bucketRatioFactor +=
+      this->smoothingFactor * (ratioFactor - bucketRatioFactor);
+  }
+  else {
+    bucketRatioFactor = ratioFactor;
+    codecState.observedBuckets[bucket] = true;
+  }
+
+  codecState.nObservations++;
+}
+
+CodecPrediction CodecCalibration::predict(const Codec & codec,
+                                          const double & entropy) const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  auto found = this->codecs.find(codec);
+
+  if (found == this->codecs.end()) {
+    return {0, 1};
+  }
+
+  const CodecState & codecState = found->second;
+
+  return {
+    codecState.compressionRate,
+    std::max(getRatioFactor(codecState, getEntropyBucket(entropy)) *
+               getEntropyCoderRatio(entropy),
+             1.0)
+  };
+}
+
+bool CodecCalibration::isCalibrated(const Codec & codec) const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  return this->codecs.count(codec) > 0;
+}
+
+// Buckets with no chunks yet take the factors of the nearest ones with
+// chunks, interpolated if there are some on both sides
+double CodecCalibration::getRatioFactor(const CodecState & codecState,
+                                        const std::size_t & bucket)
+{
+  if (codecState.observedBuckets[bucket]) {
+    return codecState.ratioFactors[bucket];
+  }
+
+  const int nBuckets = N_ENTROPY_BUCKETS;
+  int lower = bucket, upper = bucket;
+
+  while (lower >= 0 and not codecState.observedBuckets[lower]) {
+    lower--;
+  }
+
+  while (upper < nBuckets and not codecState.observedBuckets[upper]) {
+    upper++;
+  }
+
+  if (lower < 0) {
+    return codecState.ratioFactors[upper];
+  }
+
+  if (upper == nBuckets) {
+    return codecState.ratioFactors[lower];
+  }
+
+  double weight = (static_cast<int>(bucket) - lower) /
+                  static_cast<double>(upper - lower);
+
+  return codecState.ratioFactors[lower] +
+         weight * (codecState.ratioFactors[upper] -
+                   codecState.ratioFactors[lower]);
+}
+
+std::size_t CodecCalibration::getEntropyBucket(const double & entropy)
+{
+  return std::min<std::size_t>(std::max(entropy, 0.0), N_ENTROPY_BUCKETS - 1);
+}
+
+std::ostream & operator<<(std::ostream & stream,
+                          const CodecCalibration & calibration)
+{
+  std::lock_guard<std::mutex> guard(calibration.mutex);
+
+  stream << "{";
+
+  for (auto it = calibration.codecs.begin(); it != calibration.codecs.end();
+       it++) {
+    const CodecCalibration::CodecState & codecState = it->second;
+    double meanRatioFactor = 0;
+
+    for (std::size_t bucket = 0; bucket < CodecCalibration::N_ENTROPY_BUCKETS;
+         bucket++) {
+      meanRatioFactor += CodecCalibration::getRatioFactor(codecState, bucket) /
+                         CodecCalibration::N_ENTROPY_BUCKETS;
+    }
+
+    stream << (it == calibration.codecs.begin() ? "" : ", ")
+           << Compressor_Name(it->first.first) << " " << it->first.second
+           << ": {compressionRate: " << codecState.compressionRate
+           << ", ratioFactor: " << meanRatioFactor
+           << ", nObservations: " << codecState.nObservations << "}";
+  }
+
+  return stream << "}";
+}
+
+} // namespace autocomp
@@ -0,0 +1,340 @@
+/**
+ *  AutoComp Contextual Bandit
+ *  contextual_bandit.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/contextual_bandit.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <algorithm>
+
+#include "utils/constants.hpp"
+#include "utils/exceptions.hpp"
+
+namespace autocomp {
+
+namespace
+{
+  const std::string banditHeader("contextual_bandit");
+
+  const std::vector<ContextualBandit::Arm> defaultArms{
+    {COPY, -1}, {SNAPPY, -1}, {LZO, 1}, {LZO, 8}, {ZLIB, 1}, {ZLIB, 6},
+    {ZLIB, 9}, {BZIP2, 5}, {LZMA, 1}, {FPC, constants::FPC_FAST_LEVEL},
+    {FPC, constants::FPC_STRONG_LEVEL}
+  };
+}
+
+ContextualBandit::ContextualBandit(const std::vector<Arm> & arms)
+  : arms(arms.empty() ? defaultArms : arms),
+    warmStartModel(nullptr),
+    stats()
+{}
+
+void
+ContextualBandit::setWarmStartModel(const ClassificationModel * warmStartModel)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  // Models trained on more features than the context, like the
+  // compressibility probe, can not warm start it
+  this->warmStartModel =
+    warmStartModel and
+    warmStartModel->getFeatureCount() == std::tuple_size<Context>::value
+      ? warmStartModel
+      : nullptr;
+}
+
+// The best known arm is the one with the highest mean. The posterior of the
+// mean is taken as normal, with the deviation of the rewards over the root of
+// the observations
+ContextualBandit::Choice
+ContextualBandit::choose(const Context & context, std::mt19937 & generator,
+                         const bool & explore)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  const std::vector<ArmState> & armStates = this->getArmStates(context);
+  std::normal_distribution<double> normal;
+  std::size_t best = 0, sampledBest = 0;
+  double bestSample = 0;
+
+  for (std::size_t i = 0; i < armStates.size(); i++) {
+    const ArmState & armState = armStates[i];
+
+    if (armState.meanReward > armStates[best].meanReward) {
+      best = i;
+    }
+
+    if (not explore) {
+      continue;
+    }
+
+    double deviation = armState.nObservations >= 2
+                         ? std::sqrt(armState.squaredDeviations /
+                                       (armState.nObservations - 1))
+                         : constants::BANDIT_PRIOR_DEVIATION;
+    double sample = armState.meanReward +
+                    normal(generator) *
+                      std::max(deviation, constants::BANDIT_MIN_DEVIATION) /
+                      std::sqrt(armState.nObservations);
+
+    if (i == 0 or sample > bestSample) {
+      sampledBest = i;
+      bestSample = sample;
+    }
+  }
+
+  std::size_t chosen = explore ? sampledBest : best;
+
+  this->stats.nChoices++;
+  this->stats.nExplorations += chosen != best;
+
+  return Choice{this->arms[chosen], chosen != best};
+}
+
+// Once an arm has the most observations it remembers, each new one weighs as
+// much as the average of the older ones
+void ContextualBandit::record(const Context & context, const Arm & arm,
+                              const double & reward)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  int index = this->findArm(arm);
+
+  if (index < 0) {
+    return;
+  }
+
+  ArmState & armState = this->getArmStates(context)[index];
+
+  if (armState.nObservations >= constants::BANDIT_MAX_OBSERVATIONS) {
+    armState.squaredDeviations *= (armState.nObservations - 1) /
+                                  armState.nObservations;
+  }
+  else {
+    armState.nObservations++;
+  }
+
+  double deviation = reward - armState.meanReward;
+  armState.meanReward += deviation / armState.nObservations;
+  armState.squaredDeviations += deviation * (reward - armState.meanReward);
+
+  this->stats.nObservations++;
+}
+
+double ContextualBandit::getMeanReward(const Context & context,
+                                       const Arm & arm) const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  int index = this->findArm(arm);
+  auto contextEntry = this->contexts.find(pack(context));
+
+  if (index >= 0 and contextEntry != this->contexts.end()) {
+    return contextEntry->second[index].meanReward;
+  }
+
+  if (this->warmStartModel and this->warmStartModel->classify(context) == arm) {
+    return constants::BANDIT_PRIOR_REWARD + constants::BANDIT_WARM_START_BONUS;
+  }
+
+  return constants::BANDIT_PRIOR_REWARD;
+}
+
+const std::vector<ContextualBandit::Arm> & ContextualBandit::getArms() const
+{
+  return this->arms;
+}
+
+BanditStats ContextualBandit::getStats() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  BanditStats stats = this->stats;
+  stats.nContexts = this->contexts.size();
+
+  return stats;
+}
+
+// The format is the header, the arms, as compressor and level, and then one
+// line per context with its levels and the state of every arm
+bool ContextualBandit::load(const std::string & filename)
+{
+  std::ifstream input(filename);
+
+  if (not input) {
+    return false;
+  }
+
+  const std::string errorMessage("File " + filename +
+                                 " is not a valid contextual bandit");
+  std::string header;
+  std::size_t nArms, nContexts;
+  input >> header >> nArms;
+
+  if (not input or header != banditHeader) {
+    throw exceptions::IOError(errorMessage);
+  }
+
+  std::vector<int> indices(nArms);
+
+  for (int & index : indices) {
+    int compressor, level;
+    input >> compressor >> level;
+
+    if (not input or not Compressor_IsValid(compressor)) {
+      throw exceptions::IOError(errorMessage);
+    }
+
+    index = this->findArm(Arm(static_cast<Compressor>(compressor), level));
+  }
+
+  input >> nContexts;
+
+  if (not input) {
+    throw exceptions::IOError(errorMessage);
+  }
+
+  std::unordered_map<std::uint64_t, std::vector<ArmState>> contexts;
+  const ArmState prior{1, constants::BANDIT_PRIOR_REWARD, 0};
+
+  for (std::size_t i = 0; i < nContexts; i++) {
+    Context context;
+    input >> context[0] >> context[1] >> context[2];
+
+    std::vector<ArmState> armStates(this->arms.size(), prior);
+
+    for (const int & index : indices) {
+      ArmState armState;
+      input >> armState.nObservations >> armState.meanReward
+            >> armState.squaredDeviations;
+
+      if (not input or armState.nObservations < 1 or
+          armState.squaredDeviations < 0) {
+        throw exceptions::IOError(errorMessage);
+      }
+
+      if (index >= 0) {
+        armStates[index] = armState;
+      }
+    }
+
+    contexts[pack(context)] = std::move(armStates);
+  }
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->contexts = std::move(contexts);
+
+  return true;
+}
+
+void ContextualBandit::save(const std::string & filename) const
+{
+  std::ostringstream output;
+
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+
+    output << banditHeader << "\n" << this->arms.size() << "\n";
+
+    for (const Arm & arm : this->arms) {
+      output << arm.first << " " << arm.second << "\n";
+    }
+
+    output << this->contexts.size() << "\n";
+    output.precision(9);
+
+    for (const auto & contextEntry : this->contexts) {
+      Context context = unpack(contextEntry.first);
+      output << context[0] << " " << context[1] << " " << context[2];
+
+      for (const ArmState & armState : contextEntry.second) {
+        output << " " << armState.nObservations << " " << armState.meanReward
+               << " " << armState.squaredDeviations;
+      }
+
+      output << "\n";
+    }
+  }
+
+  // Written aside and renamed, so a crash never leaves half a file
+  const std::string temporaryFilename(filename + ".tmp");
+  std::ofstream file(temporaryFilename, std::ios::trunc);
+  file << output.str();
+  file.close();
+
+  if (not file or
+      std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+    std::remove(temporaryFilename.c_str());
+
+    throw exceptions::IOError("Could not write contextual bandit " + filename);
+  }
+}
+
+// Contexts are created on first use, with the prior of every arm
+std::vector<ContextualBandit::ArmState> &
+ContextualBandit::getArmStates(const Context & context)
+{
+  auto contextEntry = this->contexts.find(pack(context));
+
+  if (contextEntry != this->contexts.end()) {
+    return contextEntry->second;
+  }
+
+  const ArmState prior{1, constants::BANDIT_PRIOR_REWARD, 0};
+  std::vector<ArmState> armStates(this->arms.size(), prior);
+
+  if (this->warmStartModel) {
+    int index = this->findArm(this->warmStartModel->classify(context));
+
+    if (index >= 0) {
+      armStates[index].meanReward += constants::BANDIT_WARM_START_BONUS;
+    }
+  }
+
+  return this->contexts[pack(context)] = std::move(armStates);
+}
+
+int ContextualBandit::findArm(const Arm & arm) const
+{
+  auto armEntry = std::find(this->arms.begin(), this->arms.end(), arm);
+
+  return armEntry != this->arms.end() ? armEntry - this->arms.begin() : -1;
+}
+
+// Levels are small and not negative, 16 bits each is plenty
+std::uint64_t ContextualBandit::pack(const Context & context)
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint16_t>(context[0]))
+            << 32) |
+         (static_cast<std::uint64_t>(static_cast<std::uint16_t>(context[1]))
+            << 16) |
+         static_cast<std::uint16_t>(context[2]);
+}
+
+ContextualBandit::Context ContextualBandit::unpack(const std::uint64_t & key)
+{
+  return Context{{static_cast<std::int16_t>(key >> 32),
+                  static_cast<std::int16_t>(key >> 16),
+                  static_cast<std::int16_t>(key)}};
+}
+
+std::ostream & operator<<(std::ostream & stream, const BanditStats & stats)
+{
+  return stream << "{nContexts: " << stats.nContexts
+                << ", nChoices: " << stats.nChoices
+                << ", nExplorations: " << stats.nExplorations
+                << ", nObservations: " << stats.nObservations
+                << "}";
+}
+
+} // namespace autocomp
@@ -0,0 +1,206 @@
+/**
+ *  AutoComp CPU Budget
+ *  cpu_budget.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/cpu_budget.hpp"
+
+#include <sched.h>
+
+#include <thread>
+#include <algorithm>
+
+#include "utils/constants.hpp"
+
+namespace autocomp {
+
+namespace
+{
+  // CPUs the process is allowed to run on, which a sharded server restricts
+  unsigned int getAvailableCores()
+  {
+    cpu_set_t cpuSet;
+
+    if (::sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+      return std::max(CPU_COUNT(&cpuSet), 1);
+    }
+
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+}
+
+CPUBudget::Commitment::Commitment(CPUBudget * cpuBudget)
+  : cpuBudget(cpuBudget),
+    cores(0),
+    measured(false),
+    lastRecord(Clock::now())
+{}
+
+CPUBudget::Commitment::Commitment(Commitment && other)
+  : cpuBudget(other.cpuBudget),
+    cores(other.cores),
+    measured(other.measured),
+    lastRecord(other.lastRecord)
+{
+  other.cpuBudget = nullptr;
+  other.cores = 0;
+}
+
+CPUBudget::Commitment & CPUBudget::Commitment::operator=(Commitment && other)
+{
+  if (this != &other) {
+    if (this->cpuBudget) {
+      this->cpuBudget->withdraw(this->cores);
+    }
+
+    this->cpuBudget = other.cpuBudget;
+    this->cores = other.cores;
+    this->measured = other.measured;
+    this->lastRecord = other.lastRecord;
+    other.cpuBudget = nullptr;
+    other.cores = 0;
+  }
+
+  return *this;
+}
+
+CPUBudget::Commitment::~Commitment()
+{
+  if (this->cpuBudget) {
+    this->cpuBudget->withdraw(this->cores);
+  }
+}
+
+// The first chunk sets the demand right away, so that the sessions starting
+// at once see each other after a chunk
+void CPUBudget::Commitment::record(const std::chrono::nanoseconds & cpuTime)
+{
+  Clock::time_point now = Clock::now();
+  double elapsedTime =
+    std::chrono::duration<double, std::nano>(now - this->lastRecord).count();
+  double cores = elapsedTime > 0
+                   ? std::min(cpuTime.count() / elapsedTime, 1.0)
+                   : 1.0;
+  double previousCores = this->cores;
+
+  if (this->measured) {
+    this->cores += constants::CPU_DEMAND_SMOOTHING_FACTOR *
+                   (cores - this->cores);
+  }
+  else {
+    this->cores = cores;
+    this->measured = true;
+  }
+
+  this->lastRecord = now;
+
+  if (this->cpuBudget) {
+    this->cpuBudget->update(previousCores, this->cores);
+  }
+}
+
+double CPUBudget::Commitment::getCores() const
+{
+  return this->cores;
+}
+
+CPUBudget::Commitment::operator bool() const
+{
+  return this->cpuBudget != nullptr;
+}
+
+CPUBudget::CPUBudget(const unsigned int & nCores)
+  : stats()
+{
+  this->stats.nCores = nCores > 0 ? nCores : getAvailableCores();
+}
+
+void CPUBudget::setCores(const unsigned int & nCores)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.nCores = nCores > 0 ? nCores : getAvailableCores();
+}
+
+unsigned int CPUBudget::getCores() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  return this->stats.nCores;
+}
+
+CPUBudget::Commitment CPUBudget::commit()
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.nCommitments++;
+
+  return Commitment(this);
+}
+
+// The load the sessions do not account for belongs to other processes
+double CPUBudget::getHeadroom(const Commitment & commitment,
+                              const float & cpuLoad) const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  double committedCores = this->stats.committedCores;
+  double otherSessionsCores =
+    std::max(committedCores - commitment.getCores(), 0.0);
+  double otherProcessesCores =
+    std::max(cpuLoad * this->stats.nCores - committedCores, 0.0);
+
+  return std::max(this->stats.nCores - otherSessionsCores -
+                    otherProcessesCores,
+                  0.0);
+}
+
+float CPUBudget::getLoad(const Commitment & commitment,
+                         const float & cpuLoad) const
+{
+  double headroom = this->getHeadroom(commitment, cpuLoad);
+
+  return std::min(std::max(1 - headroom / this->getCores(), 0.0), 1.0);
+}
+
+CPUBudgetStats CPUBudget::getStats() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  return this->stats;
+}
+
+void CPUBudget::update(const double & previousCores, const double & cores)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.committedCores =
+    std::max(this->stats.committedCores - previousCores + cores, 0.0);
+  this->stats.peakCommittedCores = std::max(this->stats.peakCommittedCores,
+                                            this->stats.committedCores);
+}
+
+void CPUBudget::withdraw(const double & cores)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.committedCores =
+    std::max(this->stats.committedCores - cores, 0.0);
+  this->stats.nCommitments -= std::min<std::size_t>(this->stats.nCommitments,
+                                                    1);
+}
+
+std::ostream & operator<<(std::ostream & stream, const CPUBudgetStats & stats)
+{
+  return stream << "{nCores: " << stats.nCores
+                << ", nCommitments: " << stats.nCommitments
+                << ", committedCores: " << stats.committedCores
+                << ", peakCommittedCores: " << stats.peakCommittedCores
+                << "}";
+}
+
+} // namespace autocomp
@@ -9,10 +9,69 @@
 
 #include "utils/decision_tree.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cmath>
+#include <limits>
+#include <cstring>
+
+#include "utils/constants.hpp"
+
 namespace autocomp
 {
 
+namespace
+{
+  // Layout of the binary model, in the byte order of the host:
+  // a header, the compressors, the flattened nodes, the bounds of the
+  // features and the table, if there is one
+  const char binaryModelMagic[4] = {'A', 'C', 'D', 'T'};
+  const std::uint32_t binaryModelVersion = 1;
+
+  struct BinaryModelHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t nFeatures;
+    std::uint32_t nCompressors;
+    std::uint32_t nNodes;
+    std::uint32_t tableSize;          //!< 0 if there is no table
+  };
+
+  struct BinaryModelCompressor
+  {
+    std::int32_t compressor;
+    std::int32_t compressionLevel;
+  };
+
+  struct BinaryModelNode
+  {
+    std::int32_t feature;
+    float threshold;
+    std::int32_t child;
+  };
+
+  struct BinaryModelBounds
+  {
+    std::int32_t lowerBound;
+    std::int32_t upperBound;
+  };
+
+  void throwInvalidModel(const std::string & filename)
+  {
+    throw exceptions::IOError("File " + filename +
+                              " is not a valid binary decision tree");
+  }
+}
+
 DecisionTree::DecisionTree(const std::string & filename)
+  : table(nullptr),
+    tableSize(0),
+    mapping(nullptr),
+    mappingSize(0)
 {
   std::ifstream input(filename);
 
@@ -20,6 +79,39 @@ DecisionTree::DecisionTree(const std::string & filename)
     throw exceptions::IOError("File " + filename + " does not exist");
   }
 
+  char magic[sizeof(binaryModelMagic)] = {};
+  input.read(magic, sizeof(magic));
+
+  if (input.gcount() == sizeof(magic) and
+      std::equal(magic, magic + sizeof(magic), binaryModelMagic)) {
+    input.close();
+
+    if (not this->loadBinary(filename)) {
+      if (this->mapping) {
+        ::munmap(this->mapping, this->mappingSize);
+      }
+
+      throwInvalidModel(filename);
+    }
+
+    return;
+  }
+
+  input.clear();
+  input.seekg(0);
+  this->loadText(input, filename);
+  this->compileTable();
+}
+
+DecisionTree::~DecisionTree()
+{
+  if (this->mapping) {
+    ::munmap(this->mapping, this->mappingSize);
+  }
+}
+
+void DecisionTree::loadText(std::ifstream & input, const std::string & filename)
+{
   // Read compressor labels
   int nCompressors;
   input >> nCompressors;
@@ -44,12 +136,12 @@ DecisionTree::DecisionTree(const std::string & filename)
   std::size_t nNodes;
   input >> nNodes;
   checkInputStream(input, " 4");
-  this->nodes = std::vector<Node>(nNodes);
+  std::vector<Node> nodes(nNodes);
 
   input.ignore(2);
 
   // Read node info
-  for (int i = 0; i < nNodes; i++) {
+  for (std::size_t i = 0; i < nNodes; i++) {
     std::string line;
     int leftChild, rightChild, feature, value;
     float threshold;
@@ -61,69 +153,330 @@ DecisionTree::DecisionTree(const std::string & filename)
     stream >> leftChild >> rightChild >> feature >> threshold >> value;
     checkInputStream(stream, " 6");
 
-    this->nodes[i] = {leftChild, rightChild, feature, threshold, value};
+    nodes[i] = {leftChild, rightChild, feature, threshold, value};
   }
 
   input.close();
+
+  this->flatten(nodes);
 }
 
-std::pair<Compressor, int>
-DecisionTree::classify(const std::vector<int> & point) const
+bool DecisionTree::loadBinary(const std::string & filename)
 {
-  if (point.size() != this->nFeatures) {
-    throw std::invalid_argument("Invalid point dimensionality. Shape of " +
-                                std::to_string(point.size()) +
-                                " was given but must be " +
-                                std::to_string(this->nFeatures));
+  int fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+
+  if (fileDescriptor < 0) {
+    return false;
+  }
+
+  struct stat fileStatus;
+
+  if (::fstat(fileDescriptor, &fileStatus) < 0 or
+      static_cast<std::size_t>(fileStatus.st_size) <
+        sizeof(BinaryModelHeader)) {
+    ::close(fileDescriptor);
+    return false;
+  }
+
+  this->mappingSize = fileStatus.st_size;
+  this->mapping = ::mmap(nullptr, this->mappingSize, PROT_READ, MAP_PRIVATE,
+                         fileDescriptor, 0);
+  ::close(fileDescriptor);
+
+  if (this->mapping == MAP_FAILED) {
+    this->mapping = nullptr;
+    return false;
+  }
+
+  const char * data = static_cast<const char *>(this->mapping);
+  BinaryModelHeader header;
+  std::memcpy(&header, data, sizeof(header));
+
+  std::size_t boundsCount = header.tableSize > 0 ? header.nFeatures : 0;
+  std::size_t expectedSize =
+    sizeof(BinaryModelHeader) +
+    header.nCompressors * sizeof(BinaryModelCompressor) +
+    header.nNodes * sizeof(BinaryModelNode) +
+    boundsCount * sizeof(BinaryModelBounds) +
+    header.tableSize;
+
+  if (header.version != binaryModelVersion or header.nNodes == 0 or
+      header.nCompressors == 0 or expectedSize != this->mappingSize) {
+    return false;
+  }
+
+  this->nFeatures = header.nFeatures;
+  std::size_t offset = sizeof(BinaryModelHeader);
+
+  for (std::uint32_t i = 0; i < header.nCompressors; i++) {
+    BinaryModelCompressor compressor;
+    std::memcpy(&compressor, data + offset, sizeof(compressor));
+    offset += sizeof(compressor);
+
+    if (not Compressor_IsValid(compressor.compressor)) {
+      return false;
+    }
+
+    this->compressors.emplace_back(
+        static_cast<Compressor>(compressor.compressor),
+        compressor.compressionLevel
+      );
+  }
+
+  for (std::uint32_t i = 0; i < header.nNodes; i++) {
+    BinaryModelNode node;
+    std::memcpy(&node, data + offset, sizeof(node));
+    offset += sizeof(node);
+
+    // Children come after their parent, so walking always ends. Widened so
+    // that negative values are not taken for large ones
+    std::int64_t feature = node.feature;
+    std::int64_t child = node.child;
+    bool valid = feature < 0
+                   ? child >= 0 and child < header.nCompressors
+                   : feature < header.nFeatures and child > i and
+                     child + 1 < header.nNodes;
+
+    if (not valid) {
+      return false;
+    }
+
+    this->features.push_back(node.feature < 0 ? -1 : node.feature);
+    this->thresholds.push_back(node.threshold);
+    this->children.push_back(node.child);
+  }
+
+  if (header.tableSize == 0) {
+    return true;
+  }
+
+  std::size_t tableSize = 1;
+
+  for (std::uint32_t i = 0; i < boundsCount; i++) {
+    BinaryModelBounds bounds;
+    std::memcpy(&bounds, data + offset, sizeof(bounds));
+    offset += sizeof(bounds);
+
+    if (bounds.upperBound < bounds.lowerBound) {
+      return false;
+    }
+
+    this->lowerBounds.push_back(bounds.lowerBound);
+    this->upperBounds.push_back(bounds.upperBound);
+    tableSize *= static_cast<std::size_t>(bounds.upperBound) -
+                 bounds.lowerBound + 1;
+  }
+
+  const std::uint8_t * table =
+    reinterpret_cast<const std::uint8_t *>(data + offset);
+
+  if (tableSize != header.tableSize or
+      std::any_of(table, table + tableSize,
+                  [&header] (const std::uint8_t & label)
+                  {
+                    return label >= header.nCompressors;
+                  })) {
+    return false;
   }
 
-  int currentNodeIndex = 0;
+  this->strides.resize(this->nFeatures);
+  std::size_t stride = 1;
 
-  while (not isLeaf(this->nodes[currentNodeIndex])) {
-    const auto & currentNode = this->nodes[currentNodeIndex];
-    currentNodeIndex = (point[currentNode.feature] <= currentNode.threshold)
-                          ? currentNode.leftChild : currentNode.rightChild;
+  for (unsigned int i = this->nFeatures; i-- > 0;) {
+    this->strides[i] = stride;
+    stride *= this->upperBounds[i] - this->lowerBounds[i] + 1;
   }
 
-  return this->compressors[this->nodes[currentNodeIndex].value];
+  this->table = table;
+  this->tableSize = tableSize;
+
+  return true;
 }
 
-inline bool DecisionTree::isLeaf(const Node & node) const
+// Breadth first, each internal node takes the next two free slots for its
+// children
+void DecisionTree::flatten(const std::vector<Node> & nodes)
 {
-  return (node.leftChild == node.rightChild);
+  if (nodes.empty()) {
+    throw exceptions::IOError("Input file is not a valid decision tree 7");
+  }
+
+  std::vector<int> order{0};
+
+  for (std::size_t i = 0; i < order.size(); i++) {
+    const Node & node = nodes[order[i]];
+
+    if (this->isLeaf(node)) {
+      if (node.value < 0 or
+          std::size_t(node.value) >= this->compressors.size()) {
+        throw exceptions::IOError("Input file is not a valid decision tree 8");
+      }
+
+      this->features.push_back(-1);
+      this->thresholds.push_back(0);
+      this->children.push_back(node.value);
+      continue;
+    }
+
+    // A cycle would give more slots than nodes
+    if (node.feature < 0 or unsigned(node.feature) >= this->nFeatures or
+        node.leftChild < 0 or std::size_t(node.leftChild) >= nodes.size() or
+        node.rightChild < 0 or std::size_t(node.rightChild) >= nodes.size() or
+        order.size() + 2 > nodes.size()) {
+      throw exceptions::IOError("Input file is not a valid decision tree 8");
+    }
+
+    this->features.push_back(node.feature);
+    this->thresholds.push_back(node.threshold);
+    this->children.push_back(order.size());
+    order.push_back(node.leftChild);
+    order.push_back(node.rightChild);
+  }
 }
 
-inline bool
-DecisionTree::parseCompressors(const std::vector<std::string> &
-                                  compressorLabels)
+// On integers, x <= threshold is x <= floor(threshold), so every value at or
+// below the lowest floored threshold of a feature goes the same way, and so
+// does every value above the highest one
+void DecisionTree::compileTable()
 {
-  Compressor compressor;
-  std::string compressorName;
-  int compressionLevel;
-
-  for (const std::string & label : compressorLabels) {
-    std::size_t delimiterPosition = label.find("_");
-
-    compressorName = label.substr(0, delimiterPosition);
-    std::transform(compressorName.begin(), compressorName.end(),
-                   compressorName.begin(), ::toupper);
-    
-    try {
-      compressionLevel = (delimiterPosition == std::string::npos)
-                          ? -1 : std::stoi(label.substr(delimiterPosition + 1));
+  if (this->compressors.size() > 256) {
+    return;
+  }
+
+  std::vector<float> lowestThresholds(this->nFeatures, 0);
+  std::vector<float> highestThresholds(this->nFeatures, -1);
+  std::vector<bool> usedFeatures(this->nFeatures, false);
+
+  for (std::size_t i = 0; i < this->features.size(); i++) {
+    int feature = this->features[i];
+
+    if (feature < 0) {
+      continue;
     }
-    catch (...) {
-      return false;
+
+    float threshold = std::floor(this->thresholds[i]);
+
+    if (not usedFeatures[feature]) {
+      lowestThresholds[feature] = highestThresholds[feature] = threshold;
+      usedFeatures[feature] = true;
     }
 
-    if (not Compressor_Parse(compressorName, &compressor)) {
-      return false;
+    lowestThresholds[feature] = std::min(lowestThresholds[feature],
+                                         threshold);
+    highestThresholds[feature] = std::max(highestThresholds[feature],
+                                          threshold);
+  }
+
+  std::size_t tableSize = 1;
+
+  for (unsigned int i = 0; i < this->nFeatures; i++) {
+    if (not usedFeatures[i]) {
+      lowestThresholds[i] = highestThresholds[i] = 0;
+    }
+    else {
+      highestThresholds[i]++;
+    }
+
+    float range = highestThresholds[i] - lowestThresholds[i] + 1;
+
+    if (lowestThresholds[i] < std::numeric_limits<int>::min() or
+        highestThresholds[i] > std::numeric_limits<int>::max() or
+        range > constants::DECISION_TREE_MAX_TABLE_SIZE / tableSize) {
+      return;
     }
 
-    this->compressors.push_back(std::make_pair(compressor, compressionLevel));
+    tableSize *= range;
   }
 
-  return true;
+  this->lowerBounds.assign(lowestThresholds.begin(), lowestThresholds.end());
+  this->upperBounds.assign(highestThresholds.begin(), highestThresholds.end());
+  this->strides.resize(this->nFeatures);
+
+  std::size_t stride = 1;
+
+  for (unsigned int i = this->nFeatures; i-- > 0;) {
+    this->strides[i] = stride;
+    stride *= this->upperBounds[i] - this->lowerBounds[i] + 1;
+  }
+
+  // Walks every point, in the order of the table
+  this->tableData.resize(tableSize);
+  std::vector<int> point(this->lowerBounds);
+
+  for (std::size_t index = 0; index < tableSize; index++) {
+    this->tableData[index] = this->walk(point.data());
+
+    for (unsigned int i = this->nFeatures; i-- > 0;) {
+      if (point[i] < this->upperBounds[i]) {
+        point[i]++;
+        break;
+      }
+
+      point[i] = this->lowerBounds[i];
+    }
+  }
+
+  this->table = this->tableData.data();
+  this->tableSize = tableSize;
+}
+
+bool DecisionTree::hasTable() const
+{
+  return this->table != nullptr;
+}
+
+void DecisionTree::save(const std::string & filename) const
+{
+  std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+
+  if (not output) {
+    throw exceptions::IOError("Could not open file " + filename);
+  }
+
+  auto write = [&output] (const void * data, const std::size_t & size)
+  {
+    output.write(static_cast<const char *>(data), size);
+  };
+
+  BinaryModelHeader header = {};
+  std::copy(binaryModelMagic, binaryModelMagic + sizeof(binaryModelMagic),
+            header.magic);
+  header.version = binaryModelVersion;
+  header.nFeatures = this->nFeatures;
+  header.nCompressors = this->compressors.size();
+  header.nNodes = this->features.size();
+  header.tableSize = this->table ? this->tableSize : 0;
+  write(&header, sizeof(header));
+
+  for (const std::pair<Compressor, int> & compressor : this->compressors) {
+    BinaryModelCompressor binaryCompressor = {compressor.first,
+                                              compressor.second};
+    write(&binaryCompressor, sizeof(binaryCompressor));
+  }
+
+  for (std::size_t i = 0; i < this->features.size(); i++) {
+    BinaryModelNode node = {this->features[i], this->thresholds[i],
+                            this->children[i]};
+    write(&node, sizeof(node));
+  }
+
+  if (this->table) {
+    for (unsigned int i = 0; i < this->nFeatures; i++) {
+      BinaryModelBounds bounds = {this->lowerBounds[i], this->upperBounds[i]};
+      write(&bounds, sizeof(bounds));
+    }
+
+    write(this->table, this->tableSize);
+  }
+
+  if (not output) {
+    throw exceptions::IOError("Could not write file " + filename);
+  }
+}
+
+inline bool DecisionTree::isLeaf(const Node & node) const
+{
+  return (node.leftChild == node.rightChild);
 }
 
 
@@ -0,0 +1,297 @@
+/**
+ *  AutoComp Ensemble Model
+ *  ensemble_model.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/ensemble_model.hpp"
+
+#include <array>
+#include <limits>
+#include <sstream>
+#include <algorithm>
+
+#include "utils/constants.hpp"
+#include "utils/exceptions.hpp"
+
+namespace autocomp {
+
+namespace
+{
+  const std::string majorityVoteKind("forest_majority");
+  const std::string probabilityVoteKind("forest_probability");
+  const std::string boostedKind("boosted");
+
+  struct Node
+  {
+    int leftChild;
+    int rightChild;
+    int feature;
+    float threshold;
+    std::size_t values;               //!< Offset in the values of the tree
+  };
+}
+
+EnsembleModel::EnsembleModel(const std::string & filename)
+{
+  std::ifstream input(filename);
+
+  if (!input) {
+    throw exceptions::IOError("File " + filename + " does not exist");
+  }
+
+  std::string kind;
+  input >> kind;
+  checkInputStream(input, " 1");
+
+  if (kind == majorityVoteKind) {
+    this->kind = Kind::MAJORITY_VOTE;
+  }
+  else if (kind == probabilityVoteKind) {
+    this->kind = Kind::PROBABILITY_VOTE;
+  }
+  else if (kind == boostedKind) {
+    this->kind = Kind::BOOSTED;
+  }
+  else {
+    throw exceptions::IOError("Unknown ensemble kind " + kind + " in file " +
+                              filename);
+  }
+
+  // Read compressor labels
+  int nCompressors;
+  input >> nCompressors;
+  checkInputStream(input, " 2");
+
+  if (nCompressors <= 0 or
+      std::size_t(nCompressors) > constants::ENSEMBLE_MAX_CLASSES) {
+    throw exceptions::IOError("Invalid number of labels in file " + filename);
+  }
+
+  std::vector<std::string> compressorLabels(nCompressors);
+
+  for (int i = 0; i < nCompressors; i++) {
+    input >> compressorLabels[i];
+    checkInputStream(input, " 3");
+  }
+
+  if (not this->parseCompressors(compressorLabels)) {
+    throw exceptions::IOError("An error occured while reading a compressor "
+                              "label from file " + filename);
+  }
+
+  input >> this->nFeatures;
+  checkInputStream(input, " 4");
+
+  std::size_t nTrees;
+  input >> nTrees;
+  checkInputStream(input, " 5");
+
+  if (this->nFeatures == 0 or nTrees == 0) {
+    throw exceptions::IOError("Input file is not a valid ensemble 6");
+  }
+
+  this->initialScores.assign(nCompressors, 0);
+
+  if (this->kind == Kind::BOOSTED) {
+    for (float & initialScore : this->initialScores) {
+      input >> initialScore;
+      checkInputStream(input, " 7");
+    }
+  }
+
+  for (std::size_t tree = 0; tree < nTrees; tree++) {
+    int label;
+    std::size_t nNodes;
+    input >> label >> nNodes;
+    checkInputStream(input, " 8");
+
+    if (this->kind == Kind::BOOSTED and
+        (label < 0 or label >= nCompressors)) {
+      throw exceptions::IOError("Input file is not a valid ensemble 9");
+    }
+
+    this->roots.push_back(this->features.size());
+    this->treeLabels.push_back(label);
+
+    unsigned int depth = this->loadTree(input, nNodes);
+    std::size_t batch = tree / constants::ENSEMBLE_BATCH_SIZE;
+
+    if (batch == this->batchDepths.size()) {
+      this->batchDepths.push_back(0);
+    }
+
+    this->batchDepths[batch] = std::max(this->batchDepths[batch], depth);
+  }
+}
+
+bool EnsembleModel::isKind(const std::string & word)
+{
+  return word == majorityVoteKind or word == probabilityVoteKind or
+         word == boostedKind;
+}
+
+EnsembleModel::Kind EnsembleModel::getKind() const
+{
+  return this->kind;
+}
+
+std::size_t EnsembleModel::getTreeCount() const
+{
+  return this->roots.size();
+}
+
+// Trees are walked a batch at a time, every tree of the batch one step at a
+// time. Those that reach a leaf early stay on it
+int EnsembleModel::classifyPoint(const int * point) const
+{
+  const std::size_t batchSize = constants::ENSEMBLE_BATCH_SIZE;
+  const std::size_t nLabels = this->compressors.size();
+  const std::size_t nTrees = this->roots.size();
+
+  std::array<float, constants::ENSEMBLE_MAX_CLASSES> scores;
+  std::copy(this->initialScores.begin(), this->initialScores.end(),
+            scores.begin());
+
+  std::array<int, batchSize> nodes;
+
+  for (std::size_t first = 0, batch = 0; first < nTrees;
+       first += batchSize, batch++) {
+    std::size_t nBatchTrees = std::min(batchSize, nTrees - first);
+
+    for (std::size_t i = 0; i < nBatchTrees; i++) {
+      nodes[i] = this->roots[first + i];
+    }
+
+    for (unsigned int step = 0; step < this->batchDepths[batch]; step++) {
+      for (std::size_t i = 0; i < nBatchTrees; i++) {
+        int node = nodes[i];
+        nodes[i] = this->children[node] +
+                   (point[this->features[node]] > this->thresholds[node]);
+      }
+    }
+
+    for (std::size_t i = 0; i < nBatchTrees; i++) {
+      const float * leafValues =
+        this->values.data() + this->leafValues[nodes[i]];
+
+      switch (this->kind) {
+        case Kind::MAJORITY_VOTE:
+          scores[static_cast<int>(*leafValues)]++;
+          break;
+
+        case Kind::PROBABILITY_VOTE:
+          for (std::size_t label = 0; label < nLabels; label++) {
+            scores[label] += leafValues[label];
+          }
+          break;
+
+        case Kind::BOOSTED:
+          scores[this->treeLabels[first + i]] += *leafValues;
+          break;
+      }
+    }
+  }
+
+  return std::max_element(scores.begin(), scores.begin() + nLabels) -
+         scores.begin();
+}
+
+// Breadth first, as DecisionTree lays out its nodes
+unsigned int EnsembleModel::loadTree(std::ifstream & input,
+                                     const std::size_t & nNodes)
+{
+  const std::size_t nValues =
+    this->kind == Kind::PROBABILITY_VOTE ? this->compressors.size() : 1;
+
+  std::vector<Node> nodes(nNodes);
+  std::vector<float> nodeValues(nNodes * nValues);
+
+  input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+  for (std::size_t i = 0; i < nNodes; i++) {
+    std::string line;
+    // The last line of the file may have no newline
+    if (not std::getline(input, line)) {
+      throw exceptions::IOError("Input file is not a valid ensemble 10");
+    }
+
+    std::istringstream stream(line);
+    Node & node = nodes[i];
+    stream >> node.leftChild >> node.rightChild >> node.feature
+           >> node.threshold;
+    node.values = i * nValues;
+
+    for (std::size_t j = 0; j < nValues; j++) {
+      stream >> nodeValues[node.values + j];
+    }
+
+    if (stream.fail()) {
+      throw exceptions::IOError("Input file is not a valid ensemble 11");
+    }
+  }
+
+  if (nodes.empty()) {
+    throw exceptions::IOError("Input file is not a valid ensemble 12");
+  }
+
+  const int base = this->features.size();
+  std::vector<int> order{0};
+  std::vector<unsigned int> depths{0};
+  unsigned int depth = 0;
+
+  for (std::size_t i = 0; i < order.size(); i++) {
+    const Node & node = nodes[order[i]];
+    const int index = base + i;
+
+    if (node.leftChild == node.rightChild) {
+      const float * leafValues = nodeValues.data() + node.values;
+
+      if (this->kind == Kind::MAJORITY_VOTE and
+          (*leafValues < 0 or *leafValues >= this->compressors.size())) {
+        throw exceptions::IOError("Input file is not a valid ensemble 13");
+      }
+
+      this->features.push_back(0);
+      this->thresholds.push_back(std::numeric_limits<float>::infinity());
+      this->children.push_back(index);
+      this->leafValues.push_back(this->values.size());
+      this->values.insert(this->values.end(), leafValues,
+                          leafValues + nValues);
+      depth = std::max(depth, depths[i]);
+      continue;
+    }
+
+    // A cycle would give more slots than nodes
+    if (node.feature < 0 or unsigned(node.feature) >= this->nFeatures or
+        node.leftChild < 0 or std::size_t(node.leftChild) >= nodes.size() or
+        node.rightChild < 0 or std::size_t(node.rightChild) >= nodes.size() or
+        order.size() + 2 > nodes.size()) {
+      throw exceptions::IOError("Input file is not a valid ensemble 14");
+    }
+
+    this->features.push_back(node.feature);
+    this->thresholds.push_back(node.threshold);
+    this->children.push_back(base + order.size());
+    this->leafValues.push_back(-1);
+    order.push_back(node.leftChild);
+    order.push_back(node.rightChild);
+    depths.push_back(depths[i] + 1);
+    depths.push_back(depths[i] + 1);
+  }
+
+  return depth;
+}
+
+void EnsembleModel::checkInputStream(const std::ios & stream,
+                                     const std::string & a) const
+{
+  if (not stream.good()) {
+    throw exceptions::IOError("Input file is not a valid ensemble" + a);
+  }
+}
+
+} // namespace autocomp
@@ -0,0 +1,81 @@
+/**
+ *  AutoComp Feedback Controller
+ *  feedback_controller.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/feedback_controller.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace autocomp {
+
+FeedbackController::FeedbackController(const std::size_t & nLevels,
+                                       const double & setpoint,
+                                       const std::size_t & initialLevel,
+                                       const double & proportionalGain,
+                                       const double & integralGain,
+                                       const double & hysteresis)
+  : nLevels(nLevels),
+    setpoint(setpoint),
+    proportionalGain(proportionalGain),
+    integralGain(integralGain),
+    hysteresis(hysteresis),
+    integral(initialLevel),
+    output(initialLevel),
+    level(initialLevel)
+{
+  if (nLevels == 0) {
+    throw std::domain_error("There must be at least one level");
+  }
+
+  if (initialLevel >= nLevels) {
+    throw std::domain_error("initialLevel must be one of the levels");
+  }
+}
+
+std::size_t FeedbackController::update(const double & measurement)
+{
+  const double maxLevel = this->nLevels - 1;
+  double error = measurement - this->setpoint;
+  double proportional = this->proportionalGain * error;
+  double integral = this->integral + this->integralGain * error;
+  double output = proportional + integral;
+
+  // Anti-windup: the integral stops while the output is saturated by an
+  // error that would push it further out
+  if (not ((output > maxLevel and error > 0) or (output < 0 and error < 0))) {
+    this->integral = std::min(std::max(integral, 0.0), maxLevel);
+  }
+
+  this->output = std::min(std::max(proportional + this->integral, 0.0),
+                          maxLevel);
+
+  if (std::abs(this->output - this->level) >= 0.5 + this->hysteresis) {
+    this->level = std::lround(this->output);
+  }
+
+  return this->level;
+}
+
+std::size_t FeedbackController::getLevel() const
+{
+  return this->level;
+}
+
+double FeedbackController::getOutput() const
+{
+  return this->output;
+}
+
+double FeedbackController::getSetpoint() const
+{
+  return this->setpoint;
+}
+
+} // namespace autocomp
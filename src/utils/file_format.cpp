@@ -0,0 +1,178 @@
+/**
+ *  AutoComp File Format
+ *  file_format.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/file_format.hpp"
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <utility>
+
+namespace autocomp {
+
+namespace
+{
+  // Bytes expected at some offset of the file
+  struct MagicNumber
+  {
+    std::size_t offset;
+    std::string magic;
+  };
+
+  // Checks the bytes of a signature that are not fixed
+  using SignatureCheck = bool (*)(const char * signature,
+                                  const std::size_t & signatureSize);
+
+  struct Signature
+  {
+    FileFormat format;
+    std::vector<MagicNumber> magicNumbers;
+    SignatureCheck check;
+
+    Signature(const FileFormat & format,
+              std::vector<MagicNumber> && magicNumbers,
+              SignatureCheck check = nullptr)
+      : format(format),
+        magicNumbers(std::move(magicNumbers)),
+        check(check)
+    {}
+  };
+
+  // The block size of bzip2 streams, in hundreds of KB, follows the magic
+  // number as a digit
+  bool hasBzip2BlockSize(const char * signature,
+                         const std::size_t & signatureSize)
+  {
+    return signatureSize > 3 and signature[3] >= '1' and signature[3] <= '9';
+  }
+
+  // Magic numbers of each format, at the offset they are found at. Those of
+  // the containers whose type follows a generic header (RIFF) are matched on
+  // both
+  const std::vector<Signature> & getSignatures()
+  {
+    static const std::vector<Signature> signatures{
+      {FileFormat::GZIP, {{0, std::string("\x1f\x8b\x08", 3)}}},
+      {FileFormat::BZIP2, {{0, "BZh"}}, hasBzip2BlockSize},
+      {FileFormat::XZ, {{0, std::string("\xfd" "7zXZ\x00", 6)}}},
+      {FileFormat::ZSTD, {{0, "\x28\xb5\x2f\xfd"}}},
+      {FileFormat::LZ4, {{0, "\x04\x22\x4d\x18"}}},
+      {FileFormat::ZIP, {{0, "PK\x03\x04"}}},
+      {FileFormat::SEVEN_ZIP, {{0, "7z\xbc\xaf\x27\x1c"}}},
+      {FileFormat::RAR, {{0, "Rar!\x1a\x07"}}},
+      {FileFormat::JPEG, {{0, "\xff\xd8\xff"}}},
+      {FileFormat::PNG, {{0, "\x89PNG\r\n\x1a\n"}}},
+      {FileFormat::GIF, {{0, "GIF8"}}},
+      {FileFormat::WEBP, {{0, "RIFF"}, {8, "WEBP"}}},
+      {FileFormat::MP4, {{4, "ftyp"}}},
+      {FileFormat::MATROSKA, {{0, "\x1a\x45\xdf\xa3"}}},
+      {FileFormat::OGG, {{0, "OggS"}}},
+      {FileFormat::FLAC, {{0, "fLaC"}}},
+      {FileFormat::PARQUET, {{0, "PAR1"}}}
+    };
+
+    return signatures;
+  }
+
+  bool matches(const Signature & knownSignature, const char * signature,
+               const std::size_t & signatureSize)
+  {
+    for (const MagicNumber & magicNumber : knownSignature.magicNumbers) {
+      const std::string & magic = magicNumber.magic;
+
+      if (magicNumber.offset + magic.size() > signatureSize or
+          std::memcmp(signature + magicNumber.offset, magic.data(),
+                      magic.size()) != 0) {
+        return false;
+      }
+    }
+
+    return not knownSignature.check or
+           knownSignature.check(signature, signatureSize);
+  }
+}
+
+FileFormat sniffFileFormat(const char * signature,
+                           const std::size_t & signatureSize)
+{
+  for (const Signature & knownSignature : getSignatures()) {
+    if (matches(knownSignature, signature, signatureSize)) {
+      return knownSignature.format;
+    }
+  }
+
+  return FileFormat::UNKNOWN;
+}
+
+// Every recognized format is compressed
+bool isCompressedFormat(const FileFormat & format)
+{
+  return format != FileFormat::UNKNOWN;
+}
+
+const char * getFileFormatName(const FileFormat & format)
+{
+  switch (format) {
+    case FileFormat::GZIP:
+      return "gzip";
+
+    case FileFormat::BZIP2:
+      return "bzip2";
+
+    case FileFormat::XZ:
+      return "xz";
+
+    case FileFormat::ZSTD:
+      return "zstd";
+
+    case FileFormat::LZ4:
+      return "lz4";
+
+    case FileFormat::ZIP:
+      return "zip";
+
+    case FileFormat::SEVEN_ZIP:
+      return "7z";
+
+    case FileFormat::RAR:
+      return "rar";
+
+    case FileFormat::JPEG:
+      return "jpeg";
+
+    case FileFormat::PNG:
+      return "png";
+
+    case FileFormat::GIF:
+      return "gif";
+
+    case FileFormat::WEBP:
+      return "webp";
+
+    case FileFormat::MP4:
+      return "mp4";
+
+    case FileFormat::MATROSKA:
+      return "matroska";
+
+    case FileFormat::OGG:
+      return "ogg";
+
+    case FileFormat::FLAC:
+      return "flac";
+
+    case FileFormat::PARQUET:
+      return "parquet";
+
+    default:
+      return "unknown";
+  }
+}
+
+} // namespace autocomp
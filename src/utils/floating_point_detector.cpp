@@ -0,0 +1,140 @@
+/**
+ *  AutoComp Floating-Point Detector
+ *  floating_point_detector.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/19/2026
+ */
+
+#include "utils/floating_point_detector.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+#include "utils/constants.hpp"
+
+namespace autocomp {
+
+namespace
+{
+  const int nExponents = 2048;
+  const int maxExponent = nExponents - 1;
+
+  // Exponents the concentration is measured on
+  const int nTopExponents = 16;
+
+  // Words predicted to within this many low bytes are hits
+  const int maxMispredictedBytes = 6;
+
+  template<std::size_t N>
+  double getEntropy(const std::array<std::uint32_t, N> & counts,
+                    const double & total)
+  {
+    double entropy = 0;
+
+    for (const std::uint32_t & count : counts) {
+      if (count > 0) {
+        double probability = count / total;
+        entropy -= probability * std::log2(probability);
+      }
+    }
+
+    return entropy;
+  }
+}
+
+// The predictors are those of FPC without their tables: the last value, and
+// the last value plus the last stride
+FloatingPointFeatures getFloatingPointFeatures(const char * data,
+                                               const std::size_t & dataSize)
+{
+  FloatingPointFeatures features{0, 0, 0, 0, 0};
+
+  std::size_t nWords = std::min(dataSize / 8, constants::FP_SAMPLE_WORDS);
+
+  if (nWords == 0 or dataSize % 8 != 0) {
+    return features;
+  }
+
+  const char * sample = data + (dataSize / 8 - nWords) / 2 * 8;
+
+  std::array<std::array<std::uint32_t, 256>, 5> byteCounts{};
+  std::array<std::uint32_t, nExponents> exponentCounts{};
+  std::size_t nNormalWords = 0, nHits = 0;
+  std::uint64_t lastValue = 0, stride = 0;
+
+  for (std::size_t i = 0; i < nWords; i++) {
+    std::uint64_t value;
+    std::memcpy(&value, sample + 8 * i, sizeof(value));
+
+    int exponent = (value >> 52) & maxExponent;
+
+    if (exponent != 0 and exponent != maxExponent) {
+      exponentCounts[exponent]++;
+      nNormalWords++;
+    }
+
+    for (int byte = 0; byte < 4; byte++) {
+      byteCounts[byte][(value >> (8 * byte)) & 0xff]++;
+    }
+
+    byteCounts[4][value >> 56]++;
+
+    std::uint64_t error = std::min(value ^ lastValue,
+                                   value ^ (lastValue + stride));
+
+    nHits += error >> (8 * maxMispredictedBytes) == 0;
+    stride = value - lastValue;
+    lastValue = value;
+  }
+
+  std::partial_sort(exponentCounts.begin(),
+                    exponentCounts.begin() + nTopExponents,
+                    exponentCounts.end(), std::greater<std::uint32_t>());
+
+  std::size_t nTopExponentWords =
+    std::accumulate(exponentCounts.begin(),
+                    exponentCounts.begin() + nTopExponents, std::size_t(0));
+
+  features.normalShare = nNormalWords / static_cast<double>(nWords);
+  features.exponentConcentration =
+    nNormalWords > 0 ? nTopExponentWords / static_cast<double>(nNormalWords)
+                     : 0;
+  features.lowByteEntropy = 8;
+
+  for (int byte = 0; byte < 4; byte++) {
+    features.lowByteEntropy = std::min(features.lowByteEntropy,
+                                       getEntropy(byteCounts[byte], nWords));
+  }
+
+  features.highByteEntropy = getEntropy(byteCounts[4], nWords);
+  features.predictorHitRate = nHits / static_cast<double>(nWords);
+
+  return features;
+}
+
+bool isFloatingPointData(const FloatingPointFeatures & features)
+{
+  return features.normalShare >= constants::FP_MIN_NORMAL_SHARE and
+         features.exponentConcentration >=
+           constants::FP_MIN_EXPONENT_CONCENTRATION and
+         features.lowByteEntropy - features.highByteEntropy >=
+           constants::FP_MIN_ENTROPY_GAP;
+}
+
+// Tables larger than those of the fast level cost more to clear and miss the
+// cache more, and only pay when the simple predictors fail
+int getFPCLevel(const FloatingPointFeatures & features)
+{
+  return features.predictorHitRate >= constants::FPC_MIN_HIT_RATE
+           ? constants::FPC_FAST_LEVEL
+           : constants::FPC_STRONG_LEVEL;
+}
+
+} // namespace autocomp
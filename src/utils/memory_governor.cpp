@@ -0,0 +1,163 @@
+/**
+ *  AutoComp Memory Governor
+ *  memory_governor.cpp
+ *
+ *  @author Jhonathan Abreu
+ *  @version 1.0
+ *  @date 10/18/2026
+ */
+
+#include "utils/memory_governor.hpp"
+
+#include <algorithm>
+
+namespace autocomp {
+
+MemoryGovernor::Reservation::Reservation(MemoryGovernor * memoryGovernor,
+                                         const std::size_t & bytes)
+  : memoryGovernor(memoryGovernor),
+    bytes(bytes)
+{}
+
+MemoryGovernor::Reservation::Reservation(Reservation && other)
+  : memoryGovernor(other.memoryGovernor),
+    bytes(other.bytes)
+{
+  other.memoryGovernor = nullptr;
+  other.bytes = 0;
+}
+
+MemoryGovernor::Reservation & MemoryGovernor::Reservation::operator=(
+    Reservation && other
+  )
+{
+  if (this != &other) {
+    if (this->memoryGovernor) {
+      this->memoryGovernor->release(this->bytes);
+    }
+
+    this->memoryGovernor = other.memoryGovernor;
+    this->bytes = other.bytes;
+    other.memoryGovernor = nullptr;
+    other.bytes = 0;
+  }
+
+  return *this;
+}
+
+MemoryGovernor::Reservation::~Reservation()
+{
+  if (this->memoryGovernor) {
+    this->memoryGovernor->release(this->bytes);
+  }
+}
+
+std::size_t MemoryGovernor::Reservation::getBytes() const
+{
+  return this->bytes;
+}
+
+MemoryGovernor::Reservation::operator bool() const
+{
+  return this->memoryGovernor != nullptr;
+}
+
+MemoryGovernor::MemoryGovernor(const std::size_t & budget)
+  : stats()
+{
+  this->stats.budget = budget;
+}
+
+void MemoryGovernor::setBudget(const std::size_t & budget)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.budget = budget;
+}
+
+std::size_t MemoryGovernor::getBudget() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  return this->stats.budget;
+}
+
+bool MemoryGovernor::tryReserve(const std::size_t & bytes)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  if (this->stats.budget > 0 and
+      this->stats.usedBytes + bytes > this->stats.budget) {
+    this->stats.deniedReservations++;
+    return false;
+  }
+
+  this->stats.usedBytes += bytes;
+  this->stats.peakUsedBytes = std::max(this->stats.peakUsedBytes,
+                                       this->stats.usedBytes);
+
+  return true;
+}
+
+void MemoryGovernor::forceReserve(const std::size_t & bytes)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.usedBytes += bytes;
+  this->stats.peakUsedBytes = std::max(this->stats.peakUsedBytes,
+                                       this->stats.usedBytes);
+}
+
+MemoryGovernor::Reservation
+MemoryGovernor::tryAcquire(const std::size_t & bytes)
+{
+  if (not this->tryReserve(bytes)) {
+    return Reservation();
+  }
+
+  return Reservation(this, bytes);
+}
+
+MemoryGovernor::Reservation
+MemoryGovernor::acquire(const std::size_t & bytes)
+{
+  this->forceReserve(bytes);
+
+  return Reservation(this, bytes);
+}
+
+void MemoryGovernor::release(const std::size_t & bytes)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  this->stats.usedBytes -= std::min(this->stats.usedBytes, bytes);
+}
+
+float MemoryGovernor::getLoad() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  if (this->stats.budget == 0) {
+    return 0;
+  }
+
+  return static_cast<float>(this->stats.usedBytes) / this->stats.budget;
+}
+
+MemoryStats MemoryGovernor::getStats() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  return this->stats;
+}
+
+std::ostream & operator<<(std::ostream & stream, const MemoryStats & stats)
+{
+  return stream << "{budget: " << stats.budget
+                << ", usedBytes: " << stats.usedBytes
+                << ", peakUsedBytes: " << stats.peakUsedBytes
+                << ", deniedReservations: " << stats.deniedReservations
+                << "}";
+}
+
+} // namespace autocomp
@@ -9,65 +9,266 @@
 
 #include "utils/thread_pool.hpp"
 
+#include <new>
+#include <cstdlib>
+#include <stdexcept>
+
 namespace autocomp {
 
-ThreadPool::ThreadPool(const unsigned int & nThreads)
-  : threads(nThreads),
-    done(false)
-{}
+thread_local const ThreadPool * ThreadPool::currentPool = nullptr;
+thread_local std::size_t ThreadPool::currentWorker = 0;
+
+void * ThreadPool::CacheLineAllocated::operator new(std::size_t size)
+{
+  void * pointer;
+
+  if (::posix_memalign(&pointer, ThreadPool::cacheLineSize, size) != 0) {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+void ThreadPool::CacheLineAllocated::operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+ThreadPool::ThreadPool(const unsigned int & nThreads,
+                       const std::size_t & queueCapacity)
+  : queues(new SharedQueues(queueCapacity)),
+    done(false),
+    initialized(false),
+    activeSubmissions(0)
+{
+  for (unsigned int i = 0; i < nThreads; i++) {
+    this->workers.emplace_back(new Worker());
+    this->workers.back()->victimSeed = 2654435761u * (i + 1);
+  }
+}
 
 ThreadPool::~ThreadPool()
 {
   this->shutdown();
+
+  Task * task;
+  while (this->queues->freeTasks.tryPop(task)) {
+    delete task;
+  }
 }
 
 void ThreadPool::init()
 {
-  for (auto & thread : this->threads) {
-    thread = std::thread(&ThreadPool::worker, this);
+  for (std::size_t i = 0; i < this->workers.size(); i++) {
+    this->workers[i]->thread = std::thread(&ThreadPool::worker, this, i);
   }
+
+  this->initialized.store(true);
 }
 
+// A submission either sees the flag and is refused, or is seen in progress
+// and waited for, so no task is pushed after the last drain
 void ThreadPool::shutdown()
 {
-  { 
-    std::unique_lock<std::mutex> guard(this->mutex);
-    this->done = true;
+  // Workers run the pending tasks and then exit
+  this->done.store(true);
+  this->idleWorkers.notifyAll();
+
+  for (auto & worker : this->workers) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+
+  while (this->activeSubmissions.load() > 0) {
+    std::this_thread::yield();
+  }
+
+  // Left if the pool was never initialized, or submitted while the workers
+  // were exiting
+  while (this->runPendingTask()) {
+  }
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+  return this->workers.size();
+}
+
+// Submits a task: to the deque of the current worker if called from one of
+// them, to the injection queue otherwise
+void ThreadPool::post(Task && task)
+{
+  if (ThreadPool::currentPool == this) {
+    this->workers[ThreadPool::currentWorker]->deque.push(
+        this->acquireTask(std::move(task))
+      );
+    this->idleWorkers.notifyOne();
+
+    return;
+  }
+
+  this->activeSubmissions.fetch_add(1);
+
+  try {
+    if (this->done.load()) {
+      throw std::runtime_error("The thread pool is shut down");
+    }
+
+    Task * pooledTask = this->acquireTask(std::move(task));
+
+    while (not this->queues->injectionQueue.tryPush(std::move(pooledTask))) {
+      if (not this->initialized.load() or this->workers.empty()) {
+        delete pooledTask;
+
+        throw std::runtime_error("The thread pool queue is full and no "
+                                 "worker is running");
+      }
+
+      this->idleWorkers.notifyAll();
+      std::this_thread::yield();
+    }
+  }
+  catch (...) {
+    this->activeSubmissions.fetch_sub(1);
+    throw;
+  }
+
+  this->activeSubmissions.fetch_sub(1);
+  this->idleWorkers.notifyOne();
+}
+
+bool ThreadPool::runPendingTask()
+{
+  Task * task;
+  bool found;
+
+  if (ThreadPool::currentPool == this) {
+    found = this->findTask(task, ThreadPool::currentWorker);
+  }
+  else {
+    std::uint32_t victimSeed =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+
+    found = this->queues->injectionQueue.tryPop(task) or
+            this->stealTask(task, victimSeed, this->workers.size());
   }
 
-  this->condition.notify_all();
-  
-  for (auto & thread : this->threads) {
-    if (thread.joinable()) {
-      thread.join();
+  if (found) {
+    this->runTask(task);
+  }
+
+  return found;
+}
+
+// Function that each thread runs, which dequeues tasks and executes them
+void ThreadPool::worker(const std::size_t index)
+{
+  ThreadPool::currentPool = this;
+  ThreadPool::currentWorker = index;
+
+  Task * task;
+
+  while (true) {
+    if (this->findTask(task, index)) {
+      this->runTask(task);
+      continue;
+    }
+
+    if (this->done.load()) {
+      break;
     }
+
+    this->idleWorkers.wait([this] ()
+                           {
+                             return this->hasPendingTasks() or
+                                    this->done.load();
+                           });
   }
+
+  ThreadPool::currentPool = nullptr;
+}
+
+bool ThreadPool::findTask(Task * & task, const std::size_t & workerIndex)
+{
+  Worker & worker = *this->workers[workerIndex];
+
+  return worker.deque.pop(task) or
+         this->queues->injectionQueue.tryPop(task) or
+         this->stealTask(task, worker.victimSeed, workerIndex);
 }
 
-// Function that each thread runs, which dequeues a task and executes it
-void ThreadPool::worker()
+// Tries every other worker once, starting from a pseudo-random one
+bool ThreadPool::stealTask(Task * & task, std::uint32_t & victimSeed,
+                           const std::size_t & thiefIndex)
 {
-  VoidFunction task;
-  bool dequeued;
-  bool doneWorking = false;
-
-  while (not doneWorking) {
-    {
-      std::unique_lock<std::mutex> guard(this->mutex);
-      this->condition.wait(guard, [this]()
-                                  { 
-                                    return not this->taskQueue.isEmpty() or
-                                           this->done;
-                                  });
-      
-      dequeued = this->taskQueue.pop(task);
-      doneWorking = this->taskQueue.isEmpty() and this->done;
+  const std::size_t nWorkers = this->workers.size();
+
+  if (nWorkers == 0) {
+    return false;
+  }
+
+  // xorshift32
+  victimSeed ^= victimSeed << 13;
+  victimSeed ^= victimSeed >> 17;
+  victimSeed ^= victimSeed << 5;
+
+  const std::size_t firstVictim = victimSeed % nWorkers;
+
+  for (std::size_t i = 0; i < nWorkers; i++) {
+    const std::size_t victim = (firstVictim + i) % nWorkers;
+
+    if (victim != thiefIndex and this->workers[victim]->deque.steal(task)) {
+      return true;
     }
+  }
+
+  return false;
+}
+
+bool ThreadPool::hasPendingTasks() const
+{
+  if (not this->queues->injectionQueue.isEmpty()) {
+    return true;
+  }
 
-    if (dequeued) {
-      task();
+  for (const auto & worker : this->workers) {
+    if (not worker->deque.isEmpty()) {
+      return true;
     }
   }
+
+  return false;
+}
+
+Task * ThreadPool::acquireTask(Task && task)
+{
+  Task * pooledTask;
+
+  if (not this->queues->freeTasks.tryPop(pooledTask)) {
+    pooledTask = new Task();
+  }
+
+  *pooledTask = std::move(task);
+
+  return pooledTask;
+}
+
+// Runs a task and recycles it. The callable is destroyed right away, so
+// whatever it holds is not kept alive until the task object is reused
+void ThreadPool::runTask(Task * task)
+{
+  try {
+    (*task)();
+  }
+  catch (...) {
+  }
+
+  task->reset();
+
+  if (not this->queues->freeTasks.tryPush(std::move(task))) {
+    delete task;
+  }
 }
 
-} // namespace autocomp
\ No newline at end of file
+} // namespace autocomp
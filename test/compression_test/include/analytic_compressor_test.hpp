@@ -0,0 +1,159 @@
+#ifndef AC_ANALYTIC_COMPRESSOR_TEST_H
+#define AC_ANALYTIC_COMPRESSOR_TEST_H
+
+/* C++ System Headers */
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "test_constants.hpp"
+#include "common_functions.hpp"
+#include "utils/buffer.hpp"
+#include "utils/data_structures.hpp"
+#include "utils/codec_calibration.hpp"
+#include "compression/analytic_compressor.hpp"
+
+class AnalyticCompressorTest : public ::testing::Test
+{
+protected:
+
+  std::string originalData;
+  autocomp::Buffer * originalBuffer, * compressedBuffer;
+
+  autocomp::ResourceState resourceState;
+  autocomp::CodecCalibration calibration;
+
+  void SetUp()
+  {
+    ASSERT_NO_THROW({
+      originalData = autocomp::test::getDataFromFile(
+          autocomp::test::constants::compressionTestFilename
+        );
+    });
+
+    ASSERT_NO_THROW({
+      originalBuffer = new autocomp::Buffer(originalData.size() * 1.1);
+    });
+    ASSERT_NO_THROW({
+      compressedBuffer = new autocomp::Buffer(originalData.size() * 1.2);
+    });
+
+    ASSERT_NO_THROW(originalBuffer->setData(originalData));
+    ASSERT_NO_THROW(autocomp::AnalyticCompressor::calibrate(calibration));
+  }
+
+  void TearDown()
+  {
+    delete originalBuffer;
+    delete compressedBuffer;
+  }
+}; // class AnalyticCompressorTest
+
+TEST_F(AnalyticCompressorTest, CompressesHarderOnSlowerLinks)
+{
+  autocomp::AnalyticCompressor analyticCompressor(&calibration,
+                                                  &resourceState);
+
+  resourceState.cpuLoad.store(0);
+
+  // A link far faster than any codec is better used without compressing
+  resourceState.bandwidth.store(1e6);
+
+  ASSERT_EQ(autocomp::COPY,
+            analyticCompressor.rankCompressors(*originalBuffer).front().first);
+  ASSERT_EQ(autocomp::COPY, analyticCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+
+  // On a slow one, the strongest codecs get the data through faster
+  resourceState.bandwidth.store(1);
+
+  auto slowLinkChoice = analyticCompressor.rankCompressors(*originalBuffer)
+                                          .front();
+
+  ASSERT_TRUE(slowLinkChoice.first == autocomp::LZMA or
+              slowLinkChoice.first == autocomp::BZIP2);
+  ASSERT_EQ(slowLinkChoice.first,
+            analyticCompressor.compress(*originalBuffer, *compressedBuffer));
+  ASSERT_LT(compressedBuffer->getSize(), originalBuffer->getSize());
+
+  // In between, a fast codec
+  resourceState.bandwidth.store(500);
+
+  auto fastLinkChoice = analyticCompressor.rankCompressors(*originalBuffer)
+                                          .front();
+
+  ASSERT_NE(autocomp::COPY, fastLinkChoice.first);
+  ASSERT_NE(slowLinkChoice, fastLinkChoice);
+}
+
+TEST_F(AnalyticCompressorTest, CopiesIncompressibleData)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> bytes(0, 255);
+  std::string randomData(originalData.size(), '\0');
+
+  for (char & byte : randomData) {
+    byte = bytes(generator);
+  }
+
+  originalBuffer->setData(randomData);
+  resourceState.bandwidth.store(10);
+
+  autocomp::AnalyticCompressor analyticCompressor(&calibration,
+                                                  &resourceState);
+
+  ASSERT_EQ(autocomp::COPY, analyticCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+}
+
+TEST_F(AnalyticCompressorTest, RanksFPCForDoublesOnly)
+{
+  autocomp::AnalyticCompressor analyticCompressor(&calibration,
+                                                  &resourceState);
+  auto isFPC = [] (const std::pair<autocomp::Compressor, int> & codec)
+               {
+                 return codec.first == autocomp::FPC;
+               };
+
+  resourceState.cpuLoad.store(0);
+  resourceState.bandwidth.store(1000);
+
+  std::vector<std::pair<autocomp::Compressor, int>> ranking =
+    analyticCompressor.rankCompressors(*originalBuffer);
+
+  ASSERT_EQ(ranking.end(), std::find_if(ranking.begin(), ranking.end(),
+                                        isFPC));
+
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      ).substr(0, 128 * 1024);
+  originalBuffer->setData(trace);
+  ranking = analyticCompressor.rankCompressors(*originalBuffer);
+
+  ASSERT_EQ(1, std::count_if(ranking.begin(), ranking.end(), isFPC));
+
+  // Nor for a chunk that is not made of whole doubles
+  originalBuffer->setData(trace.substr(1));
+  ranking = analyticCompressor.rankCompressors(*originalBuffer);
+
+  ASSERT_EQ(ranking.end(), std::find_if(ranking.begin(), ranking.end(),
+                                        isFPC));
+}
+
+TEST_F(AnalyticCompressorTest, ThrowsOnNullArguments)
+{
+  ASSERT_THROW(autocomp::AnalyticCompressor(nullptr, &resourceState),
+               std::domain_error);
+  ASSERT_THROW(autocomp::AnalyticCompressor(&calibration, nullptr),
+               std::domain_error);
+}
+
+#endif //AC_ANALYTIC_COMPRESSOR_TEST_H
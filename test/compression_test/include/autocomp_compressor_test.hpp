@@ -7,6 +7,9 @@
 #include <stdexcept>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <random>
+#include <algorithm>
 
 /* External headers */
 #include "gtest/gtest.h"
@@ -19,7 +22,11 @@
 #include "utils/exceptions.hpp"
 #include "utils/data_structures.hpp"
 #include "utils/decision_tree.hpp"
+#include "utils/memory_governor.hpp"
+#include "utils/cpu_budget.hpp"
 #include "compression/autocomp_compressor.hpp"
+#include "compression/bandit_compressor.hpp"
+#include "compression/feedback_compressor.hpp"
 
 namespace mock
 {
@@ -205,4 +212,603 @@ TEST_F(AutoCompCompressorTest, CompressesAndDecompresses)
   }
 }
 
+TEST_F(AutoCompCompressorTest, KeepsTheDecisionsOfEachSessionApart)
+{
+  const std::size_t chunkSize = 64 * 1024;
+  const int nChunks = 24;
+  const int nSessions = 20;
+
+  autocomp::ResourceState resourceState;
+  resourceState.cpuLoad.store(0.3);
+  resourceState.bandwidth.store(10);
+
+  std::unique_ptr<autocomp::DecisionTree> decisionTree;
+
+  ASSERT_NO_THROW(
+  {
+    decisionTree =
+      std::unique_ptr<autocomp::DecisionTree>(
+          new autocomp::DecisionTree(autocomp::test::constants::validDecisionTreeFile)
+        );
+  });
+
+  // Chunks of text, and chunks of incompressible data
+  std::vector<std::string> compressibleChunks, incompressibleChunks;
+  std::mt19937 randomGenerator(42);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+  for (int i = 0; i < nChunks; i++) {
+    std::size_t offset = (i * chunkSize) % (this->originalData.size() -
+                                            chunkSize);
+    compressibleChunks.push_back(this->originalData.substr(offset,
+                                                           chunkSize));
+
+    std::string randomChunk(chunkSize, '\0');
+    std::generate(randomChunk.begin(), randomChunk.end(),
+                  [&] () { return byteDistribution(randomGenerator); });
+    incompressibleChunks.push_back(randomChunk);
+  }
+
+  auto runSession =
+    [&] (const std::vector<std::string> & chunks,
+         std::vector<autocomp::Compressor> & decisions)
+    {
+      auto pseudoClientSocket = std::make_shared<mock::TCPSocket>();
+
+      // A full send buffer, so the decision tree is asked
+      EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+        .WillRepeatedly(::testing::Return(1000));
+      EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+        .WillRepeatedly(::testing::Return(1000));
+
+      autocomp::AutoCompCompressor<mock::TCPSocket> autocompCompressor(
+          decisionTree.get(), &resourceState, pseudoClientSocket
+        );
+
+      autocomp::Buffer inData(chunkSize);
+      autocomp::Buffer outData(2 * chunkSize);
+
+      for (const std::string & chunk : chunks) {
+        inData.setData(chunk);
+        outData.setSize(0);
+        decisions.push_back(autocompCompressor.compress(inData, outData));
+      }
+    };
+
+  // What a compressible session decides when it runs alone
+  std::vector<autocomp::Compressor> expectedDecisions;
+  runSession(compressibleChunks, expectedDecisions);
+
+  ASSERT_NE(expectedDecisions.end(),
+            std::find_if(expectedDecisions.begin(), expectedDecisions.end(),
+                         [] (const autocomp::Compressor & decision)
+                         {
+                           return decision != autocomp::COPY;
+                         }));
+
+  // The same sessions, next to an incompressible one
+  std::vector<std::vector<autocomp::Compressor>> decisions(nSessions);
+  std::vector<std::thread> sessions;
+
+  for (int i = 0; i < nSessions; i++) {
+    sessions.emplace_back(runSession,
+                          std::cref(i == 0 ? incompressibleChunks
+                                           : compressibleChunks),
+                          std::ref(decisions[i]));
+  }
+
+  for (auto & session : sessions) {
+    session.join();
+  }
+
+  ASSERT_EQ(nChunks, std::count(decisions[0].begin(), decisions[0].end(),
+                                autocomp::COPY));
+
+  for (int i = 1; i < nSessions; i++) {
+    ASSERT_EQ(expectedDecisions, decisions[i]) << "Session " << i;
+  }
+}
+
+TEST_F(AutoCompCompressorTest, UsesLighterCompressorsWhileMemoryIsScarce)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  std::unique_ptr<autocomp::DecisionTree> decisionTree;
+
+  ASSERT_NO_THROW(
+  {
+    decisionTree =
+      std::unique_ptr<autocomp::DecisionTree>(
+          new autocomp::DecisionTree(autocomp::test::constants::validDecisionTreeFile)
+        );
+  });
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  autocomp::AutoCompCompressor<mock::TCPSocket> autocompCompressor(
+      decisionTree.get(), &resourceState, pseudoClientSocket
+    );
+
+  // Enough for zlib and snappy, but not for bzip2 nor lzma
+  autocomp::MemoryGovernor memoryGovernor(
+      autocomp::ZlibCompressor().getCompressionMemory()
+    );
+  autocompCompressor.setMemoryGovernor(&memoryGovernor);
+
+  auto compressWithEveryResourceState = [&] ()
+  {
+    std::vector<autocomp::Compressor> usedCompressors;
+
+    for (float cpuLoad = 0, bandwidth = 0.5; cpuLoad <= 100;
+         cpuLoad += 5, bandwidth += 5) {
+      resourceState.cpuLoad.store(cpuLoad);
+      resourceState.bandwidth.store(bandwidth);
+
+      compressedBuffer->setSize(0);
+      usedCompressors.push_back(
+          autocompCompressor.compress(*originalBuffer, *compressedBuffer)
+        );
+    }
+
+    return usedCompressors;
+  };
+
+  for (const autocomp::Compressor & usedCompressor :
+         compressWithEveryResourceState()) {
+    ASSERT_NE(autocomp::BZIP2, usedCompressor);
+    ASSERT_NE(autocomp::LZMA, usedCompressor);
+  }
+
+  // The decision tree did choose heavier compressors
+  ASSERT_LT(0, memoryGovernor.getStats().deniedReservations);
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+
+  // Without memory to spare nothing is compressed
+  memoryGovernor.forceReserve(memoryGovernor.getBudget());
+
+  for (const autocomp::Compressor & usedCompressor :
+         compressWithEveryResourceState()) {
+    ASSERT_EQ(autocomp::COPY, usedCompressor);
+  }
+}
+
+TEST_F(AutoCompCompressorTest, ChoosesWithTheHeadroomSiblingsLeave)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  std::unique_ptr<autocomp::DecisionTree> decisionTree;
+
+  ASSERT_NO_THROW(
+  {
+    decisionTree =
+      std::unique_ptr<autocomp::DecisionTree>(
+          new autocomp::DecisionTree(autocomp::test::constants::validDecisionTreeFile)
+        );
+  });
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  autocomp::AutoCompCompressor<mock::TCPSocket> loadedCompressor(
+      decisionTree.get(), &resourceState, pseudoClientSocket
+    );
+  autocomp::AutoCompCompressor<mock::TCPSocket> budgetedCompressor(
+      decisionTree.get(), &resourceState, pseudoClientSocket
+    );
+
+  // Two sibling sessions keep both cores busy
+  autocomp::CPUBudget cpuBudget(2);
+  autocomp::CPUBudget::Commitment firstSibling = cpuBudget.commit();
+  autocomp::CPUBudget::Commitment secondSibling = cpuBudget.commit();
+  firstSibling.record(std::chrono::hours(1));
+  secondSibling.record(std::chrono::hours(1));
+
+  budgetedCompressor.setCPUBudget(&cpuBudget);
+  ASSERT_EQ(3, cpuBudget.getStats().nCommitments);
+
+  auto compressWithEveryBandwidth = [&] (
+      autocomp::AutoCompCompressor<mock::TCPSocket> & compressor,
+      const float & cpuLoad
+    )
+  {
+    std::vector<autocomp::Compressor> usedCompressors;
+
+    for (float bandwidth = 0.5; bandwidth <= 1000; bandwidth *= 2) {
+      resourceState.cpuLoad.store(cpuLoad);
+      resourceState.bandwidth.store(bandwidth);
+
+      compressedBuffer->setSize(0);
+      usedCompressors.push_back(
+          compressor.compress(*originalBuffer, *compressedBuffer)
+        );
+    }
+
+    return usedCompressors;
+  };
+
+  // Though the CPU looks idle, the session chooses as on a busy one
+  ASSERT_EQ(compressWithEveryBandwidth(loadedCompressor, 1),
+            compressWithEveryBandwidth(budgetedCompressor, 0));
+
+  // Its own demand is committed too
+  ASSERT_LT(2, cpuBudget.getStats().committedCores);
+}
+
+TEST_F(AutoCompCompressorTest, LearnsOnlineInBanditMode)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+  autocomp::ContextualBandit contextualBandit;
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  resourceState.cpuLoad.store(0);
+  resourceState.bandwidth.store(10);
+
+  autocomp::BanditCompressor<mock::TCPSocket> banditCompressor(
+      &contextualBandit, &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  const int nChunks = 50;
+
+  for (int i = 0; i < nChunks; i++) {
+    compressedBuffer->setSize(0);
+
+    ASSERT_NO_THROW(banditCompressor.compress(*originalBuffer,
+                                              *compressedBuffer));
+  }
+
+  autocomp::BanditStats stats = contextualBandit.getStats();
+
+  // Every chunk taught the bandit, which seldom strayed from what it knew
+  ASSERT_EQ(nChunks, stats.nChoices);
+  ASSERT_EQ(nChunks, stats.nObservations);
+  ASSERT_GE(nChunks * autocomp::constants::BANDIT_MAX_EXPLORATION + 1,
+            stats.nExplorations);
+}
+
+TEST_F(AutoCompCompressorTest, CompressesRedundantDataOfManyDistinctBytes)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  resourceState.bandwidth.store(10);
+
+  // A block of random bytes over and over: bytecounting alone would copy it
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> bytes(0, 255);
+  std::string block(1024, '\0'), repeatedBlocks;
+
+  for (char & byte : block) {
+    byte = bytes(generator);
+  }
+
+  while (repeatedBlocks.size() < originalData.size()) {
+    repeatedBlocks += block;
+  }
+
+  repeatedBlocks.resize(originalData.size());
+  originalBuffer->setData(repeatedBlocks);
+
+  ASSERT_LT(100, autocomp::bytecounting(originalBuffer->getData(),
+                                        originalBuffer->getSize()));
+
+  autocomp::AutoCompCompressor<mock::TCPSocket> autocompCompressor(
+      &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  ASSERT_NE(autocomp::COPY, autocompCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+
+  // Random data is still copied
+  for (char & byte : repeatedBlocks) {
+    byte = bytes(generator);
+  }
+
+  originalBuffer->setData(repeatedBlocks);
+  autocompCompressor.reset();
+
+  ASSERT_EQ(autocomp::COPY, autocompCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+}
+
+TEST_F(AutoCompCompressorTest, CompressesDoublesWithFPC)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      ).substr(0, 128 * 1024);
+  autocomp::Buffer traceBuffer(trace.size()), decompressedBuffer(trace.size());
+  traceBuffer.setData(trace);
+
+  autocomp::AutoCompCompressor<mock::TCPSocket> autocompCompressor(
+      &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  std::vector<autocomp::Compressor> usedCompressors;
+
+  for (float cpuLoad = 0, bandwidth = 0.5; cpuLoad <= 1;
+       cpuLoad += 0.05, bandwidth *= 2) {
+    resourceState.cpuLoad.store(cpuLoad);
+    resourceState.bandwidth.store(bandwidth);
+
+    compressedBuffer->setSize(0);
+    usedCompressors.push_back(
+        autocompCompressor.compress(traceBuffer, *compressedBuffer)
+      );
+
+    if (usedCompressors.back() == autocomp::FPC) {
+      ASSERT_NO_THROW(autocomp::FPCCompressor().decompress(
+                        *compressedBuffer, decompressedBuffer
+                      ));
+      ASSERT_TRUE(trace == std::string(decompressedBuffer.getData(),
+                                       decompressedBuffer.getSize()));
+    }
+  }
+
+  // FPC takes the place of the fast byte oriented codecs
+  ASSERT_NE(usedCompressors.end(), std::find(usedCompressors.begin(),
+                                             usedCompressors.end(),
+                                             autocomp::FPC));
+  ASSERT_EQ(usedCompressors.end(), std::find(usedCompressors.begin(),
+                                             usedCompressors.end(),
+                                             autocomp::SNAPPY));
+  ASSERT_EQ(usedCompressors.end(), std::find(usedCompressors.begin(),
+                                             usedCompressors.end(),
+                                             autocomp::LZO));
+
+  // Text is left to them
+  resourceState.cpuLoad.store(0);
+  autocompCompressor.reset();
+
+  ASSERT_NE(autocomp::FPC, autocompCompressor.compress(*originalBuffer,
+                                                       *compressedBuffer));
+}
+
+TEST_F(AutoCompCompressorTest, LearnsFPCAsAnArmInBanditMode)
+{
+  autocomp::ResourceState resourceState;
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  resourceState.bandwidth.store(10);
+
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      ).substr(0, 128 * 1024);
+  autocomp::Buffer traceBuffer(trace.size());
+  traceBuffer.setData(trace);
+
+  // The fast LZ codecs are used as chosen on doubles, so they learn too
+  autocomp::ContextualBandit snappyBandit({{autocomp::SNAPPY, -1}});
+  autocomp::BanditCompressor<mock::TCPSocket> snappyCompressor(
+      &snappyBandit, &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  ASSERT_EQ(autocomp::SNAPPY, snappyCompressor.compress(traceBuffer,
+                                                        *compressedBuffer));
+  ASSERT_EQ(std::size_t(1), snappyBandit.getStats().nObservations);
+
+  autocomp::ContextualBandit fpcBandit(
+      {{autocomp::FPC, autocomp::constants::FPC_FAST_LEVEL}}
+    );
+  autocomp::BanditCompressor<mock::TCPSocket> fpcCompressor(
+      &fpcBandit, &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  compressedBuffer->setSize(0);
+
+  ASSERT_EQ(autocomp::FPC, fpcCompressor.compress(traceBuffer,
+                                                  *compressedBuffer));
+  ASSERT_EQ(std::size_t(1), fpcBandit.getStats().nObservations);
+
+  // Chunks of partial words are copied, and teach nothing
+  traceBuffer.setSize(trace.size() - 3);
+  compressedBuffer->setSize(0);
+
+  ASSERT_EQ(autocomp::COPY, fpcCompressor.compress(traceBuffer,
+                                                   *compressedBuffer));
+  ASSERT_EQ(std::size_t(1), fpcBandit.getStats().nObservations);
+}
+
+TEST_F(AutoCompCompressorTest, TakesTheMeasureOfTheDataWhenItChanges)
+{
+  const std::size_t chunkSize = 64 * 1024;
+
+  autocomp::ResourceState resourceState;
+  resourceState.cpuLoad.store(0);
+  resourceState.bandwidth.store(1);
+
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(1000));
+
+  autocomp::AutoCompCompressor<mock::TCPSocket> autocompCompressor(
+      &decisionTree, &resourceState, pseudoClientSocket
+    );
+
+  std::string textChunk = this->originalData.substr(0, chunkSize);
+  std::string randomChunk(chunkSize, '\0');
+  std::mt19937 randomGenerator(42);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+  std::generate(randomChunk.begin(), randomChunk.end(),
+                [&] () { return byteDistribution(randomGenerator); });
+
+  autocomp::Buffer inData(chunkSize), outData(2 * chunkSize);
+
+  auto compressChunks =
+    [&] (const std::string & chunk, const int & nChunks)
+    {
+      std::vector<autocomp::Compressor> decisions;
+
+      for (int i = 0; i < nChunks; i++) {
+        inData.setData(chunk);
+        outData.setSize(0);
+        decisions.push_back(autocompCompressor.compress(inData, outData));
+      }
+
+      return decisions;
+    };
+
+  std::vector<autocomp::Compressor> textDecisions =
+    compressChunks(textChunk, 4);
+
+  ASSERT_EQ(0, std::count(textDecisions.begin(), textDecisions.end(),
+                          autocomp::COPY));
+
+  // The first random chunk is already sent as it is, and the first text
+  // chunk after them compressed again
+  std::vector<autocomp::Compressor> randomDecisions =
+    compressChunks(randomChunk, 4);
+
+  ASSERT_EQ(std::vector<autocomp::Compressor>(4, autocomp::COPY),
+            randomDecisions);
+  ASSERT_NE(autocomp::COPY, compressChunks(textChunk, 1).front());
+}
+
+TEST_F(AutoCompCompressorTest, FollowsTheSendBufferInFeedbackMode)
+{
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+  int sendBufferSize = 1000;
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::ReturnPointee(&sendBufferSize));
+
+  autocomp::FeedbackCompressor<mock::TCPSocket> feedbackCompressor(
+      pseudoClientSocket
+    );
+
+  ASSERT_EQ(autocomp::ZLIB, feedbackCompressor.getCompressorType().first);
+
+  // A full send buffer calls for the strongest compressor...
+  for (int i = 0; i < 40; i++) {
+    compressedBuffer->setSize(0);
+
+    ASSERT_NO_THROW(feedbackCompressor.compress(*originalBuffer,
+                                                *compressedBuffer));
+  }
+
+  ASSERT_EQ(autocomp::LZMA, feedbackCompressor.getCompressorType().first);
+  ASSERT_EQ(6, feedbackCompressor.getCompressorType().second);
+
+  // ...and an empty one for copying
+  sendBufferSize = 0;
+
+  for (int i = 0; i < 80; i++) {
+    compressedBuffer->setSize(0);
+
+    ASSERT_NO_THROW(feedbackCompressor.compress(*originalBuffer,
+                                                *compressedBuffer));
+  }
+
+  ASSERT_EQ(autocomp::COPY, feedbackCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+
+  ASSERT_THROW(autocomp::FeedbackCompressor<mock::TCPSocket>(
+                   pseudoClientSocket, 1.5
+                 ),
+               std::domain_error);
+}
+
+TEST_F(AutoCompCompressorTest, UsesFPCOnlyOnDoublesInFeedbackMode)
+{
+  std::shared_ptr<mock::TCPSocket> pseudoClientSocket =
+    std::make_shared<mock::TCPSocket>();
+
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferCapacity())
+    .WillRepeatedly(::testing::Return(1000));
+  EXPECT_CALL(*pseudoClientSocket, getSendBufferSize())
+    .WillRepeatedly(::testing::Return(0));
+
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      ).substr(0, 128 * 1024);
+  autocomp::Buffer traceBuffer(trace.size()), decompressedBuffer(trace.size());
+  traceBuffer.setData(trace);
+
+  // On the way down from zlib 1 the doubles go through the FPC rung...
+  autocomp::FeedbackCompressor<mock::TCPSocket> feedbackCompressor(
+      pseudoClientSocket
+    );
+  bool usedFPC = false;
+
+  for (int i = 0; i < 80 and not usedFPC; i++) {
+    compressedBuffer->setSize(0);
+    usedFPC = feedbackCompressor.compress(traceBuffer, *compressedBuffer) ==
+                autocomp::FPC;
+  }
+
+  ASSERT_TRUE(usedFPC);
+  ASSERT_NO_THROW(autocomp::FPCCompressor().decompress(*compressedBuffer,
+                                                       decompressedBuffer));
+  ASSERT_TRUE(trace == std::string(decompressedBuffer.getData(),
+                                   decompressedBuffer.getSize()));
+
+  // ...which text skips
+  autocomp::FeedbackCompressor<mock::TCPSocket> textFeedbackCompressor(
+      pseudoClientSocket
+    );
+
+  for (int i = 0; i < 80; i++) {
+    compressedBuffer->setSize(0);
+
+    ASSERT_NE(autocomp::FPC,
+              textFeedbackCompressor.compress(*originalBuffer,
+                                              *compressedBuffer));
+  }
+}
+
 #endif //AC_AUTOCOMP_COMPRESSOR_TEST_HPP
\ No newline at end of file
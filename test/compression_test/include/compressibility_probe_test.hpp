@@ -0,0 +1,108 @@
+#ifndef AC_COMPRESSIBILITY_PROBE_TEST_H
+#define AC_COMPRESSIBILITY_PROBE_TEST_H
+
+/* C++ System Headers */
+#include <string>
+#include <random>
+#include <cstddef>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/buffer.hpp"
+#include "utils/constants.hpp"
+#include "utils/functions.hpp"
+#include "compression/compressibility_probe.hpp"
+
+namespace
+{
+  std::string makeRandomData(const std::size_t & size, const int & nSymbols)
+  {
+    static const std::string base64Symbols(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+      );
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> symbols(0, nSymbols - 1);
+    std::string data(size, '\0');
+
+    for (char & byte : data) {
+      int symbol = symbols(generator);
+      byte = nSymbols == 64 ? base64Symbols[symbol] : symbol;
+    }
+
+    return data;
+  }
+}
+
+TEST(CompressibilityProbeTest, TellsRedundantDataFromRandomData)
+{
+  const std::size_t dataSize = 256 * 1024;
+  autocomp::CompressibilityProbe probe;
+  autocomp::Buffer buffer(dataSize);
+
+  // Random bytes
+  buffer.setData(makeRandomData(dataSize, 256));
+
+  ASSERT_GT(autocomp::constants::PROBE_MIN_RATIO,
+            probe.probe(buffer).compressionRatio);
+
+  // Base64 of random bytes, 6 bits per byte
+  buffer.setData(makeRandomData(dataSize, 64));
+
+  ASSERT_LT(autocomp::constants::PROBE_MIN_RATIO,
+            probe.probe(buffer).compressionRatio);
+
+  // A block of random bytes over and over, which bytecounting takes for
+  // random data
+  std::string block = makeRandomData(1024, 256);
+  std::string repeatedBlocks;
+
+  while (repeatedBlocks.size() < dataSize) {
+    repeatedBlocks += block;
+  }
+
+  buffer.setData(repeatedBlocks);
+
+  ASSERT_LT(100, autocomp::bytecounting(buffer.getData(), dataSize));
+  ASSERT_LT(3, probe.probe(buffer).compressionRatio);
+  ASSERT_LT(0, probe.probe(buffer).compressionRate);
+}
+
+TEST(CompressibilityProbeTest, ProbesOncePerWindow)
+{
+  const std::size_t chunkSize = 64 * 1024;
+  autocomp::CompressibilityProbe probe;
+  autocomp::Buffer randomChunk(chunkSize), constantChunk(chunkSize);
+
+  randomChunk.setData(makeRandomData(chunkSize, 256));
+  constantChunk.setData(std::string(chunkSize, 'a'));
+
+  float randomRatio = probe.get(randomChunk).compressionRatio;
+
+  // The rest of the window keeps the result of its first chunk
+  for (std::size_t i = 1;
+       i < autocomp::constants::PROBE_WINDOW / chunkSize; i++) {
+    ASSERT_EQ(randomRatio, probe.get(constantChunk).compressionRatio);
+  }
+
+  ASSERT_LT(randomRatio, probe.get(constantChunk).compressionRatio);
+
+  probe.reset();
+
+  ASSERT_EQ(randomRatio, probe.get(randomChunk).compressionRatio);
+}
+
+TEST(CompressibilityProbeTest, ProbesSmallChunksWhole)
+{
+  autocomp::CompressibilityProbe probe;
+  autocomp::Buffer buffer(1024), emptyBuffer(1);
+
+  buffer.setData(std::string(1024, 'a'));
+
+  ASSERT_LT(10, probe.probe(buffer).compressionRatio);
+  ASSERT_EQ(1, probe.probe(emptyBuffer).compressionRatio);
+}
+
+#endif //AC_COMPRESSIBILITY_PROBE_TEST_H
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <memory>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 
 /* External headers */
 #include "gtest/gtest.h"
@@ -19,6 +21,7 @@
 #include "messaging/compressor.pb.h"
 #include "compression/round_robin_compressor.hpp"
 #include "compression/file_processor.hpp"
+#include "utils/file_format.hpp"
 
 TEST(FileProcessorTest, ProcessesSingleFile)
 {
@@ -256,6 +259,60 @@ TEST(FileProcessorTest, ProcessesDirectory)
   ASSERT_EQ(realFileList, fileList);
 }
 
+TEST(FileProcessorTest, CopiesAlreadyCompressedFiles)
+{
+  unsigned int chunkSize = 15;
+  autocomp::Buffer chunk(1.1 * chunkSize * 1024);
+  const std::string gzipFile(autocomp::test::constants::testOutputDirectory +
+                             "/alice29.txt.gz");
+
+  // Text behind a gzip header: compressible, but taken for gzip
+  std::string fileData = std::string("\x1f\x8b\x08\x00", 4) +
+                         autocomp::test::getDataFromFile(
+                           autocomp::test::constants::compressionTestFilename
+                         );
+
+  {
+    std::ofstream output(gzipFile, std::ofstream::binary |
+                                   std::ofstream::trunc);
+    output.write(fileData.data(), fileData.size());
+  }
+
+  std::shared_ptr<autocomp::io::PerformanceDataWriter> performanceDataWriter =
+    std::make_shared<autocomp::io::PerformanceDataWriter>();
+  autocomp::FileProcessor fileProcessor(
+      chunkSize,
+      std::make_shared<autocomp::RoundRobinCompressor>(performanceDataWriter)
+    );
+
+  ASSERT_NO_THROW({
+    fileProcessor.preparePath(gzipFile);
+    fileProcessor.openNextFile();
+  });
+
+  ASSERT_EQ(autocomp::FileFormat::GZIP, fileProcessor.getCurrentFileFormat());
+
+  std::string processedData;
+
+  while (fileProcessor.hasNextChunk()) {
+    ASSERT_EQ(autocomp::COPY, fileProcessor.getNextChunk(chunk));
+
+    processedData.append(chunk.getData(), chunk.getSize());
+  }
+
+  ASSERT_TRUE(fileData == processedData);
+
+  std::remove(gzipFile.c_str());
+
+  // Plain text is still compressed
+  fileProcessor.preparePath(autocomp::test::constants::compressionTestFilename);
+  fileProcessor.openNextFile();
+
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN,
+            fileProcessor.getCurrentFileFormat());
+  ASSERT_NE(autocomp::COPY, fileProcessor.getNextChunk(chunk));
+}
+
 TEST(FileProcessorTest, DoesNotPreparedUnexistingPath)
 {
   std::shared_ptr<autocomp::io::PerformanceDataWriter> performanceDataWriter =
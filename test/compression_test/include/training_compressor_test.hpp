@@ -17,7 +17,8 @@
 #include "utils/buffer.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/data_structures.hpp"
-#include "utils/synchronous_queue.hpp"
+#include "utils/bounded_queue.hpp"
+#include "network/socket/frame.hpp"
 #include "compression/training_compressor.hpp"
 
 class TrainingCompressorTest : public ::testing::Test
@@ -59,7 +60,8 @@ protected:
 TEST_F(TrainingCompressorTest, CompressesAndDecompresses)
 {
   autocomp::ResourceState resourceState;
-  autocomp::SynchronousQueue<autocomp::Buffer> pseudoTransmissionQueue;
+  autocomp::BoundedQueue<autocomp::net::Frame> pseudoTransmissionQueue(
+    1024 * 1024, 16);
   std::shared_ptr<autocomp::net::TCPSocket> pseudoClientSocket =
     std::make_shared<autocomp::net::TCPSocket>();
   std::shared_ptr<autocomp::io::PerformanceDataWriter> performanceDataWriter =
@@ -71,7 +73,8 @@ TEST_F(TrainingCompressorTest, CompressesAndDecompresses)
 
   autocomp::Compressor compressors[] = {autocomp::ZLIB, autocomp::SNAPPY,
                                         autocomp::LZO, autocomp::BZIP2,
-                                        autocomp::LZMA, autocomp::COPY};
+                                        autocomp::LZMA, autocomp::FPC,
+                                        autocomp::COPY};
 
   for (auto & compressor : compressors) {
     trainingCompressor.setCompressor(compressor);
@@ -118,6 +121,13 @@ TEST_F(TrainingCompressorTest, CompressesAndDecompresses)
         });
         break;
 
+      case autocomp::FPC:
+        ASSERT_NO_THROW({
+          autocomp::FPCCompressor().decompress(*compressedBuffer,
+                                               *decompressedBuffer);
+        });
+        break;
+
       case autocomp::COPY:
         ASSERT_EQ(0, compressedBuffer->getSize());
         continue;
@@ -138,4 +148,32 @@ TEST_F(TrainingCompressorTest, CompressesAndDecompresses)
   }
 }
 
+TEST_F(TrainingCompressorTest, CopiesPartialWordsInsteadOfFPC)
+{
+  autocomp::ResourceState resourceState;
+  autocomp::BoundedQueue<autocomp::net::Frame> pseudoTransmissionQueue(
+    1024 * 1024, 16);
+  std::shared_ptr<autocomp::net::TCPSocket> pseudoClientSocket =
+    std::make_shared<autocomp::net::TCPSocket>();
+  std::shared_ptr<autocomp::io::PerformanceDataWriter> performanceDataWriter =
+    std::make_shared<autocomp::io::PerformanceDataWriter>();
+  autocomp::TrainingCompressor trainingCompressor(&resourceState,
+                                                  &pseudoTransmissionQueue,
+                                                  pseudoClientSocket,
+                                                  performanceDataWriter);
+
+  trainingCompressor.setCompressor(autocomp::FPC);
+
+  originalBuffer->setSize(8 * 1024 + 3);
+
+  ASSERT_EQ(autocomp::COPY, trainingCompressor.compress(*originalBuffer,
+                                                        *compressedBuffer));
+  ASSERT_EQ(0, compressedBuffer->getSize());
+
+  originalBuffer->setSize(8 * 1024);
+
+  ASSERT_EQ(autocomp::FPC, trainingCompressor.compress(*originalBuffer,
+                                                       *compressedBuffer));
+}
+
 #endif //AC_TRAINING_COMPRESSOR_TEST_H
\ No newline at end of file
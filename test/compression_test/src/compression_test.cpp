@@ -12,6 +12,8 @@
 #include "file_processor_test.hpp"
 #include "pre_compressing_file_processor_test.hpp"
 #include "autocomp_compressor_test.hpp"
+#include "analytic_compressor_test.hpp"
+#include "compressibility_probe_test.hpp"
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,176 @@
+#ifndef AC_ADMISSION_CONTROLLER_TEST_HPP
+#define AC_ADMISSION_CONTROLLER_TEST_HPP
+
+/* C++ System Headers */
+#include <chrono>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "network/server/admission_controller.hpp"
+
+namespace
+{
+  using AdmissionController = autocomp::net::AdmissionController;
+
+  // Requests a session, which is stored once the controller calls back
+  std::shared_ptr<std::promise<AdmissionController::Session>>
+  requestSession(AdmissionController & admissionController)
+  {
+    auto session =
+      std::make_shared<std::promise<AdmissionController::Session>>();
+
+    admissionController.admit(
+        AdmissionController::Clock::now(),
+        [session] (AdmissionController::Session admission)
+        {
+          session->set_value(std::move(admission));
+        }
+      );
+
+    return session;
+  }
+
+  bool isReady(std::future<AdmissionController::Session> & session)
+  {
+    return session.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+  }
+}
+
+TEST(AdmissionControllerTest, RefusesConnectionsWhenTheQueueIsFull)
+{
+  AdmissionController admissionController(
+      1, 2, std::chrono::milliseconds(1000)
+    );
+
+  auto runningSession = requestSession(admissionController)->get_future()
+                          .get();
+  auto firstWaitingSession = requestSession(admissionController)
+                               ->get_future();
+  auto secondWaitingSession = requestSession(admissionController)
+                                ->get_future();
+  auto refusedSession = requestSession(admissionController)->get_future();
+
+  ASSERT_TRUE(bool(runningSession));
+  ASSERT_FALSE(isReady(firstWaitingSession));
+  ASSERT_FALSE(isReady(secondWaitingSession));
+  ASSERT_FALSE(bool(refusedSession.get()));
+
+  autocomp::net::AdmissionStats stats = admissionController.getStats();
+  ASSERT_EQ(2, stats.queuedSessions);
+  ASSERT_EQ(1, stats.rejectedSessions);
+  ASSERT_EQ(0, stats.timedOutSessions);
+}
+
+TEST(AdmissionControllerTest, TracksActiveSessions)
+{
+  AdmissionController admissionController(
+      2, 4, std::chrono::milliseconds(1000)
+    );
+
+  auto firstSession = requestSession(admissionController)->get_future()
+                        .get();
+  ASSERT_TRUE(bool(firstSession));
+
+  {
+    auto secondSession = requestSession(admissionController)->get_future()
+                           .get();
+    ASSERT_TRUE(bool(secondSession));
+    ASSERT_EQ(2, admissionController.getStats().activeSessions);
+  }
+
+  autocomp::net::AdmissionStats stats = admissionController.getStats();
+  ASSERT_EQ(1, stats.activeSessions);
+  ASSERT_EQ(2, stats.peakActiveSessions);
+  ASSERT_EQ(2, stats.admittedSessions);
+  ASSERT_EQ(0, stats.queuedSessions);
+
+  // Moving the session does not release it twice
+  auto movedSession = std::move(firstSession);
+  ASSERT_EQ(1, admissionController.getStats().activeSessions);
+}
+
+TEST(AdmissionControllerTest, AdmitsWaitingRequestsAsSessionsEnd)
+{
+  AdmissionController admissionController(
+      1, 4, std::chrono::milliseconds(5000)
+    );
+
+  auto runningSession = requestSession(admissionController)->get_future()
+                          .get();
+  std::vector<std::future<AdmissionController::Session>> waitingSessions;
+
+  for (int i = 0; i < 3; i++) {
+    waitingSessions.push_back(requestSession(admissionController)
+                                ->get_future());
+  }
+
+  ASSERT_EQ(3, admissionController.getStats().queuedSessions);
+
+  // Each session that ends lets the next request in, in order
+  AdmissionController::Session session = std::move(runningSession);
+
+  for (auto & waitingSession : waitingSessions) {
+    ASSERT_FALSE(isReady(waitingSession));
+
+    session = AdmissionController::Session();
+    session = waitingSession.get();
+
+    ASSERT_TRUE(bool(session));
+    ASSERT_EQ(1, admissionController.getStats().activeSessions);
+  }
+
+  autocomp::net::AdmissionStats stats = admissionController.getStats();
+  ASSERT_EQ(4, stats.admittedSessions);
+  ASSERT_EQ(0, stats.queuedSessions);
+  ASSERT_EQ(0, stats.rejectedSessions);
+  ASSERT_EQ(0, stats.timedOutSessions);
+}
+
+TEST(AdmissionControllerTest, RefusesConnectionsThatWaitedTooLong)
+{
+  AdmissionController admissionController(
+      1, 1, std::chrono::milliseconds(100)
+    );
+
+  auto runningSession = requestSession(admissionController)->get_future()
+                          .get();
+  auto waitingSession = requestSession(admissionController)->get_future();
+
+  // Refused when the wait is over, while the running session goes on
+  ASSERT_EQ(std::future_status::ready,
+            waitingSession.wait_for(std::chrono::seconds(2)));
+  ASSERT_FALSE(bool(waitingSession.get()));
+
+  autocomp::net::AdmissionStats stats = admissionController.getStats();
+  ASSERT_EQ(1, stats.activeSessions);
+  ASSERT_EQ(0, stats.queuedSessions);
+  ASSERT_EQ(0, stats.rejectedSessions);
+  ASSERT_EQ(1, stats.timedOutSessions);
+}
+
+TEST(AdmissionControllerTest, RefusesWaitingConnectionsOnShutdown)
+{
+  AdmissionController admissionController(
+      1, 1, std::chrono::milliseconds(5000)
+    );
+
+  auto runningSession = requestSession(admissionController)->get_future()
+                          .get();
+  auto waitingSession = requestSession(admissionController)->get_future();
+
+  admissionController.shutdown();
+
+  ASSERT_FALSE(bool(waitingSession.get()));
+  ASSERT_FALSE(bool(requestSession(admissionController)->get_future()
+                      .get()));
+  ASSERT_EQ(2, admissionController.getStats().rejectedSessions);
+}
+
+#endif // AC_ADMISSION_CONTROLLER_TEST_HPP
@@ -0,0 +1,65 @@
+#ifndef AC_CHUNK_FRAME_HEADER_TEST_HPP
+#define AC_CHUNK_FRAME_HEADER_TEST_HPP
+
+/* C++ System Headers */
+#include <cstdint>
+#include <cstring>
+#include <arpa/inet.h>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "messaging/compressor.pb.h"
+#include "network/socket/chunk_frame_header.hpp"
+
+TEST(ChunkFrameHeaderTest, SerializesAndDeserializes)
+{
+  autocomp::net::ChunkFrameHeader header;
+  header.compressor = autocomp::LZMA;
+  header.level = 9;
+  header.chunkIndex = (uint64_t(1) << 40) + 7;
+  header.compressedSize = 123456;
+  header.uncompressedSize = 524288;
+  header.checksum = 0xDEADBEEF;
+  header.setFlag(autocomp::net::ChunkFrameHeader::LAST_CHUNK);
+  header.setFlag(autocomp::net::ChunkFrameHeader::HAS_CHECKSUM);
+
+  char buffer[autocomp::net::CHUNK_FRAME_HEADER_SIZE];
+  header.serialize(buffer);
+
+  ASSERT_TRUE(autocomp::net::ChunkFrameHeader::isChunkFrame(buffer));
+
+  autocomp::net::ChunkFrameHeader readHeader;
+  ASSERT_TRUE(readHeader.deserialize(buffer));
+
+  ASSERT_EQ(header.version, readHeader.version);
+  ASSERT_EQ(header.flags, readHeader.flags);
+  ASSERT_EQ(header.compressor, readHeader.compressor);
+  ASSERT_EQ(header.level, readHeader.level);
+  ASSERT_EQ(header.chunkIndex, readHeader.chunkIndex);
+  ASSERT_EQ(header.compressedSize, readHeader.compressedSize);
+  ASSERT_EQ(header.uncompressedSize, readHeader.uncompressedSize);
+  ASSERT_EQ(header.checksum, readHeader.checksum);
+  ASSERT_TRUE(
+    readHeader.hasFlag(autocomp::net::ChunkFrameHeader::LAST_CHUNK)
+  );
+  ASSERT_FALSE(
+    readHeader.hasFlag(autocomp::net::ChunkFrameHeader::DEPENDENT_CHUNK)
+  );
+}
+
+TEST(ChunkFrameHeaderTest, RejectsLengthPrefixedMessages)
+{
+  char buffer[autocomp::net::CHUNK_FRAME_HEADER_SIZE] = {};
+  uint32_t networkByteOrderMessageSize = htonl(1024);
+  std::memcpy(buffer, &networkByteOrderMessageSize,
+              sizeof(networkByteOrderMessageSize));
+
+  autocomp::net::ChunkFrameHeader header;
+
+  ASSERT_FALSE(autocomp::net::ChunkFrameHeader::isChunkFrame(buffer));
+  ASSERT_FALSE(header.deserialize(buffer));
+}
+
+#endif //AC_CHUNK_FRAME_HEADER_TEST_HPP
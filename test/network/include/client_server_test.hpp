@@ -9,6 +9,7 @@
 #include <mutex>
 #include <iostream>
 #include <chrono>
+#include <atomic>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -49,7 +50,8 @@ protected:
   pid_t currentServerPID;
 
   ClientServerTest()
-    : clients(50)
+    : clients(50),
+      currentServerPID(-1)
   {}
 
   void SetUp()
@@ -73,7 +75,7 @@ protected:
 
 public:
 
-  void server(const int & port)
+  void server(const int & port, const unsigned int & nAcceptors = 1)
   {
     std::unique_ptr<autocomp::net::Server> server;
 
@@ -83,6 +85,7 @@ public:
             new autocomp::net::Server(port, this->shutdownPipeName)
           );
 
+      server->setAcceptorCount(nAcceptors);
       server->init();
     }
     catch (autocomp::exceptions::NetworkError & error) {
@@ -94,21 +97,34 @@ public:
   }
 
   void killServer()
+  {
+    if (this->currentServerPID > 0) {
+      this->shutDownServer();
+    }
+  }
+
+  // Asks the server to shut down, and waits for it to exit
+  int shutDownServer()
   {
     int shutdownPipeFileDescriptor = ::open(this->shutdownPipeName.c_str(),
                                             O_WRONLY | O_NONBLOCK);
 
     if (shutdownPipeFileDescriptor == -1) {
-       FAIL() << "Error opening fifo: " <<  std::strerror(errno)
-              << "(" << errno << ")" << std::endl;
+       ADD_FAILURE() << "Error opening fifo: " <<  std::strerror(errno)
+                     << "(" << errno << ")" << std::endl;
+
+       return -1;
     }
 
     ::write(shutdownPipeFileDescriptor, "1", 1);
 
-    int status;
+    int status = -1;
     ::waitpid(this->currentServerPID, &status, 0);
+    this->currentServerPID = -1;
 
     ::close(shutdownPipeFileDescriptor);
+
+    return status;
   }
  
 }; // class ClientServerTest
@@ -556,6 +572,140 @@ TEST_F(ClientServerTest, TransfersSingleFileWithoutCompressing)
   std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 
+TEST_F(ClientServerTest, TransfersFilesToConcurrentClientsWithManyAcceptors)
+{
+  this->currentServerPID = fork();
+
+  //child
+  if (this->currentServerPID == 0) {
+    this->server(autocomp::test::constants::testPortFour, 4);
+
+    std::exit(0);
+  }
+  else if (this->currentServerPID == -1) {
+    std::cerr << "Could not create child process: " << std::strerror(errno)
+              << " (" << errno << ")" << std::endl;
+    std::exit(-1);
+  }
+
+  // Wait for server to be ready
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  if (::kill(this->currentServerPID, 0) == -1 and errno == ESRCH) {
+    FAIL() << "Failed to launch server" << std::endl;
+  }
+
+  std::vector<std::thread> clients;
+  std::vector<char> transferred(this->realFileList.size(), false);
+
+  // Each client requests a different file, so they write different files
+  for (std::size_t i = 0; i < this->realFileList.size(); i++) {
+    clients.emplace_back(
+        [this, i, &transferred] ()
+        {
+          autocomp::net::Client client("localhost",
+                                       autocomp::test::constants::testPortFour);
+          client.init();
+
+          autocomp::FileRequestMode mode = autocomp::NO_COMPRESSION;
+          client.requestFile(this->realFileList[i], mode, nullptr, nullptr,
+                             autocomp::test::constants::testOutputDirectory);
+
+          char sentFileName[1000 + 1];
+          ::strncpy(sentFileName, this->realFileList[i].c_str(), 1000);
+          std::string sentFile =
+            autocomp::test::constants::testOutputDirectory + "/" +
+              ::basename(sentFileName);
+
+          transferred[i] =
+            autocomp::test::getDataFromFile(sentFile) ==
+              autocomp::test::getDataFromFile(this->realFileList[i]);
+        }
+      );
+  }
+
+  for (auto & client : clients) {
+    client.join();
+  }
+
+  for (std::size_t i = 0; i < this->realFileList.size(); i++) {
+    ASSERT_TRUE(transferred[i]) << this->realFileList[i];
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+}
+
+TEST_F(ClientServerTest, TransfersSingleFileWithEveryProtocolVersion)
+{
+  this->currentServerPID = fork();
+
+  //child
+  if (this->currentServerPID == 0) {
+    this->server(autocomp::test::constants::testPortFour);
+
+    std::exit(0);
+  }
+  else if (this->currentServerPID == -1) {
+    std::cerr << "Could not create child process: " << std::strerror(errno)
+              << " (" << errno << ")" << std::endl;
+    std::exit(-1);
+  }
+
+  // Wait for server to be ready
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  if (::kill(this->currentServerPID, 0) == -1 and errno == ESRCH) {
+    FAIL() << "Failed to launch server" << std::endl;
+  }
+
+  // {protocol version, chunk checksums}
+  std::vector<std::pair<unsigned int, bool>> configurations{
+                                                              {1, false},
+                                                              {2, false},
+                                                              {2, true}
+                                                            };
+
+  for (auto & configuration : configurations) {
+    autocomp::net::Client client("localhost",
+                                 autocomp::test::constants::testPortFour);
+
+    client.setProtocolVersion(configuration.first);
+    client.setChunkChecksums(configuration.second);
+    client.init();
+
+    autocomp::FileRequestMode mode = autocomp::COMPRESS;
+    autocomp::Compressor compressor = autocomp::ZLIB;
+    client.requestFile(autocomp::test::constants::fpcTestFilename, mode,
+                       &compressor, nullptr,
+                       autocomp::test::constants::testOutputDirectory);
+
+    // Checking file integrity
+    char sentFileName[1000 + 1];
+    ::strncpy(sentFileName,
+              autocomp::test::constants::fpcTestFilename.c_str(), 1000);
+    std::string sentFile = autocomp::test::constants::testOutputDirectory +
+                            "/" + ::basename(sentFileName);
+    std::string originalFileData, sentFileData;
+
+    ASSERT_NO_THROW({
+      sentFileData = autocomp::test::getDataFromFile(sentFile);
+    });
+
+    ASSERT_NO_THROW({
+      originalFileData = autocomp::test::getDataFromFile(
+          autocomp::test::constants::fpcTestFilename
+        );
+    });
+
+    ASSERT_EQ(originalFileData.size(), sentFileData.size());
+    ASSERT_TRUE(originalFileData == sentFileData);
+
+    ::remove(sentFile.c_str());
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
 TEST_F(ClientServerTest, TransfersDirectoryWithoutCompressing)
 {
   this->currentServerPID = fork();
@@ -878,4 +1028,85 @@ TEST_F(ClientServerTest, TransfersDirectoryWithTrainingCompressor)
   std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 
+TEST_F(ClientServerTest, ShutsDownWhileTransfersAreActive)
+{
+  this->currentServerPID = fork();
+
+  //child
+  if (this->currentServerPID == 0) {
+    std::unique_ptr<autocomp::net::Server> server(
+        new autocomp::net::Server(autocomp::test::constants::testPortEight,
+                                  this->shutdownPipeName)
+      );
+
+    // Sessions suspend after every couple of frames, and the reactor
+    // resumes them as it sends
+    server->setTransmissionQueueCapacity(16 * 1024, 2);
+    server->init();
+    server->serve();
+
+    std::exit(0);
+  }
+  else if (this->currentServerPID == -1) {
+    std::cerr << "Could not create child process: " << std::strerror(errno)
+              << " (" << errno << ")" << std::endl;
+    std::exit(-1);
+  }
+
+  // Wait for server to be ready
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  if (::kill(this->currentServerPID, 0) == -1 and errno == ESRCH) {
+    FAIL() << "Failed to launch server" << std::endl;
+  }
+
+  std::atomic<bool> done(false);
+  std::atomic<int> nStartedTransfers(0);
+  std::vector<std::thread> clients;
+
+  // Transfers requested again and again until the server is gone
+  for (std::size_t i = 0; i < this->realFileList.size(); i++) {
+    clients.emplace_back(
+        [this, i, &done, &nStartedTransfers] ()
+        {
+          while (not done) {
+            try {
+              autocomp::net::Client client(
+                  "localhost", autocomp::test::constants::testPortEight
+                );
+              client.init();
+
+              autocomp::FileRequestMode mode = autocomp::NO_COMPRESSION;
+              nStartedTransfers++;
+              client.requestFile(this->realFileList[i], mode, nullptr,
+                                 nullptr,
+                                 autocomp::test::constants
+                                   ::testOutputDirectory);
+            }
+            catch (std::exception &) {
+              return;
+            }
+          }
+        }
+      );
+  }
+
+  while (nStartedTransfers < int(clients.size())) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  int status = this->shutDownServer();
+  done = true;
+
+  for (auto & client : clients) {
+    client.join();
+  }
+
+  ASSERT_TRUE(WIFEXITED(status)) << "Server killed by signal "
+                                 << WTERMSIG(status);
+  ASSERT_EQ(0, WEXITSTATUS(status));
+}
+
 #endif //AC_CLIENT_SERVER_TEST_HPP
\ No newline at end of file
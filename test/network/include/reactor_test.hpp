@@ -0,0 +1,358 @@
+#ifndef AC_REACTOR_TEST_HPP
+#define AC_REACTOR_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "test_constants.hpp"
+#include "utils/exceptions.hpp"
+#include "utils/buffer.hpp"
+#include "utils/memory_governor.hpp"
+#include "network/socket/tcp_socket.hpp"
+#include "network/socket/frame.hpp"
+#include "network/server/connection.hpp"
+#include "network/server/reactor.hpp"
+
+class ReactorTest : public ::testing::Test
+{
+protected:
+
+  const int nClients = 32;
+  const int nFramesPerClient = 64;
+  const std::size_t frameSize = 16 * 1024;
+
+  /**
+   * Queues nFrames frames, suspending whenever the queue is full as the
+   * server does
+   */
+  struct Producer
+  {
+    std::shared_ptr<autocomp::net::Connection> connection;
+    std::string request;
+    int nFrames;
+    std::size_t frameSize;
+    int nQueuedFrames = 0;
+
+    void produce()
+    {
+      while (this->nQueuedFrames < this->nFrames) {
+        autocomp::Buffer payload(this->frameSize);
+        payload.setSize(this->frameSize);
+        std::fill(payload.getData(), payload.getData() + this->frameSize,
+                  static_cast<char>(this->nQueuedFrames));
+
+        autocomp::Buffer header(this->request.size());
+        header.setData(this->request);
+
+        auto result =
+          this->connection->queue(autocomp::net::Frame(std::move(header),
+                                                       std::move(payload)));
+
+        if (result == autocomp::net::Connection::QueueResult::CLOSED) {
+          return;
+        }
+
+        if (result == autocomp::net::Connection::QueueResult::FULL) {
+          if (this->connection->suspend()) {
+            return;
+          }
+
+          continue;
+        }
+
+        this->nQueuedFrames++;
+      }
+
+      this->connection->finish();
+    }
+  };
+
+}; // class ReactorTest
+
+
+TEST_F(ReactorTest, ServesManySlowConnectionsWithFewThreads)
+{
+  autocomp::net::Reactor reactor(2);
+  autocomp::net::TCPSocket serverSocket(
+      autocomp::test::constants::testPortThree, this->nClients
+    );
+
+  ASSERT_NO_THROW({
+    serverSocket.setReuseAddress(true);
+    serverSocket.bind();
+    serverSocket.listen();
+    reactor.init();
+  });
+
+  std::atomic<int> nClosedConnections(0);
+  std::atomic<int> nFailedConnections(0);
+  std::vector<std::thread> clients;
+
+  for (int i = 0; i < this->nClients; i++) {
+    clients.emplace_back(
+        [this, i] ()
+        {
+          autocomp::net::TCPSocket socket;
+          socket.connect("localhost", autocomp::test::constants::testPortThree);
+          socket.send(std::to_string(i));
+
+          std::string header;
+          autocomp::Buffer payload;
+
+          for (int j = 0; j < this->nFramesPerClient; j++) {
+            // Slow clients keep the queues full
+            if (i % 2 == 0) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            header.clear();
+            socket.receive(header);
+            socket.receive(payload);
+
+            ASSERT_EQ(std::to_string(i), header);
+            ASSERT_EQ(this->frameSize, payload.getSize());
+            ASSERT_EQ(static_cast<char>(j), payload.getData()[0]);
+          }
+
+          // The server closes the connection once everything is sent
+          ASSERT_THROW(socket.receive(header),
+                       autocomp::exceptions::NetworkError);
+        }
+      );
+  }
+
+  for (int i = 0; i < this->nClients; i++) {
+    auto connection =
+      std::make_shared<autocomp::net::Connection>(serverSocket.accept(),
+                                                  4 * this->frameSize, 4);
+
+    connection->setRequestHandler(
+        [this] (const std::shared_ptr<autocomp::net::Connection> & connection,
+                std::vector<char> && request)
+        {
+          auto producer = std::make_shared<Producer>();
+          producer->connection = connection;
+          producer->request.assign(request.begin(), request.end());
+          producer->nFrames = this->nFramesPerClient;
+          producer->frameSize = this->frameSize;
+
+          connection->setResumeHandler([producer] ()
+                                       {
+                                         producer->produce();
+                                       });
+          producer->produce();
+        }
+      );
+    connection->setCloseHandler(
+        [&nClosedConnections, &nFailedConnections] (const std::string & error)
+        {
+          if (not error.empty()) {
+            nFailedConnections++;
+          }
+
+          nClosedConnections++;
+        }
+      );
+
+    reactor.add(connection);
+  }
+
+  for (auto & client : clients) {
+    client.join();
+  }
+
+  while (reactor.getConnectionCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  reactor.shutdown();
+
+  ASSERT_EQ(this->nClients, nClosedConnections.load());
+  ASSERT_EQ(0, nFailedConnections.load());
+}
+
+TEST_F(ReactorTest, ClosesConnectionsOfClientsThatLeave)
+{
+  autocomp::net::Reactor reactor(1);
+  autocomp::net::TCPSocket serverSocket(
+      autocomp::test::constants::testPortThree
+    );
+
+  ASSERT_NO_THROW({
+    serverSocket.setReuseAddress(true);
+    serverSocket.bind();
+    serverSocket.listen();
+    reactor.init();
+  });
+
+  std::atomic<int> nFailedConnections(0);
+
+  std::thread client([] ()
+                     {
+                       autocomp::net::TCPSocket socket;
+                       socket.connect("localhost",
+                                      autocomp::test::constants::testPortThree);
+                       socket.send(std::string("leaving"));
+
+                       std::string header;
+                       socket.receive(header);
+                       socket.close();
+                     });
+
+  auto connection =
+    std::make_shared<autocomp::net::Connection>(serverSocket.accept(),
+                                                4 * this->frameSize, 4);
+  auto producer = std::make_shared<Producer>();
+
+  connection->setRequestHandler(
+      [this, producer]
+      (const std::shared_ptr<autocomp::net::Connection> & connection,
+       std::vector<char> && request)
+      {
+        producer->connection = connection;
+        producer->request.assign(request.begin(), request.end());
+        // Far more than the socket buffers hold
+        producer->nFrames = 100000;
+        producer->frameSize = this->frameSize;
+
+        connection->setResumeHandler([producer] ()
+                                     {
+                                       producer->produce();
+                                     });
+        producer->produce();
+      }
+    );
+  connection->setCloseHandler(
+      [&nFailedConnections] (const std::string & error)
+      {
+        if (not error.empty()) {
+          nFailedConnections++;
+        }
+      }
+    );
+
+  reactor.add(connection);
+  connection.reset();
+
+  client.join();
+
+  while (reactor.getConnectionCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  reactor.shutdown();
+
+  ASSERT_EQ(1, nFailedConnections.load());
+  ASSERT_LT(producer->nQueuedFrames, 100000);
+}
+
+TEST_F(ReactorTest, KeepsQueuedFramesWithinTheMemoryBudget)
+{
+  const int nClients = 8;
+  // Far less than the queues of the connections hold
+  autocomp::MemoryGovernor memoryGovernor(4 * this->frameSize);
+  autocomp::net::Reactor reactor(2);
+  autocomp::net::TCPSocket serverSocket(
+      autocomp::test::constants::testPortThree, nClients
+    );
+
+  ASSERT_NO_THROW({
+    serverSocket.setReuseAddress(true);
+    serverSocket.bind();
+    serverSocket.listen();
+    reactor.init();
+  });
+
+  std::atomic<int> nFailedConnections(0);
+  std::vector<std::thread> clients;
+
+  for (int i = 0; i < nClients; i++) {
+    clients.emplace_back(
+        [this, i] ()
+        {
+          autocomp::net::TCPSocket socket;
+          socket.connect("localhost", autocomp::test::constants::testPortThree);
+          socket.send(std::to_string(i));
+
+          std::string header;
+          autocomp::Buffer payload;
+
+          for (int j = 0; j < this->nFramesPerClient; j++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            header.clear();
+            socket.receive(header);
+            socket.receive(payload);
+
+            ASSERT_EQ(std::to_string(i), header);
+            ASSERT_EQ(static_cast<char>(j), payload.getData()[0]);
+          }
+        }
+      );
+  }
+
+  for (int i = 0; i < nClients; i++) {
+    auto connection =
+      std::make_shared<autocomp::net::Connection>(serverSocket.accept(),
+                                                  64 * this->frameSize, 64);
+    connection->setMemoryGovernor(&memoryGovernor);
+
+    connection->setRequestHandler(
+        [this] (const std::shared_ptr<autocomp::net::Connection> & connection,
+                std::vector<char> && request)
+        {
+          auto producer = std::make_shared<Producer>();
+          producer->connection = connection;
+          producer->request.assign(request.begin(), request.end());
+          producer->nFrames = this->nFramesPerClient;
+          producer->frameSize = this->frameSize;
+
+          connection->setResumeHandler([producer] ()
+                                       {
+                                         producer->produce();
+                                       });
+          producer->produce();
+        }
+      );
+    connection->setCloseHandler(
+        [&nFailedConnections] (const std::string & error)
+        {
+          if (not error.empty()) {
+            nFailedConnections++;
+          }
+        }
+      );
+
+    reactor.add(connection);
+  }
+
+  for (auto & client : clients) {
+    client.join();
+  }
+
+  while (reactor.getConnectionCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  reactor.shutdown();
+
+  autocomp::MemoryStats stats = memoryGovernor.getStats();
+
+  ASSERT_EQ(0, nFailedConnections.load());
+  ASSERT_EQ(0, stats.usedBytes);
+  ASSERT_LT(0, stats.deniedReservations);
+  // Each connection may queue a frame past the budget when its queue is empty
+  ASSERT_LE(stats.peakUsedBytes,
+            memoryGovernor.getBudget() + nClients * (this->frameSize + 16));
+}
+
+#endif // AC_REACTOR_TEST_HPP
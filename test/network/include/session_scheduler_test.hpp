@@ -0,0 +1,243 @@
+#ifndef AC_SESSION_SCHEDULER_TEST_HPP
+#define AC_SESSION_SCHEDULER_TEST_HPP
+
+/* C++ System Headers */
+#include <ctime>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/thread_pool.hpp"
+#include "network/server/session_scheduler.hpp"
+
+namespace
+{
+  // Spins until the calling thread used the given CPU time
+  void spin(const double & milliseconds)
+  {
+    timespec time;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    double start = time.tv_sec * 1E3 + time.tv_nsec / 1E6;
+    double now = start;
+
+    while (now - start < milliseconds) {
+      ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+      now = time.tv_sec * 1E3 + time.tv_nsec / 1E6;
+    }
+  }
+}
+
+TEST(SessionSchedulerTest, RefusesInvalidWeights)
+{
+  autocomp::ThreadPool threadPool(1);
+  autocomp::net::SessionScheduler scheduler(threadPool);
+
+  ASSERT_THROW(scheduler.addFlow([] () { return false; }, 0),
+               std::domain_error);
+  ASSERT_THROW(scheduler.addFlow([] () { return false; },
+                                 autocomp::constants::MAX_SESSION_WEIGHT + 1),
+               std::domain_error);
+}
+
+TEST(SessionSchedulerTest, SharesCpuTimeByWeight)
+{
+  autocomp::ThreadPool threadPool(1);
+  autocomp::net::SessionScheduler scheduler(threadPool,
+                                            std::chrono::milliseconds(2));
+  std::atomic<bool> done(false);
+
+  threadPool.init();
+  scheduler.init();
+
+  auto slice = [&done] ()
+  {
+    spin(1);
+    return not done;
+  };
+
+  auto lightFlow = scheduler.addFlow(slice, 1);
+  auto heavyFlow = scheduler.addFlow(slice, 3);
+
+  scheduler.schedule(lightFlow);
+  scheduler.schedule(heavyFlow);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(800));
+  done = true;
+
+  scheduler.shutdown();
+  threadPool.shutdown();
+
+  autocomp::net::FlowStats lightStats = scheduler.getFlowStats(*lightFlow);
+  autocomp::net::FlowStats heavyStats = scheduler.getFlowStats(*heavyFlow);
+
+  ASSERT_LT(0, lightStats.cpuTime);
+  ASSERT_NEAR(3, heavyStats.cpuTime / lightStats.cpuTime, 1);
+  ASSERT_LT(heavyStats.cpuShare, 1);
+  ASSERT_EQ(2, scheduler.getStats().nFlows);
+}
+
+TEST(SessionSchedulerTest, CapsTheRateOfAFlow)
+{
+  autocomp::ThreadPool threadPool(2);
+  autocomp::net::SessionScheduler scheduler(threadPool);
+  std::atomic<bool> done(false);
+  const double maxRate = 100 * 1024;
+  const std::size_t chunkSize = 8 * 1024;
+  autocomp::net::SessionScheduler::Flow * flowPointer = nullptr;
+
+  threadPool.init();
+  scheduler.init();
+
+  auto flow = scheduler.addFlow([&] ()
+                                {
+                                  scheduler.charge(*flowPointer, chunkSize);
+                                  return not done;
+                                },
+                                1, maxRate);
+  flowPointer = flow.get();
+
+  auto start = std::chrono::steady_clock::now();
+  scheduler.schedule(flow);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  done = true;
+  double elapsedTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+
+  scheduler.shutdown();
+  threadPool.shutdown();
+
+  autocomp::net::FlowStats stats = scheduler.getFlowStats(*flow);
+  double burst = maxRate * autocomp::constants::RATE_CAP_BURST / 1000;
+
+  ASSERT_GE(maxRate * elapsedTime + burst + 2 * chunkSize, stats.bytes);
+  ASSERT_LE(maxRate * elapsedTime / 2, stats.bytes);
+  ASSERT_LT(0, stats.throttledTime);
+}
+
+TEST(SessionSchedulerTest, RunsAFlowOnceAtATime)
+{
+  autocomp::ThreadPool threadPool(4);
+  autocomp::net::SessionScheduler scheduler(threadPool);
+  std::atomic<bool> running(false);
+  std::atomic<int> overlaps(0);
+  std::atomic<int> slices(0);
+
+  threadPool.init();
+  scheduler.init();
+
+  auto flow = scheduler.addFlow([&] ()
+                                {
+                                  if (running.exchange(true)) {
+                                    overlaps++;
+                                  }
+
+                                  std::this_thread::sleep_for(
+                                    std::chrono::microseconds(200));
+                                  slices++;
+                                  running = false;
+
+                                  return false;
+                                });
+
+  std::vector<std::thread> schedulers;
+
+  for (int i = 0; i < 4; i++) {
+    schedulers.emplace_back([&scheduler, &flow] ()
+                            {
+                              for (int j = 0; j < 200; j++) {
+                                scheduler.schedule(flow);
+                              }
+                            });
+  }
+
+  for (std::thread & thread : schedulers) {
+    thread.join();
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  scheduler.shutdown();
+  threadPool.shutdown();
+
+  ASSERT_EQ(0, overlaps);
+  ASSERT_LT(0, slices);
+  ASSERT_GE(800, slices);
+  ASSERT_EQ(slices, scheduler.getFlowStats(*flow).nSlices);
+}
+
+TEST(SessionSchedulerTest, KeepsLightFlowsResponsive)
+{
+  autocomp::ThreadPool threadPool(1);
+  autocomp::net::SessionScheduler scheduler(threadPool);
+  std::atomic<bool> done(false);
+
+  threadPool.init();
+  scheduler.init();
+
+  auto heavyFlow = scheduler.addFlow([&done] ()
+                                     {
+                                       spin(autocomp::constants::
+                                              SCHEDULER_QUANTUM);
+                                       return not done;
+                                     });
+  auto lightFlow = scheduler.addFlow([] () { return false; });
+
+  scheduler.schedule(heavyFlow);
+
+  for (int i = 0; i < 20; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler.schedule(lightFlow);
+  }
+
+  done = true;
+
+  scheduler.shutdown();
+  threadPool.shutdown();
+
+  autocomp::net::FlowStats stats = scheduler.getFlowStats(*lightFlow);
+
+  ASSERT_LT(0, stats.nSlices);
+  ASSERT_GT(4 * autocomp::constants::SCHEDULER_QUANTUM,
+            stats.meanQueueingDelay);
+}
+
+TEST(SessionSchedulerTest, IdlesFlowsWhoseSliceThrows)
+{
+  autocomp::ThreadPool threadPool(1);
+  autocomp::net::SessionScheduler scheduler(threadPool);
+  std::atomic<int> slices(0);
+
+  threadPool.init();
+  scheduler.init();
+
+  auto flow = scheduler.addFlow([&slices] () -> bool
+                                {
+                                  slices++;
+                                  throw std::runtime_error("Slice failed");
+                                });
+
+  // Not run again until it is scheduled, though the slice did not finish
+  scheduler.schedule(flow);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(1, slices);
+
+  scheduler.schedule(flow);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  scheduler.shutdown();
+  threadPool.shutdown();
+
+  ASSERT_EQ(2, slices);
+  ASSERT_EQ(2, scheduler.getFlowStats(*flow).nSlices);
+}
+
+#endif //AC_SESSION_SCHEDULER_TEST_HPP
@@ -0,0 +1,86 @@
+#ifndef AC_SHARED_SERVER_STATE_TEST_HPP
+#define AC_SHARED_SERVER_STATE_TEST_HPP
+
+/* C++ System Headers */
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/constants.hpp"
+#include "network/server/shared_server_state.hpp"
+
+namespace
+{
+  autocomp::net::ShardStats makeShardStats(const std::size_t & value)
+  {
+    autocomp::net::ShardStats stats = {};
+    stats.cpuLoad = value / 10.0;
+    stats.bandwidth = value;
+    stats.acceptedConnections = value;
+    stats.activeSessions = value;
+    stats.admittedSessions = value;
+
+    return stats;
+  }
+}
+
+TEST(SharedServerStateTest, AggregatesTheRunningShards)
+{
+  autocomp::net::SharedServerState sharedState(3);
+
+  sharedState.publish(0, 100, makeShardStats(1));
+  sharedState.publish(1, 101, makeShardStats(2));
+
+  autocomp::net::ShardStats aggregate = sharedState.getAggregate();
+  ASSERT_EQ(2, aggregate.nShards);
+  ASSERT_FLOAT_EQ(0.2, aggregate.cpuLoad);
+  ASSERT_FLOAT_EQ(3, aggregate.bandwidth);
+  ASSERT_EQ(3, aggregate.acceptedConnections);
+  ASSERT_EQ(3, aggregate.activeSessions);
+
+  // A stopped shard still counts what it did, but not its load
+  sharedState.publish(1, 0, makeShardStats(2));
+
+  aggregate = sharedState.getAggregate();
+  ASSERT_EQ(1, aggregate.nShards);
+  ASSERT_FLOAT_EQ(1, aggregate.bandwidth);
+  ASSERT_EQ(1, aggregate.activeSessions);
+  ASSERT_EQ(3, aggregate.acceptedConnections);
+  ASSERT_EQ(3, aggregate.admittedSessions);
+}
+
+TEST(SharedServerStateTest, IsSharedWithForkedProcesses)
+{
+  autocomp::net::SharedServerState sharedState(2);
+
+  pid_t pid = ::fork();
+  ASSERT_NE(-1, pid);
+
+  if (pid == 0) {
+    sharedState.publish(1, ::getpid(), makeShardStats(5));
+    std::_Exit(EXIT_SUCCESS);
+  }
+
+  int status;
+  ASSERT_EQ(pid, ::waitpid(pid, &status, 0));
+
+  autocomp::net::ShardStats stats = sharedState.getShardStats(1);
+  ASSERT_EQ(1, stats.nShards);
+  ASSERT_EQ(5, stats.acceptedConnections);
+  ASSERT_EQ(0, sharedState.getShardStats(0).nShards);
+}
+
+TEST(SharedServerStateTest, ThrowsOnTooManyShards)
+{
+  ASSERT_THROW(
+      autocomp::net::SharedServerState(autocomp::constants::MAX_SHARDS + 1),
+      std::domain_error
+    );
+}
+
+#endif // AC_SHARED_SERVER_STATE_TEST_HPP
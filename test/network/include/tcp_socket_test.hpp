@@ -3,6 +3,7 @@
 
 /* C++ System Headers */
 #include <string>
+#include <algorithm>
 #include <cstddef>
 #include <stdexcept>
 #include <thread>
@@ -16,6 +17,8 @@
 /* Project headers */
 #include "test_constants.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/buffer.hpp"
+#include "utils/buffer_pool.hpp"
 #include "network/socket/tcp_socket.hpp"
 
 class TCPSocketTest : public ::testing::Test
@@ -25,6 +28,7 @@ protected:
   const std::string pingMessage = "PING";
   const std::string pongMessage = "PONG";
   const int nMessages = 20;
+  const std::size_t zeroCopyMessageSize = 256 * 1024;
 
 public:
 
@@ -72,6 +76,137 @@ public:
       ASSERT_EQ(this->pongMessage, message);
     }
   }
+
+  void serveZeroCopy()
+  {
+    autocomp::net::TCPSocket socket(autocomp::test::constants::testPortSix);
+
+    try {
+      socket.bind();
+    }
+    catch(autocomp::exceptions::NetworkError & error) {
+      std::cout << "Could not bind to the socket, try later" << std::endl;
+      exit(0);
+    }
+
+    ASSERT_NO_THROW(socket.listen());
+
+    std::shared_ptr<autocomp::net::TCPSocket> clientSocket;
+    ASSERT_NO_THROW(clientSocket = socket.accept());
+
+    auto pool =
+      std::make_shared<autocomp::BufferPool>(this->zeroCopyMessageSize);
+
+    try {
+      clientSocket->enableZeroCopy(this->zeroCopyMessageSize / 2);
+    }
+    catch (autocomp::exceptions::NetworkError & error) {
+      std::cout << "Zero copy is not supported, using regular sends"
+                << std::endl;
+    }
+
+    for (int i = 0; i < this->nMessages; i++) {
+      autocomp::Buffer message = pool->acquire();
+      message.setSize(this->zeroCopyMessageSize);
+      std::fill_n(message.getData(), message.getSize(), 'A' + i);
+
+      ASSERT_EQ(this->zeroCopyMessageSize,
+                clientSocket->send(std::move(message), pool));
+    }
+
+    ASSERT_NO_THROW(clientSocket->flushZeroCopy());
+    ASSERT_EQ(0, clientSocket->getPendingZeroCopyBuffers());
+    ASSERT_LT(0, pool->getIdleBuffers());
+  }
+
+  void requestZeroCopy()
+  {
+    autocomp::net::TCPSocket socket;
+
+    ASSERT_NO_THROW({
+      socket.connect("localhost", autocomp::test::constants::testPortSix);
+    });
+
+    autocomp::Buffer message(this->zeroCopyMessageSize);
+
+    for (int i = 0; i < this->nMessages; i++) {
+      ASSERT_EQ(this->zeroCopyMessageSize, socket.receive(message));
+      ASSERT_EQ(std::string(this->zeroCopyMessageSize, 'A' + i),
+                std::string(message.getData(), message.getSize()));
+    }
+  }
+
+  void serveFrames()
+  {
+    autocomp::net::TCPSocket socket(autocomp::test::constants::testPortSeven);
+
+    try {
+      socket.bind();
+    }
+    catch(autocomp::exceptions::NetworkError & error) {
+      std::cout << "Could not bind to the socket, try later" << std::endl;
+      exit(0);
+    }
+
+    ASSERT_NO_THROW(socket.listen());
+
+    std::shared_ptr<autocomp::net::TCPSocket> clientSocket;
+    ASSERT_NO_THROW(clientSocket = socket.accept());
+    ASSERT_NO_THROW(clientSocket->setCork(true));
+
+    for (int i = 0; i < this->nMessages; i++) {
+      autocomp::Buffer header(this->pingMessage.size());
+      header.setData(this->pingMessage.data(), this->pingMessage.size());
+
+      // Payloads both smaller and larger than the read ahead buffer
+      std::size_t payloadSize = (i % 2) ? 100 : this->zeroCopyMessageSize;
+      autocomp::Buffer payload(payloadSize);
+      payload.setSize(payloadSize);
+      std::fill_n(payload.getData(), payloadSize, 'A' + i);
+
+      ASSERT_EQ(this->pingMessage.size() + payloadSize,
+                clientSocket->sendFrame(
+                    autocomp::net::Frame(std::move(header), std::move(payload))
+                  ));
+    }
+
+    autocomp::Buffer lastHeader(this->pongMessage.size());
+    lastHeader.setData(this->pongMessage.data(), this->pongMessage.size());
+
+    ASSERT_EQ(this->pongMessage.size(),
+              clientSocket->sendFrame(
+                  autocomp::net::Frame(std::move(lastHeader))
+                ));
+    ASSERT_NO_THROW(clientSocket->setCork(false));
+  }
+
+  void requestFrames()
+  {
+    autocomp::net::TCPSocket socket;
+
+    ASSERT_NO_THROW({
+      socket.connect("localhost", autocomp::test::constants::testPortSeven);
+    });
+
+    socket.enableReadAhead(64 * 1024);
+
+    std::string header;
+    autocomp::Buffer payload;
+
+    for (int i = 0; i < this->nMessages; i++) {
+      std::size_t payloadSize = (i % 2) ? 100 : this->zeroCopyMessageSize;
+
+      socket.receive(header);
+      ASSERT_EQ(this->pingMessage, header);
+
+      ASSERT_EQ(payloadSize, socket.receive(payload));
+      ASSERT_EQ(std::string(payloadSize, 'A' + i),
+                std::string(payload.getData(), payload.getSize()));
+    }
+
+    socket.receive(header);
+    ASSERT_EQ(this->pongMessage, header);
+  }
 }; // class TCPSocketTest
 
 TEST_F(TCPSocketTest, ThrowsOnBusyPort)
@@ -90,6 +225,53 @@ TEST_F(TCPSocketTest, ThrowsOnBusyPort)
   ASSERT_THROW(secondSocket.bind(), autocomp::exceptions::NetworkError);
 }
 
+TEST_F(TCPSocketTest, SharesPortWithReusePort)
+{
+  autocomp::net::TCPSocket socket(autocomp::test::constants::testPortOne);
+  autocomp::net::TCPSocket secondSocket(autocomp::test::constants::testPortOne);
+
+  socket.setReusePort(true);
+  secondSocket.setReusePort(true);
+
+  ASSERT_NO_THROW({
+    socket.bind();
+    socket.listen();
+    secondSocket.bind();
+    secondSocket.listen();
+  });
+
+  autocomp::net::TCPSocket client;
+  client.connect("localhost", autocomp::test::constants::testPortOne);
+}
+
+TEST_F(TCPSocketTest, ReadsConnectionInfo)
+{
+  autocomp::net::TCPSocket socket(autocomp::test::constants::testPortOne);
+
+  ASSERT_NO_THROW({
+    socket.setReuseAddress(true);
+    socket.bind();
+    socket.listen();
+  });
+
+  autocomp::net::TCPSocket client;
+  client.connect("localhost", autocomp::test::constants::testPortOne);
+
+  std::shared_ptr<autocomp::net::TCPSocket> serverSide = socket.accept();
+  serverSide->send(std::string(64 * 1024, 'a'));
+
+  std::string message;
+  client.receive(message);
+
+  autocomp::ConnectionInfo connectionInfo;
+  ASSERT_NO_THROW(serverSide->getConnectionInfo(connectionInfo));
+
+  ASSERT_GT(connectionInfo.maxSegmentSize, 0);
+  ASSERT_GT(connectionInfo.congestionWindow, 0);
+  ASSERT_GE(connectionInfo.roundTripTime, 0);
+  ASSERT_GE(connectionInfo.deliveryRate, 0);
+}
+
 TEST_F(TCPSocketTest, PingPong)
 {
   std::thread server(&TCPSocketTest::serve, this);
@@ -100,4 +282,24 @@ TEST_F(TCPSocketTest, PingPong)
   server.join();
 }
 
+TEST_F(TCPSocketTest, SendsPooledBuffersWithZeroCopy)
+{
+  std::thread server(&TCPSocketTest::serveZeroCopy, this);
+  usleep(500000);
+  std::thread client(&TCPSocketTest::requestZeroCopy, this);
+
+  client.join();
+  server.join();
+}
+
+TEST_F(TCPSocketTest, SendsFramesReadableAsMessages)
+{
+  std::thread server(&TCPSocketTest::serveFrames, this);
+  usleep(500000);
+  std::thread client(&TCPSocketTest::requestFrames, this);
+
+  client.join();
+  server.join();
+}
+
 #endif //AC_TCP_SOCKET_TEST_HPP
\ No newline at end of file
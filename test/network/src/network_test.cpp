@@ -1,6 +1,11 @@
 #include "gtest/gtest.h"
 
 #include "tcp_socket_test.hpp"
+#include "chunk_frame_header_test.hpp"
+#include "admission_controller_test.hpp"
+#include "reactor_test.hpp"
+#include "shared_server_state_test.hpp"
+#include "session_scheduler_test.hpp"
 //#include "server_test.hpp"
 #include "client_server_test.hpp"
 
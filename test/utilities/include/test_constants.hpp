@@ -27,11 +27,23 @@ namespace autocomp
 
       const unsigned short testPortFive = 25115;
 
+      const unsigned short testPortSix = 25116;
+
+      const unsigned short testPortSeven = 25117;
+
+      const unsigned short testPortEight = 25118;
+
       const std::string invalidDecisionTreeFile("test/utils_test/include/"
                                                 "decision_tree_classifier_invalid.txt");
 
       const std::string validDecisionTreeFile("test/utils_test/include/"
                                               "decision_tree_classifier.txt");
+
+      const std::string validEnsembleFile("test/utils_test/include/"
+                                          "ensemble_classifier.txt");
+
+      const std::string validBoostedTreesFile("test/utils_test/include/"
+                                              "boosted_classifier.txt");
     
     } // constants
   } // test
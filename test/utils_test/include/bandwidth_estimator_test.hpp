@@ -0,0 +1,80 @@
+#ifndef AC_BANDWIDTH_ESTIMATOR_TEST_HPP
+#define AC_BANDWIDTH_ESTIMATOR_TEST_HPP
+
+/* C++ System Headers */
+#include <chrono>
+#include <stdexcept>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/bandwidth_estimator.hpp"
+
+class BandwidthEstimatorTest : public ::testing::Test
+{
+protected:
+
+  autocomp::ConnectionInfo makeConnectionInfo(const double & deliveryRate)
+  {
+    autocomp::ConnectionInfo connectionInfo = {};
+    connectionInfo.deliveryRate = deliveryRate;
+    connectionInfo.roundTripTime = 2;
+    connectionInfo.congestionWindow = 10;
+    connectionInfo.maxSegmentSize = 1000;
+
+    return connectionInfo;
+  }
+}; // class BandwidthEstimatorTest
+
+
+TEST_F(BandwidthEstimatorTest, SmoothsTheDeliveryRate)
+{
+  autocomp::BandwidthEstimator estimator(0.5, std::chrono::milliseconds(0));
+
+  ASSERT_FLOAT_EQ(0, estimator.getBandwidth());
+
+  // The first sample is taken as is
+  estimator.addSample(this->makeConnectionInfo(100));
+  ASSERT_FLOAT_EQ(100, estimator.getBandwidth());
+  ASSERT_FLOAT_EQ(2, estimator.getRoundTripTime());
+
+  estimator.addSample(this->makeConnectionInfo(50));
+  ASSERT_FLOAT_EQ(75, estimator.getBandwidth());
+
+  estimator.reset();
+  ASSERT_FLOAT_EQ(0, estimator.getBandwidth());
+
+  estimator.addSample(this->makeConnectionInfo(10));
+  ASSERT_FLOAT_EQ(10, estimator.getBandwidth());
+}
+
+TEST_F(BandwidthEstimatorTest, FallsBackOnTheCongestionWindow)
+{
+  autocomp::BandwidthEstimator estimator;
+
+  // 10 segments of 1000 bytes every 2 ms: 40 Mbps
+  estimator.addSample(this->makeConnectionInfo(0));
+  ASSERT_FLOAT_EQ(40, estimator.getBandwidth());
+}
+
+TEST_F(BandwidthEstimatorTest, SamplesAtMostOncePerInterval)
+{
+  autocomp::BandwidthEstimator estimator(0.5, std::chrono::milliseconds(20));
+  auto now = autocomp::BandwidthEstimator::Clock::now();
+
+  ASSERT_TRUE(estimator.isSamplingDue(now));
+
+  estimator.addSample(this->makeConnectionInfo(100), now);
+
+  ASSERT_FALSE(estimator.isSamplingDue(now + std::chrono::milliseconds(10)));
+  ASSERT_TRUE(estimator.isSamplingDue(now + std::chrono::milliseconds(20)));
+}
+
+TEST_F(BandwidthEstimatorTest, ThrowsOnInvalidSmoothingFactor)
+{
+  ASSERT_THROW(autocomp::BandwidthEstimator(0), std::domain_error);
+  ASSERT_THROW(autocomp::BandwidthEstimator(1.5), std::domain_error);
+}
+
+#endif // AC_BANDWIDTH_ESTIMATOR_TEST_HPP
@@ -0,0 +1,170 @@
+#ifndef AC_BOUNDED_QUEUE_TEST_HPP
+#define AC_BOUNDED_QUEUE_TEST_HPP
+
+/* C++ System Headers */
+#include <cstddef>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/bounded_queue.hpp"
+
+class BoundedQueueTest : public ::testing::Test
+{
+protected:
+
+  /**
+   * Queue entry of a given size
+   */
+  struct Entry
+  {
+    std::size_t size;
+
+    Entry(const std::size_t & size = 0)
+      : size(size)
+    {}
+
+    std::size_t getSize() const
+    {
+      return this->size;
+    }
+  };
+
+  const std::size_t maxBytes = 100;
+  const std::size_t maxEntries = 4;
+}; // class BoundedQueueTest
+
+
+TEST_F(BoundedQueueTest, ReportsItsLoad)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+
+  ASSERT_FLOAT_EQ(0, queue.getLoad());
+
+  ASSERT_TRUE(queue.push(Entry(50)));
+  ASSERT_EQ(1, queue.getSize());
+  ASSERT_EQ(50, queue.getBytes());
+  ASSERT_FLOAT_EQ(0.5, queue.getLoad());
+
+  ASSERT_TRUE(queue.push(Entry(1)));
+  ASSERT_TRUE(queue.push(Entry(1)));
+  ASSERT_FLOAT_EQ(0.75, queue.getLoad());
+
+  Entry entry;
+  ASSERT_TRUE(queue.pop(entry));
+  ASSERT_EQ(50, entry.getSize());
+  ASSERT_EQ(2, queue.getBytes());
+  ASSERT_FLOAT_EQ(0.5, queue.getLoad());
+}
+
+TEST_F(BoundedQueueTest, BlocksProducersWhileFull)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+  std::atomic<bool> pushed(false);
+
+  ASSERT_TRUE(queue.push(Entry(60)));
+
+  std::thread producer([&queue, &pushed] ()
+                       {
+                         queue.push(Entry(60));
+                         pushed = true;
+                       });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(pushed);
+
+  Entry entry;
+  ASSERT_TRUE(queue.waitPop(entry));
+  producer.join();
+
+  ASSERT_TRUE(pushed);
+  ASSERT_EQ(1, queue.getSize());
+}
+
+TEST_F(BoundedQueueTest, AcceptsOversizedEntriesWhenEmpty)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+
+  ASSERT_TRUE(queue.push(Entry(2 * this->maxBytes)));
+  ASSERT_FLOAT_EQ(1, queue.getLoad());
+}
+
+TEST_F(BoundedQueueTest, TryPushFailsWithoutWaitingWhenFull)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+
+  ASSERT_TRUE(queue.tryPush(Entry(2 * this->maxBytes)));
+  ASSERT_FALSE(queue.tryPush(Entry(1)));
+
+  Entry entry;
+  ASSERT_TRUE(queue.pop(entry));
+  ASSERT_TRUE(queue.tryPush(Entry(1)));
+
+  queue.close();
+  ASSERT_FALSE(queue.tryPush(Entry(1)));
+  ASSERT_EQ(1, queue.getSize());
+}
+
+TEST_F(BoundedQueueTest, ClosingReleasesProducersAndConsumers)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+  std::vector<std::thread> threads;
+  std::atomic<int> rejected(0);
+
+  ASSERT_TRUE(queue.push(Entry(this->maxBytes)));
+
+  for (int i = 0; i < 2; i++) {
+    threads.emplace_back([&queue, &rejected] ()
+                         {
+                           if (not queue.push(Entry(1))) {
+                             rejected++;
+                           }
+                         });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.close();
+
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(2, rejected);
+
+  // The remaining entries are still handed out, then the queue is exhausted
+  Entry entry;
+  ASSERT_TRUE(queue.waitPop(entry));
+  ASSERT_FALSE(queue.waitPop(entry));
+}
+
+TEST_F(BoundedQueueTest, DeliversEveryEntry)
+{
+  autocomp::BoundedQueue<Entry> queue(this->maxBytes, this->maxEntries);
+  const int nEntries = 1000;
+  std::size_t receivedBytes = 0;
+
+  std::thread consumer([&queue, &receivedBytes] ()
+                       {
+                         Entry entry;
+
+                         while (queue.waitPop(entry)) {
+                           receivedBytes += entry.getSize();
+                         }
+                       });
+
+  for (int i = 0; i < nEntries; i++) {
+    ASSERT_TRUE(queue.push(Entry(i % 10)));
+  }
+
+  queue.close();
+  consumer.join();
+
+  ASSERT_EQ(nEntries / 10 * 45, receivedBytes);
+}
+
+#endif // AC_BOUNDED_QUEUE_TEST_HPP
@@ -0,0 +1,107 @@
+#ifndef AC_BUFFER_POOL_TEST_HPP
+#define AC_BUFFER_POOL_TEST_HPP
+
+/* C++ System Headers */
+#include <cstddef>
+#include <utility>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/buffer.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/memory_governor.hpp"
+
+class BufferPoolTest : public ::testing::Test
+{
+protected:
+
+  const std::size_t bufferCapacity = 1024;
+  const std::size_t maxIdleBuffers = 2;
+}; // class BufferPoolTest
+
+
+TEST_F(BufferPoolTest, AcquiresEmptyBuffersWithEnoughCapacity)
+{
+  autocomp::BufferPool pool(this->bufferCapacity, this->maxIdleBuffers);
+
+  autocomp::Buffer buffer = pool.acquire();
+
+  ASSERT_GE(buffer.getCapacity(), this->bufferCapacity);
+  ASSERT_EQ(0, buffer.getSize());
+  ASSERT_EQ(0, pool.getIdleBuffers());
+}
+
+TEST_F(BufferPoolTest, ReusesReleasedBuffers)
+{
+  autocomp::BufferPool pool(this->bufferCapacity, this->maxIdleBuffers);
+
+  autocomp::Buffer buffer = pool.acquire();
+  buffer.setSize(this->bufferCapacity / 2);
+  const char * data = buffer.getData();
+
+  pool.release(std::move(buffer));
+  ASSERT_EQ(1, pool.getIdleBuffers());
+
+  autocomp::Buffer reusedBuffer = pool.acquire();
+
+  ASSERT_EQ(data, reusedBuffer.getData());
+  ASSERT_EQ(0, reusedBuffer.getSize());
+  ASSERT_EQ(0, pool.getIdleBuffers());
+}
+
+TEST_F(BufferPoolTest, DropsSmallBuffers)
+{
+  autocomp::BufferPool pool(this->bufferCapacity, this->maxIdleBuffers);
+
+  pool.release(autocomp::Buffer(this->bufferCapacity / 2));
+
+  ASSERT_EQ(0, pool.getIdleBuffers());
+}
+
+TEST_F(BufferPoolTest, KeepsAtMostMaxIdleBuffers)
+{
+  autocomp::BufferPool pool(this->bufferCapacity, this->maxIdleBuffers);
+
+  for (std::size_t i = 0; i < this->maxIdleBuffers + 2; i++) {
+    pool.release(autocomp::Buffer(this->bufferCapacity));
+  }
+
+  ASSERT_EQ(this->maxIdleBuffers, pool.getIdleBuffers());
+}
+
+TEST_F(BufferPoolTest, ChargesIdleBuffersToTheMemoryGovernor)
+{
+  autocomp::MemoryGovernor memoryGovernor(3 * this->bufferCapacity / 2);
+
+  {
+    autocomp::BufferPool pool(this->bufferCapacity, this->maxIdleBuffers);
+    pool.setMemoryGovernor(&memoryGovernor);
+
+    // Only one idle buffer fits in the budget
+    pool.release(autocomp::Buffer(this->bufferCapacity));
+    pool.release(autocomp::Buffer(this->bufferCapacity));
+
+    ASSERT_EQ(1, pool.getIdleBuffers());
+    ASSERT_EQ(this->bufferCapacity, memoryGovernor.getStats().usedBytes);
+
+    // Its holder accounts for an acquired buffer
+    autocomp::Buffer buffer = pool.acquire();
+
+    ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+
+    pool.release(std::move(buffer));
+    pool.trim();
+
+    ASSERT_EQ(0, pool.getIdleBuffers());
+    ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+
+    pool.release(autocomp::Buffer(this->bufferCapacity));
+  }
+
+  // The charge goes away with the pool
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+}
+
+#endif // AC_BUFFER_POOL_TEST_HPP
@@ -0,0 +1,205 @@
+#ifndef AC_BYTE_HISTOGRAM_TEST_HPP
+#define AC_BYTE_HISTOGRAM_TEST_HPP
+
+/* C++ System Headers */
+#include <array>
+#include <cmath>
+#include <string>
+#include <random>
+#include <vector>
+#include <cstddef>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/byte_histogram.hpp"
+
+namespace
+{
+  // Byte by byte, as bytecounting used to count
+  std::array<std::size_t, 256> countBytesOneByOne(const std::string & data)
+  {
+    std::array<std::size_t, 256> counts{};
+
+    for (const char & byte : data) {
+      counts[static_cast<unsigned char>(byte)]++;
+    }
+
+    return counts;
+  }
+
+  std::size_t countRuns(const std::string & data)
+  {
+    std::size_t nRuns = data.empty() ? 0 : 1;
+
+    for (std::size_t i = 1; i < data.size(); i++) {
+      nRuns += data[i] != data[i - 1];
+    }
+
+    return nRuns;
+  }
+
+  // Random bytes of a small alphabet, in runs of random length
+  std::string makeRunsOfBytes(const std::size_t & size)
+  {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> bytes(0, 7);
+    std::uniform_int_distribution<int> runLengths(1, 40);
+    std::string data;
+
+    while (data.size() < size) {
+      data.append(runLengths(generator), bytes(generator) * 37);
+    }
+
+    data.resize(size);
+
+    return data;
+  }
+}
+
+TEST(ByteHistogramTest, CountsAsOneByOne)
+{
+  // Sizes around the SIMD blocks and the groups of the lanes
+  for (std::size_t size : {0, 1, 2, 3, 5, 15, 16, 17, 31, 32, 33, 64, 65,
+                           1000, 65536}) {
+    std::string data = makeRunsOfBytes(size);
+    std::array<std::size_t, 256> expectedCounts = countBytesOneByOne(data);
+    autocomp::ByteHistogram histogram;
+
+    histogram.update(data.data(), data.size());
+
+    ASSERT_EQ(size, histogram.getSize());
+
+    for (int byte = 0; byte < 256; byte++) {
+      ASSERT_EQ(expectedCounts[byte], histogram.getCount(byte))
+        << "byte " << byte << " of " << size;
+    }
+
+    autocomp::ByteFeatures features = histogram.getFeatures();
+
+    if (size > 0) {
+      ASSERT_DOUBLE_EQ(size / static_cast<double>(countRuns(data)),
+                       features.meanRunLength) << "size " << size;
+      ASSERT_DOUBLE_EQ(expectedCounts[0] / static_cast<double>(size),
+                       features.zeroRatio);
+    }
+  }
+}
+
+TEST(ByteHistogramTest, GetsTheFeaturesOfKnownData)
+{
+  autocomp::ByteHistogram histogram;
+
+  // A quarter of zeros, then three quarters of four other bytes
+  histogram.update(std::string(256, '\0').data(), 256);
+  histogram.update(std::string(256, 'a').data(), 256);
+  histogram.update(std::string(256, 'b').data(), 256);
+  histogram.update(std::string(256, 'c').data(), 256);
+
+  autocomp::ByteFeatures features = histogram.getFeatures();
+
+  ASSERT_EQ(4, features.bytecount);
+  ASSERT_DOUBLE_EQ(2, features.entropy);
+  ASSERT_DOUBLE_EQ(0.25, features.zeroRatio);
+  ASSERT_DOUBLE_EQ(256, features.meanRunLength);
+
+  // Every byte as often
+  std::string allBytes;
+
+  for (int byte = 0; byte < 256; byte++) {
+    allBytes.push_back(byte);
+  }
+
+  histogram.clear();
+  histogram.update(allBytes.data(), allBytes.size());
+  features = histogram.getFeatures();
+
+  ASSERT_EQ(256, features.bytecount);
+  ASSERT_DOUBLE_EQ(8, features.entropy);
+  ASSERT_DOUBLE_EQ(1, features.meanRunLength);
+}
+
+TEST(ByteHistogramTest, CountsDataAddedInPiecesAsAWhole)
+{
+  std::string data = makeRunsOfBytes(10000);
+  autocomp::ByteHistogram wholeHistogram, piecewiseHistogram;
+
+  wholeHistogram.update(data.data(), data.size());
+
+  // Pieces that split runs
+  for (std::size_t offset = 0; offset < data.size(); offset += 333) {
+    piecewiseHistogram.update(data.data() + offset,
+                              std::min<std::size_t>(333,
+                                                    data.size() - offset));
+  }
+
+  autocomp::ByteFeatures wholeFeatures = wholeHistogram.getFeatures();
+  autocomp::ByteFeatures piecewiseFeatures = piecewiseHistogram.getFeatures();
+
+  ASSERT_EQ(wholeFeatures.bytecount, piecewiseFeatures.bytecount);
+  ASSERT_DOUBLE_EQ(wholeFeatures.entropy, piecewiseFeatures.entropy);
+  ASSERT_DOUBLE_EQ(wholeFeatures.zeroRatio, piecewiseFeatures.zeroRatio);
+  ASSERT_DOUBLE_EQ(wholeFeatures.meanRunLength,
+                   piecewiseFeatures.meanRunLength);
+}
+
+TEST(ByteHistogramTest, CountsAsNewOnceCleared)
+{
+  std::string data = makeRunsOfBytes(10000);
+  autocomp::ByteHistogram newHistogram, reusedHistogram;
+
+  newHistogram.update(data.data(), data.size());
+
+  // Cleared twice in a row too, and with every byte counted before
+  reusedHistogram.update(std::string(256 * 40, 'z').data(), 256 * 40);
+  reusedHistogram.clear();
+  reusedHistogram.clear();
+
+  for (int byte = 0; byte < 256; byte++) {
+    char value = byte;
+    reusedHistogram.update(&value, 1);
+  }
+
+  reusedHistogram.clear();
+  reusedHistogram.update(data.data(), data.size());
+
+  ASSERT_EQ(data.size(), reusedHistogram.getSize());
+
+  for (int byte = 0; byte < 256; byte++) {
+    ASSERT_EQ(newHistogram.getCount(byte), reusedHistogram.getCount(byte));
+  }
+
+  autocomp::ByteFeatures newFeatures = newHistogram.getFeatures();
+  autocomp::ByteFeatures reusedFeatures = reusedHistogram.getFeatures();
+
+  ASSERT_EQ(newFeatures.bytecount, reusedFeatures.bytecount);
+  ASSERT_DOUBLE_EQ(newFeatures.entropy, reusedFeatures.entropy);
+  ASSERT_DOUBLE_EQ(newFeatures.meanRunLength, reusedFeatures.meanRunLength);
+}
+
+TEST(ByteHistogramTest, SamplesTheSubchunksOfAChunk)
+{
+  std::string data(100000, 'a');
+
+  // Each subchunk of 10000 bytes has a different number of distinct bytes
+  for (int i = 0; i < 10000; i++) {
+    data[10000 + i] = i % 2;
+    data[45000 + i] = i % 4;
+    data[80000 + i] = i % 8;
+  }
+
+  autocomp::ByteFeatures features =
+    autocomp::ByteHistogram::getSampledFeatures(data.data(), data.size());
+
+  ASSERT_EQ(std::round((2 + 4 + 8) / 3.0), features.bytecount);
+  ASSERT_DOUBLE_EQ((1 + 2 + 3) / 3.0, features.entropy);
+
+  // Too small to sample
+  features = autocomp::ByteHistogram::getSampledFeatures("aaab", 4);
+
+  ASSERT_NEAR(0.811, features.entropy, 0.001);
+  ASSERT_DOUBLE_EQ(2, features.meanRunLength);
+}
+
+#endif // AC_BYTE_HISTOGRAM_TEST_HPP
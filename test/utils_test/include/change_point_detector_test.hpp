@@ -0,0 +1,67 @@
+#ifndef AC_CHANGE_POINT_DETECTOR_TEST_HPP
+#define AC_CHANGE_POINT_DETECTOR_TEST_HPP
+
+/* C++ System Headers */
+#include <random>
+#include <stdexcept>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/change_point_detector.hpp"
+
+TEST(ChangePointDetectorTest, ThrowsOnInvalidArguments)
+{
+  ASSERT_THROW(autocomp::ChangePointDetector(-0.1, 1), std::domain_error);
+  ASSERT_THROW(autocomp::ChangePointDetector(0.1, 0), std::domain_error);
+  ASSERT_NO_THROW(autocomp::ChangePointDetector(0, 1));
+}
+
+TEST(ChangePointDetectorTest, IgnoresNoiseWithinTheDrift)
+{
+  autocomp::ChangePointDetector detector(0.25, 2);
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> noise(-0.2, 0.2);
+
+  for (int i = 0; i < 10000; i++) {
+    ASSERT_FALSE(detector.update(4.5 + noise(generator))) << i;
+  }
+
+  ASSERT_NEAR(4.5, detector.getReference(), 0.01);
+}
+
+TEST(ChangePointDetectorTest, DetectsShiftsOfTheMean)
+{
+  autocomp::ChangePointDetector detector(0.25, 2);
+
+  for (int i = 0; i < 20; i++) {
+    ASSERT_FALSE(detector.update(4.5));
+  }
+
+  // A sharp shift up is detected at once
+  ASSERT_TRUE(detector.update(8));
+
+  // A small one down, after a few observations
+  detector.reset();
+
+  for (int i = 0; i < 20; i++) {
+    ASSERT_FALSE(detector.update(4.5));
+  }
+
+  int nObservations = 0;
+
+  while (not detector.update(3.8)) {
+    ASSERT_LT(++nObservations, 10);
+  }
+
+  ASSERT_GT(nObservations, 1);
+
+  // The first observation after a reset is the new reference
+  detector.reset();
+
+  ASSERT_FALSE(detector.update(3.8));
+  ASSERT_DOUBLE_EQ(3.8, detector.getReference());
+}
+
+#endif // AC_CHANGE_POINT_DETECTOR_TEST_HPP
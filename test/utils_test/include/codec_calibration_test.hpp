@@ -0,0 +1,86 @@
+#ifndef AC_CODEC_CALIBRATION_TEST_HPP
+#define AC_CODEC_CALIBRATION_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <sstream>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/codec_calibration.hpp"
+#include "utils/data_structures.hpp"
+#include "utils/functions.hpp"
+
+TEST(CodecCalibrationTest, FollowsTheMeasuredRates)
+{
+  const autocomp::CodecCalibration::Codec zlib{autocomp::ZLIB, 6};
+  autocomp::CodecCalibration calibration(0.5);
+
+  ASSERT_FALSE(calibration.isCalibrated(zlib));
+  ASSERT_EQ(0, calibration.predict(zlib, 4).compressionRate);
+
+  // 1 MB in 80 ms, 100 Mbits/s, at a ratio of 4 on data of 4 bits per byte
+  calibration.record(zlib, {"zlib", 6, 80000, 1000000, 250000}, 4);
+
+  ASSERT_TRUE(calibration.isCalibrated(zlib));
+  ASSERT_DOUBLE_EQ(100, calibration.predict(zlib, 4).compressionRate);
+  ASSERT_DOUBLE_EQ(4, calibration.predict(zlib, 4).compressionRatio);
+
+  // Until other entropies are seen, they take the factor of the first chunk
+  // over the ratio of an entropy coder, 2
+  ASSERT_DOUBLE_EQ(8, calibration.predict(zlib, 2).compressionRatio);
+  ASSERT_NEAR(2, calibration.predict(zlib, 7.99).compressionRatio, 0.01);
+
+  // Twice as slow, halfway there with a smoothing factor of 0.5
+  calibration.record(zlib, {"zlib", 6, 160000, 1000000, 250000}, 4);
+
+  ASSERT_DOUBLE_EQ(75, calibration.predict(zlib, 4).compressionRate);
+
+  // A ratio of 3 on data of 2 bits per byte only changes that entropy
+  calibration.record(zlib, {"zlib", 6, 80000, 1000000, 333333}, 2.5);
+
+  ASSERT_NEAR(3, calibration.predict(zlib, 2.5).compressionRatio, 1e-3);
+  ASSERT_DOUBLE_EQ(4, calibration.predict(zlib, 4).compressionRatio);
+
+  std::ostringstream stream;
+  stream << calibration;
+
+  ASSERT_NE(std::string::npos, stream.str().find("ZLIB 6"));
+}
+
+TEST(CodecCalibrationTest, IgnoresEmptyChunks)
+{
+  const autocomp::CodecCalibration::Codec snappy{autocomp::SNAPPY, -1};
+  autocomp::CodecCalibration calibration;
+
+  calibration.record(snappy, {"snappy", -1, 10, 0, 0}, 4);
+
+  ASSERT_FALSE(calibration.isCalibrated(snappy));
+}
+
+TEST(CodecCalibrationTest, MeasuresTheEntropy)
+{
+  std::string constant(1024, 'a');
+  std::string twoSymbols(1024, 'a');
+
+  for (std::size_t i = 0; i < twoSymbols.size(); i += 2) {
+    twoSymbols[i] = 'b';
+  }
+
+  std::string allBytes;
+
+  for (int i = 0; i < 256 * 4; i++) {
+    allBytes.push_back(static_cast<char>(i));
+  }
+
+  ASSERT_DOUBLE_EQ(0, autocomp::shannonEntropy(constant.data(),
+                                               constant.size()));
+  ASSERT_DOUBLE_EQ(1, autocomp::shannonEntropy(twoSymbols.data(),
+                                               twoSymbols.size()));
+  ASSERT_DOUBLE_EQ(8, autocomp::shannonEntropy(allBytes.data(),
+                                               allBytes.size()));
+}
+
+#endif // AC_CODEC_CALIBRATION_TEST_HPP
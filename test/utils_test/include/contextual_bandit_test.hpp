@@ -0,0 +1,140 @@
+#ifndef AC_CONTEXTUAL_BANDIT_TEST_HPP
+#define AC_CONTEXTUAL_BANDIT_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <random>
+#include <fstream>
+#include <cstdio>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/contextual_bandit.hpp"
+#include "utils/decision_tree.hpp"
+#include "utils/exceptions.hpp"
+#include "test_constants.hpp"
+
+TEST(ContextualBanditTest, LearnsTheBestArmOfEachContext)
+{
+  const autocomp::ContextualBandit::Arm snappy{autocomp::SNAPPY, -1};
+  const autocomp::ContextualBandit::Arm zlib{autocomp::ZLIB, 6};
+  const autocomp::ContextualBandit::Context slowLink{{0, 1, 3}};
+  const autocomp::ContextualBandit::Context fastLink{{0, 40, 3}};
+
+  autocomp::ContextualBandit bandit({{autocomp::COPY, -1}, snappy, zlib});
+  std::mt19937 generator(42);
+
+  // Rewards as the chunks would give them: zlib is better on the slow link
+  // and snappy on the fast one
+  auto rewardOf = [&] (const autocomp::ContextualBandit::Context & context,
+                       const autocomp::ContextualBandit::Arm & arm)
+  {
+    if (arm.first == autocomp::COPY) {
+      return 1.0;
+    }
+
+    bool slow = context == slowLink;
+    return arm == zlib ? (slow ? 3.0 : 0.6) : (slow ? 2.0 : 1.5);
+  };
+
+  for (int i = 0; i < 300; i++) {
+    for (const auto & context : {slowLink, fastLink}) {
+      auto choice = bandit.choose(context, generator, true);
+      bandit.record(context, choice.arm, rewardOf(context, choice.arm));
+    }
+  }
+
+  ASSERT_EQ(zlib, bandit.choose(slowLink, generator, false).arm);
+  ASSERT_EQ(snappy, bandit.choose(fastLink, generator, false).arm);
+  ASSERT_NEAR(3.0, bandit.getMeanReward(slowLink, zlib), 0.01);
+
+  autocomp::BanditStats stats = bandit.getStats();
+  ASSERT_EQ(2, stats.nContexts);
+  ASSERT_EQ(602, stats.nChoices);
+  ASSERT_EQ(600, stats.nObservations);
+
+  // Once it knows, it seldom explores
+  ASSERT_GT(60, stats.nExplorations);
+}
+
+TEST(ContextualBanditTest, ExploresOnlyWhenAllowed)
+{
+  autocomp::ContextualBandit bandit;
+  std::mt19937 generator(42);
+  const autocomp::ContextualBandit::Context context{{5, 5, 5}};
+
+  for (int i = 0; i < 100; i++) {
+    auto choice = bandit.choose(context, generator, false);
+
+    ASSERT_FALSE(choice.exploratory);
+    ASSERT_EQ(bandit.getArms().front(), choice.arm);
+  }
+
+  ASSERT_EQ(0, bandit.getStats().nExplorations);
+}
+
+TEST(ContextualBanditTest, WarmStartsFromTheDecisionTree)
+{
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+  autocomp::ContextualBandit bandit;
+  std::mt19937 generator(42);
+
+  bandit.setWarmStartModel(&decisionTree);
+
+  for (int cpu = 0; cpu <= 10; cpu += 5) {
+    for (int bandwidth = 0; bandwidth <= 58; bandwidth += 7) {
+      for (int bytecount = 0; bytecount <= 10; bytecount += 2) {
+        autocomp::ContextualBandit::Context context{{cpu, bandwidth,
+                                                     bytecount}};
+
+        ASSERT_EQ(decisionTree.classify(context),
+                  bandit.choose(context, generator, false).arm);
+      }
+    }
+  }
+}
+
+TEST(ContextualBanditTest, SavesAndLoadsWhatItLearned)
+{
+  const std::string banditFile("contextual_bandit_test_model.txt");
+  const autocomp::ContextualBandit::Arm lzma{autocomp::LZMA, 1};
+  const autocomp::ContextualBandit::Context context{{2, 12, 4}};
+
+  autocomp::ContextualBandit bandit;
+
+  for (int i = 0; i < 10; i++) {
+    bandit.record(context, lzma, 4);
+  }
+
+  ASSERT_NO_THROW(bandit.save(banditFile));
+
+  // A bandit with fewer arms keeps those it has
+  autocomp::ContextualBandit loadedBandit({{autocomp::COPY, -1}, lzma});
+  std::mt19937 generator(42);
+
+  ASSERT_TRUE(loadedBandit.load(banditFile));
+  ASSERT_EQ(1, loadedBandit.getStats().nContexts);
+  ASSERT_NEAR(bandit.getMeanReward(context, lzma),
+              loadedBandit.getMeanReward(context, lzma), 1e-6);
+  ASSERT_EQ(lzma, loadedBandit.choose(context, generator, false).arm);
+
+  {
+    std::ofstream file(banditFile, std::ios::trunc);
+    file << "contextual_bandit\n2\n0 6\n";
+  }
+
+  ASSERT_THROW(loadedBandit.load(banditFile), autocomp::exceptions::IOError);
+  ASSERT_THROW(
+      loadedBandit.load(autocomp::test::constants::validDecisionTreeFile),
+      autocomp::exceptions::IOError
+    );
+  ASSERT_FALSE(loadedBandit.load("./file/not/supposed/to/exist.txt"));
+
+  std::remove(banditFile.c_str());
+}
+
+#endif // AC_CONTEXTUAL_BANDIT_TEST_HPP
@@ -0,0 +1,103 @@
+#ifndef AC_CPU_BUDGET_TEST_HPP
+#define AC_CPU_BUDGET_TEST_HPP
+
+/* C++ System Headers */
+#include <chrono>
+#include <thread>
+#include <utility>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/cpu_budget.hpp"
+
+TEST(CPUBudgetTest, AccountsTheDemandOfTheSessions)
+{
+  autocomp::CPUBudget cpuBudget(4);
+
+  {
+    autocomp::CPUBudget::Commitment busySession = cpuBudget.commit();
+    autocomp::CPUBudget::Commitment idleSession = cpuBudget.commit();
+
+    // A chunk takes as much CPU time as the time since the session started
+    busySession.record(std::chrono::hours(1));
+    ASSERT_DOUBLE_EQ(1, busySession.getCores());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    idleSession.record(std::chrono::nanoseconds(0));
+    ASSERT_DOUBLE_EQ(0, idleSession.getCores());
+
+    autocomp::CPUBudgetStats stats = cpuBudget.getStats();
+    ASSERT_EQ(4, stats.nCores);
+    ASSERT_EQ(2, stats.nCommitments);
+    ASSERT_DOUBLE_EQ(1, stats.committedCores);
+
+    // Later chunks are smoothed
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    busySession.record(std::chrono::nanoseconds(0));
+    ASSERT_LT(0.5, busySession.getCores());
+    ASSERT_GT(1, busySession.getCores());
+    ASSERT_DOUBLE_EQ(busySession.getCores(),
+                     cpuBudget.getStats().committedCores);
+  }
+
+  autocomp::CPUBudgetStats stats = cpuBudget.getStats();
+  ASSERT_EQ(0, stats.nCommitments);
+  ASSERT_DOUBLE_EQ(0, stats.committedCores);
+  ASSERT_DOUBLE_EQ(1, stats.peakCommittedCores);
+}
+
+TEST(CPUBudgetTest, LeavesTheHeadroomOthersDoNotUse)
+{
+  autocomp::CPUBudget cpuBudget(4);
+
+  autocomp::CPUBudget::Commitment session = cpuBudget.commit();
+  autocomp::CPUBudget::Commitment firstSibling = cpuBudget.commit();
+  autocomp::CPUBudget::Commitment secondSibling = cpuBudget.commit();
+
+  firstSibling.record(std::chrono::hours(1));
+  secondSibling.record(std::chrono::hours(1));
+
+  // The siblings count even before the CPU load shows them
+  ASSERT_DOUBLE_EQ(2, cpuBudget.getHeadroom(session, 0));
+  ASSERT_FLOAT_EQ(0.5, cpuBudget.getLoad(session, 0));
+
+  // Three busy cores, two of them the siblings'
+  ASSERT_DOUBLE_EQ(1, cpuBudget.getHeadroom(session, 0.75));
+  ASSERT_FLOAT_EQ(0.75, cpuBudget.getLoad(session, 0.75));
+
+  // The demand of the session itself is part of its headroom
+  session.record(std::chrono::hours(1));
+  ASSERT_DOUBLE_EQ(2, cpuBudget.getHeadroom(session, 0.75));
+
+  ASSERT_DOUBLE_EQ(0, cpuBudget.getHeadroom(session, 1.5));
+  ASSERT_FLOAT_EQ(1, cpuBudget.getLoad(session, 1.5));
+}
+
+TEST(CPUBudgetTest, KeepsOneAccountForMovedCommitments)
+{
+  autocomp::CPUBudget cpuBudget(2);
+
+  autocomp::CPUBudget::Commitment commitment = cpuBudget.commit();
+  commitment.record(std::chrono::hours(1));
+
+  autocomp::CPUBudget::Commitment movedCommitment(std::move(commitment));
+  ASSERT_FALSE(static_cast<bool>(commitment));
+  ASSERT_TRUE(static_cast<bool>(movedCommitment));
+  ASSERT_EQ(1, cpuBudget.getStats().nCommitments);
+  ASSERT_DOUBLE_EQ(1, cpuBudget.getStats().committedCores);
+
+  movedCommitment = autocomp::CPUBudget::Commitment();
+  ASSERT_EQ(0, cpuBudget.getStats().nCommitments);
+  ASSERT_DOUBLE_EQ(0, cpuBudget.getStats().committedCores);
+}
+
+TEST(CPUBudgetTest, DefaultsToTheAvailableCpus)
+{
+  autocomp::CPUBudget cpuBudget;
+
+  ASSERT_LE(1, cpuBudget.getCores());
+}
+
+#endif //AC_CPU_BUDGET_TEST_HPP
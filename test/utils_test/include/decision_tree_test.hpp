@@ -5,6 +5,13 @@
 #include <string>
 #include <stdexcept>
 #include <memory>
+#include <array>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <set>
+#include <sstream>
 
 /* External headers */
 #include "gtest/gtest.h"
@@ -14,6 +21,50 @@
 #include "utils/exceptions.hpp"
 #include "test_constants.hpp"
 
+namespace
+{
+  // Exposes both ways of classifying a point
+  class InspectableDecisionTree : public autocomp::DecisionTree
+  {
+  public:
+
+    using autocomp::DecisionTree::DecisionTree;
+    using autocomp::DecisionTree::walk;
+    using autocomp::DecisionTree::lookUp;
+  };
+
+  // Reads the thresholds of each feature from a text model
+  std::vector<std::set<float>> readThresholds(const std::string & filename)
+  {
+    std::ifstream input(filename);
+    std::size_t nCompressors, nFeatures, nNodes;
+    std::string label;
+
+    input >> nCompressors;
+
+    for (std::size_t i = 0; i < nCompressors; i++) {
+      input >> label;
+    }
+
+    input >> nFeatures >> nNodes;
+
+    std::vector<std::set<float>> thresholds(nFeatures);
+
+    for (std::size_t i = 0; i < nNodes; i++) {
+      int leftChild, rightChild, feature, value;
+      float threshold;
+
+      input >> leftChild >> rightChild >> feature >> threshold >> value;
+
+      if (feature >= 0) {
+        thresholds[feature].insert(threshold);
+      }
+    }
+
+    return thresholds;
+  }
+}
+
 TEST(DecisionTreeTest, FailsOnNonexistentFile)
 {
   ASSERT_THROW(autocomp::DecisionTree("./file/not/supposed/to/exist.txt"),
@@ -69,7 +120,7 @@ TEST(DecisionTreeTest, Classfies)
                                        "snappy", "snappy", "snappy", "copy",
                                        "copy", "copy", "copy"};
 
-  for (int i = 0; i < points.size(); i++) {
+  for (std::size_t i = 0; i < points.size(); i++) {
     auto compressor = decisionTree->classify(points[i]);
     std::string compressorName(autocomp::Compressor_Name(compressor.first));
 
@@ -84,4 +135,113 @@ TEST(DecisionTreeTest, Classfies)
   }
 }
 
+TEST(DecisionTreeTest, ClassifiesFixedArityPoints)
+{
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  ASSERT_TRUE(decisionTree.hasTable());
+  ASSERT_EQ(3, decisionTree.getFeatureCount());
+
+  // Values beyond the thresholds of the tree included
+  for (int cpu = -2; cpu <= 30; cpu += 2) {
+    for (int bandwidth = -5; bandwidth <= 150; bandwidth += 3) {
+      for (int bytecount = -1; bytecount <= 40; bytecount++) {
+        ASSERT_EQ(decisionTree.classify({cpu, bandwidth, bytecount}),
+                  decisionTree.classify(
+                    std::array<int, 3>{{cpu, bandwidth, bytecount}}
+                  ));
+      }
+    }
+  }
+
+  ASSERT_THROW(decisionTree.classify(std::array<int, 2>{{0, 0}}),
+               std::invalid_argument);
+}
+
+TEST(DecisionTreeTest, TableAgreesWithTheTree)
+{
+  InspectableDecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+  std::vector<std::set<float>> thresholds =
+    readThresholds(autocomp::test::constants::validDecisionTreeFile);
+
+  ASSERT_TRUE(decisionTree.hasTable());
+  ASSERT_EQ(3, thresholds.size());
+
+  // Every value next to or on a threshold, and values well beyond the lowest
+  // and the highest ones, which the table clamps
+  std::vector<std::vector<int>> values(thresholds.size());
+
+  for (std::size_t i = 0; i < thresholds.size(); i++) {
+    ASSERT_FALSE(thresholds[i].empty());
+
+    std::set<int> featureValues{int(std::floor(*thresholds[i].begin())) - 50,
+                                int(std::ceil(*thresholds[i].rbegin())) + 50};
+
+    for (float threshold : thresholds[i]) {
+      int value = std::floor(threshold);
+
+      featureValues.insert({value - 1, value, value + 1, value + 2});
+    }
+
+    values[i].assign(featureValues.begin(), featureValues.end());
+  }
+
+  for (int cpu : values[0]) {
+    for (int bandwidth : values[1]) {
+      for (int bytecount : values[2]) {
+        int point[3] = {cpu, bandwidth, bytecount};
+        ASSERT_EQ(decisionTree.walk(point), decisionTree.lookUp(point))
+          << cpu << ", " << bandwidth << ", " << bytecount;
+      }
+    }
+  }
+}
+
+TEST(DecisionTreeTest, SavesAndMapsBinaryModels)
+{
+  const std::string binaryModelFile("decision_tree_test_model.bin");
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+
+  ASSERT_NO_THROW(decisionTree.save(binaryModelFile));
+
+  {
+    autocomp::DecisionTree binaryDecisionTree(binaryModelFile);
+
+    ASSERT_TRUE(binaryDecisionTree.hasTable());
+
+    for (int cpu = -2; cpu <= 30; cpu += 2) {
+      for (int bandwidth = -5; bandwidth <= 150; bandwidth += 3) {
+        for (int bytecount = -1; bytecount <= 40; bytecount++) {
+          std::array<int, 3> point{{cpu, bandwidth, bytecount}};
+          ASSERT_EQ(decisionTree.classify(point),
+                    binaryDecisionTree.classify(point));
+        }
+      }
+    }
+  }
+
+  // A truncated model is refused
+  {
+    std::ifstream input(binaryModelFile, std::ios::binary);
+    std::vector<char> model((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+    input.close();
+
+    std::ofstream output(binaryModelFile,
+                         std::ios::binary | std::ios::trunc);
+    output.write(model.data(), model.size() / 2);
+  }
+
+  ASSERT_THROW(autocomp::DecisionTree{binaryModelFile},
+               autocomp::exceptions::IOError);
+
+  std::remove(binaryModelFile.c_str());
+}
+
 #endif //AC_DECISION_TREE_TEST_HPP
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef AC_ENSEMBLE_MODEL_TEST_HPP
+#define AC_ENSEMBLE_MODEL_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <memory>
+#include <array>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <cstdio>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/classification_model.hpp"
+#include "utils/ensemble_model.hpp"
+#include "utils/decision_tree.hpp"
+#include "utils/exceptions.hpp"
+#include "test_constants.hpp"
+
+TEST(EnsembleModelTest, FailsOnNonexistentFile)
+{
+  ASSERT_THROW(autocomp::EnsembleModel("./file/not/supposed/to/exist.txt"),
+               autocomp::exceptions::IOError);
+}
+
+TEST(EnsembleModelTest, FailsOnInvalidFile)
+{
+  ASSERT_THROW(
+      autocomp::EnsembleModel(autocomp::test::constants::validDecisionTreeFile),
+      autocomp::exceptions::IOError
+    );
+  ASSERT_THROW(
+      autocomp::EnsembleModel(autocomp::test::constants::invalidDecisionTreeFile),
+      autocomp::exceptions::IOError
+    );
+}
+
+TEST(EnsembleModelTest, Classifies)
+{
+  const std::pair<autocomp::Compressor, int> bzip2{autocomp::BZIP2, 5};
+  const std::pair<autocomp::Compressor, int> lzo{autocomp::LZO, 8};
+  const std::pair<autocomp::Compressor, int> zlib{autocomp::ZLIB, 6};
+  const std::pair<autocomp::Compressor, int> copy{autocomp::COPY, -1};
+  const std::pair<autocomp::Compressor, int> snappy{autocomp::SNAPPY, -1};
+
+  autocomp::EnsembleModel forest(autocomp::test::constants::validEnsembleFile);
+  autocomp::EnsembleModel boostedTrees(
+      autocomp::test::constants::validBoostedTreesFile
+    );
+
+  ASSERT_EQ(autocomp::EnsembleModel::Kind::PROBABILITY_VOTE, forest.getKind());
+  ASSERT_EQ(20, forest.getTreeCount());
+  ASSERT_EQ(autocomp::EnsembleModel::Kind::BOOSTED, boostedTrees.getKind());
+  ASSERT_EQ(30, boostedTrees.getTreeCount());
+  ASSERT_EQ(3, boostedTrees.getFeatureCount());
+
+  // Point, then the label of the forest and that of the boosted trees
+  std::vector<std::array<int, 3>> points{{{-1,-1,5}}, {{0,1,10}}, {{3,9,1}},
+                                         {{4,11,6}}, {{5,14,-1}}, {{7,18,9}},
+                                         {{8,21,2}}, {{9,23,7}}, {{10,26,0}},
+                                         {{11,28,5}}};
+  std::vector<std::pair<autocomp::Compressor, int>> forestLabels{
+    snappy, snappy, snappy, copy, lzo, copy, lzo, zlib, snappy, snappy
+  };
+  std::vector<std::pair<autocomp::Compressor, int>> boostedTreesLabels{
+    snappy, snappy, snappy, snappy, snappy, copy, bzip2, snappy, bzip2, copy
+  };
+
+  for (std::size_t i = 0; i < points.size(); i++) {
+    ASSERT_EQ(forestLabels[i], forest.classify(points[i]));
+    ASSERT_EQ(boostedTreesLabels[i], boostedTrees.classify(points[i]));
+  }
+
+  ASSERT_THROW(forest.classify(std::vector<int>{0, 0}), std::invalid_argument);
+}
+
+// A forest of the decision tree alone votes as the tree does
+TEST(EnsembleModelTest, SingleTreeForestMatchesDecisionTree)
+{
+  const std::string ensembleFile("ensemble_model_test_forest.txt");
+
+  {
+    std::ifstream input(autocomp::test::constants::validDecisionTreeFile);
+    std::ofstream output(ensembleFile);
+    std::string line;
+
+    output << "forest_majority\n";
+
+    // Labels and number of features, then the number of nodes
+    for (int i = 0; i < 3 and std::getline(input, line); i++) {
+      output << line << "\n";
+    }
+
+    std::getline(input, line);
+    output << "1\n-1 " << line << "\n" << input.rdbuf();
+  }
+
+  autocomp::DecisionTree decisionTree(
+      autocomp::test::constants::validDecisionTreeFile
+    );
+  std::unique_ptr<autocomp::ClassificationModel> forest;
+
+  ASSERT_NO_THROW(forest = autocomp::ClassificationModel::load(ensembleFile));
+  ASSERT_NE(nullptr, dynamic_cast<autocomp::EnsembleModel *>(forest.get()));
+
+  for (int cpu = -1; cpu <= 11; cpu++) {
+    for (int bandwidth = -1; bandwidth <= 130; bandwidth++) {
+      for (int bytecount = -1; bytecount <= 21; bytecount++) {
+        std::array<int, 3> point{{cpu, bandwidth, bytecount}};
+
+        ASSERT_EQ(decisionTree.classify(point), forest->classify(point));
+      }
+    }
+  }
+
+  std::remove(ensembleFile.c_str());
+}
+
+TEST(EnsembleModelTest, LoadsEitherModel)
+{
+  std::unique_ptr<autocomp::ClassificationModel> model;
+
+  ASSERT_NO_THROW(
+    model = autocomp::ClassificationModel::load(
+              autocomp::test::constants::validBoostedTreesFile
+            )
+  );
+  ASSERT_NE(nullptr, dynamic_cast<autocomp::EnsembleModel *>(model.get()));
+
+  ASSERT_NO_THROW(
+    model = autocomp::ClassificationModel::load(
+              autocomp::test::constants::validDecisionTreeFile
+            )
+  );
+  ASSERT_NE(nullptr, dynamic_cast<autocomp::DecisionTree *>(model.get()));
+
+  ASSERT_THROW(
+      autocomp::ClassificationModel::load("./file/not/supposed/to/exist.txt"),
+      autocomp::exceptions::IOError
+    );
+}
+
+#endif // AC_ENSEMBLE_MODEL_TEST_HPP
@@ -0,0 +1,91 @@
+#ifndef AC_FEEDBACK_CONTROLLER_TEST_HPP
+#define AC_FEEDBACK_CONTROLLER_TEST_HPP
+
+/* C++ System Headers */
+#include <stdexcept>
+#include <cstddef>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/feedback_controller.hpp"
+
+TEST(FeedbackControllerTest, FollowsTheError)
+{
+  autocomp::FeedbackController controller(9, 0.5, 3);
+
+  ASSERT_EQ(3, controller.getLevel());
+
+  // Data piling up moves it to the last level...
+  for (int i = 0; i < 50; i++) {
+    controller.update(1);
+  }
+
+  ASSERT_EQ(8, controller.getLevel());
+
+  // ...and an idle network to the first one
+  for (int i = 0; i < 50; i++) {
+    controller.update(0);
+  }
+
+  ASSERT_EQ(0, controller.getLevel());
+
+  // On the setpoint it settles wherever the integral left it
+  std::size_t level = controller.update(0.5);
+
+  for (int i = 0; i < 50; i++) {
+    ASSERT_EQ(level, controller.update(0.5));
+  }
+}
+
+TEST(FeedbackControllerTest, DoesNotFlapAroundAMidpoint)
+{
+  autocomp::FeedbackController controller(9, 0.5, 3, 2, 0, 0.25);
+
+  // Outputs between 3.5 and 3.75 are past the midpoint to level 4, but not
+  // by the hysteresis
+  for (int i = 0; i < 50; i++) {
+    ASSERT_EQ(3, controller.update(i % 2 ? 0.8 : 0.85));
+  }
+
+  ASSERT_EQ(4, controller.update(0.9));
+
+  // Nor between 3.25 and 3.5 on the way back
+  for (int i = 0; i < 50; i++) {
+    ASSERT_EQ(4, controller.update(i % 2 ? 0.65 : 0.7));
+  }
+
+  ASSERT_EQ(3, controller.update(0.6));
+}
+
+TEST(FeedbackControllerTest, DoesNotWindUp)
+{
+  autocomp::FeedbackController controller(9, 0.5, 3);
+
+  // A long time stuck at the last level...
+  for (int i = 0; i < 10000; i++) {
+    controller.update(1);
+  }
+
+  ASSERT_EQ(8, controller.getLevel());
+  ASSERT_DOUBLE_EQ(8, controller.getOutput());
+
+  // ...is not paid for with as long a time stuck there once it drains
+  std::size_t nUpdates = 0;
+
+  while (controller.update(0.25) == 8) {
+    nUpdates++;
+  }
+
+  ASSERT_GT(5, nUpdates);
+}
+
+TEST(FeedbackControllerTest, ThrowsOnInvalidLevels)
+{
+  ASSERT_THROW(autocomp::FeedbackController(0, 0.5, 0), std::domain_error);
+  ASSERT_THROW(autocomp::FeedbackController(9, 0.5, 9), std::domain_error);
+  ASSERT_NO_THROW(autocomp::FeedbackController(1, 0.5, 0));
+}
+
+#endif // AC_FEEDBACK_CONTROLLER_TEST_HPP
@@ -0,0 +1,63 @@
+#ifndef AC_FILE_FORMAT_TEST_HPP
+#define AC_FILE_FORMAT_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <utility>
+#include <vector>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/file_format.hpp"
+
+namespace
+{
+  autocomp::FileFormat sniff(const std::string & signature)
+  {
+    return autocomp::sniffFileFormat(signature.data(), signature.size());
+  }
+}
+
+TEST(FileFormatTest, TellsFormatsFromTheirSignatures)
+{
+  std::vector<std::pair<autocomp::FileFormat, std::string>> signatures{
+    {autocomp::FileFormat::GZIP, std::string("\x1f\x8b\x08\x00", 4)},
+    {autocomp::FileFormat::BZIP2, "BZh91AY&SY"},
+    {autocomp::FileFormat::XZ, std::string("\xfd" "7zXZ\x00\x00\x04", 8)},
+    {autocomp::FileFormat::ZIP, "PK\x03\x04\x14"},
+    {autocomp::FileFormat::JPEG, "\xff\xd8\xff\xe0"},
+    {autocomp::FileFormat::PNG, "\x89PNG\r\n\x1a\n"},
+    {autocomp::FileFormat::WEBP, "RIFF\x10\x20\x30\x01WEBPVP8 "},
+    {autocomp::FileFormat::MP4, std::string("\x00\x00\x00\x20" "ftypisom", 12)},
+    {autocomp::FileFormat::PARQUET, "PAR1\x15"}
+  };
+
+  for (const auto & signature : signatures) {
+    autocomp::FileFormat format = sniff(signature.second);
+
+    ASSERT_EQ(signature.first, format)
+      << autocomp::getFileFormatName(signature.first);
+    ASSERT_TRUE(autocomp::isCompressedFormat(format));
+  }
+}
+
+TEST(FileFormatTest, DoesNotTakeOtherDataForAFormat)
+{
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("Alice was beginning"));
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff(""));
+  ASSERT_FALSE(autocomp::isCompressedFormat(autocomp::FileFormat::UNKNOWN));
+
+  // Too short for the signature, and a RIFF file of another type
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("\x89PNG"));
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("RIFF\x10\x20\x30\x01WAVE"));
+
+  // Text that only looks like the start of a signature
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("BZh"));
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("BZhang said"));
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("BZh0AY&SY"));
+  ASSERT_EQ(autocomp::FileFormat::UNKNOWN, sniff("Our new WEBPage"));
+}
+
+#endif // AC_FILE_FORMAT_TEST_HPP
@@ -0,0 +1,142 @@
+#ifndef AC_FLOATING_POINT_DETECTOR_TEST_HPP
+#define AC_FLOATING_POINT_DETECTOR_TEST_HPP
+
+/* C++ System Headers */
+#include <string>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "test_constants.hpp"
+#include "common_functions.hpp"
+#include "utils/constants.hpp"
+#include "utils/floating_point_detector.hpp"
+
+namespace
+{
+  template<class T>
+  std::string toBytes(const std::vector<T> & values)
+  {
+    std::string bytes(values.size() * sizeof(T), '\0');
+    std::memcpy(&bytes[0], values.data(), bytes.size());
+
+    return bytes;
+  }
+
+  autocomp::FloatingPointFeatures getFeatures(const std::string & data)
+  {
+    return autocomp::getFloatingPointFeatures(data.data(), data.size());
+  }
+}
+
+TEST(FloatingPointDetectorTest, DetectsDoubles)
+{
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      );
+
+  ASSERT_TRUE(autocomp::isFloatingPointData(getFeatures(trace)));
+
+  // A noisy random walk, as measurements are
+  std::mt19937 generator(3);
+  std::normal_distribution<double> steps(0, 0.01);
+  std::vector<double> walk(8192);
+  double value = 100;
+
+  for (double & step : walk) {
+    step = value += steps(generator);
+  }
+
+  autocomp::FloatingPointFeatures features = getFeatures(toBytes(walk));
+
+  ASSERT_TRUE(autocomp::isFloatingPointData(features));
+  ASSERT_DOUBLE_EQ(1, features.normalShare);
+  ASSERT_GT(features.lowByteEntropy - features.highByteEntropy,
+            autocomp::constants::FP_MIN_ENTROPY_GAP);
+}
+
+TEST(FloatingPointDetectorTest, DoesNotTakeOtherDataForDoubles)
+{
+  std::mt19937 generator(5);
+
+  // Random bytes
+  std::string randomData(64 * 1024, '\0');
+
+  for (char & byte : randomData) {
+    byte = generator();
+  }
+
+  ASSERT_FALSE(autocomp::isFloatingPointData(getFeatures(randomData)));
+
+  // Text
+  ASSERT_FALSE(autocomp::isFloatingPointData(getFeatures(
+    autocomp::test::getDataFromFile(
+      autocomp::test::constants::compressionTestFilename
+    ).substr(0, 64 * 1024)
+  )));
+
+  // Small 64 bit integers, whose exponent is always 0
+  std::geometric_distribution<std::int64_t> counters(0.001);
+  std::vector<std::int64_t> integers(8192);
+
+  for (std::int64_t & integer : integers) {
+    integer = counters(generator);
+  }
+
+  ASSERT_FALSE(autocomp::isFloatingPointData(getFeatures(toBytes(integers))));
+
+  // Single precision floats, whose exponents are in the fourth byte too
+  std::normal_distribution<float> floatValues(100, 10);
+  std::vector<float> floats(16384);
+
+  for (float & value : floats) {
+    value = floatValues(generator);
+  }
+
+  ASSERT_FALSE(autocomp::isFloatingPointData(getFeatures(toBytes(floats))));
+
+  // Not made of 8 byte words
+  std::string trace = autocomp::test::getDataFromFile(
+                        autocomp::test::constants::fpcTestFilename
+                      );
+
+  ASSERT_FALSE(autocomp::isFloatingPointData(getFeatures(trace.substr(1))));
+}
+
+TEST(FloatingPointDetectorTest, ChoosesTheFPCLevelFromThePredictorHits)
+{
+  // A constant stride is always predicted
+  std::vector<double> ramp(4096);
+
+  for (std::size_t i = 0; i < ramp.size(); i++) {
+    ramp[i] = 1000 + 0.25 * i;
+  }
+
+  autocomp::FloatingPointFeatures features = getFeatures(toBytes(ramp));
+
+  ASSERT_LT(0.99, features.predictorHitRate);
+  ASSERT_EQ(autocomp::constants::FPC_FAST_LEVEL,
+            autocomp::getFPCLevel(features));
+
+  // Independent values are not
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> uniform(1, 2);
+  std::vector<double> noise(4096);
+
+  for (double & value : noise) {
+    value = uniform(generator);
+  }
+
+  features = getFeatures(toBytes(noise));
+
+  ASSERT_GT(0.1, features.predictorHitRate);
+  ASSERT_EQ(autocomp::constants::FPC_STRONG_LEVEL,
+            autocomp::getFPCLevel(features));
+}
+
+#endif // AC_FLOATING_POINT_DETECTOR_TEST_HPP
@@ -0,0 +1,115 @@
+#ifndef AC_MEMORY_GOVERNOR_TEST_HPP
+#define AC_MEMORY_GOVERNOR_TEST_HPP
+
+/* C++ System Headers */
+#include <thread>
+#include <vector>
+#include <utility>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/memory_governor.hpp"
+
+TEST(MemoryGovernorTest, DeniesReservationsBeyondTheBudget)
+{
+  autocomp::MemoryGovernor memoryGovernor(100);
+
+  ASSERT_TRUE(memoryGovernor.tryReserve(60));
+  ASSERT_TRUE(memoryGovernor.tryReserve(40));
+  ASSERT_FALSE(memoryGovernor.tryReserve(1));
+  ASSERT_FLOAT_EQ(1, memoryGovernor.getLoad());
+
+  memoryGovernor.release(40);
+  ASSERT_TRUE(memoryGovernor.tryReserve(30));
+
+  autocomp::MemoryStats stats = memoryGovernor.getStats();
+  ASSERT_EQ(100, stats.budget);
+  ASSERT_EQ(90, stats.usedBytes);
+  ASSERT_EQ(100, stats.peakUsedBytes);
+  ASSERT_EQ(1, stats.deniedReservations);
+}
+
+TEST(MemoryGovernorTest, AccountsForcedReservations)
+{
+  autocomp::MemoryGovernor memoryGovernor(100);
+
+  memoryGovernor.forceReserve(150);
+  ASSERT_FLOAT_EQ(1.5, memoryGovernor.getLoad());
+  ASSERT_FALSE(memoryGovernor.tryReserve(1));
+
+  memoryGovernor.release(150);
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+  ASSERT_EQ(150, memoryGovernor.getStats().peakUsedBytes);
+
+  // Releasing more than reserved does not wrap around
+  memoryGovernor.release(10);
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+}
+
+TEST(MemoryGovernorTest, ReleasesReservationsOnDestruction)
+{
+  autocomp::MemoryGovernor memoryGovernor(100);
+
+  {
+    autocomp::MemoryGovernor::Reservation reservation =
+      memoryGovernor.tryAcquire(80);
+    ASSERT_TRUE(static_cast<bool>(reservation));
+    ASSERT_EQ(80, reservation.getBytes());
+
+    autocomp::MemoryGovernor::Reservation denied =
+      memoryGovernor.tryAcquire(80);
+    ASSERT_FALSE(static_cast<bool>(denied));
+
+    autocomp::MemoryGovernor::Reservation moved(std::move(reservation));
+    ASSERT_FALSE(static_cast<bool>(reservation));
+    ASSERT_EQ(80, memoryGovernor.getStats().usedBytes);
+  }
+
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+
+  {
+    autocomp::MemoryGovernor::Reservation forced =
+      memoryGovernor.acquire(200);
+    ASSERT_EQ(200, memoryGovernor.getStats().usedBytes);
+  }
+
+  ASSERT_EQ(0, memoryGovernor.getStats().usedBytes);
+}
+
+TEST(MemoryGovernorTest, NeverDeniesWithoutABudget)
+{
+  autocomp::MemoryGovernor memoryGovernor(0);
+
+  ASSERT_TRUE(memoryGovernor.tryReserve(1024 * 1024 * 1024));
+  ASSERT_FLOAT_EQ(0, memoryGovernor.getLoad());
+  ASSERT_EQ(1024 * 1024 * 1024, memoryGovernor.getStats().usedBytes);
+}
+
+TEST(MemoryGovernorTest, StaysWithinTheBudgetWithManyThreads)
+{
+  const int nThreads = 8;
+  const int nReservations = 10000;
+  autocomp::MemoryGovernor memoryGovernor(1000);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < nThreads; i++) {
+    threads.emplace_back([&memoryGovernor, nReservations] ()
+                         {
+                           for (int j = 0; j < nReservations; j++) {
+                             auto reservation = memoryGovernor.tryAcquire(300);
+                           }
+                         });
+  }
+
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  autocomp::MemoryStats stats = memoryGovernor.getStats();
+  ASSERT_EQ(0, stats.usedBytes);
+  ASSERT_LE(stats.peakUsedBytes, 1000);
+}
+
+#endif // AC_MEMORY_GOVERNOR_TEST_HPP
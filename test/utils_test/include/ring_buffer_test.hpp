@@ -0,0 +1,180 @@
+#ifndef AC_RING_BUFFER_TEST_HPP
+#define AC_RING_BUFFER_TEST_HPP
+
+/* C++ System Headers */
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <iterator>
+
+/* External headers */
+#include "gtest/gtest.h"
+
+/* Project headers */
+#include "utils/spsc_ring_buffer.hpp"
+#include "utils/mpmc_ring_buffer.hpp"
+#include "utils/blocking_ring_buffer.hpp"
+
+class RingBufferTest : public ::testing::Test
+{
+protected:
+
+  const std::size_t capacity = 8;
+  const int nEntries = 100000;
+}; // class RingBufferTest
+
+
+TEST_F(RingBufferTest, SpscRingHoldsUpToItsCapacity)
+{
+  autocomp::SpscRingBuffer<int> ring(this->capacity - 1);
+
+  ASSERT_EQ(this->capacity, ring.getCapacity());
+
+  for (std::size_t i = 0; i < this->capacity; i++) {
+    ASSERT_TRUE(ring.tryPush(int(i)));
+  }
+
+  ASSERT_FALSE(ring.tryPush(-1));
+  ASSERT_EQ(this->capacity, ring.getSize());
+
+  int entry;
+  for (std::size_t i = 0; i < this->capacity; i++) {
+    ASSERT_TRUE(ring.tryPop(entry));
+    ASSERT_EQ(int(i), entry);
+  }
+
+  ASSERT_FALSE(ring.tryPop(entry));
+}
+
+TEST_F(RingBufferTest, MpmcRingHoldsUpToItsCapacity)
+{
+  autocomp::MpmcRingBuffer<int> ring(this->capacity);
+
+  for (std::size_t i = 0; i < this->capacity; i++) {
+    ASSERT_TRUE(ring.tryPush(int(i)));
+  }
+
+  ASSERT_FALSE(ring.tryPush(-1));
+
+  int entry;
+  for (std::size_t i = 0; i < this->capacity; i++) {
+    ASSERT_TRUE(ring.tryPop(entry));
+    ASSERT_EQ(int(i), entry);
+  }
+
+  ASSERT_FALSE(ring.tryPop(entry));
+}
+
+TEST_F(RingBufferTest, PopsBatches)
+{
+  autocomp::SpscRingBuffer<int> ring(this->capacity);
+  std::vector<int> entries;
+
+  for (int i = 0; i < 5; i++) {
+    ASSERT_TRUE(ring.tryPush(int(i)));
+  }
+
+  ASSERT_EQ(3, ring.tryPopBatch(std::back_inserter(entries), 3));
+  ASSERT_EQ(2, ring.tryPopBatch(std::back_inserter(entries), 3));
+  ASSERT_EQ(0, ring.tryPopBatch(std::back_inserter(entries), 3));
+
+  for (int i = 0; i < 5; i++) {
+    ASSERT_EQ(i, entries[i]);
+  }
+}
+
+TEST_F(RingBufferTest, SpscQueueKeepsOrderAcrossThreads)
+{
+  autocomp::SpscQueue<int> queue(this->capacity);
+  std::vector<int> received;
+
+  std::thread consumer([&queue, &received] ()
+                       {
+                         int entry;
+
+                         while (queue.pop(entry)) {
+                           received.push_back(entry);
+                         }
+                       });
+
+  for (int i = 0; i < this->nEntries; i++) {
+    ASSERT_TRUE(queue.push(int(i)));
+  }
+
+  queue.close();
+  consumer.join();
+
+  ASSERT_EQ(this->nEntries, received.size());
+  for (int i = 0; i < this->nEntries; i++) {
+    ASSERT_EQ(i, received[i]);
+  }
+}
+
+TEST_F(RingBufferTest, MpmcQueueDeliversEveryEntryOnce)
+{
+  const int nProducers = 3, nConsumers = 3;
+  autocomp::MpmcQueue<int> queue(this->capacity);
+  std::vector<std::thread> producers, consumers;
+  std::vector<int> received;
+  std::mutex receivedMutex;
+
+  for (int i = 0; i < nConsumers; i++) {
+    consumers.emplace_back([&queue, &received, &receivedMutex] ()
+                           {
+                             std::vector<int> entries;
+
+                             while (queue.popBatch(std::back_inserter(entries),
+                                                   4) > 0) {}
+
+                             std::unique_lock<std::mutex> guard(receivedMutex);
+                             received.insert(received.end(), entries.begin(),
+                                             entries.end());
+                           });
+  }
+
+  for (int i = 0; i < nProducers; i++) {
+    producers.emplace_back([this, &queue, i] ()
+                           {
+                             for (int j = i * this->nEntries;
+                                  j < (i + 1) * this->nEntries; j++) {
+                               queue.push(int(j));
+                             }
+                           });
+  }
+
+  for (auto & producer : producers) {
+    producer.join();
+  }
+
+  queue.close();
+
+  for (auto & consumer : consumers) {
+    consumer.join();
+  }
+
+  std::set<int> uniqueEntries(received.begin(), received.end());
+  ASSERT_EQ(nProducers * this->nEntries, received.size());
+  ASSERT_EQ(received.size(), uniqueEntries.size());
+}
+
+TEST_F(RingBufferTest, ClosedQueueRejectsProducersAndDrains)
+{
+  autocomp::SpscQueue<int> queue(this->capacity);
+
+  ASSERT_TRUE(queue.push(1));
+  queue.close();
+
+  ASSERT_FALSE(queue.push(2));
+
+  int entry;
+  ASSERT_TRUE(queue.pop(entry));
+  ASSERT_EQ(1, entry);
+  ASSERT_FALSE(queue.pop(entry));
+
+  queue.reopen();
+  ASSERT_TRUE(queue.push(3));
+}
+
+#endif // AC_RING_BUFFER_TEST_HPP
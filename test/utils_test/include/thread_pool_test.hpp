@@ -8,12 +8,16 @@
 #include <thread>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
 #include <unistd.h>
 
 /* External headers */
 #include "gtest/gtest.h"
 
 /* Project headers */
+#include "utils/task.hpp"
 #include "utils/thread_pool.hpp"
 
 class ThreadPoolTest : public ::testing::Test
@@ -55,9 +59,9 @@ TEST_F(ThreadPoolTest, SimpleTesting)
   std::vector<int> results(resultsSize, 0);
   std::vector<std::future<void>> futures(resultsSize);
 
-  for (int i = 0; i < operands.size(); i++) {
-    for (int j = 0; j < operands.size(); j++) {
-      int resultIndex = 9 * i + j;
+  for (std::size_t i = 0; i < operands.size(); i++) {
+    for (std::size_t j = 0; j < operands.size(); j++) {
+      std::size_t resultIndex = 9 * i + j;
       futures[resultIndex] =
         this->threadPool->run(ThreadPoolTest::multiply,
                               operands[i], operands[j],
@@ -69,13 +73,160 @@ TEST_F(ThreadPoolTest, SimpleTesting)
     future.wait();
   }
 
-  for (int i = 0; i < operands.size(); i++) {
-    for (int j = 0; j < operands.size(); j++) {
-      int resultIndex = 9 * i + j;
+  for (std::size_t i = 0; i < operands.size(); i++) {
+    for (std::size_t j = 0; j < operands.size(); j++) {
+      std::size_t resultIndex = 9 * i + j;
       int result = operands[i] * operands[j];
       ASSERT_EQ(result, results[resultIndex]);
     }
   }
 }
 
+TEST_F(ThreadPoolTest, RunsPostedTasks)
+{
+  std::atomic<int> counter(0);
+  std::promise<void> allDone;
+  const int nTasks = 1000;
+
+  for (int i = 0; i < nTasks; i++) {
+    this->threadPool->post([&counter, &allDone, nTasks] ()
+                           {
+                             if (counter.fetch_add(1) + 1 == nTasks) {
+                               allDone.set_value();
+                             }
+                           });
+  }
+
+  allDone.get_future().wait();
+  ASSERT_EQ(nTasks, counter);
+}
+
+TEST_F(ThreadPoolTest, RunsParallelForOverEveryRange)
+{
+  std::vector<int> values(10000, 1);
+  std::atomic<int> sum(0);
+
+  this->threadPool->parallelFor(0, values.size(), 64,
+                                [&values, &sum] (std::size_t begin,
+                                                 std::size_t end)
+                                {
+                                  sum += std::accumulate(values.begin() + begin,
+                                                         values.begin() + end,
+                                                         0);
+                                });
+
+  ASSERT_EQ(values.size(), sum);
+}
+
+TEST_F(ThreadPoolTest, RunsNestedParallelForFromWorkers)
+{
+  std::atomic<int> sum(0);
+  autocomp::ThreadPool & threadPool = *this->threadPool;
+
+  auto future = threadPool.run([&threadPool, &sum] ()
+                               {
+                                 threadPool.parallelFor(
+                                     0, 100, 1,
+                                     [&sum] (std::size_t, std::size_t)
+                                     {
+                                       sum++;
+                                     }
+                                   );
+                               });
+
+  future.wait();
+  ASSERT_EQ(100, sum);
+}
+
+TEST_F(ThreadPoolTest, PropagatesParallelForExceptions)
+{
+  ASSERT_THROW({
+    this->threadPool->parallelFor(0, 10, 1,
+                                  [] (std::size_t begin, std::size_t)
+                                  {
+                                    if (begin == 5) {
+                                      throw std::runtime_error("range 5");
+                                    }
+                                  });
+  }, std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, RefusesTasksOnceShutDown)
+{
+  std::atomic<int> nTasksRun(0);
+  std::vector<std::thread> submitters;
+
+  // Submissions racing the shutdown are either refused or run
+  for (int i = 0; i < 4; i++) {
+    submitters.emplace_back([this, &nTasksRun] ()
+                            {
+                              for (int j = 0; j < 1000; j++) {
+                                try {
+                                  this->threadPool->post(
+                                      autocomp::Task([&nTasksRun] ()
+                                                     {
+                                                       nTasksRun++;
+                                                     })
+                                    );
+                                }
+                                catch (std::runtime_error & error) {
+                                  nTasksRun++;
+                                }
+                              }
+                            });
+  }
+
+  this->threadPool->shutdown();
+
+  for (auto & submitter : submitters) {
+    submitter.join();
+  }
+
+  ASSERT_EQ(4000, nTasksRun.load());
+  ASSERT_THROW(this->threadPool->run([] () { return 1; }),
+               std::runtime_error);
+}
+
+TEST(ThreadPoolShutdownTest, RunsTheTasksOfAPoolNeverInitialized)
+{
+  autocomp::ThreadPool threadPool(2, 4);
+  int nTasksRun = 0;
+
+  for (int i = 0; i < 4; i++) {
+    threadPool.post(autocomp::Task([&nTasksRun] () { nTasksRun++; }));
+  }
+
+  // Nothing would ever empty the queue
+  ASSERT_THROW(threadPool.post(autocomp::Task([] () {})),
+               std::runtime_error);
+
+  threadPool.shutdown();
+
+  ASSERT_EQ(4, nTasksRun);
+}
+
+TEST(TaskTest, StoresMoveOnlyAndBigCallables)
+{
+  int result = 0;
+  std::unique_ptr<int> value(new int(21));
+  std::vector<int> bigCapture(100, 1);
+
+  autocomp::Task moveOnlyTask([&result, value = std::move(value)] ()
+                              {
+                                result += 2 * *value;
+                              });
+  autocomp::Task bigTask([&result, bigCapture] ()
+                         {
+                           result += bigCapture.size();
+                         });
+
+  autocomp::Task movedTask(std::move(moveOnlyTask));
+  ASSERT_FALSE(moveOnlyTask);
+
+  movedTask();
+  bigTask();
+
+  ASSERT_EQ(142, result);
+}
+
 #endif //AC_THREAD_POOL_TEST_HPP
\ No newline at end of file
@@ -1,12 +1,90 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <fcntl.h>
 #include <cmath>
 
 #include "utils/functions.hpp"
+#include "utils/byte_histogram.hpp"
 #include "common_functions.hpp"
 
+namespace
+{
+  const int nRepetitions = 20;
+
+  // Byte by byte into a single histogram, as bytecounting used to count
+  std::size_t countBytesOneByOne(const unsigned char * data,
+                                 const std::size_t & dataSize)
+  {
+    std::array<std::size_t, 256> byteOccurrences{};
+
+    for (std::size_t i = 0; i < dataSize; i++) {
+      byteOccurrences[data[i]]++;
+    }
+
+    return byteOccurrences[data[0]];
+  }
+
+  std::size_t countBytesWithHistogram(const unsigned char * data,
+                                      const std::size_t & dataSize)
+  {
+    autocomp::ByteHistogram histogram;
+    histogram.update(data, dataSize);
+
+    return histogram.getCount(data[0]);
+  }
+
+  // MB/s the data is counted at, the best of the repetitions
+  template<class Function>
+  double measureThroughput(Function countBytes,
+                           const unsigned char * data,
+                           const std::size_t & dataSize)
+  {
+    volatile std::size_t sink = 0;
+    double bestTime = 1e30;
+
+    for (int i = 0; i < nRepetitions; i++) {
+      auto startTime = std::chrono::steady_clock::now();
+      sink = sink + countBytes(data, dataSize);
+      auto endTime = std::chrono::steady_clock::now();
+
+      bestTime = std::min(
+                   bestTime,
+                   std::chrono::duration<double>(endTime - startTime).count()
+                 );
+    }
+
+    return dataSize / bestTime / 1e6;
+  }
+
+  void benchmark(const std::string & name,
+                 const unsigned char * data,
+                 const std::size_t & dataSize)
+  {
+    autocomp::ByteHistogram histogram;
+    histogram.update(data, dataSize);
+    autocomp::ByteFeatures features = histogram.getFeatures();
+
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::fixed << std::setprecision(0)
+              << std::setw(12) << measureThroughput(countBytesOneByOne, data,
+                                                    dataSize)
+              << std::setw(12) << measureThroughput(countBytesWithHistogram,
+                                                    data, dataSize)
+              << std::setprecision(2)
+              << std::setw(8) << features.bytecount
+              << std::setw(8) << features.entropy
+              << std::setw(8) << features.zeroRatio
+              << std::setw(12) << features.meanRunLength
+              << std::endl;
+  }
+}
+
 int main()
 {
   std::vector<unsigned char> as(1000000, 'a');
@@ -104,5 +182,35 @@ int main()
               << std::endl;
   }
 
+  // Throughput of the byte counting: one by one against the histogram kernel
+  std::vector<unsigned char> records(4000000);
+
+  for (std::size_t i = 0; i < records.size(); i++) {
+    records[i] = i % 8 < 2 ? (i / 8) % 251 : 0;
+  }
+
+  std::string alice = autocomp::test::getDataFromFile(fileList.front());
+  std::vector<unsigned char> randomData(4000000);
+  std::mt19937 generator(0);
+
+  for (unsigned char & byte : randomData) {
+    byte = generator();
+  }
+
+  std::cout << "\nThroughput in MB/s, "
+            << autocomp::ByteHistogram::getKernelName() << " kernel:\n"
+            << std::left << std::setw(28) << "data" << std::right
+            << std::setw(12) << "one by one" << std::setw(12) << "histogram"
+            << std::setw(8) << "count" << std::setw(8) << "entropy"
+            << std::setw(8) << "zeros" << std::setw(12) << "run"
+            << std::endl;
+
+  benchmark("1 mb of 'a'", as.data(), as.size());
+  benchmark("4 mb of sparse records", records.data(), records.size());
+  benchmark(fileList.front(),
+            reinterpret_cast<const unsigned char *>(alice.data()),
+            alice.size());
+  benchmark("4 mb of random data", randomData.data(), randomData.size());
+
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,103 @@
+/**
+ *  Latency microbenchmark of the classification models: the decision tree,
+ *  as a dense table and walked, against ensembles, over points spread on the
+ *  feature space AutoComp classifies.
+ *
+ *  usage: model_benchmark [model...]
+ *
+ *  With no models, the ones the tests use are measured.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+#include "utils/classification_model.hpp"
+#include "utils/exceptions.hpp"
+
+namespace
+{
+  const std::size_t nPoints = 4096;
+  const std::size_t nRounds = 250;
+
+  std::vector<std::array<int, 3>> makePoints()
+  {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> cpuLoad(0, 10);
+    std::uniform_int_distribution<int> bandwidth(0, 130);
+    std::uniform_int_distribution<int> bytecount(0, 20);
+    std::vector<std::array<int, 3>> points(nPoints);
+
+    for (auto & point : points) {
+      point = {{cpuLoad(generator), bandwidth(generator),
+                bytecount(generator)}};
+    }
+
+    return points;
+  }
+
+  double run(const autocomp::ClassificationModel & model,
+             const std::vector<std::array<int, 3>> & points)
+  {
+    volatile int sink = 0;
+    int checksum = 0;
+
+    auto tic = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t round = 0; round < nRounds; round++) {
+      for (const auto & point : points) {
+        checksum += model.classify(point).second;
+      }
+    }
+
+    auto toc = std::chrono::high_resolution_clock::now();
+
+    // Keeps the classifications from being optimized away
+    sink = sink + checksum;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(toc - tic)
+                           .count();
+
+    return nanoseconds / (nRounds * points.size());
+  }
+
+  void report(const std::string & name, const double & nanoseconds)
+  {
+    std::cout << "  " << std::left << std::setw(56) << name
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << nanoseconds << " ns/point"
+              << std::endl;
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::vector<std::string> filenames(argv + 1, argv + argc);
+
+  if (filenames.empty()) {
+    filenames = {"test/utils_test/include/decision_tree_classifier.txt",
+                 "test/utils_test/include/ensemble_classifier.txt",
+                 "test/utils_test/include/boosted_classifier.txt"};
+  }
+
+  const std::vector<std::array<int, 3>> points = makePoints();
+
+  for (const std::string & filename : filenames) {
+    try {
+      auto model = autocomp::ClassificationModel::load(filename);
+      report(filename, run(*model, points));
+    }
+    catch (autocomp::exceptions::IOError & error) {
+      std::cerr << error.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return 0;
+}
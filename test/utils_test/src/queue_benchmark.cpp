@@ -0,0 +1,170 @@
+/**
+ *  Contention microbenchmark of the hand-off queues: the SynchronousQueue
+ *  guarded by an external condition variable (as the server, the client and
+ *  the thread pool used it) against the lock-free ring buffers.
+ *
+ *  usage: queue_benchmark [entries_per_producer]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdlib>
+
+#include "utils/synchronous_queue.hpp"
+#include "utils/blocking_ring_buffer.hpp"
+
+namespace
+{
+  const std::size_t ringCapacity = 1024;
+
+  /**
+   * The pattern the ring buffers replace: a SynchronousQueue plus an outer
+   * mutex and condition variable
+   */
+  class LockedQueue
+  {
+    autocomp::SynchronousQueue<long> queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+
+  public:
+
+    explicit LockedQueue(const std::size_t &)
+    {}
+
+    bool push(long && entry)
+    {
+      this->queue.push(std::move(entry));
+      this->condition.notify_one();
+
+      return true;
+    }
+
+    bool pop(long & entry)
+    {
+      while (true) {
+        std::unique_lock<std::mutex> guard(this->mutex);
+        this->condition.wait(guard, [this] ()
+                                    {
+                                      return not this->queue.isEmpty() or
+                                             this->done;
+                                    });
+
+        if (this->queue.pop(entry)) {
+          return true;
+        }
+
+        if (this->done) {
+          return false;
+        }
+      }
+    }
+
+    void close()
+    {
+      {
+        std::unique_lock<std::mutex> guard(this->mutex);
+        this->done = true;
+      }
+
+      this->condition.notify_all();
+    }
+  };
+
+  template <typename Queue>
+  double run(const int nProducers, const int nConsumers,
+             const long entriesPerProducer)
+  {
+    Queue queue(ringCapacity);
+    std::vector<std::thread> producers, consumers;
+    std::vector<long> sums(nConsumers, 0);
+
+    auto tic = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < nConsumers; i++) {
+      consumers.emplace_back([&queue, &sums, i] ()
+                             {
+                               long entry;
+
+                               while (queue.pop(entry)) {
+                                 sums[i] += entry;
+                               }
+                             });
+    }
+
+    for (int i = 0; i < nProducers; i++) {
+      producers.emplace_back([&queue, entriesPerProducer] ()
+                             {
+                               for (long j = 0; j < entriesPerProducer; j++) {
+                                 queue.push(long(j));
+                               }
+                             });
+    }
+
+    for (auto & producer : producers) {
+      producer.join();
+    }
+
+    queue.close();
+
+    for (auto & consumer : consumers) {
+      consumer.join();
+    }
+
+    auto toc = std::chrono::high_resolution_clock::now();
+
+    long sum = 0;
+    for (auto & consumerSum : sums) {
+      sum += consumerSum;
+    }
+
+    if (sum != nProducers * (entriesPerProducer - 1) * entriesPerProducer / 2) {
+      std::cerr << "Entries were lost" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
+    double seconds = std::chrono::duration<double>(toc - tic).count();
+
+    return nProducers * entriesPerProducer / seconds;
+  }
+
+  void report(const std::string & name, const double & entriesPerSecond)
+  {
+    std::cout << "  " << std::left << std::setw(28) << name
+              << std::right << std::setw(14) << std::fixed
+              << std::setprecision(0) << entriesPerSecond << " entries/s"
+              << std::endl;
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  const long entriesPerProducer = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+  std::cout << "1 producer, 1 consumer" << std::endl;
+  report("SynchronousQueue + condvar", run<LockedQueue>(1, 1,
+                                                        entriesPerProducer));
+  report("SpscQueue", run<autocomp::SpscQueue<long>>(1, 1,
+                                                     entriesPerProducer));
+  report("MpmcQueue", run<autocomp::MpmcQueue<long>>(1, 1,
+                                                     entriesPerProducer));
+
+  for (int nThreads : {2, 4}) {
+    std::cout << nThreads << " producers, " << nThreads << " consumers"
+              << std::endl;
+    report("SynchronousQueue + condvar",
+           run<LockedQueue>(nThreads, nThreads, entriesPerProducer));
+    report("MpmcQueue",
+           run<autocomp::MpmcQueue<long>>(nThreads, nThreads,
+                                          entriesPerProducer));
+  }
+
+  return 0;
+}
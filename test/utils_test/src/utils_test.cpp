@@ -1,10 +1,24 @@
 #include "gtest/gtest.h"
 
 #include "buffer_test.hpp"
+#include "buffer_pool_test.hpp"
+#include "bandwidth_estimator_test.hpp"
+#include "bounded_queue_test.hpp"
+#include "memory_governor_test.hpp"
+#include "cpu_budget_test.hpp"
+#include "ring_buffer_test.hpp"
 #include "directory_explorer_test.hpp"
 #include "synchronous_queue_test.hpp"
 #include "thread_pool_test.hpp"
 #include "decision_tree_test.hpp"
+#include "ensemble_model_test.hpp"
+#include "contextual_bandit_test.hpp"
+#include "feedback_controller_test.hpp"
+#include "codec_calibration_test.hpp"
+#include "byte_histogram_test.hpp"
+#include "file_format_test.hpp"
+#include "floating_point_detector_test.hpp"
+#include "change_point_detector_test.hpp"
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);